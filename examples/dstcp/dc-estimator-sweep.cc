@@ -0,0 +1,150 @@
+// Offline parameter sweep of the DCTCP, DSTCP and DcVegas estimators.
+//
+// Replays the ACKs recorded by one run of single-rack, leaf-spine or
+// fat-tree with --rttSamples through every combination of the estimation
+// gain, the queue length threshold and the initial minimum RTT, and prints
+// one CSV row per combination.  All the combinations are evaluated in a
+// single pass over the file, see TcpDcEstimatorReplay.
+//
+// Example:
+//
+//   ./waf --run "single-rack --tcpTypeId=TcpDstcp --rttSamples"
+//   ./waf --run "dc-estimator-sweep --tcpTypeId=TcpDstcp
+//       --file=TcpDstcp-single-rack-8-load-1-seed-1-rtt.bin
+//       --g=0.0078125:0.5:2 --tdcv=1:32:1 --minRtt=30,42,60"
+
+#include <iostream>
+#include <sstream>
+
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("DcEstimatorSweep");
+
+/**
+ * Parse a list of values: "a,b,c" or a range "first:last:step", the step
+ * being a factor for the gains and an increment otherwise.
+ *
+ * \param text the list
+ * \param geometric whether the step of a range is a factor
+ * \returns the values
+ */
+static std::vector<double>
+ParseList (std::string text, bool geometric)
+{
+  std::vector<double> values;
+  double first, last, step;
+  char c1, c2;
+  std::istringstream range (text);
+  if (range >> first >> c1 >> last >> c2 >> step && c1 == ':' && c2 == ':')
+    {
+      for (double v = first; v <= last * (1 + 1e-9); v = geometric ? v * step : v + step)
+        {
+          values.push_back (v);
+          if ((geometric && step <= 1) || (!geometric && step <= 0))
+            {
+              break;
+            }
+        }
+      return values;
+    }
+  std::istringstream list (text);
+  std::string item;
+  while (std::getline (list, item, ','))
+    {
+      values.push_back (std::stod (item));
+    }
+  return values;
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string tcpTypeId = "TcpDstcp";
+  std::string fileName;
+  uint32_t segmentSize = 1448;
+  std::string gList = "0.0625";
+  std::string tdcvList = "11";
+  std::string minRttList = "42";
+  double alpha = 1.0;
+  double beta = 1.0;
+  bool followCwnd = false;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("tcpTypeId", "Congestion control replayed: TcpDctcp, TcpDstcp or TcpDcVegas", tcpTypeId);
+  cmd.AddValue ("file", "RTT samples written by --rttSamples", fileName);
+  cmd.AddValue ("segmentSize", "Segment size of the recorded sockets", segmentSize);
+  cmd.AddValue ("g", "Estimation gains, as a list or a geometric range first:last:factor", gList);
+  cmd.AddValue ("tdcv", "Queue length thresholds in segments, as a list or a range first:last:step", tdcvList);
+  cmd.AddValue ("minRtt", "Initial minimum RTTs in microseconds, as a list or a range first:last:step", minRttList);
+  cmd.AddValue ("alpha", "Initial alpha", alpha);
+  cmd.AddValue ("beta", "Initial beta", beta);
+  cmd.AddValue ("followCwnd", "Use the recorded congestion window instead of replaying it", followCwnd);
+  cmd.Parse (argc, argv);
+
+  TcpDcEstimatorReplay::Variant variant;
+  if (tcpTypeId == "TcpDctcp")
+    {
+      variant = TcpDcEstimatorReplay::DCTCP;
+    }
+  else if (tcpTypeId == "TcpDstcp")
+    {
+      variant = TcpDcEstimatorReplay::DSTCP;
+    }
+  else if (tcpTypeId == "TcpDcVegas")
+    {
+      variant = TcpDcEstimatorReplay::DCVEGAS;
+    }
+  else
+    {
+      NS_FATAL_ERROR ("Unknown congestion control " << tcpTypeId);
+    }
+
+  TcpDcEstimatorReplay replay (variant, segmentSize);
+  replay.SetFollowRecordedCwnd (followCwnd);
+  std::vector<double> gs = ParseList (gList, true);
+  std::vector<double> tdcvs = ParseList (tdcvList, false);
+  std::vector<double> minRtts = ParseList (minRttList, false);
+  for (std::vector<double>::const_iterator g = gs.begin (); g != gs.end (); ++g)
+    {
+      for (std::vector<double>::const_iterator tdcv = tdcvs.begin (); tdcv != tdcvs.end (); ++tdcv)
+        {
+          for (std::vector<double>::const_iterator minRtt = minRtts.begin (); minRtt != minRtts.end (); ++minRtt)
+            {
+              TcpDcEstimatorReplay::Parameters p;
+              p.g = *g;
+              p.tdcv = static_cast<uint32_t> (*tdcv);
+              p.minRtt = MicroSeconds (*minRtt);
+              p.alpha = alpha;
+              p.beta = beta;
+              replay.AddParameters (p);
+            }
+        }
+    }
+
+  if (!replay.ReplayFile (fileName))
+    {
+      NS_FATAL_ERROR ("Cannot read the RTT samples of " << fileName);
+    }
+
+  std::cout << "g,tdcv,min_rtt_us,acks,windows,bytes_acked,bytes_rtt_marked,"
+            << "ecn_reductions,rtt_reductions,mean_alpha,mean_beta,mean_cwnd" << std::endl;
+  uint32_t index = 0;
+  for (std::vector<double>::const_iterator g = gs.begin (); g != gs.end (); ++g)
+    {
+      for (std::vector<double>::const_iterator tdcv = tdcvs.begin (); tdcv != tdcvs.end (); ++tdcv)
+        {
+          for (std::vector<double>::const_iterator minRtt = minRtts.begin (); minRtt != minRtts.end (); ++minRtt)
+            {
+              TcpDcEstimatorReplay::Result r = replay.GetResult (index++);
+              std::cout << *g << "," << static_cast<uint32_t> (*tdcv) << "," << *minRtt << ","
+                        << r.acks << "," << r.windows << "," << r.bytesAcked << ","
+                        << r.bytesRttMarked << "," << r.ecnReductions << "," << r.rttReductions << ","
+                        << r.meanAlpha << "," << r.meanBeta << "," << r.meanCwnd << std::endl;
+            }
+        }
+    }
+  return 0;
+}
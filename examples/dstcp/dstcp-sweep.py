@@ -0,0 +1,279 @@
+#! /usr/bin/env python3
+## -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+#
+# Parallel parameter sweep for the examples/dstcp scenarios.
+#
+# Every (topology, tcpTypeId, load, seed) point of the requested matrix is an
+# independent replication, so they are run as a pool of worker processes (one
+# per local core by default) instead of the serial ./waf --run loops of the
+# single-rack-*.sh and leaf-spine-*.sh scripts.  The programs are executed
+# directly from the build directory, like test.py does, so that waf is not
+# re-entered for every run.
+#
+# Each replication runs in a private scratch directory; its FlowMonitor output,
+# streamed in the binary format of src/flow-monitor/examples/flowmon_binary.py
+# unless --flowmon-format=xml is given, is reduced to one row per flow and
+# merged into a single SQLite result store:
+#
+#   runs  (run_id, topology, tcp, load, seed, status, wall_s)
+#   flows (run_id, flow_id, src, dst, sport, dport, tx_bytes, rx_bytes,
+#          tx_packets, rx_packets, lost_packets, first_tx_ns, last_rx_ns,
+#          fct_ns)
+#
+# Runs already present in the store with status 0 are skipped, so an
+# interrupted nightly sweep can simply be restarted.
+#
+# Example:
+#
+#   ./waf build
+#   ./examples/dstcp/dstcp-sweep.py --topology single-rack leaf-spine \
+#       --tcp TcpDctcp TcpDcVegas TcpDstcp --load 0.1:1.0:0.1 --seed 1:20 \
+#       --db dstcp-sweep.db
+#
+
+from __future__ import print_function
+import argparse
+import multiprocessing
+import os
+import shutil
+import sqlite3
+import subprocess
+import sys
+import tempfile
+import time
+from xml.etree import ElementTree
+
+TOPOLOGIES = ['single-rack', 'leaf-spine', 'fat-tree']
+
+NS3_BASEDIR = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+
+sys.path.insert(0, os.path.join(NS3_BASEDIR, 'src', 'flow-monitor', 'examples'))
+import flowmon_binary
+
+
+def read_waf_config():
+    '''Locate the build directory and program name decoration used by waf.
+
+    @return A tuple (build directory, list of library directories,
+            program prefix, program suffix).
+    '''
+    lock = os.path.join(NS3_BASEDIR, '.lock-waf_' + sys.platform + '_build')
+    if not os.path.exists(lock):
+        sys.exit('%s not found; configure and build ns-3 with ./waf first' % lock)
+    out_dir = None
+    for line in open(lock):
+        if line.startswith('out_dir ='):
+            out_dir = eval(line.split('=', 1)[1].strip())
+    config = {}
+    for line in open(os.path.join(out_dir, 'c4che', '_cache.py')):
+        key = line.split('=', 1)[0].strip()
+        if key in ('APPNAME', 'VERSION', 'BUILD_PROFILE', 'NS3_MODULE_PATH'):
+            config[key] = eval(line.split('=', 1)[1].strip())
+    suffix = '' if config['BUILD_PROFILE'] == 'release' else '-' + config['BUILD_PROFILE']
+    prefix = config['APPNAME'] + config['VERSION'] + '-'
+    return out_dir, config['NS3_MODULE_PATH'], prefix, suffix
+
+
+def parse_range(text, cast):
+    '''Parse "a,b,c" or "start:stop[:step]" (stop inclusive).'''
+    if ':' not in text:
+        return [cast(v) for v in text.split(',')]
+    parts = [cast(v) for v in text.split(':')]
+    start, stop = parts[0], parts[1]
+    step = parts[2] if len(parts) > 2 else cast(1)
+    values = []
+    i = 0
+    while True:
+        # Multiply instead of accumulating so float loads stay exact-ish.
+        v = start + i * step
+        if v > stop + step * 1e-9:
+            break
+        values.append(round(v, 6) if cast is float else v)
+        i += 1
+    return values
+
+
+def parse_time_ns(tm):
+    # FlowMonitor writes times as e.g. "+123456.0ns"
+    return int(float(tm.rstrip('ns')))
+
+
+def reduce_flowmon(path):
+    '''Reduce a FlowMonitor XML file to a list of per-flow tuples.
+
+    The file is walked with iterparse and elements are released as soon as
+    they are consumed, so the histograms do not have to be held in memory.
+    '''
+    stats = {}
+    tuples = {}
+    for event, el in ElementTree.iterparse(path, events=('end',)):
+        if el.tag == 'Flow' and el.get('txBytes') is not None:
+            first_tx = parse_time_ns(el.get('timeFirstTxPacket'))
+            last_rx = parse_time_ns(el.get('timeLastRxPacket'))
+            stats[int(el.get('flowId'))] = (
+                int(el.get('txBytes')), int(el.get('rxBytes')),
+                int(el.get('txPackets')), int(el.get('rxPackets')),
+                int(el.get('lostPackets')), first_tx, last_rx,
+                last_rx - first_tx if int(el.get('rxPackets')) > 0 else None)
+            el.clear()
+        elif el.tag == 'Flow' and el.get('sourceAddress') is not None:
+            tuples[int(el.get('flowId'))] = (
+                el.get('sourceAddress'), el.get('destinationAddress'),
+                int(el.get('sourcePort')), int(el.get('destinationPort')))
+            el.clear()
+        elif el.tag in ('histogram', 'delayHistogram', 'jitterHistogram',
+                        'packetSizeHistogram', 'flowInterruptionsHistogram'):
+            el.clear()
+    rows = []
+    for flow_id, s in sorted(stats.items()):
+        t = tuples.get(flow_id, (None, None, None, None))
+        rows.append((flow_id,) + t + s)
+    return rows
+
+
+def reduce_flowmon_binary(path):
+    '''Reduce a binary FlowMonitor file to a list of per-flow tuples.'''
+    rows = []
+    for flow in flowmon_binary.read_flows(path):
+        rows.append((flow.flow_id, flow.src, flow.dst, flow.sport, flow.dport,
+                     flow.tx_bytes, flow.rx_bytes, flow.tx_packets, flow.rx_packets,
+                     flow.lost_packets, flow.time_first_tx_ns, flow.time_last_rx_ns,
+                     flow.fct_ns()))
+    return rows
+
+
+def run_one(job):
+    '''Worker: run one replication and return its reduced results.'''
+    program, env, cdf, binary, point = job
+    topology, tcp, load, seed = point
+    workdir = tempfile.mkdtemp(prefix='dstcp-sweep-')
+    argv = [program,
+            '--tcpTypeId=%s' % tcp,
+            '--load=%s' % load,
+            '--randomSeed=%d' % seed,
+            '--cdfFile=%s' % cdf,
+            '--outputDir=%s' % workdir,
+            '--flowmonBinary=%d' % binary]
+    start = time.time()
+    try:
+        with open(os.path.join(workdir, 'stdout.txt'), 'w') as out:
+            status = subprocess.call(argv, cwd=workdir, env=env, stdout=out,
+                                     stderr=subprocess.STDOUT)
+        wall = time.time() - start
+        rows = []
+        outputs = [f for f in os.listdir(workdir) if f.endswith('.bin' if binary else '.xml')]
+        if status == 0 and outputs:
+            reduce = reduce_flowmon_binary if binary else reduce_flowmon
+            rows = reduce(os.path.join(workdir, outputs[0]))
+        elif status == 0:
+            status = -1
+        return point, status, wall, rows
+    finally:
+        shutil.rmtree(workdir, ignore_errors=True)
+
+
+def open_store(path):
+    db = sqlite3.connect(path)
+    db.executescript('''
+        CREATE TABLE IF NOT EXISTS runs (
+            run_id INTEGER PRIMARY KEY,
+            topology TEXT, tcp TEXT, load REAL, seed INTEGER,
+            status INTEGER, wall_s REAL,
+            UNIQUE (topology, tcp, load, seed));
+        CREATE TABLE IF NOT EXISTS flows (
+            run_id INTEGER REFERENCES runs (run_id), flow_id INTEGER,
+            src TEXT, dst TEXT, sport INTEGER, dport INTEGER,
+            tx_bytes INTEGER, rx_bytes INTEGER,
+            tx_packets INTEGER, rx_packets INTEGER, lost_packets INTEGER,
+            first_tx_ns INTEGER, last_rx_ns INTEGER, fct_ns INTEGER,
+            PRIMARY KEY (run_id, flow_id));
+        ''')
+    return db
+
+
+def store_result(db, point, status, wall, rows):
+    topology, tcp, load, seed = point
+    cur = db.execute('SELECT run_id FROM runs WHERE topology=? AND tcp=? AND load=? AND seed=?',
+                     point)
+    old = cur.fetchone()
+    if old is not None:
+        db.execute('DELETE FROM flows WHERE run_id=?', old)
+        db.execute('DELETE FROM runs WHERE run_id=?', old)
+    cur = db.execute('INSERT INTO runs (topology, tcp, load, seed, status, wall_s) VALUES (?,?,?,?,?,?)',
+                     (topology, tcp, load, seed, status, wall))
+    run_id = cur.lastrowid
+    db.executemany('INSERT INTO flows VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?)',
+                   [(run_id,) + r for r in rows])
+    db.commit()
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Run the examples/dstcp scenarios as a parallel sweep')
+    parser.add_argument('--topology', nargs='+', default=['single-rack'], choices=TOPOLOGIES)
+    parser.add_argument('--tcp', nargs='+', default=['TcpDctcp', 'TcpDcVegas', 'TcpDstcp'],
+                        help='TCP TypeIds (without the ns3:: prefix)')
+    parser.add_argument('--load', default='1', help='loads, "a,b,c" or "start:stop:step"')
+    parser.add_argument('--seed', default='1', help='seeds, "a,b,c" or "start:stop"')
+    parser.add_argument('--cdf', default=os.path.join(NS3_BASEDIR, 'DCTCP_CDF.txt'),
+                        help='flow size CDF file')
+    parser.add_argument('--db', default='dstcp-sweep.db', help='SQLite result store')
+    parser.add_argument('-j', '--jobs', type=int, default=multiprocessing.cpu_count(),
+                        help='number of concurrent replications')
+    parser.add_argument('--flowmon-format', choices=['binary', 'xml'], default='binary',
+                        help='FlowMonitor output reduced by the sweep')
+    parser.add_argument('--force', action='store_true',
+                        help='rerun points that already completed in the store')
+    options = parser.parse_args(argv)
+
+    out_dir, module_path, prefix, suffix = read_waf_config()
+    env = dict(os.environ)
+    env['LD_LIBRARY_PATH'] = ':'.join(module_path + [env.get('LD_LIBRARY_PATH', '')])
+    env['DYLD_LIBRARY_PATH'] = ':'.join(module_path + [env.get('DYLD_LIBRARY_PATH', '')])
+
+    programs = {}
+    for topology in options.topology:
+        programs[topology] = os.path.join(out_dir, 'examples', 'dstcp', prefix + topology + suffix)
+        if not os.path.exists(programs[topology]):
+            sys.exit('%s not built; run ./waf configure --enable-examples && ./waf build'
+                     % programs[topology])
+
+    db = open_store(options.db)
+    done = set()
+    if not options.force:
+        done = set(db.execute('SELECT topology, tcp, load, seed FROM runs WHERE status=0'))
+
+    points = [(topology, tcp, load, seed)
+              for topology in options.topology
+              for tcp in options.tcp
+              for load in parse_range(options.load, float)
+              for seed in parse_range(options.seed, int)]
+    todo = [p for p in points if p not in done]
+    print('%d points, %d already in %s, running %d with %d jobs'
+          % (len(points), len(points) - len(todo), options.db, len(todo), options.jobs))
+
+    binary = options.flowmon_format == 'binary'
+    jobs = [(programs[p[0]], env, os.path.abspath(options.cdf), binary, p) for p in todo]
+    failures = 0
+    pool = multiprocessing.Pool(options.jobs)
+    try:
+        # Results are merged in the parent as they complete, so only one
+        # process ever writes to the store.
+        for n, (point, status, wall, rows) in enumerate(pool.imap_unordered(run_one, jobs), 1):
+            store_result(db, point, status, wall, rows)
+            if status != 0:
+                failures += 1
+            print('[%d/%d] %s %s load=%s seed=%d: %s (%.1fs, %d flows)'
+                  % (n, len(jobs), point[0], point[1], point[2], point[3],
+                     'ok' if status == 0 else 'FAIL (%d)' % status, wall, len(rows)))
+        pool.close()
+    except KeyboardInterrupt:
+        pool.terminate()
+        raise
+    finally:
+        pool.join()
+        db.close()
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
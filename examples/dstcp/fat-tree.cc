@@ -10,11 +10,9 @@
 #include "ns3/flow-monitor-module.h"
 #include "ns3/netanim-module.h"
 
-// The CDF in TrafficGenerator
-extern "C"
-{
-  #include "cdf.h"
-}
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
 
 #define PORT_START 10000
 #define PORT_END 50000
@@ -25,21 +23,8 @@ NS_LOG_COMPONENT_DEFINE ("FatTree");
 
 std::ofstream tQueueLength;
 
-double poission_gen_interval(double avg_rate)
-{
-    if (avg_rate > 0)
-       return -logf(1.0 - (double)rand() / RAND_MAX) / avg_rate;
-    else
-       return 0;
-}
-
-template<typename T>
-T rand_range (T min, T max)
-{
-    return min + ((double)max - min) * rand () / RAND_MAX;
-}
-
-void install_applications (uint32_t fromPodId, uint32_t serverCount, uint32_t k, NodeContainer servers, double requestRate, struct cdf_table *cdfTable,
+void install_applications (uint32_t fromPodId, uint32_t serverCount, uint32_t k, NodeContainer servers, Ptr<RandomVariableStream> interArrival, Ptr<RandomVariableStream> flowSizes,
+        Ptr<UniformRandomVariable> uniform,
         long &flowCount, long &totalFlowSize, double START_TIME, double END_TIME, double FLOW_LAUNCH_END_TIME)
 {
     NS_LOG_INFO ("Install applications:");
@@ -47,18 +32,18 @@ void install_applications (uint32_t fromPodId, uint32_t serverCount, uint32_t k,
     {
         uint32_t fromServerIndex = fromPodId * serverCount * (k / 2) + i;
 
-        double startTime = START_TIME + poission_gen_interval (requestRate);
+        double startTime = START_TIME + interArrival->GetValue ();
         while (startTime < FLOW_LAUNCH_END_TIME)
         {
             flowCount ++;
-            uint16_t port = rand_range (PORT_START, PORT_END);
+            uint16_t port = uniform->GetInteger (PORT_START, PORT_END);
 
             uint32_t destServerIndex = fromServerIndex;
             while (destServerIndex >= fromPodId * serverCount * (k / 2)
                     && destServerIndex < (fromPodId + 1) * serverCount * (k / 2))
 
             {
-                destServerIndex = rand_range (0u, serverCount * (k / 2) * k);
+                destServerIndex = uniform->GetInteger (0, serverCount * (k / 2) * k - 1);
             }
 
 	        Ptr<Node> destServer = servers.Get (destServerIndex);
@@ -67,29 +52,35 @@ void install_applications (uint32_t fromPodId, uint32_t serverCount, uint32_t k,
 	        Ipv4Address destAddress = destInterface.GetLocal ();
 
             BulkSendHelper source ("ns3::TcpSocketFactory", InetSocketAddress (destAddress, port));
-            uint32_t flowSize = gen_random_cdf (cdfTable);
+            uint32_t flowSize = flowSizes->GetInteger ();
 
             totalFlowSize += flowSize;
  	          source.SetAttribute ("SendSize", UintegerValue (1448));
             source.SetAttribute ("MaxBytes", UintegerValue(flowSize));
 
             // Install apps
-            ApplicationContainer sourceApp = source.Install (servers.Get (fromServerIndex));
-            sourceApp.Start (Seconds (startTime));
-            sourceApp.Stop (Seconds (END_TIME));
+            if (TopologyPartitionHelper::IsLocal (servers.Get (fromServerIndex)))
+              {
+                ApplicationContainer sourceApp = source.Install (servers.Get (fromServerIndex));
+                sourceApp.Start (Seconds (startTime));
+                sourceApp.Stop (Seconds (END_TIME));
+              }
 
             // Install packet sinks
             PacketSinkHelper sink ("ns3::TcpSocketFactory",
                     InetSocketAddress (Ipv4Address::GetAny (), port));
-            ApplicationContainer sinkApp = sink.Install (servers. Get (destServerIndex));
-            sinkApp.Start (Seconds (startTime));
-            sinkApp.Stop (Seconds (END_TIME));
+            if (TopologyPartitionHelper::IsLocal (servers.Get (destServerIndex)))
+              {
+                ApplicationContainer sinkApp = sink.Install (servers.Get (destServerIndex));
+                sinkApp.Start (Seconds (startTime));
+                sinkApp.Stop (Seconds (END_TIME));
+              }
 
             // NS_LOG_INFO ("\tFlow from server: " << fromServerIndex << " to server: "
             //         << destServerIndex << " on port: " << port << " with flow size: "
             //         << flowSize << " [start time: " << startTime <<"]");
 
-            startTime += poission_gen_interval (requestRate);
+            startTime += interArrival->GetValue ();
         }
     }
 }
@@ -133,21 +124,58 @@ int main (int argc, char *argv[])
   double END_TIME = 0.25;
   double FLOW_LAUNCH_END_TIME = 0.1;
   std::string cdfFileName = "DCTCP_CDF.txt";
+  std::string outputDir = ".";
+  bool flowmonBinary = false;
+  bool rttSamples = false;
+  bool virtualPayload = true;
+  std::string ecmpMode = "PerFlow";
 
   uint32_t k = 4;
   uint32_t serverCount = 4;
+  uint32_t threads = 1;
+  bool distributed = false;
 
   CommandLine cmd (__FILE__);
   cmd.AddValue ("tcpTypeId", "ns-3 TCP TypeId", tcpTypeId);
   cmd.AddValue ("enableSwitchEcn", "enable ECN at switches", enableSwitchEcn);
   cmd.AddValue ("randomSeed", "Random seed, 0 for random generated", randomSeed);
   cmd.AddValue ("load", "Load of the network, 0.0 - 1.0", load);
+  cmd.AddValue ("cdfFile", "File holding the flow size CDF", cdfFileName);
+  cmd.AddValue ("outputDir", "Directory for the FlowMonitor and queue length output", outputDir);
+  cmd.AddValue ("flowmonBinary", "Stream the completed flows to a binary FlowMonitor file instead of writing XML", flowmonBinary);
+  cmd.AddValue ("rttSamples", "Record the RTT samples of the DCTCP, DSTCP and DcVegas sockets to a binary file", rttSamples);
+  cmd.AddValue ("virtualPayload", "Keep only the size of the TCP data in the socket buffers, not its content", virtualPayload);
+  cmd.AddValue ("ecmpMode", "ECMP route selection: PerPacket, PerFlow or Flowlet", ecmpMode);
+  cmd.AddValue ("threads", "Number of threads running the simulation, one per pod at most", threads);
+  cmd.AddValue ("distributed", "Run on the MPI processes, splitting the topology automatically", distributed);
   cmd.Parse (argc, argv);
 
+  // The partitions would share the recorder, which is not thread-safe
+  NS_ABORT_MSG_IF (rttSamples && threads > 1, "Choose either threads or rttSamples");
+#ifdef HAVE_PTHREAD_H
+  if (threads > 1)
+    {
+      MultithreadedSimulatorHelper::Enable ();
+    }
+#else
+  NS_ABORT_MSG_IF (threads > 1, "Multithreaded simulations need thread support");
+#endif
+#ifdef NS3_MPI
+  if (distributed)
+    {
+      NS_ABORT_MSG_IF (threads > 1, "Choose either threads or distributed");
+      MpiInterface::Enable (&argc, &argv);
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DistributedSimulatorImpl"));
+    }
+#else
+  NS_ABORT_MSG_IF (distributed, "Distributed simulations need MPI support");
+#endif
+
   NS_LOG_INFO ("tcpTypeId: " << tcpTypeId);
   NS_LOG_INFO ("load: " << load);
 
   Config::SetDefault ("ns3::TcpL4Protocol::SocketType", StringValue ("ns3::" + tcpTypeId));
+  Config::SetDefault ("ns3::Ipv4GlobalRouting::EcmpMode", StringValue (ecmpMode));
   if(tcpTypeId.compare("TcpDcVegas") == 0)
     {
       //TcpDcVegas doesn't use RED queue, INT_MAX makea the threshold useless
@@ -166,6 +194,7 @@ int main (int argc, char *argv[])
   GlobalValue::Bind ("ChecksumEnabled", BooleanValue (false));
   Config::SetDefault ("ns3::TcpSocketBase::MinRto", TimeValue (MilliSeconds (10)));
   Config::SetDefault ("ns3::TcpSocketBase::Sack", BooleanValue (false));
+  Config::SetDefault ("ns3::TcpSocketBase::VirtualPayload", BooleanValue (virtualPayload));
   Config::SetDefault ("ns3::TcpSocketBase::UseEcn", EnumValue (TcpSocketState::On));
   // if(tcpTypeId.compare("TcpDstcp") == 0 || tcpTypeId.compare("TcpDcVegas") == 0)
     // {
@@ -298,30 +327,40 @@ int main (int argc, char *argv[])
         }
     }
 
+#ifdef NS3_MPI
+  if (distributed)
+    {
+      // Before the routing tables, which are only computed for the
+      // nodes of this process.
+      TopologyPartitionHelper partitioner;
+      partitioner.Install (NodeContainer::GetGlobal (), MpiInterface::GetSize ());
+      NS_LOG_INFO ("Split among " << MpiInterface::GetSize () << " processes: " << partitioner.GetCutSize ()
+                   << " channels cut, lookahead " << partitioner.GetLookahead ());
+    }
+#endif
+
   NS_LOG_INFO ("Populate global routing tables");
   Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
 
   double oversubRatio = static_cast<double> (serverCount * (k / 2) * k * 10000000000) / (10000000000 * (k / 2) * aggregationCount);
   NS_LOG_INFO ("Over-subscription ratio: " << oversubRatio);
 
+  NS_LOG_INFO ("Initialize random seed: " << randomSeed);
+  RngSeedManager::SetSeed (randomSeed == 0 ? static_cast<uint32_t> (time (NULL)) : randomSeed);
+
   NS_LOG_INFO ("Initialize CDF table");
-  struct cdf_table* cdfTable = new cdf_table ();
-  init_cdf (cdfTable);
-  load_cdf (cdfTable, cdfFileName.c_str ());
+  Ptr<CdfFileRandomVariable> flowSizes = CreateObject<CdfFileRandomVariable> ();
+  flowSizes->SetAttribute ("File", StringValue (cdfFileName));
+  flowSizes->SetStream (0);
 
   NS_LOG_INFO ("Calculating request rate");
-  double requestRate = load * 10000000000 / oversubRatio / (8 * avg_cdf (cdfTable));
+  double requestRate = load * 10000000000 / oversubRatio / (8 * flowSizes->GetMean ());
   NS_LOG_INFO ("Average request rate: " << requestRate << " per second");
-
-  NS_LOG_INFO ("Initialize random seed: " << randomSeed);
-  if (randomSeed == 0)
-  {
-    srand ((unsigned)time (NULL));
-  }
-  else
-  {
-     srand (randomSeed);
-  }
+  Ptr<ExponentialRandomVariable> interArrival = CreateObject<ExponentialRandomVariable> ();
+  interArrival->SetAttribute ("Mean", DoubleValue (1 / requestRate));
+  interArrival->SetStream (1);
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uniform->SetStream (2);
 
   NS_LOG_INFO ("Create applications");
 
@@ -330,7 +369,7 @@ int main (int argc, char *argv[])
 
   for (uint32_t fromPodId = 0; fromPodId < k; ++fromPodId)
   {
-    install_applications (fromPodId, serverCount, k, servers, requestRate, cdfTable, flowCount, totalFlowSize, START_TIME, END_TIME, FLOW_LAUNCH_END_TIME);
+    install_applications (fromPodId, serverCount, k, servers, interArrival, flowSizes, uniform, flowCount, totalFlowSize, START_TIME, END_TIME, FLOW_LAUNCH_END_TIME);
   }
 
   NS_LOG_INFO ("Total flow: " << flowCount);
@@ -342,22 +381,77 @@ int main (int argc, char *argv[])
   flowMonitor = flowHelper.InstallAll();
   flowMonitor->CheckForLostPackets ();
   std::stringstream flowMonitorFilename;
-  flowMonitorFilename << tcpTypeId << "-fattree-k-" << k << "-load-" << load<< "-seed-" << randomSeed << ".xml";
+  std::string rank = distributed ? "-rank-" + std::to_string (Simulator::GetSystemId ()) : "";
+  flowMonitorFilename << outputDir << "/" << tcpTypeId << "-fattree-k-" << k << "-load-" << load<< "-seed-" << randomSeed << rank << (flowmonBinary ? ".bin" : ".xml");
+  Ptr<TcpRttRecorder> rttRecorder;
+  if (rttSamples)
+    {
+      std::string rttFileName = flowMonitorFilename.str ();
+      rttFileName = rttFileName.substr (0, rttFileName.rfind ('.')) + "-rtt.bin";
+      rttRecorder = CreateObject<TcpRttRecorder> ();
+      rttRecorder->Open (rttFileName);
+      Config::SetDefaultFailSafe ("ns3::" + tcpTypeId + "::RttRecorder", PointerValue (rttRecorder));
+    }
+
+#ifdef HAVE_PTHREAD_H
+  if (threads > 1)
+    {
+      // A pod (its edges, aggregations and servers) runs in one thread;
+      // the cores are dealt among the threads.
+      MultithreadedSimulatorHelper mt;
+      for (uint32_t i = 0; i < edgeCount; i++)
+        {
+          uint32_t partition = (i / (k / 2)) % threads;
+          mt.SetPartition (edges.Get (i), partition);
+          mt.SetPartition (aggregations.Get (i), partition);
+          for (uint32_t j = 0; j < serverCount; j++)
+            {
+              mt.SetPartition (servers.Get (i * serverCount + j), partition);
+            }
+        }
+      for (uint32_t i = 0; i < coreCount; i++)
+        {
+          mt.SetPartition (cores.Get (i), i % threads);
+        }
+      mt.Install (NodeContainer::GetGlobal (), threads);
+      NS_LOG_INFO ("Running on " << threads << " threads, lookahead " << mt.GetLookahead ());
+    }
+#endif
 
   NS_LOG_INFO ("Start simulation");
   // AnimationInterface anim("single-rack.xml");
   Simulator::Schedule (progressInterval, &PrintProgress, progressInterval);
   Simulator::Stop (Seconds (END_TIME));
 
-//   tQueueLength.open (tcpTypeId + "-sigle-rack-t-length.dat", std::ios::out);
+//   tQueueLength.open (outputDir + "/" + tcpTypeId + "-sigle-rack-t-length.dat", std::ios::out);
 //   tQueueLength << "#Time(s) qlen(pkts) qlen(us)" << std::endl;
 //   Simulator::Schedule (Seconds (START_TIME), &CheckTQueueSize, queueDiscs.Get (1));
     
+  if (flowmonBinary)
+    {
+      flowMonitor->StartBinaryStream (flowMonitorFilename.str (), MilliSeconds (10), false);
+    }
   Simulator::Run ();
   tQueueLength.close ();
-  flowMonitor->SerializeToXmlFile(flowMonitorFilename.str (), true, true);
+  if (flowmonBinary)
+    {
+      flowMonitor->StopBinaryStream ();
+    }
+  else
+    {
+      flowMonitor->SerializeToXmlFile(flowMonitorFilename.str (), true, true);
+    }
+  if (rttRecorder)
+    {
+      rttRecorder->Close ();
+    }
   Simulator::Destroy ();
-  free_cdf (cdfTable);
+#ifdef NS3_MPI
+  if (distributed)
+    {
+      MpiInterface::Disable ();
+    }
+#endif
   NS_LOG_INFO ("Stop simulation");
   return 0;
 }
\ No newline at end of file
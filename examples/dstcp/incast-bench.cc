@@ -0,0 +1,361 @@
+// Incast benchmark of the data center congestion controls.
+//
+// 'senders' servers answer the queries of one receiver through a single
+// switch, all links being 10 Gb/s with 10 us of delay as in single-rack.
+// Each query asks every sender for 'responseBytes' at the same time (by
+// default 'queryBytes' split between the senders, as in the incast
+// experiment of the DCTCP paper) and the next query starts once the last
+// response completed.  'longFlows' other servers send long flows to the
+// receiver during the whole run, to measure the queries behind a standing
+// queue.
+//
+// One line of JSON is printed at the end, and appended to 'report' if
+// given, with the simulator performance of the run (events, wall time,
+// events per second, peak resident memory) and the protocol behavior
+// (response and query completion time percentiles, long flow goodput,
+// drops, marks and maximum length of the bottleneck queue).  The run is
+// deterministic for a given seed, so any change of the protocol figures
+// between two commits is a behavior change.  incast-bench.py runs the
+// matrix of congestion controls, fan-ins and mixes and compares reports.
+//
+// Example:
+//
+//   ./waf --run "incast-bench --tcpTypeId=TcpDstcp --senders=64 --longFlows=2"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <sys/resource.h>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/traffic-control-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("IncastBench");
+
+/// First port of the responses, one port per sender
+static const uint16_t RESPONSE_PORT = 10000;
+/// First port of the long flows
+static const uint16_t LONG_FLOW_PORT = 9000;
+
+/**
+ * \brief The queries of an incast benchmark and their completion times
+ */
+class IncastQueries
+{
+public:
+  /**
+   * \param senders the nodes answering the queries
+   * \param receiver the address of the receiver
+   * \param responseBytes the size of each response
+   * \param queries the number of queries
+   */
+  IncastQueries (NodeContainer senders, Ipv4Address receiver, uint32_t responseBytes, uint32_t queries);
+
+  /// Send a query to all the senders
+  void StartQuery (void);
+  /**
+   * \brief Account for data received from a sender
+   * \param sender the index of the sender
+   * \param p the packet received
+   * \param from the address of the sender
+   */
+  void Received (uint32_t sender, Ptr<const Packet> p, const Address &from);
+
+  std::vector<double> m_fcts;    //!< Response completion times, in microseconds
+  std::vector<double> m_qcts;    //!< Query completion times, in microseconds
+
+private:
+  NodeContainer m_senders;       //!< The nodes answering the queries
+  Ipv4Address m_receiver;        //!< The address of the receiver
+  uint32_t m_responseBytes;      //!< Size of each response
+  uint32_t m_queries;            //!< Number of queries
+  uint32_t m_started;            //!< Number of queries started
+  uint32_t m_pending;            //!< Responses of the current query not complete
+  Time m_queryStart;             //!< Start of the current query
+  std::vector<uint64_t> m_rx;    //!< Bytes received from each sender
+};
+
+IncastQueries::IncastQueries (NodeContainer senders, Ipv4Address receiver,
+                              uint32_t responseBytes, uint32_t queries)
+  : m_senders (senders),
+    m_receiver (receiver),
+    m_responseBytes (responseBytes),
+    m_queries (queries),
+    m_started (0),
+    m_pending (0),
+    m_rx (senders.GetN (), 0)
+{
+}
+
+void
+IncastQueries::StartQuery (void)
+{
+  m_started++;
+  m_pending = m_senders.GetN ();
+  m_queryStart = Simulator::Now ();
+  for (uint32_t i = 0; i < m_senders.GetN (); i++)
+    {
+      BulkSendHelper source ("ns3::TcpSocketFactory", InetSocketAddress (m_receiver, RESPONSE_PORT + i));
+      source.SetAttribute ("SendSize", UintegerValue (1448));
+      source.SetAttribute ("MaxBytes", UintegerValue (m_responseBytes));
+      source.Install (m_senders.Get (i)).Start (Seconds (0));
+    }
+}
+
+void
+IncastQueries::Received (uint32_t sender, Ptr<const Packet> p, const Address &from)
+{
+  uint64_t expected = static_cast<uint64_t> (m_started) * m_responseBytes;
+  bool complete = m_rx[sender] >= expected;
+  m_rx[sender] += p->GetSize ();
+  if (complete || m_rx[sender] < expected)
+    {
+      return;
+    }
+  m_fcts.push_back ((Simulator::Now () - m_queryStart).GetSeconds () * 1e6);
+  if (--m_pending > 0)
+    {
+      return;
+    }
+  m_qcts.push_back ((Simulator::Now () - m_queryStart).GetSeconds () * 1e6);
+  if (m_started < m_queries)
+    {
+      StartQuery ();
+    }
+  else
+    {
+      Simulator::Stop ();
+    }
+}
+
+/**
+ * \param values the values, sorted
+ * \param p the percentile, between 0 and 100
+ * \returns the nearest-rank percentile of the values, 0 if there are none
+ */
+static double
+Percentile (const std::vector<double> &values, double p)
+{
+  if (values.empty ())
+    {
+      return 0;
+    }
+  size_t rank = static_cast<size_t> (std::ceil (p / 100 * values.size ()));
+  return values[std::max<size_t> (rank, 1) - 1];
+}
+
+/**
+ * \param json the JSON object being written
+ * \param name the name of the member
+ * \param values the values
+ */
+static void
+WritePercentiles (std::ostream &json, std::string name, std::vector<double> values)
+{
+  std::sort (values.begin (), values.end ());
+  json << ",\"" << name << "_p50_us\":" << Percentile (values, 50)
+       << ",\"" << name << "_p95_us\":" << Percentile (values, 95)
+       << ",\"" << name << "_p99_us\":" << Percentile (values, 99)
+       << ",\"" << name << "_max_us\":" << (values.empty () ? 0 : values.back ());
+}
+
+/**
+ * \param maxPackets the maximum queue length, updated
+ * \param oldValue the previous queue length
+ * \param newValue the queue length
+ */
+static void
+QueueLengthChanged (uint32_t *maxPackets, uint32_t oldValue, uint32_t newValue)
+{
+  *maxPackets = std::max (*maxPackets, newValue);
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string tcpTypeId = "TcpDctcp";
+  uint32_t senders = 32;
+  uint32_t queryBytes = 1000000;
+  uint32_t responseBytes = 0;
+  uint32_t queries = 20;
+  uint32_t longFlows = 0;
+  Time warmup = MilliSeconds (10);
+  Time maxTime = Seconds (5);
+  std::string bufferSize = "600p";
+  double K = 65;
+  uint32_t randomSeed = 1;
+  std::string report;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("tcpTypeId", "Congestion control: TcpDctcp, TcpDstcp or TcpDcVegas", tcpTypeId);
+  cmd.AddValue ("senders", "Number of servers answering each query", senders);
+  cmd.AddValue ("queryBytes", "Bytes of each query, split between the senders", queryBytes);
+  cmd.AddValue ("responseBytes", "Bytes sent by each sender, 0 to split queryBytes", responseBytes);
+  cmd.AddValue ("queries", "Number of queries", queries);
+  cmd.AddValue ("longFlows", "Number of long flows to the receiver", longFlows);
+  cmd.AddValue ("warmup", "Time given to the long flows before the first query", warmup);
+  cmd.AddValue ("maxTime", "Simulation time after which the run is stopped", maxTime);
+  cmd.AddValue ("bufferSize", "Size of the switch queues", bufferSize);
+  cmd.AddValue ("K", "Marking threshold of the switch queues, in packets", K);
+  cmd.AddValue ("randomSeed", "Seed of the random number generators", randomSeed);
+  cmd.AddValue ("report", "File the JSON report is appended to", report);
+  cmd.Parse (argc, argv);
+
+  if (senders == 0 || queries == 0)
+    {
+      NS_FATAL_ERROR ("At least one sender and one query are needed");
+    }
+  if (responseBytes == 0)
+    {
+      responseBytes = std::max<uint32_t> (queryBytes / senders, 1);
+    }
+  RngSeedManager::SetSeed (randomSeed);
+
+  SystemWallClockMs setupClock;
+  setupClock.Start ();
+
+  // The configuration of single-rack
+  Config::SetDefault ("ns3::TcpL4Protocol::SocketType", StringValue ("ns3::" + tcpTypeId));
+  if (tcpTypeId == "TcpDcVegas")
+    {
+      // TcpDcVegas does not use the marks
+      K = INT_MAX;
+    }
+  Config::SetDefault ("ns3::TcpDstcp::DstcpMinRtt", TimeValue (MicroSeconds (42)));
+  Config::SetDefault ("ns3::TcpDstcp::DstcpTdcvOnInit", UintegerValue (11));
+  Config::SetDefault ("ns3::TcpDcVegas::DcVegasMinRtt", TimeValue (MicroSeconds (42)));
+  Config::SetDefault ("ns3::TcpDcVegas::DcVegasTdcvOnInit", UintegerValue (11));
+  Config::SetDefault ("ns3::TcpSocket::InitialCwnd", UintegerValue (10));
+  Config::SetDefault ("ns3::TcpSocket::SegmentSize", UintegerValue (1448));
+  Config::SetDefault ("ns3::TcpSocket::DelAckCount", UintegerValue (1));
+  GlobalValue::Bind ("ChecksumEnabled", BooleanValue (false));
+  Config::SetDefault ("ns3::TcpSocketBase::MinRto", TimeValue (MilliSeconds (10)));
+  Config::SetDefault ("ns3::TcpSocketBase::Sack", BooleanValue (false));
+  Config::SetDefault ("ns3::TcpSocketBase::VirtualPayload", BooleanValue (true));
+  Config::SetDefault ("ns3::TcpSocketBase::UseEcn", EnumValue (TcpSocketState::On));
+  Config::SetDefault ("ns3::RedQueueDisc::UseEcn", BooleanValue (true));
+  Config::SetDefault ("ns3::RedQueueDisc::UseHardDrop", BooleanValue (false));
+  Config::SetDefault ("ns3::RedQueueDisc::MeanPktSize", UintegerValue (1500));
+  Config::SetDefault ("ns3::RedQueueDisc::MaxSize", QueueSizeValue (QueueSize (bufferSize)));
+  Config::SetDefault ("ns3::RedQueueDisc::QW", DoubleValue (1));
+
+  Ptr<Node> tor = CreateObject<Node> ();
+  Ptr<Node> receiver = CreateObject<Node> ();
+  NodeContainer responders;
+  responders.Create (senders);
+  NodeContainer longSenders;
+  longSenders.Create (longFlows);
+
+  InternetStackHelper stack;
+  stack.InstallAll ();
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Gbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("10us"));
+
+  TrafficControlHelper tchRed;
+  tchRed.SetRootQueueDisc ("ns3::RedQueueDisc",
+                           "LinkBandwidth", StringValue ("10Gbps"),
+                           "LinkDelay", StringValue ("10us"),
+                           "MinTh", DoubleValue (K),
+                           "MaxTh", DoubleValue (K));
+
+  Ipv4AddressHelper address ("10.1.0.0", "255.255.255.0");
+  NetDeviceContainer bottleneck = p2p.Install (tor, receiver);
+  QueueDiscContainer bottleneckQueue = tchRed.Install (bottleneck.Get (0));
+  Ipv4Address receiverAddress = address.Assign (bottleneck).GetAddress (1);
+
+  NodeContainer hosts (responders, longSenders);
+  for (uint32_t i = 0; i < hosts.GetN (); i++)
+    {
+      address.NewNetwork ();
+      NetDeviceContainer devices = p2p.Install (hosts.Get (i), tor);
+      tchRed.Install (devices.Get (1));
+      address.Assign (devices);
+    }
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  IncastQueries incast (responders, receiverAddress, responseBytes, queries);
+  for (uint32_t i = 0; i < senders; i++)
+    {
+      PacketSinkHelper sink ("ns3::TcpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), RESPONSE_PORT + i));
+      Ptr<Application> app = sink.Install (receiver).Get (0);
+      app->TraceConnectWithoutContext ("Rx", MakeCallback (&IncastQueries::Received, &incast).Bind (i));
+    }
+
+  ApplicationContainer longSinks;
+  for (uint32_t i = 0; i < longFlows; i++)
+    {
+      BulkSendHelper source ("ns3::TcpSocketFactory", InetSocketAddress (receiverAddress, LONG_FLOW_PORT + i));
+      source.SetAttribute ("SendSize", UintegerValue (1448));
+      source.SetAttribute ("MaxBytes", UintegerValue (0));
+      source.Install (longSenders.Get (i));
+      PacketSinkHelper sink ("ns3::TcpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), LONG_FLOW_PORT + i));
+      longSinks.Add (sink.Install (receiver));
+    }
+
+  uint32_t maxQueuePackets = 0;
+  bottleneckQueue.Get (0)->TraceConnectWithoutContext ("PacketsInQueue",
+                                                       MakeBoundCallback (&QueueLengthChanged, &maxQueuePackets));
+
+  Simulator::Schedule (longFlows > 0 ? warmup : Seconds (0), &IncastQueries::StartQuery, &incast);
+  Simulator::Stop (maxTime);
+  int64_t setupMs = setupClock.End ();
+
+  SystemWallClockMs runClock;
+  runClock.Start ();
+  Simulator::Run ();
+  int64_t runMs = runClock.End ();
+
+  double simSeconds = Simulator::Now ().GetSeconds ();
+  uint64_t events = Simulator::GetEventCount ();
+  uint64_t longBytes = 0;
+  for (uint32_t i = 0; i < longSinks.GetN (); i++)
+    {
+      longBytes += DynamicCast<PacketSink> (longSinks.Get (i))->GetTotalRx ();
+    }
+  const QueueDisc::Stats &queueStats = bottleneckQueue.Get (0)->GetStats ();
+  Simulator::Destroy ();
+
+  struct rusage usage;
+  getrusage (RUSAGE_SELF, &usage);
+
+  std::ostringstream json;
+  json << "{\"tcp\":\"" << tcpTypeId << "\""
+       << ",\"senders\":" << senders
+       << ",\"long_flows\":" << longFlows
+       << ",\"response_bytes\":" << responseBytes
+       << ",\"queries\":" << queries
+       << ",\"seed\":" << randomSeed
+       << ",\"events\":" << events
+       << ",\"setup_ms\":" << setupMs
+       << ",\"run_ms\":" << runMs
+       << ",\"events_per_s\":" << (runMs > 0 ? events * 1000.0 / runMs : 0)
+       << ",\"peak_rss_kb\":" << usage.ru_maxrss
+       << ",\"sim_s\":" << simSeconds
+       << ",\"completed_queries\":" << incast.m_qcts.size ();
+  WritePercentiles (json, "fct", incast.m_fcts);
+  WritePercentiles (json, "qct", incast.m_qcts);
+  json << ",\"long_goodput_gbps\":" << (simSeconds > 0 ? longBytes * 8 / simSeconds / 1e9 : 0)
+       << ",\"drops\":" << queueStats.nTotalDroppedPackets
+       << ",\"marks\":" << queueStats.nTotalMarkedPackets
+       << ",\"max_queue_packets\":" << maxQueuePackets
+       << "}";
+
+  std::cout << json.str () << std::endl;
+  if (!report.empty ())
+    {
+      std::ofstream out (report, std::ios::app);
+      out << json.str () << std::endl;
+    }
+  return incast.m_qcts.size () == queries ? 0 : 1;
+}
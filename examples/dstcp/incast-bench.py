@@ -0,0 +1,182 @@
+#! /usr/bin/env python3
+## -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+#
+# Incast benchmark suite of TcpDctcp, TcpDcVegas and TcpDstcp.
+#
+# Runs incast-bench for every (tcpTypeId, senders, longFlows) point of the
+# requested matrix and writes its JSON lines, tagged with the commit of the
+# tree and the host, to a report:
+#
+#   {"commit": ..., "host": ..., "tcp": ..., "senders": ..., "long_flows": ...,
+#    "events": ..., "run_ms": ..., "events_per_s": ..., "peak_rss_kb": ...,
+#    "fct_p50_us": ..., "fct_p99_us": ..., "qct_p99_us": ..., ...}
+#
+# Each point is a separate process, so that its peak resident memory is its
+# own, and the points run one at a time by default so that their timings do
+# not disturb each other.
+#
+# With --compare, the report is checked against the report of an earlier
+# commit.  The simulator performance (events per second and peak memory)
+# regresses when it is worse by more than --perf-tolerance.  The runs are
+# deterministic, so the protocol behavior (event count, completion times,
+# goodput, drops and marks) regresses when it differs by more than
+# --behavior-tolerance, exactly by default.  The exit status is 1 if any
+# point regressed or failed.
+#
+# Example:
+#
+#   ./waf build
+#   ./examples/dstcp/incast-bench.py --report base.jsonl
+#   (change and rebuild)
+#   ./examples/dstcp/incast-bench.py --report new.jsonl --compare base.jsonl
+#
+
+from __future__ import print_function
+import argparse
+import importlib.machinery
+import json
+import os
+import socket
+import subprocess
+import sys
+
+NS3_BASEDIR = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+
+# The build directory lookup of the sweep driver
+dstcp_sweep = importlib.machinery.SourceFileLoader(
+    'dstcp_sweep', os.path.join(os.path.dirname(os.path.abspath(__file__)), 'dstcp-sweep.py')).load_module()
+
+KEY = ('tcp', 'senders', 'long_flows')
+
+# Higher is better for these, lower is better for the other performance figures
+HIGHER_IS_BETTER = ('events_per_s',)
+PERFORMANCE = ('events_per_s', 'peak_rss_kb')
+BEHAVIOR = ('events', 'completed_queries', 'fct_p50_us', 'fct_p99_us', 'qct_p50_us',
+            'qct_p99_us', 'long_goodput_gbps', 'drops', 'marks', 'max_queue_packets')
+
+
+def git_commit():
+    try:
+        return subprocess.check_output(['git', 'rev-parse', '--short', 'HEAD'], cwd=NS3_BASEDIR,
+                                       stderr=subprocess.DEVNULL).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return 'unknown'
+
+
+def run_point(program, env, point, options):
+    '''Run one point of the matrix and return its report, or None.'''
+    tcp, senders, long_flows = point
+    argv = [program,
+            '--tcpTypeId=%s' % tcp,
+            '--senders=%d' % senders,
+            '--longFlows=%d' % long_flows,
+            '--queries=%d' % options.queries,
+            '--queryBytes=%d' % options.query_bytes,
+            '--randomSeed=%d' % options.seed]
+    proc = subprocess.Popen(argv, env=env, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    out = proc.communicate()[0].decode()
+    for line in reversed(out.splitlines()):
+        if line.startswith('{'):
+            result = json.loads(line)
+            result['status'] = proc.returncode
+            return result
+    sys.stderr.write(out)
+    return None
+
+
+def compare(base, new, options):
+    '''Print the differences of two reports and return the number of regressions.'''
+    old = dict((tuple(r[k] for k in KEY), r) for r in base)
+    regressions = 0
+    for r in new:
+        key = tuple(r[k] for k in KEY)
+        if key not in old:
+            continue
+        b = old[key]
+        notes = []
+        for field in PERFORMANCE + BEHAVIOR:
+            if field not in b or field not in r:
+                continue
+            before, after = float(b[field]), float(r[field])
+            change = (after - before) / before if before else (0.0 if after == before else float('inf'))
+            if field in PERFORMANCE:
+                worse = -change if field in HIGHER_IS_BETTER else change
+                regressed = worse > options.perf_tolerance
+            else:
+                regressed = abs(change) > options.behavior_tolerance
+            if regressed or (field in PERFORMANCE and abs(change) > options.perf_tolerance):
+                notes.append('%s %s -> %s (%+.1f%%)%s'
+                             % (field, b[field], r[field], 100 * change, ' REGRESSION' if regressed else ''))
+            regressions += regressed
+        print('%s senders=%d long_flows=%d: %s'
+              % (key[0], key[1], key[2], '; '.join(notes) if notes else 'unchanged'))
+    return regressions
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Run the incast benchmark suite')
+    parser.add_argument('--tcp', nargs='+', default=['TcpDctcp', 'TcpDcVegas', 'TcpDstcp'],
+                        help='TCP TypeIds (without the ns3:: prefix)')
+    parser.add_argument('--senders', default='8,16,32,64,128,256',
+                        help='fan-ins, "a,b,c" or "start:stop:step"')
+    parser.add_argument('--long-flows', default='0,2',
+                        help='numbers of long flows mixed with the queries')
+    parser.add_argument('--queries', type=int, default=20, help='queries of each run')
+    parser.add_argument('--query-bytes', type=int, default=1000000,
+                        help='bytes of each query, split between the senders')
+    parser.add_argument('--seed', type=int, default=1, help='random seed')
+    parser.add_argument('--report', default='incast-bench.jsonl',
+                        help='JSON lines report written')
+    parser.add_argument('--compare', help='report of an earlier run to compare with')
+    parser.add_argument('--perf-tolerance', type=float, default=0.1,
+                        help='relative loss of events per second or memory tolerated')
+    parser.add_argument('--behavior-tolerance', type=float, default=0.0,
+                        help='relative change of the protocol figures tolerated')
+    options = parser.parse_args(argv)
+
+    out_dir, module_path, prefix, suffix = dstcp_sweep.read_waf_config()
+    env = dict(os.environ)
+    env['LD_LIBRARY_PATH'] = ':'.join(module_path + [env.get('LD_LIBRARY_PATH', '')])
+    env['DYLD_LIBRARY_PATH'] = ':'.join(module_path + [env.get('DYLD_LIBRARY_PATH', '')])
+    program = os.path.join(out_dir, 'examples', 'dstcp', prefix + 'incast-bench' + suffix)
+    if not os.path.exists(program):
+        sys.exit('%s not built; run ./waf configure --enable-examples && ./waf build' % program)
+
+    points = [(tcp, senders, long_flows)
+              for tcp in options.tcp
+              for senders in dstcp_sweep.parse_range(options.senders, int)
+              for long_flows in dstcp_sweep.parse_range(options.long_flows, int)]
+    commit = git_commit()
+    host = socket.gethostname()
+    results = []
+    failures = 0
+    with open(options.report, 'w') as report:
+        for n, point in enumerate(points, 1):
+            result = run_point(program, env, point, options)
+            if result is None or result['status'] != 0:
+                failures += 1
+            if result is None:
+                print('[%d/%d] %s senders=%d long_flows=%d: FAIL'
+                      % ((n, len(points)) + point))
+                continue
+            result['commit'] = commit
+            result['host'] = host
+            report.write(json.dumps(result, sort_keys=True) + '\n')
+            report.flush()
+            results.append(result)
+            print('[%d/%d] %s senders=%d long_flows=%d: %.0f ev/s, %d kB, qct p99 %.0f us%s'
+                  % ((n, len(points)) + point
+                     + (result['events_per_s'], result['peak_rss_kb'], result['qct_p99_us'],
+                        '' if result['status'] == 0 else ' (incomplete)')))
+
+    regressions = 0
+    if options.compare:
+        with open(options.compare) as f:
+            base = [json.loads(line) for line in f if line.strip()]
+        regressions = compare(base, results, options)
+        print('%d regressions' % regressions)
+    return 1 if failures or regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -10,11 +10,9 @@
 #include "ns3/flow-monitor-module.h"
 #include "ns3/netanim-module.h"
 
-// The CDF in TrafficGenerator
-extern "C"
-{
-  #include "cdf.h"
-}
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
 
 #define PORT_START 10000
 #define PORT_END 50000
@@ -25,39 +23,25 @@ NS_LOG_COMPONENT_DEFINE ("LeafSpine");
 
 std::ofstream tQueueLength;
 
-double poission_gen_interval(double avg_rate)
-{
-    if (avg_rate > 0)
-       return -logf(1.0 - (double)rand() / RAND_MAX) / avg_rate;
-    else
-       return 0;
-}
-
-template<typename T>
-T rand_range (T min, T max)
-{
-    return min + ((double)max - min) * rand () / RAND_MAX;
-}
-
-void install_applications (int fromLeafId, NodeContainer servers, double requestRate, struct cdf_table *cdfTable,
+void install_applications (int fromLeafId, NodeContainer servers, Ptr<RandomVariableStream> interArrival, Ptr<RandomVariableStream> flowSizes,
+        Ptr<UniformRandomVariable> uniform,
         long &flowCount, long &totalFlowSize, int SERVER_COUNT, int LEAF_COUNT, double START_TIME, double END_TIME, double FLOW_LAUNCH_END_TIME)
 {
     NS_LOG_INFO ("Install applications:");
     for (int i = 0; i < SERVER_COUNT; i++)
     {
         int fromServerIndex = fromLeafId * SERVER_COUNT + i;
-        double startTime = START_TIME + poission_gen_interval (requestRate);
+        double startTime = START_TIME + interArrival->GetValue ();
           
         while (startTime < FLOW_LAUNCH_END_TIME)
         {
           flowCount ++;
-        //   double port = rand_range (PORT_START, PORT_END);
           double port = PORT_START + flowCount;
 
           int destServerIndex = fromServerIndex;
 	        while (destServerIndex >= fromLeafId * SERVER_COUNT && destServerIndex < fromLeafId * SERVER_COUNT + SERVER_COUNT)
             {
-		        destServerIndex = rand_range (0, SERVER_COUNT * LEAF_COUNT);
+		        destServerIndex = uniform->GetInteger (0, SERVER_COUNT * LEAF_COUNT - 1);
             }
 
           Ptr<Node> destServer = servers.Get (destServerIndex);
@@ -66,7 +50,7 @@ void install_applications (int fromLeafId, NodeContainer servers, double request
 	        Ipv4Address destAddress = destInterface.GetLocal ();
 
           BulkSendHelper source ("ns3::TcpSocketFactory", InetSocketAddress (destAddress, port));
-          uint32_t flowSize = gen_random_cdf (cdfTable);
+          uint32_t flowSize = flowSizes->GetInteger ();
 
           totalFlowSize += flowSize;
 
@@ -74,15 +58,21 @@ void install_applications (int fromLeafId, NodeContainer servers, double request
           source.SetAttribute ("MaxBytes", UintegerValue(flowSize));
 
           // Install apps
-          ApplicationContainer sourceApp = source.Install (servers.Get (fromServerIndex));
-          sourceApp.Start (Seconds (startTime));
-          sourceApp.Stop (Seconds (END_TIME));
+          if (TopologyPartitionHelper::IsLocal (servers.Get (fromServerIndex)))
+            {
+              ApplicationContainer sourceApp = source.Install (servers.Get (fromServerIndex));
+              sourceApp.Start (Seconds (startTime));
+              sourceApp.Stop (Seconds (END_TIME));
+            }
 
           // Install packet sinks
           PacketSinkHelper sink ("ns3::TcpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port));
-          ApplicationContainer sinkApp = sink.Install (servers. Get (destServerIndex));
-          sinkApp.Start (Seconds (START_TIME));
-          sinkApp.Stop (Seconds (END_TIME));
+          if (TopologyPartitionHelper::IsLocal (servers.Get (destServerIndex)))
+            {
+              ApplicationContainer sinkApp = sink.Install (servers.Get (destServerIndex));
+              sinkApp.Start (Seconds (START_TIME));
+              sinkApp.Stop (Seconds (END_TIME));
+            }
 
           // /*
           // NS_LOG_INFO ("\tFlow from server: " << fromServerIndex << " to server: "
@@ -90,7 +80,7 @@ void install_applications (int fromLeafId, NodeContainer servers, double request
           //           << flowSize << " [start time: " << startTime <<"]");
           // */
 
-          startTime += poission_gen_interval (requestRate);
+          startTime += interArrival->GetValue ();
         }
     }
 }
@@ -121,6 +111,8 @@ int main (int argc, char *argv[])
   LogComponentEnable ("LeafSpine", LOG_LEVEL_INFO);
   std::string tcpTypeId = "TcpDctcp";//TcpDcVegas, TcpDstcp, TcpDctcp
   std::string bufferSize = "600p";
+  std::string sharedBuffer = "";
+  double bufferAlpha = 1;
   double K1 = 65;
 //   double K10 = 65;
   bool enableSwitchEcn = true;
@@ -133,23 +125,68 @@ int main (int argc, char *argv[])
   double END_TIME = 0.25;
   double FLOW_LAUNCH_END_TIME = 0.1;
   std::string cdfFileName = "DCTCP_CDF.txt";
+  std::string outputDir = ".";
+  bool flowmonBinary = false;
+  bool rttSamples = false;
+  bool virtualPayload = true;
+  std::string ecmpMode = "PerFlow";
 
   int SERVER_COUNT = 8;
   int SPINE_COUNT = 4;
   int LEAF_COUNT = 4;
   int LINK_COUNT = 1;
+  uint32_t threads = 1;
+  bool distributed = false;
+  uint32_t fluidFlows = 0;
+  uint32_t maxTrainLength = 1;
+  std::string profile = "";
 
   CommandLine cmd (__FILE__);
   cmd.AddValue ("tcpTypeId", "ns-3 TCP TypeId", tcpTypeId);
   cmd.AddValue ("enableSwitchEcn", "enable ECN at switches", enableSwitchEcn);
   cmd.AddValue ("randomSeed", "Random seed, 0 for random generated", randomSeed);
   cmd.AddValue ("load", "Load of the network, 0.0 - 1.0", load);
+  cmd.AddValue ("cdfFile", "File holding the flow size CDF", cdfFileName);
+  cmd.AddValue ("outputDir", "Directory for the FlowMonitor and queue length output", outputDir);
+  cmd.AddValue ("flowmonBinary", "Stream the completed flows to a binary FlowMonitor file instead of writing XML", flowmonBinary);
+  cmd.AddValue ("rttSamples", "Record the RTT samples of the DCTCP, DSTCP and DcVegas sockets to a binary file", rttSamples);
+  cmd.AddValue ("virtualPayload", "Keep only the size of the TCP data in the socket buffers, not its content", virtualPayload);
+  cmd.AddValue ("sharedBuffer", "Size of the buffer shared by the ports of each switch, empty for a buffer per port", sharedBuffer);
+  cmd.AddValue ("bufferAlpha", "Alpha of the dynamic threshold of the shared buffers", bufferAlpha);
+  cmd.AddValue ("ecmpMode", "ECMP route selection: PerPacket, PerFlow or Flowlet", ecmpMode);
+  cmd.AddValue ("threads", "Number of threads running the simulation, one per leaf at most", threads);
+  cmd.AddValue ("distributed", "Run on the MPI processes, splitting the topology automatically", distributed);
+  cmd.AddValue ("fluidFlows", "Number of long-lived flows of tcpTypeId represented as a fluid on each leaf uplink", fluidFlows);
+  cmd.AddValue ("maxTrainLength", "Highest number of queued packets serialized as a train by the devices", maxTrainLength);
+  cmd.AddValue ("profile", "File for the folded stacks of the cost of the events, none if empty", profile);
   cmd.Parse (argc, argv);
 
+  // The partitions would share the recorder, which is not thread-safe
+  NS_ABORT_MSG_IF (rttSamples && threads > 1, "Choose either threads or rttSamples");
+#ifdef HAVE_PTHREAD_H
+  if (threads > 1)
+    {
+      MultithreadedSimulatorHelper::Enable ();
+    }
+#else
+  NS_ABORT_MSG_IF (threads > 1, "Multithreaded simulations need thread support");
+#endif
+#ifdef NS3_MPI
+  if (distributed)
+    {
+      NS_ABORT_MSG_IF (threads > 1, "Choose either threads or distributed");
+      MpiInterface::Enable (&argc, &argv);
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DistributedSimulatorImpl"));
+    }
+#else
+  NS_ABORT_MSG_IF (distributed, "Distributed simulations need MPI support");
+#endif
+
   NS_LOG_INFO ("tcpTypeId: " << tcpTypeId);
   NS_LOG_INFO ("load: " << load);
 
   Config::SetDefault ("ns3::TcpL4Protocol::SocketType", StringValue ("ns3::" + tcpTypeId));
+  Config::SetDefault ("ns3::Ipv4GlobalRouting::EcmpMode", StringValue (ecmpMode));
   if(tcpTypeId.compare("TcpDcVegas") == 0)
     {
       //TcpDcVegas doesn't use RED queue, INT_MAX makea the threshold useless
@@ -167,6 +204,7 @@ int main (int argc, char *argv[])
   GlobalValue::Bind ("ChecksumEnabled", BooleanValue (false));
   Config::SetDefault ("ns3::TcpSocketBase::MinRto", TimeValue (MilliSeconds (10)));
   Config::SetDefault ("ns3::TcpSocketBase::Sack", BooleanValue (false));
+  Config::SetDefault ("ns3::TcpSocketBase::VirtualPayload", BooleanValue (virtualPayload));
   Config::SetDefault ("ns3::TcpSocketBase::UseEcn", EnumValue (TcpSocketState::On));
   if(tcpTypeId.compare("TcpDstcp") == 0 || tcpTypeId.compare("TcpDcVegas") == 0)
     {
@@ -183,7 +221,10 @@ int main (int argc, char *argv[])
   Config::SetDefault ("ns3::RedQueueDisc::MeanPktSize", UintegerValue (1500));
   // Triumph and Scorpion switches used in DCTCP Paper have 4 MB of buffer
   // If every packet is 1500 bytes, 2666 packets can be stored in 4 MB
-  Config::SetDefault ("ns3::RedQueueDisc::MaxSize", QueueSizeValue (QueueSize (bufferSize)));
+  // With a shared buffer, a port may hold up to the whole buffer and the
+  // dynamic threshold of the switch limits its queue
+  Config::SetDefault ("ns3::RedQueueDisc::MaxSize",
+                      QueueSizeValue (QueueSize (sharedBuffer.empty () ? bufferSize : sharedBuffer)));
   // DCTCP tracks instantaneous queue length only; so set QW = 1
   Config::SetDefault ("ns3::RedQueueDisc::QW", DoubleValue (1));
   // Config::SetDefault ("ns3::RedQueueDisc::MinTh", DoubleValue (20));
@@ -208,6 +249,7 @@ int main (int argc, char *argv[])
   PointToPointHelper p2p;
   p2p.SetDeviceAttribute ("DataRate", StringValue ("10Gbps"));
   p2p.SetChannelAttribute ("Delay", StringValue ("10us"));
+  p2p.SetDeviceAttribute ("MaxTrainLength", UintegerValue (maxTrainLength));
 
   TrafficControlHelper tchRed10;
   tchRed10.SetRootQueueDisc ("ns3::RedQueueDisc",
@@ -246,6 +288,7 @@ int main (int argc, char *argv[])
       }
 
   NS_LOG_INFO ("Configuring switches");
+  NetDeviceContainer uplinks;
     for (int i = 0; i < LEAF_COUNT; i++)
       {
         for (int j = 0; j < SPINE_COUNT; j++)
@@ -258,6 +301,7 @@ int main (int argc, char *argv[])
         		NetDeviceContainer netDeviceContainer = p2p.Install (nodeContainer);
         		//NS_LOG_INFO ("Install RED Queue for leaf: " << i << " and spine: " << j);
         		tchRed10.Install (netDeviceContainer);
+        		uplinks.Add (netDeviceContainer.Get (0));
         		Ipv4InterfaceContainer ipv4InterfaceContainer = ipv4.Assign (netDeviceContainer);
         		//NS_LOG_INFO ("ipv4.Assign");
 //        		NS_LOG_INFO ("Leaf - " << i << " is connected to Spine - " << j << " with address "
@@ -268,30 +312,55 @@ int main (int argc, char *argv[])
           }
       }
 
+  NodeContainer switches (leaves, spines);
+  std::vector<Ptr<SharedBufferManager> > buffers;
+  if (!sharedBuffer.empty ())
+    {
+      NS_LOG_INFO ("Sharing the buffers of the switches");
+      for (uint32_t i = 0; i < switches.GetN (); i++)
+        {
+          Ptr<SharedBufferManager> buffer = CreateObjectWithAttributes<SharedBufferManager>
+              ("Size", QueueSizeValue (QueueSize (sharedBuffer)),
+               "Alpha", DoubleValue (bufferAlpha));
+          TrafficControlHelper::InstallSharedBuffer (switches.Get (i), buffer);
+          buffers.push_back (buffer);
+        }
+    }
+
+#ifdef NS3_MPI
+  if (distributed)
+    {
+      // Before the routing tables, which are only computed for the
+      // nodes of this process.
+      TopologyPartitionHelper partitioner;
+      partitioner.Install (NodeContainer::GetGlobal (), MpiInterface::GetSize ());
+      NS_LOG_INFO ("Split among " << MpiInterface::GetSize () << " processes: " << partitioner.GetCutSize ()
+                   << " channels cut, lookahead " << partitioner.GetLookahead ());
+    }
+#endif
+
   NS_LOG_INFO ("Populate global routing tables");
   Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
 
   double oversubRatio = static_cast<double>(SERVER_COUNT * 10000000000) / (10000000000 * SPINE_COUNT * LINK_COUNT);
   NS_LOG_INFO ("Over-subscription ratio: " << oversubRatio);
 
+  NS_LOG_INFO ("Initialize random seed: " << randomSeed);
+  RngSeedManager::SetSeed (randomSeed == 0 ? static_cast<uint32_t> (time (NULL)) : randomSeed);
+
   NS_LOG_INFO ("Initialize CDF table");
-  struct cdf_table* cdfTable = new cdf_table ();
-  init_cdf (cdfTable);
-  load_cdf (cdfTable, cdfFileName.c_str ());
+  Ptr<CdfFileRandomVariable> flowSizes = CreateObject<CdfFileRandomVariable> ();
+  flowSizes->SetAttribute ("File", StringValue (cdfFileName));
+  flowSizes->SetStream (0);
 
   NS_LOG_INFO ("Calculating request rate");
-  double requestRate = load * 10000000000 * SERVER_COUNT / oversubRatio / (8 * avg_cdf (cdfTable)) / SERVER_COUNT;
+  double requestRate = load * 10000000000 * SERVER_COUNT / oversubRatio / (8 * flowSizes->GetMean ()) / SERVER_COUNT;
   NS_LOG_INFO ("Average request rate: " << requestRate << " per second");
-
-  NS_LOG_INFO ("Initialize random seed: " << randomSeed);
-  if (randomSeed == 0)
-  {
-    srand ((unsigned)time (NULL));
-  }
-  else
-  {
-     srand (randomSeed);
-  }
+  Ptr<ExponentialRandomVariable> interArrival = CreateObject<ExponentialRandomVariable> ();
+  interArrival->SetAttribute ("Mean", DoubleValue (1 / requestRate));
+  interArrival->SetStream (1);
+  Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+  uniform->SetStream (2);
 
   NS_LOG_INFO ("Create applications");
 
@@ -300,7 +369,7 @@ int main (int argc, char *argv[])
 
   for (int fromLeafId = 0; fromLeafId < LEAF_COUNT; fromLeafId ++)
   {
-    install_applications(fromLeafId, servers, requestRate, cdfTable, flowCount, totalFlowSize, SERVER_COUNT, LEAF_COUNT, START_TIME, END_TIME, FLOW_LAUNCH_END_TIME);
+    install_applications(fromLeafId, servers, interArrival, flowSizes, uniform, flowCount, totalFlowSize, SERVER_COUNT, LEAF_COUNT, START_TIME, END_TIME, FLOW_LAUNCH_END_TIME);
   }
 
   NS_LOG_INFO ("Total flow: " << flowCount);
@@ -312,22 +381,122 @@ int main (int argc, char *argv[])
   flowMonitor = flowHelper.InstallAll();
   flowMonitor->CheckForLostPackets ();
   std::stringstream flowMonitorFilename;
-  flowMonitorFilename << tcpTypeId << "-leaf-spine-" << LEAF_COUNT << "X" << SPINE_COUNT << "-load-" << load<< "-seed-" << randomSeed << ".xml";
+  std::string rank = distributed ? "-rank-" + std::to_string (Simulator::GetSystemId ()) : "";
+  flowMonitorFilename << outputDir << "/" << tcpTypeId << "-leaf-spine-" << LEAF_COUNT << "X" << SPINE_COUNT << "-load-" << load<< "-seed-" << randomSeed << rank << (flowmonBinary ? ".bin" : ".xml");
+  Ptr<TcpRttRecorder> rttRecorder;
+  if (rttSamples)
+    {
+      std::string rttFileName = flowMonitorFilename.str ();
+      rttFileName = rttFileName.substr (0, rttFileName.rfind ('.')) + "-rtt.bin";
+      rttRecorder = CreateObject<TcpRttRecorder> ();
+      rttRecorder->Open (rttFileName);
+      Config::SetDefaultFailSafe ("ns3::" + tcpTypeId + "::RttRecorder", PointerValue (rttRecorder));
+    }
+
+#ifdef HAVE_PTHREAD_H
+  if (threads > 1)
+    {
+      // A leaf and its servers run in the same thread; the spines are
+      // dealt among the threads.
+      MultithreadedSimulatorHelper mt;
+      for (int i = 0; i < LEAF_COUNT; i++)
+        {
+          mt.SetPartition (leaves.Get (i), i % threads);
+          for (int j = 0; j < SERVER_COUNT; j++)
+            {
+              mt.SetPartition (servers.Get (i * SERVER_COUNT + j), i % threads);
+            }
+        }
+      for (int j = 0; j < SPINE_COUNT; j++)
+        {
+          mt.SetPartition (spines.Get (j), j % threads);
+        }
+      mt.Install (NodeContainer::GetGlobal (), threads);
+      NS_LOG_INFO ("Running on " << threads << " threads, lookahead " << mt.GetLookahead ());
+    }
+#endif
+
+  std::vector<Ptr<TcpFluidLoad> > fluidLoads;
+  if (fluidFlows > 0)
+    {
+      NS_LOG_INFO ("Adding " << fluidFlows << " fluid flows to each leaf uplink");
+      for (uint32_t i = 0; i < uplinks.GetN (); i++)
+        {
+          Ptr<NetDevice> device = uplinks.Get (i);
+          if (device->GetNode ()->GetSystemId () != Simulator::GetSystemId ())
+            {
+              continue;
+            }
+          // The flows cross the fabric, with the RTT of the DSTCP and DcVegas sockets
+          Ptr<TcpFluidLoad> fluid = CreateObjectWithAttributes<TcpFluidLoad>
+              ("Variant", StringValue (tcpTypeId),
+               "Flows", UintegerValue (fluidFlows),
+               "BaseRtt", TimeValue (MicroSeconds (85)),
+               "Tdcv", UintegerValue (16),
+               "MarkingThreshold", QueueSizeValue (QueueSize (QueueSizeUnit::PACKETS, static_cast<uint32_t> (K1))));
+          TrafficControlHelper::InstallFluidLoad (device, fluid);
+          fluidLoads.push_back (fluid);
+        }
+    }
 
   NS_LOG_INFO ("Start simulation");
   // AnimationInterface anim("single-rack.xml");
   Simulator::Schedule (progressInterval, &PrintProgress, progressInterval);
   Simulator::Stop (Seconds (END_TIME));
 
-//   tQueueLength.open (tcpTypeId + "-sigle-rack-t-length.dat", std::ios::out);
+//   tQueueLength.open (outputDir + "/" + tcpTypeId + "-sigle-rack-t-length.dat", std::ios::out);
 //   tQueueLength << "#Time(s) qlen(pkts) qlen(us)" << std::endl;
 //   Simulator::Schedule (Seconds (START_TIME), &CheckTQueueSize, queueDiscs.Get (1));
     
+  if (flowmonBinary)
+    {
+      flowMonitor->StartBinaryStream (flowMonitorFilename.str (), MilliSeconds (10), false);
+    }
+  if (profile != "")
+    {
+      EventProfiler::Enable ();
+    }
   Simulator::Run ();
+  if (profile != "")
+    {
+      EventProfiler::Disable ();
+      std::ofstream folded (profile.c_str ());
+      EventProfiler::WriteFolded (folded);
+      EventProfiler::WriteSummary (std::cout, 15);
+    }
   tQueueLength.close ();
-  flowMonitor->SerializeToXmlFile(flowMonitorFilename.str (), true, true);
+  if (flowmonBinary)
+    {
+      flowMonitor->StopBinaryStream ();
+    }
+  else
+    {
+      flowMonitor->SerializeToXmlFile(flowMonitorFilename.str (), true, true);
+    }
+  if (rttRecorder)
+    {
+      rttRecorder->Close ();
+    }
+  for (uint32_t i = 0; i < buffers.size (); i++)
+    {
+      const SharedBufferManager::Stats &stats = buffers[i]->GetStats ();
+      std::cout << "Switch " << switches.Get (i)->GetId () << " buffer: peak " << stats.maxOccupancy
+                << ", " << stats.nDroppedPackets << " packets refused" << std::endl;
+    }
+  for (uint32_t i = 0; i < fluidLoads.size (); i++)
+    {
+      FluidLoad::Stats stats = fluidLoads[i]->GetStats ();
+      std::cout << "Uplink " << i << " fluid: " << stats.nServedBytes << " bytes served, "
+                << stats.nDroppedBytes << " dropped, peak backlog " << stats.maxBacklog
+                << ", " << stats.nHolds << " packets held" << std::endl;
+    }
   Simulator::Destroy ();
-  free_cdf (cdfTable);
+#ifdef NS3_MPI
+  if (distributed)
+    {
+      MpiInterface::Disable ();
+    }
+#endif
   NS_LOG_INFO ("Stop simulation");
   return 0;
 }
\ No newline at end of file
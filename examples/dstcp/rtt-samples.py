@@ -0,0 +1,65 @@
+#! /usr/bin/env python3
+## -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+#
+# Reader of the RTT samples written by TcpRttRecorder, as enabled by the
+# --rttSamples option of the examples.  The format is described in
+# src/internet/model/tcp-rtt-recorder.h.
+#
+# Used as a program, it prints the samples carrying an RTT measurement as
+# "rtt minRtt" lines in microseconds, or every field with --all.
+#
+
+from __future__ import division, print_function
+import argparse
+import struct
+import sys
+
+MAGIC = b'NS3RTTSR'
+VERSION = 1
+FLAG_ECE = 0x1
+FLAG_WINDOW_END = 0x2
+
+_HEADER = struct.Struct('<8sHH')
+_RECORD = struct.Struct('<qIIqqddIIII')
+FIELDS = ('time_ns', 'flow_id', 'cwnd', 'rtt_ns', 'min_rtt_ns', 'alpha', 'beta',
+          'bytes_acked', 'ack_seq', 'next_tx_seq', 'flags')
+
+
+def read_samples(path):
+    '''Yield the samples of a file as tuples of FIELDS, in the order they were written.
+
+    The samples of a socket are in time order, but the samples of different
+    sockets are interleaved by blocks.
+    '''
+    with open(path, 'rb') as f:
+        header = f.read(_HEADER.size)
+        if len(header) < _HEADER.size:
+            raise ValueError('%s: not a file of RTT samples' % path)
+        magic, version, size = _HEADER.unpack(header)
+        if magic != MAGIC or size < _RECORD.size:
+            raise ValueError('%s: not a file of RTT samples' % path)
+        if version != VERSION:
+            raise ValueError('%s: unsupported version %d' % (path, version))
+        while True:
+            record = f.read(size)
+            if len(record) < size:
+                return
+            yield _RECORD.unpack_from(record)
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Print the RTT samples of a TcpRttRecorder file')
+    parser.add_argument('file')
+    parser.add_argument('--all', action='store_true', help='print every field of every sample')
+    args = parser.parse_args(argv[1:])
+    if args.all:
+        print(' '.join(FIELDS))
+    for sample in read_samples(args.file):
+        if args.all:
+            print(' '.join(str(value) for value in sample))
+        elif sample[3] != 0:
+            print('%d %d' % (sample[3] // 1000, sample[4] // 1000))
+
+
+if __name__ == '__main__':
+    main(sys.argv)
@@ -10,12 +10,6 @@
 #include "ns3/flow-monitor-module.h"
 #include "ns3/netanim-module.h"
 
-// The CDF in TrafficGenerator
-extern "C"
-{
-  #include "cdf.h"
-}
-
 #define PORT_START 10000
 #define PORT_END 50000
 
@@ -25,40 +19,21 @@ NS_LOG_COMPONENT_DEFINE ("SingleRack");
 
 std::ofstream tQueueLength;
 
-double poission_gen_interval(double avg_rate)
-{
-    if (avg_rate > 0)
-       return -logf(1.0 - (double)rand() / RAND_MAX) / avg_rate;
-    else
-       return 0;
-}
-
-template<typename T>
-T rand_range (T min, T max)
-{
-    return min + ((double)max - min) * rand () / RAND_MAX;
-}
-
-void install_applications (NodeContainer servers, double requestRate, struct cdf_table *cdfTable,
+void install_applications (NodeContainer servers, Ptr<RandomVariableStream> interArrival, Ptr<RandomVariableStream> flowSizes,
         long &flowCount, long &totalFlowSize, int SERVER_COUNT, double START_TIME, double END_TIME, double FLOW_LAUNCH_END_TIME)
 {
     NS_LOG_INFO ("Install applications:");
     for (int i = 0; i < SERVER_COUNT-1; i++)
     {
         int fromServerIndex =  i;
-        double startTime = START_TIME + poission_gen_interval (requestRate);
+        double startTime = START_TIME + interArrival->GetValue ();
           
         while (startTime < FLOW_LAUNCH_END_TIME)
         {
           flowCount ++;
-          // double port = rand_range (PORT_START, PORT_END);
           double port = PORT_START + flowCount;
 
           int destServerIndex = SERVER_COUNT-1;
-	        // while (destServerIndex == fromServerIndex)
-          //   {
-		      //   destServerIndex = rand_range (0, SERVER_COUNT);
-          //   }
 
           Ptr<Node> destServer = servers.Get (destServerIndex);
 	        Ptr<Ipv4> ipv4 = destServer->GetObject<Ipv4> ();
@@ -66,7 +41,7 @@ void install_applications (NodeContainer servers, double requestRate, struct cdf
 	        Ipv4Address destAddress = destInterface.GetLocal ();
 
           BulkSendHelper source ("ns3::TcpSocketFactory", InetSocketAddress (destAddress, port));
-          uint32_t flowSize = gen_random_cdf (cdfTable);
+          uint32_t flowSize = flowSizes->GetInteger ();
 
           totalFlowSize += flowSize;
 
@@ -90,7 +65,7 @@ void install_applications (NodeContainer servers, double requestRate, struct cdf
           //           << flowSize << " [start time: " << startTime <<"]");
           // */
 
-          startTime += poission_gen_interval (requestRate);
+          startTime += interArrival->GetValue ();
         }
     }
 }
@@ -133,6 +108,11 @@ int main (int argc, char *argv[])
   double START_TIME = 0.0;
   double END_TIME = 0.5;
   std::string cdfFileName = "DCTCP_CDF.txt";
+  std::string outputDir = ".";
+  bool flowmonBinary = false;
+  bool rttSamples = false;
+  bool virtualPayload = true;
+  bool stepMarking = false;
 
   double FLOW_LAUNCH_END_TIME = 0.2;
 
@@ -141,6 +121,12 @@ int main (int argc, char *argv[])
   cmd.AddValue ("enableSwitchEcn", "enable ECN at switches", enableSwitchEcn);
   cmd.AddValue ("randomSeed", "Random seed, 0 for random generated", randomSeed);
   cmd.AddValue ("load", "Load of the network, 0.0 - 1.0", load);
+  cmd.AddValue ("cdfFile", "File holding the flow size CDF", cdfFileName);
+  cmd.AddValue ("outputDir", "Directory for the FlowMonitor and queue length output", outputDir);
+  cmd.AddValue ("flowmonBinary", "Stream the completed flows to a binary FlowMonitor file instead of writing XML", flowmonBinary);
+  cmd.AddValue ("rttSamples", "Record the RTT samples of the DCTCP, DSTCP and DcVegas sockets to a binary file", rttSamples);
+  cmd.AddValue ("virtualPayload", "Keep only the size of the TCP data in the socket buffers, not its content", virtualPayload);
+  cmd.AddValue ("stepMarking", "Mark with StepMarkingQueueDisc instead of RedQueueDisc configured as a step", stepMarking);
   cmd.Parse (argc, argv);
 
   NS_LOG_INFO ("tcpTypeId: " << tcpTypeId);
@@ -170,6 +156,7 @@ int main (int argc, char *argv[])
   GlobalValue::Bind ("ChecksumEnabled", BooleanValue (false));
   Config::SetDefault ("ns3::TcpSocketBase::MinRto", TimeValue (MilliSeconds (10)));
   Config::SetDefault ("ns3::TcpSocketBase::Sack", BooleanValue (false));
+  Config::SetDefault ("ns3::TcpSocketBase::VirtualPayload", BooleanValue (virtualPayload));
   Config::SetDefault ("ns3::TcpSocketBase::UseEcn", EnumValue (TcpSocketState::On));
   //TcpDstcp and TcpDcVegas use Instantaneous RTT samples
   // Config::SetDefault ("ns3::RttMeanDeviation::Alpha", DoubleValue (1.0));
@@ -207,11 +194,21 @@ int main (int argc, char *argv[])
   stack.InstallAll ();
 
   TrafficControlHelper tchRed1;
-  tchRed1.SetRootQueueDisc ("ns3::RedQueueDisc",
-                            "LinkBandwidth", StringValue ("10Gbps"),
-                            "LinkDelay", StringValue ("10us"),
-                            "MinTh", DoubleValue (K1),
-                            "MaxTh", DoubleValue (K1));
+  if (stepMarking)
+    {
+      tchRed1.SetRootQueueDisc ("ns3::StepMarkingQueueDisc",
+                                "MaxSize", QueueSizeValue (QueueSize (bufferSize)),
+                                "MarkingThreshold", QueueSizeValue (QueueSize (QueueSizeUnit::PACKETS, K1)),
+                                "UseEcn", BooleanValue (enableSwitchEcn));
+    }
+  else
+    {
+      tchRed1.SetRootQueueDisc ("ns3::RedQueueDisc",
+                                "LinkBandwidth", StringValue ("10Gbps"),
+                                "LinkDelay", StringValue ("10us"),
+                                "MinTh", DoubleValue (K1),
+                                "MaxTh", DoubleValue (K1));
+    }
   for (std::size_t i = 0; i < SERVER_COUNT-1; i++)
     {
       tchRed1.Install (ST[i].Get (1));
@@ -235,31 +232,27 @@ int main (int argc, char *argv[])
   double oversubRatio = static_cast<double>(4);
   NS_LOG_INFO ("Over-subscription ratio: " << oversubRatio);
 
+  NS_LOG_INFO ("Initialize random seed: " << randomSeed);
+  RngSeedManager::SetSeed (randomSeed == 0 ? static_cast<uint32_t> (time (NULL)) : randomSeed);
+
   NS_LOG_INFO ("Initialize CDF table");
-  struct cdf_table* cdfTable = new cdf_table ();
-  init_cdf (cdfTable);
-  load_cdf (cdfTable, cdfFileName.c_str ());
+  Ptr<CdfFileRandomVariable> flowSizes = CreateObject<CdfFileRandomVariable> ();
+  flowSizes->SetAttribute ("File", StringValue (cdfFileName));
+  flowSizes->SetStream (0);
 
   NS_LOG_INFO ("Calculating request rate");
-  double requestRate = load * 10000000000 * (SERVER_COUNT-1) / oversubRatio / (8 * avg_cdf (cdfTable)) / (SERVER_COUNT-1);
+  double requestRate = load * 10000000000 * (SERVER_COUNT-1) / oversubRatio / (8 * flowSizes->GetMean ()) / (SERVER_COUNT-1);
   NS_LOG_INFO ("Average request rate: " << requestRate << " per second");
-
-  NS_LOG_INFO ("Initialize random seed: " << randomSeed);
-  if (randomSeed == 0)
-  {
-    srand ((unsigned)time (NULL));
-  }
-  else
-  {
-     srand (randomSeed);
-  }
+  Ptr<ExponentialRandomVariable> interArrival = CreateObject<ExponentialRandomVariable> ();
+  interArrival->SetAttribute ("Mean", DoubleValue (1 / requestRate));
+  interArrival->SetStream (1);
 
   NS_LOG_INFO ("Create applications");
 
   long flowCount = 0;
   long totalFlowSize = 0;
 
-  install_applications(S, requestRate, cdfTable, flowCount, totalFlowSize, SERVER_COUNT, START_TIME, END_TIME, FLOW_LAUNCH_END_TIME);
+  install_applications(S, interArrival, flowSizes, flowCount, totalFlowSize, SERVER_COUNT, START_TIME, END_TIME, FLOW_LAUNCH_END_TIME);
 
   NS_LOG_INFO ("Total flow: " << flowCount);
 
@@ -272,22 +265,45 @@ int main (int argc, char *argv[])
   flowMonitor = flowHelper.InstallAll();
   flowMonitor->CheckForLostPackets ();
   std::stringstream flowMonitorFilename;
-  flowMonitorFilename << tcpTypeId << "-single-rack-" << SERVER_COUNT-1 << "-load-" << load<< "-seed-" << randomSeed << ".xml";
+  flowMonitorFilename << outputDir << "/" << tcpTypeId << "-single-rack-" << SERVER_COUNT-1 << "-load-" << load<< "-seed-" << randomSeed << (flowmonBinary ? ".bin" : ".xml");
+  Ptr<TcpRttRecorder> rttRecorder;
+  if (rttSamples)
+    {
+      std::string rttFileName = flowMonitorFilename.str ();
+      rttFileName = rttFileName.substr (0, rttFileName.rfind ('.')) + "-rtt.bin";
+      rttRecorder = CreateObject<TcpRttRecorder> ();
+      rttRecorder->Open (rttFileName);
+      Config::SetDefaultFailSafe ("ns3::" + tcpTypeId + "::RttRecorder", PointerValue (rttRecorder));
+    }
 
   NS_LOG_INFO ("Start simulation");
   // AnimationInterface anim("single-rack.xml");
   Simulator::Schedule (progressInterval, &PrintProgress, progressInterval);
   Simulator::Stop (Seconds (END_TIME));
 
-  tQueueLength.open (tcpTypeId + "-sigle-rack-t-length.dat", std::ios::out);
+  tQueueLength.open (outputDir + "/" + tcpTypeId + "-sigle-rack-t-length.dat", std::ios::out);
   tQueueLength << "#Time(s) qlen(pkts) qlen(us)" << std::endl;
   Simulator::Schedule (Seconds (START_TIME), &CheckTQueueSize, queueDiscs.Get (1));
     
+  if (flowmonBinary)
+    {
+      flowMonitor->StartBinaryStream (flowMonitorFilename.str (), MilliSeconds (10), false);
+    }
   Simulator::Run ();
   // tQueueLength.close ();
-  flowMonitor->SerializeToXmlFile(flowMonitorFilename.str (), true, true);
+  if (flowmonBinary)
+    {
+      flowMonitor->StopBinaryStream ();
+    }
+  else
+    {
+      flowMonitor->SerializeToXmlFile(flowMonitorFilename.str (), true, true);
+    }
+  if (rttRecorder)
+    {
+      rttRecorder->Close ();
+    }
   Simulator::Destroy ();
-  free_cdf (cdfTable);
   NS_LOG_INFO ("Stop simulation");
   return 0;
 
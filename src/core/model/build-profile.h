@@ -24,7 +24,7 @@
 /**
  * \file
  * \ingroup debugging
- * NS_BUILD_DEBUG, NS_BUILD_RELEASE, and NS_BUILD_OPTIMIZED
+ * NS_BUILD_DEBUG, NS_BUILD_RELEASE, NS_BUILD_OPTIMIZED and NS_BUILD_ULTRA
  * macro definitions.
  */
 
@@ -84,6 +84,17 @@
 #define NS_BUILD_OPTIMIZED(code) NS_BUILD_PROFILE_NOOP (code)
 #endif
 
+#ifdef NS3_BUILD_PROFILE_ULTRA
+/**
+ * \ingroup debugging
+ * Execute a code snippet in ultra builds.
+ * \param [in] code The code to execute.
+ */
+#define NS_BUILD_ULTRA(code)     NS_BUILD_PROFILE_OP (code)
+#else
+#define NS_BUILD_ULTRA(code)     NS_BUILD_PROFILE_NOOP (code)
+#endif
+
 
 
 
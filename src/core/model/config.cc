@@ -26,6 +26,7 @@
 #include "pointer.h"
 #include "log.h"
 
+#include <limits>
 #include <sstream>
 
 /**
@@ -182,6 +183,10 @@ MatchContainer::DisconnectWithoutContext (std::string name, const CallbackBase &
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once into ranges of indices, so that
+ * testing the entries of a large array, such as the NodeList, does not
+ * parse it again for each entry.
  */
 class ArrayMatcher
 {
@@ -199,8 +204,21 @@ public:
    * \returns \c true if the index matches the Config Path.
    */
   bool Matches (std::size_t i) const;
+  /**
+   * Get the index matched by a specification of a single index.
+   *
+   * \param [out] i The index.
+   * \returns \c true if the specification matches a single index.
+   */
+  bool GetIndex (std::size_t *i) const;
 
 private:
+  /**
+   * Parse a Config path specification into ranges of indices.
+   *
+   * \param [in] element The Config path specification.
+   */
+  void Parse (std::string element);
   /**
    * Convert a string to an \c uint32_t.
    *
@@ -209,78 +227,84 @@ private:
    * \returns \c true if the string could be converted.
    */
   bool StringToUint32 (std::string str, uint32_t *value) const;
-  /** The Config path element. */
-  std::string m_element;
+  /** The ranges of indices matched, bounds included. */
+  std::vector<std::pair<std::size_t, std::size_t> > m_ranges;
 
 };  // class ArrayMatcher
 
 
 ArrayMatcher::ArrayMatcher (std::string element)
-  : m_element (element)
 {
   NS_LOG_FUNCTION (this << element);
+  Parse (element);
 }
-bool
-ArrayMatcher::Matches (std::size_t i) const
+void
+ArrayMatcher::Parse (std::string element)
 {
-  NS_LOG_FUNCTION (this << i);
-  if (m_element == "*")
+  NS_LOG_FUNCTION (this << element);
+  if (element == "*")
     {
-      NS_LOG_DEBUG ("Array " << i << " matches *");
-      return true;
+      m_ranges.push_back (std::make_pair (0, std::numeric_limits<std::size_t>::max ()));
+      return;
     }
   std::string::size_type tmp;
-  tmp = m_element.find ("|");
+  tmp = element.find ("|");
   if (tmp != std::string::npos)
     {
-      std::string left = m_element.substr (0, tmp - 0);
-      std::string right = m_element.substr (tmp + 1, m_element.size () - (tmp + 1));
-      ArrayMatcher matcher = ArrayMatcher (left);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << left);
-          return true;
-        }
-      matcher = ArrayMatcher (right);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array " << i << " matches " << right);
-          return true;
-        }
-      NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
-      return false;
+      std::string left = element.substr (0, tmp - 0);
+      std::string right = element.substr (tmp + 1, element.size () - (tmp + 1));
+      Parse (left);
+      Parse (right);
+      return;
     }
-  std::string::size_type leftBracket = m_element.find ("[");
-  std::string::size_type rightBracket = m_element.find ("]");
-  std::string::size_type dash = m_element.find ("-");
-  if (leftBracket == 0 && rightBracket == m_element.size () - 1
+  std::string::size_type leftBracket = element.find ("[");
+  std::string::size_type rightBracket = element.find ("]");
+  std::string::size_type dash = element.find ("-");
+  if (leftBracket == 0 && rightBracket == element.size () - 1
       && dash > leftBracket && dash < rightBracket)
     {
-      std::string lowerBound = m_element.substr (leftBracket + 1, dash - (leftBracket + 1));
-      std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
+      std::string lowerBound = element.substr (leftBracket + 1, dash - (leftBracket + 1));
+      std::string upperBound = element.substr (dash + 1, rightBracket - (dash + 1));
       uint32_t min;
       uint32_t max;
       if (StringToUint32 (lowerBound, &min)
           && StringToUint32 (upperBound, &max)
-          && i >= min && i <= max)
+          && min <= max)
         {
-          NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
-          return true;
+          m_ranges.push_back (std::make_pair (min, max));
         }
-      else
+      return;
+    }
+  uint32_t value;
+  if (StringToUint32 (element, &value))
+    {
+      m_ranges.push_back (std::make_pair (value, value));
+    }
+}
+bool
+ArrayMatcher::Matches (std::size_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  for (std::size_t j = 0; j < m_ranges.size (); j++)
+    {
+      if (i >= m_ranges[j].first && i <= m_ranges[j].second)
         {
-          NS_LOG_DEBUG ("Array " << i << " does not " << m_element);
-          return false;
+          NS_LOG_DEBUG ("Array " << i << " matches [" << m_ranges[j].first << "-" << m_ranges[j].second << "]");
+          return true;
         }
     }
-  uint32_t value;
-  if (StringToUint32 (m_element, &value)
-      && i == value)
+  NS_LOG_DEBUG ("Array " << i << " does not match");
+  return false;
+}
+bool
+ArrayMatcher::GetIndex (std::size_t *i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  if (m_ranges.size () == 1 && m_ranges[0].first == m_ranges[0].second)
     {
-      NS_LOG_DEBUG ("Array " << i << " matches " << m_element);
+      *i = m_ranges[0].first;
       return true;
     }
-  NS_LOG_DEBUG ("Array " << i << " does not match " << m_element);
   return false;
 }
 
@@ -297,6 +321,14 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
+ *
+ * The Config path is compiled once into a list of elements.  Each
+ * element keeps its ArrayMatcher, the TypeId of a \c $TypeId element,
+ * and the attributes it matches on each TypeId met on the path, so that
+ * resolving a path through many objects of the same type, such as all
+ * the nodes of the NodeList, looks up the names only once.  An element
+ * which selects a single index of an object container gets that object
+ * directly, instead of copying the whole container.
  */
 class Resolver
 {
@@ -320,23 +352,59 @@ public:
   void Resolve (Ptr<Object> root);
 
 private:
+  /** An attribute matched by an element of the Config path. */
+  struct AttributeMatch
+  {
+    std::string name;                                  //!< Name of the attribute.
+    Ptr<const AttributeAccessor> accessor;             //!< Accessor of the attribute.
+    Ptr<const ObjectPtrContainerAccessor> container;   //!< Accessor of an object container, or 0 for a pointer.
+  };
+  /** The attributes matched by an element on a TypeId. */
+  typedef std::pair<TypeId, std::vector<AttributeMatch> > AttributeMatches;
+  /** An element of the compiled Config path. */
+  struct Element
+  {
+    /**
+     * Constructor.
+     * \param [in] item The element of the Config path.
+     */
+    Element (std::string item);
+
+    std::string item;                         //!< The element of the Config path.
+    ArrayMatcher matcher;                     //!< The indices matched by the element.
+    bool hasTid;                              //!< Whether tid was looked up.
+    TypeId tid;                               //!< The TypeId of a \c $TypeId element.
+    std::vector<AttributeMatches> attributes; //!< The attributes matched on each TypeId.
+  };
+
   /** Ensure the Config path starts and ends with a '/'. */
   void Canonicalize (void);
+  /** Split the Config path into its elements. */
+  void Compile (void);
+  /**
+   * Get the attributes of a TypeId and of its parents matched by an element.
+   *
+   * \param [in,out] element The element of the Config path.
+   * \param [in] tid The TypeId.
+   * \returns The pointer and object container attributes matched.
+   */
+  const std::vector<AttributeMatch> & GetAttributes (Element &element, TypeId tid);
   /**
    * Parse the next element in the Config path.
    *
-   * \param [in] path The remaining portion of the Config path.
+   * \param [in] element The index of the next element of the Config path.
    * \param [in] root The object corresponding to the current position
    *                  in the Config path.
    */
-  void DoResolve (std::string path, Ptr<Object> root);
+  void DoResolve (std::size_t element, Ptr<Object> root);
   /**
    * Parse an index on the Config path.
    *
-   * \param [in] path The remaining Config path.
-   * \param [in,out] vector The resulting list of matching objects.
+   * \param [in] element The index of the element of the Config path.
+   * \param [in] root The object holding the container.
+   * \param [in] match The object container attribute.
    */
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
+  void DoArrayResolve (std::size_t element, Ptr<Object> root, const AttributeMatch &match);
   /**
    * Handle one object found on the path.
    *
@@ -361,14 +429,24 @@ private:
   std::vector<std::string> m_workStack;
   /** The Config path. */
   std::string m_path;
+  /** The elements of the Config path. */
+  std::vector<Element> m_elements;
 
 };  // class Resolver
 
+Resolver::Element::Element (std::string item)
+  : item (item),
+    matcher (item),
+    hasTid (false)
+{
+}
+
 Resolver::Resolver (std::string path)
   : m_path (path)
 {
   NS_LOG_FUNCTION (this << path);
   Canonicalize ();
+  Compile ();
 }
 Resolver::~Resolver ()
 {
@@ -394,12 +472,27 @@ Resolver::Canonicalize (void)
     }
 }
 
+void
+Resolver::Compile (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  std::string::size_type cur = 0;
+  std::string::size_type next = m_path.find ("/", 1);
+  while (next != std::string::npos)
+    {
+      m_elements.push_back (Element (m_path.substr (cur + 1, next - (cur + 1))));
+      cur = next;
+      next = m_path.find ("/", cur + 1);
+    }
+}
+
 void
 Resolver::Resolve (Ptr<Object> root)
 {
   NS_LOG_FUNCTION (this << root);
 
-  DoResolve (m_path, root);
+  DoResolve (0, root);
 }
 
 std::string
@@ -424,14 +517,65 @@ Resolver::DoResolveOne (Ptr<Object> object)
   DoOne (object, GetResolvedPath ());
 }
 
+const std::vector<Resolver::AttributeMatch> &
+Resolver::GetAttributes (Element &element, TypeId tid)
+{
+  NS_LOG_FUNCTION (this << element.item << tid);
+
+  for (std::vector<AttributeMatches>::const_iterator i = element.attributes.begin ();
+       i != element.attributes.end (); i++)
+    {
+      if (i->first == tid)
+        {
+          return i->second;
+        }
+    }
+
+  std::vector<AttributeMatch> matches;
+  TypeId instanceTid = tid;
+  TypeId nextTid = tid;
+  do
+    {
+      tid = nextTid;
+      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+        {
+          struct TypeId::AttributeInformation info;
+          info = tid.GetAttribute (i);
+          if (info.name != element.item && element.item != "*")
+            {
+              continue;
+            }
+          AttributeMatch match;
+          match.name = info.name;
+          match.accessor = info.accessor;
+          // attempt to cast to a pointer checker.
+          if (dynamic_cast<const PointerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              matches.push_back (match);
+            }
+          // attempt to cast to an object vector.
+          else if (dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              match.container = DynamicCast<const ObjectPtrContainerAccessor> (info.accessor);
+              matches.push_back (match);
+            }
+          // this could be anything else and we don't know what to do with it.
+          // So, we just ignore it.
+        }
+      nextTid = tid.GetParent ();
+    }
+  while (nextTid != tid);
+
+  element.attributes.push_back (std::make_pair (instanceTid, matches));
+  return element.attributes.back ().second;
+}
+
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
+Resolver::DoResolve (std::size_t element, Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
+  NS_LOG_FUNCTION (this << element << root);
 
-  if (next == std::string::npos)
+  if (element == m_elements.size ())
     {
       //
       // If root is zero, we're beginning to see if we can use the object name
@@ -447,8 +591,8 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
         }
       return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
+  Element &current = m_elements[element];
+  const std::string &item = current.item;
 
   //
   // If root is zero, we're beginning to see if we can use the object name
@@ -459,11 +603,10 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   //
   if (root == 0)
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
+      if (item.compare (0, 5, "Names") == 0)
         {
           m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
+          DoResolve (element + 1, root);
           m_workStack.pop_back ();
           return;
         }
@@ -480,7 +623,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (element + 1, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -500,78 +643,61 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   if (dollarPos == 0)
     {
       // This is a call to GetObject
-      std::string tidString = item.substr (1, item.size () - 1);
-      NS_LOG_DEBUG ("GetObject=" << tidString << " on path=" << GetResolvedPath ());
-      TypeId tid = TypeId::LookupByName (tidString);
-      Ptr<Object> object = root->GetObject<Object> (tid);
+      if (!current.hasTid)
+        {
+          std::string tidString = item.substr (1, item.size () - 1);
+          current.tid = TypeId::LookupByName (tidString);
+          current.hasTid = true;
+        }
+      NS_LOG_DEBUG ("GetObject=" << current.tid.GetName () << " on path=" << GetResolvedPath ());
+      Ptr<Object> object = root->GetObject<Object> (current.tid);
       if (object == 0)
         {
-          NS_LOG_DEBUG ("GetObject (" << tidString << ") failed on path=" << GetResolvedPath ());
+          NS_LOG_DEBUG ("GetObject (" << current.tid.GetName () << ") failed on path=" << GetResolvedPath ());
           return;
         }
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (element + 1, object);
       m_workStack.pop_back ();
     }
   else
     {
       // this is a normal attribute.
-      TypeId tid;
-      TypeId nextTid = root->GetInstanceTypeId ();
+      const std::vector<AttributeMatch> &matches = GetAttributes (current, root->GetInstanceTypeId ());
       bool foundMatch = false;
 
-      do
+      for (std::vector<AttributeMatch>::const_iterator i = matches.begin (); i != matches.end (); i++)
         {
-          tid = nextTid;
-
-          for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+          if (i->container == 0)
             {
-              struct TypeId::AttributeInformation info;
-              info = tid.GetAttribute (i);
-              if (info.name != item && item != "*")
+              NS_LOG_DEBUG ("GetAttribute(ptr)=" << i->name << " on path=" << GetResolvedPath ());
+              PointerValue pValue;
+              if (!i->accessor->Get (PeekPointer (root), pValue))
                 {
-                  continue;
-                }
-              // attempt to cast to a pointer checker.
-              const PointerChecker *pChecker = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker));
-              if (pChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(ptr)=" << info.name << " on path=" << GetResolvedPath ());
-                  PointerValue pValue;
-                  root->GetAttribute (info.name, pValue);
-                  Ptr<Object> object = pValue.Get<Object> ();
-                  if (object == 0)
-                    {
-                      NS_LOG_ERROR ("Requested object name=\"" << item <<
-                                    "\" exists on path=\"" << GetResolvedPath () << "\""
-                                    " but is null.");
-                      continue;
-                    }
-                  foundMatch = true;
-                  m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
-                  m_workStack.pop_back ();
+                  root->GetAttribute (i->name, pValue);
                 }
-              // attempt to cast to an object vector.
-              const ObjectPtrContainerChecker *vectorChecker =
-                dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
-              if (vectorChecker != 0)
+              Ptr<Object> object = pValue.Get<Object> ();
+              if (object == 0)
                 {
-                  NS_LOG_DEBUG ("GetAttribute(vector)=" << info.name << " on path=" << GetResolvedPath () << pathLeft);
-                  foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
-                  m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
-                  m_workStack.pop_back ();
+                  NS_LOG_ERROR ("Requested object name=\"" << item <<
+                                "\" exists on path=\"" << GetResolvedPath () << "\""
+                                " but is null.");
+                  continue;
                 }
-              // this could be anything else and we don't know what to do with it.
-              // So, we just ignore it.
+              foundMatch = true;
+              m_workStack.push_back (i->name);
+              DoResolve (element + 1, object);
+              m_workStack.pop_back ();
+            }
+          else
+            {
+              NS_LOG_DEBUG ("GetAttribute(vector)=" << i->name << " on path=" << GetResolvedPath ());
+              foundMatch = true;
+              m_workStack.push_back (i->name);
+              DoArrayResolve (element + 1, root, *i);
+              m_workStack.pop_back ();
             }
-
-          nextTid = tid.GetParent ();
         }
-      while (nextTid != tid);
 
       if (!foundMatch)
         {
@@ -582,20 +708,39 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+Resolver::DoArrayResolve (std::size_t element, Ptr<Object> root, const AttributeMatch &match)
 {
-  NS_LOG_FUNCTION (this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  NS_LOG_FUNCTION (this << element << root << match.name);
+  if (element == m_elements.size ())
     {
       return;
     }
-  std::string item = path.substr (1, next - 1);
-  std::string pathLeft = path.substr (next, path.size () - next);
+  const ArrayMatcher &matcher = m_elements[element].matcher;
+
+  // A single index is looked up without copying the container, which
+  // keeps the resolution of /NodeList/<i>/... independent of the
+  // number of nodes.
+  std::size_t i;
+  if (matcher.GetIndex (&i))
+    {
+      std::size_t index;
+      Ptr<Object> object = match.container->GetItem (PeekPointer (root), i, &index);
+      if (object != 0 && index == i)
+        {
+          std::ostringstream oss;
+          oss << index;
+          m_workStack.push_back (oss.str ());
+          DoResolve (element + 1, object);
+          m_workStack.pop_back ();
+          return;
+        }
+    }
 
-  ArrayMatcher matcher = ArrayMatcher (item);
+  ObjectPtrContainerValue container;
+  if (!match.accessor->Get (PeekPointer (root), container))
+    {
+      root->GetAttribute (match.name, container);
+    }
   ObjectPtrContainerValue::Iterator it;
   for (it = container.Begin (); it != container.End (); ++it)
     {
@@ -604,7 +749,7 @@ Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &conta
           std::ostringstream oss;
           oss << (*it).first;
           m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
+          DoResolve (element + 1, (*it).second);
           m_workStack.pop_back ();
         }
     }
@@ -21,6 +21,10 @@
 #include "event-impl.h"
 #include "log.h"
 
+#include <atomic>
+#include <cstring>
+#include <new>
+
 /**
  * \file
  * \ingroup events
@@ -31,6 +35,134 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+namespace {
+
+/** Event sizes are rounded up to a multiple of this, in bytes. */
+const std::size_t POOL_GRANULE = 16;
+/** Number of size classes; larger events use the heap directly. */
+const std::size_t POOL_CLASSES = 16;
+/** Maximum number of blocks kept on each free list. */
+const uint32_t POOL_MAX_FREE = 65536;
+
+/** A free block, linked into the free list of its size class. */
+struct FreeBlock
+{
+  FreeBlock *next;  /**< Next free block of the same size class. */
+};
+
+/**
+ * The free lists of one thread.
+ *
+ * This is trivially destructible, so that events released during the
+ * destruction of the thread (or of the program) can still consult it
+ * once the EventPoolReaper of the thread has run.
+ */
+struct EventPool
+{
+  FreeBlock *head[POOL_CLASSES];  /**< Free list of each size class. */
+  uint32_t length[POOL_CLASSES];  /**< Length of each free list. */
+  bool registered;                /**< The reaper of the thread exists. */
+  bool dead;                      /**< The reaper of the thread has run. */
+  EventImpl::PoolStats stats;     /**< Allocation counters. */
+};
+
+/** Releases the free lists of a thread when it terminates. */
+struct EventPoolReaper
+{
+  ~EventPoolReaper ();
+};
+
+/** Are the free lists in use. */
+std::atomic<bool> g_poolEnabled (true);
+/** The free lists of the current thread. */
+thread_local EventPool g_pool;
+/** Releases g_pool at thread exit. */
+thread_local EventPoolReaper g_poolReaper;
+
+EventPoolReaper::~EventPoolReaper ()
+{
+  for (std::size_t i = 0; i < POOL_CLASSES; ++i)
+    {
+      while (g_pool.head[i] != 0)
+        {
+          FreeBlock *block = g_pool.head[i];
+          g_pool.head[i] = block->next;
+          ::operator delete (block);
+        }
+      g_pool.length[i] = 0;
+    }
+  g_pool.dead = true;
+}
+
+} // unnamed namespace
+
+void *
+EventImpl::operator new (std::size_t size)
+{
+  EventPool &pool = g_pool;
+  ++pool.stats.allocations;
+  std::size_t index = (size - 1) / POOL_GRANULE;
+  if (index < POOL_CLASSES && pool.head[index] != 0
+      && g_poolEnabled.load (std::memory_order_relaxed))
+    {
+      FreeBlock *block = pool.head[index];
+      pool.head[index] = block->next;
+      --pool.length[index];
+      return block;
+    }
+  ++pool.stats.heapAllocations;
+  if (index < POOL_CLASSES)
+    {
+      // Allocate the whole size class so the block can be reused
+      // by any event of the same class.
+      size = (index + 1) * POOL_GRANULE;
+    }
+  return ::operator new (size);
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  if (p == 0)
+    {
+      return;
+    }
+  EventPool &pool = g_pool;
+  std::size_t index = (size - 1) / POOL_GRANULE;
+  if (index < POOL_CLASSES && !pool.dead
+      && pool.length[index] < POOL_MAX_FREE
+      && g_poolEnabled.load (std::memory_order_relaxed))
+    {
+      if (!pool.registered)
+        {
+          // Construct the reaper of this thread.
+          (void) &g_poolReaper;
+          pool.registered = true;
+        }
+      FreeBlock *block = static_cast<FreeBlock *> (p);
+      block->next = pool.head[index];
+      pool.head[index] = block;
+      ++pool.length[index];
+      return;
+    }
+  ++pool.stats.heapFrees;
+  ::operator delete (p);
+}
+
+void
+EventImpl::SetPoolEnabled (bool enabled)
+{
+  NS_LOG_FUNCTION (enabled);
+  g_poolEnabled.store (enabled, std::memory_order_relaxed);
+}
+
+EventImpl::PoolStats
+EventImpl::GetPoolStats (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return g_pool.stats;
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
@@ -66,4 +198,63 @@ EventImpl::IsCancelled (void)
   return m_cancel;
 }
 
+EventImpl::Target
+EventImpl::GetTarget (void) const
+{
+  Target target;
+  target.function = 0;
+  target.object = 0;
+  return target;
+}
+
+const void *
+EventImpl::GetMethodAddress (const void *method, std::size_t size, const void *object)
+{
+#if defined (__GNUC__) && !defined (_WIN32)
+  // An Itanium method pointer is a function address, or one plus the
+  // offset of the function in the vtable for a virtual method, and the
+  // adjustment of the object pointer.  ARM moves the virtual flag from
+  // the address to the adjustment.
+  struct MethodPointer
+  {
+    uintptr_t ptr;
+    ptrdiff_t adj;
+  } mp;
+  if (size != sizeof (mp) || object == 0)
+    {
+      return 0;
+    }
+  std::memcpy (&mp, method, sizeof (mp));
+#if defined (__arm__) || defined (__aarch64__)
+  bool isVirtual = mp.adj & 1;
+  ptrdiff_t adj = mp.adj >> 1;
+  uintptr_t offset = mp.ptr;
+#else
+  bool isVirtual = mp.ptr & 1;
+  ptrdiff_t adj = mp.adj;
+  uintptr_t offset = mp.ptr - 1;
+#endif
+  if (!isVirtual)
+    {
+      return reinterpret_cast<const void *> (mp.ptr);
+    }
+  const char *self = static_cast<const char *> (object) + adj;
+  const char *vtable = *reinterpret_cast<const char * const *> (self);
+  return *reinterpret_cast<const void * const *> (vtable + offset);
+#else
+  return 0;
+#endif
+}
+
+const void *
+EventImpl::GetFunctionAddress (const void *function, std::size_t size)
+{
+  const void *address = 0;
+  if (size == sizeof (address))
+    {
+      std::memcpy (&address, function, sizeof (address));
+    }
+  return address;
+}
+
 } // namespace ns3
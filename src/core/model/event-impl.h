@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
 
 /**
@@ -31,6 +32,8 @@
 
 namespace ns3 {
 
+class ObjectBase;
+
 /**
  * \ingroup events
  * \brief A simulation event.
@@ -40,6 +43,13 @@ namespace ns3 {
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * Events are allocated from per-thread free lists, one per size
+ * class, so that the steady state of a simulation recycles the
+ * memory of executed events instead of going through the heap
+ * allocator for every event.  Events larger than the largest size
+ * class, or allocated while pooling is disabled with SetPoolEnabled(),
+ * come directly from the heap.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -66,6 +76,83 @@ public:
    */
   bool IsCancelled (void);
 
+  /** The function run by an event, and the object of a method. */
+  struct Target
+  {
+    const void *function;      /**< Address of the function, 0 if unknown. */
+    const ObjectBase *object;  /**< Object of the method, 0 if none or not an ObjectBase. */
+  };
+
+  /**
+   * Get the function run by the event, for the EventProfiler.
+   *
+   * The events made by MakeEvent() know their function and object;
+   * the other events return an unknown target.
+   *
+   * \returns The target of the event.
+   */
+  virtual Target GetTarget (void) const;
+
+  /**
+   * Get the address of the function called through a method pointer.
+   *
+   * The virtual methods are resolved on the object.  This decodes the
+   * method pointers of the Itanium C++ ABI, and returns 0 elsewhere.
+   *
+   * \param [in] method The method pointer.
+   * \param [in] size The size of the method pointer, in bytes.
+   * \param [in] object The object the method is called on, as a pointer
+   *             to the class of the method.
+   * \returns The address of the function, 0 if unknown.
+   */
+  static const void * GetMethodAddress (const void *method, std::size_t size, const void *object);
+
+  /**
+   * Get the address of a function from a function pointer.
+   *
+   * \param [in] function The function pointer.
+   * \param [in] size The size of the function pointer, in bytes.
+   * \returns The address of the function, 0 if unknown.
+   */
+  static const void * GetFunctionAddress (const void *function, std::size_t size);
+
+  /** Event allocation counters of the calling thread. */
+  struct PoolStats
+  {
+    uint64_t allocations;     /**< Number of events allocated. */
+    uint64_t heapAllocations; /**< Allocations not served by a free list. */
+    uint64_t heapFrees;       /**< Releases not kept in a free list. */
+  };
+
+  /**
+   * Allocate the memory of an event.
+   *
+   * \param [in] size The size of the event, in bytes.
+   * \returns The allocated memory.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Release the memory of an event.
+   *
+   * \param [in] p The memory to release.
+   * \param [in] size The size of the event, in bytes.
+   */
+  static void operator delete (void *p, std::size_t size);
+
+  /**
+   * Enable or disable the event free lists, for all threads.
+   *
+   * Events can be released whatever the state of the pool when
+   * they were allocated.
+   *
+   * \param [in] enabled \c true to recycle the memory of events.
+   */
+  static void SetPoolEnabled (bool enabled);
+  /**
+   * \returns The event allocation counters of the calling thread.
+   */
+  static PoolStats GetPoolStats (void);
+
 protected:
   /**
    * Implementation for Invoke().
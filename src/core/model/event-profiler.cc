@@ -0,0 +1,481 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "event-profiler.h"
+#include "event-impl.h"
+#include "object-base.h"
+#include "log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <typeinfo>
+#include <unordered_map>
+
+#if defined (__x86_64__) || defined (__i386__)
+#include <x86intrin.h>
+#endif
+
+#if (defined (__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34))) || defined (__APPLE__)
+// dladdr is in the C library, without linking libdl
+#define NS3_EVENT_PROFILER_DLADDR 1
+#include <dlfcn.h>
+#endif
+
+#if (__GNUC__ >= 3)
+#include <cxxabi.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventProfiler");
+
+bool EventProfiler::m_enabled = false;
+
+namespace {
+
+/** Number of buckets of the histograms, one per power of two ticks. */
+const uint32_t HISTOGRAM_SIZE = 64;
+
+/** The context of the events without a node. */
+const uint32_t NO_CONTEXT = 0xffffffff;
+
+/**
+ * Read the cycle counter of the processor.
+ *
+ * \returns The cycle counter.
+ */
+inline uint64_t
+ReadCounter (void)
+{
+#if defined (__x86_64__) || defined (__i386__)
+  return __rdtsc ();
+#elif defined (__aarch64__)
+  uint64_t counter;
+  asm volatile ("mrs %0, cntvct_el0" : "=r" (counter));
+  return counter;
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds> (
+    std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+#endif
+}
+
+/**
+ * Get the floor of the base 2 logarithm of a number of ticks.
+ *
+ * \param [in] ticks The number of ticks.
+ * \returns The bucket of the histogram.
+ */
+inline uint32_t
+Log2 (uint64_t ticks)
+{
+  uint32_t bucket = 0;
+  while (ticks >>= 1)
+    {
+      bucket++;
+    }
+  return bucket;
+}
+
+/**
+ * Demangle a C++ name.
+ *
+ * \param [in] mangled The mangled name.
+ * \returns The demangled name, or \p mangled.
+ */
+std::string
+Demangle (const char *mangled)
+{
+  std::string name = mangled;
+#if (__GNUC__ >= 3)
+  int status;
+  char *demangled = abi::__cxa_demangle (mangled, 0, 0, &status);
+  if (status == 0)
+    {
+      name = demangled;
+    }
+  std::free (demangled);
+#endif
+  return name;
+}
+
+/** What identifies a kind of event. */
+struct KindKey
+{
+  const std::type_info *event;  //!< Class of the event.
+  const void *function;         //!< Function called by the event.
+  uint16_t tid;                 //!< TypeId of the object, 0 if none.
+
+  /**
+   * \param [in] o The other key.
+   * \returns \c true if the keys are equal.
+   */
+  bool operator == (const KindKey &o) const
+  {
+    return event == o.event && function == o.function && tid == o.tid;
+  }
+};
+
+/** Hash of a KindKey. */
+struct KindKeyHash
+{
+  /**
+   * \param [in] k The key.
+   * \returns The hash of the key.
+   */
+  std::size_t operator () (const KindKey &k) const
+  {
+    std::size_t h = reinterpret_cast<std::size_t> (k.event);
+    h = h * 31 + reinterpret_cast<std::size_t> (k.function);
+    return h * 31 + k.tid;
+  }
+};
+
+/** The cost of a kind of event. */
+struct Kind
+{
+  KindKey key;                        //!< The kind.
+  std::string object;                 //!< Name of the TypeId of the object.
+  uint64_t count;                     //!< Number of events.
+  uint64_t ticks;                     //!< Ticks spent in the events.
+  uint64_t histogram[HISTOGRAM_SIZE]; //!< Events by the log2 of their ticks.
+};
+
+/** The cost of some events. */
+struct Cost
+{
+  uint64_t count;  //!< Number of events.
+  uint64_t ticks;  //!< Ticks spent in the events.
+};
+
+/** The results of the profiler. */
+struct Profile
+{
+  std::unordered_map<KindKey, uint32_t, KindKeyHash> index;  //!< Index of each kind.
+  std::vector<Kind> kinds;                                   //!< Cost of each kind.
+  std::unordered_map<uint64_t, Cost> kindNodes;              //!< Cost by kind and context.
+  uint32_t period;                                           //!< Profile an event out of period.
+  uint32_t skip;                                             //!< Events to skip before the next sample.
+  uint64_t startTicks;                                       //!< Counter at the first Enable.
+  std::chrono::steady_clock::time_point startTime;           //!< Time of the first Enable.
+  bool started;                                              //!< Whether Enable was called.
+};
+
+/**
+ * Get the results of the profiler.
+ *
+ * \returns The results.
+ */
+Profile &
+GetProfile (void)
+{
+  static Profile profile = Profile ();
+  return profile;
+}
+
+/**
+ * Get the name of the function of a kind of event.
+ *
+ * \param [in] key The kind.
+ * \returns The name of the function, or of the class of the event.
+ */
+std::string
+GetFunctionName (const KindKey &key)
+{
+#ifdef NS3_EVENT_PROFILER_DLADDR
+  Dl_info info;
+  if (key.function != 0 && dladdr (key.function, &info) != 0 && info.dli_sname != 0)
+    {
+      return Demangle (info.dli_sname);
+    }
+#endif
+  return Demangle (key.event->name ());
+}
+
+/**
+ * Get the name of a context.
+ *
+ * \param [in] context The context.
+ * \returns The name of the node of the context.
+ */
+std::string
+GetNodeName (uint32_t context)
+{
+  if (context == NO_CONTEXT)
+    {
+      return "no node";
+    }
+  std::ostringstream oss;
+  oss << "node " << context;
+  return oss.str ();
+}
+
+/**
+ * Sort entries, most expensive first.
+ *
+ * \param [in] a An entry.
+ * \param [in] b Another entry.
+ * \returns \c true if \p a cost more than \p b.
+ */
+bool
+MoreTicks (const EventProfiler::Entry &a, const EventProfiler::Entry &b)
+{
+  return a.ticks > b.ticks || (a.ticks == b.ticks && a.name < b.name);
+}
+
+} // unnamed namespace
+
+void
+EventProfiler::Enable (uint32_t period)
+{
+  NS_LOG_FUNCTION (period);
+  Profile &profile = GetProfile ();
+  profile.period = std::max (period, 1u);
+  profile.skip = 0;
+  if (!profile.started)
+    {
+      profile.started = true;
+      profile.startTicks = ReadCounter ();
+      profile.startTime = std::chrono::steady_clock::now ();
+    }
+  m_enabled = true;
+}
+
+void
+EventProfiler::Disable (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_enabled = false;
+}
+
+void
+EventProfiler::Reset (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  Profile &profile = GetProfile ();
+  profile.index.clear ();
+  profile.kinds.clear ();
+  profile.kindNodes.clear ();
+  profile.started = false;
+  if (m_enabled)
+    {
+      Enable (profile.period);
+    }
+}
+
+void
+EventProfiler::Invoke (EventImpl *event, uint32_t context)
+{
+  Profile &profile = GetProfile ();
+  if (profile.skip != 0)
+    {
+      profile.skip--;
+      event->Invoke ();
+      return;
+    }
+  profile.skip = profile.period - 1;
+
+  // Identify the event before running it, as it may release its object
+  EventImpl::Target target = event->GetTarget ();
+  KindKey key;
+  key.event = &typeid (*event);
+  key.function = target.function;
+  key.tid = target.object != 0 ? target.object->GetInstanceTypeId ().GetUid () : 0;
+
+  std::pair<std::unordered_map<KindKey, uint32_t, KindKeyHash>::iterator, bool> inserted =
+    profile.index.insert (std::make_pair (key, static_cast<uint32_t> (profile.kinds.size ())));
+  if (inserted.second)
+    {
+      Kind kind = Kind ();
+      kind.key = key;
+      kind.object = target.object != 0 ? target.object->GetInstanceTypeId ().GetName () : "(no object)";
+      profile.kinds.push_back (kind);
+    }
+  uint32_t index = inserted.first->second;
+
+  uint64_t start = ReadCounter ();
+  event->Invoke ();
+  uint64_t ticks = ReadCounter () - start;
+
+  Kind &kind = profile.kinds[index];
+  kind.count++;
+  kind.ticks += ticks;
+  kind.histogram[Log2 (ticks)]++;
+  Cost &cost = profile.kindNodes[(static_cast<uint64_t> (index) << 32) | context];
+  cost.count++;
+  cost.ticks += ticks;
+}
+
+std::vector<EventProfiler::Entry>
+EventProfiler::GetKinds (void)
+{
+  const Profile &profile = GetProfile ();
+  std::vector<Entry> entries;
+  for (const Kind &kind : profile.kinds)
+    {
+      Entry entry;
+      entry.name = kind.object + ";" + GetFunctionName (kind.key);
+      entry.count = kind.count;
+      entry.ticks = kind.ticks;
+      entries.push_back (entry);
+    }
+  std::sort (entries.begin (), entries.end (), MoreTicks);
+  return entries;
+}
+
+std::vector<EventProfiler::Entry>
+EventProfiler::GetNodes (void)
+{
+  const Profile &profile = GetProfile ();
+  std::unordered_map<uint32_t, Cost> nodes;
+  for (const std::pair<const uint64_t, Cost> &kindNode : profile.kindNodes)
+    {
+      Cost &cost = nodes[static_cast<uint32_t> (kindNode.first)];
+      cost.count += kindNode.second.count;
+      cost.ticks += kindNode.second.ticks;
+    }
+  std::vector<Entry> entries;
+  for (const std::pair<const uint32_t, Cost> &node : nodes)
+    {
+      Entry entry;
+      entry.name = GetNodeName (node.first);
+      entry.count = node.second.count;
+      entry.ticks = node.second.ticks;
+      entries.push_back (entry);
+    }
+  std::sort (entries.begin (), entries.end (), MoreTicks);
+  return entries;
+}
+
+double
+EventProfiler::GetTickRate (void)
+{
+#if defined (__x86_64__) || defined (__i386__) || defined (__aarch64__)
+  Profile &profile = GetProfile ();
+  if (!profile.started)
+    {
+      profile.started = true;
+      profile.startTicks = ReadCounter ();
+      profile.startTime = std::chrono::steady_clock::now ();
+    }
+  // Calibrate the counter against the steady clock over at least 10 ms
+  std::chrono::duration<double> elapsed;
+  uint64_t ticks;
+  do
+    {
+      ticks = ReadCounter () - profile.startTicks;
+      elapsed = std::chrono::steady_clock::now () - profile.startTime;
+    }
+  while (elapsed.count () < 0.01);
+  return ticks / elapsed.count ();
+#else
+  return 1e9;
+#endif
+}
+
+void
+EventProfiler::WriteFolded (std::ostream &os)
+{
+  const Profile &profile = GetProfile ();
+  double nsPerTick = 1e9 / GetTickRate ();
+  std::vector<std::string> names;
+  for (const Kind &kind : profile.kinds)
+    {
+      names.push_back (kind.object + ";" + GetFunctionName (kind.key));
+    }
+  std::vector<std::string> lines;
+  for (const std::pair<const uint64_t, Cost> &kindNode : profile.kindNodes)
+    {
+      std::ostringstream oss;
+      oss << names[kindNode.first >> 32] << ";" << GetNodeName (static_cast<uint32_t> (kindNode.first))
+          << " " << static_cast<uint64_t> (kindNode.second.ticks * nsPerTick + 0.5);
+      lines.push_back (oss.str ());
+    }
+  std::sort (lines.begin (), lines.end ());
+  for (const std::string &line : lines)
+    {
+      os << line << std::endl;
+    }
+}
+
+void
+EventProfiler::WriteSummary (std::ostream &os, uint32_t top)
+{
+  const Profile &profile = GetProfile ();
+  double nsPerTick = 1e9 / GetTickRate ();
+  std::vector<Entry> kinds = GetKinds ();
+  std::vector<Entry> nodes = GetNodes ();
+  uint64_t count = 0;
+  uint64_t ticks = 0;
+  for (const Entry &kind : kinds)
+    {
+      count += kind.count;
+      ticks += kind.ticks;
+    }
+  os << "Profiled " << count << " events (1 in " << std::max (profile.period, 1u) << ") for "
+     << std::fixed << std::setprecision (3) << ticks * nsPerTick / 1e9 << " s" << std::endl;
+
+  for (uint32_t table = 0; table < 2; table++)
+    {
+      const std::vector<Entry> &entries = table == 0 ? kinds : nodes;
+      os << std::endl << (table == 0 ? "Kinds of event" : "Nodes") << std::endl
+         << std::setw (7) << "time%" << std::setw (12) << "events" << std::setw (12) << "ns/event"
+         << "  name" << std::endl;
+      for (uint32_t i = 0; i < entries.size () && i < top; i++)
+        {
+          const Entry &e = entries[i];
+          os << std::setw (7) << std::setprecision (2) << (ticks ? 100.0 * e.ticks / ticks : 0)
+             << std::setw (12) << e.count
+             << std::setw (12) << std::setprecision (0) << e.ticks * nsPerTick / e.count
+             << "  " << e.name << std::endl;
+        }
+    }
+
+  std::vector<const Kind *> sorted;
+  for (const Kind &kind : profile.kinds)
+    {
+      sorted.push_back (&kind);
+    }
+  std::sort (sorted.begin (), sorted.end (),
+             [] (const Kind *a, const Kind *b) { return a->ticks > b->ticks; });
+  os << std::endl << "Ticks per event, by powers of two" << std::endl;
+  for (uint32_t i = 0; i < sorted.size () && i < top; i++)
+    {
+      const Kind &kind = *sorted[i];
+      os << kind.object << ";" << GetFunctionName (kind.key) << std::endl << " ";
+      for (uint32_t bucket = 0; bucket < HISTOGRAM_SIZE; bucket++)
+        {
+          if (kind.histogram[bucket] != 0)
+            {
+              os << " 2^" << bucket << ":" << kind.histogram[bucket];
+            }
+        }
+      os << std::endl;
+    }
+  os.unsetf (std::ios_base::floatfield);
+  os << std::setprecision (6);
+}
+
+} // namespace ns3
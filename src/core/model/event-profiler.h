@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+#include <stdint.h>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ *
+ * \brief Attribute the wall clock time of the simulation to the
+ * kinds of events and to the nodes running them.
+ *
+ * When enabled, the DefaultSimulatorImpl runs each sampled event
+ * through EventProfiler::Invoke, which reads the cycle counter of the
+ * processor (\c rdtsc on x86, \c cntvct_el0 on AArch64, the steady
+ * clock elsewhere) around the event.  The cost is charged to the kind
+ * of the event, identified by the function it calls and the TypeId of
+ * the object of a method, and to the node of the event context.
+ * Unlike DesMetrics, which records when the events are scheduled, the
+ * profiler measures what the events cost.
+ *
+ * The cost of an event includes the events it schedules and the trace
+ * sinks it calls, but not the scheduler work to remove it from the
+ * event list.  Each kind keeps a histogram of the cost of its events in
+ * powers of two cycles, which tells a few slow events from many cheap
+ * ones.
+ *
+ * The results are written as a summary table, or as "folded" stacks
+ * of the form
+ * \verbatim
+   ns3::TcpSocketBase;ns3::TcpSocketBase::ReTxTimeout;node 3 1520340 \endverbatim
+ * with the time in nanoseconds, which \c flamegraph.pl and speedscope
+ * render as a flame graph.
+ *
+ * The profiler is off by default, and then costs a single test of a
+ * flag per event.  Only the events made by MakeEvent() know their
+ * function; the others are charged to the name of their class.  The
+ * function names are found with \c dladdr, which needs the symbols to
+ * be exported, as they are in the ns-3 shared libraries.  The profiler
+ * is not thread safe, and the other simulator implementations do not
+ * use it.
+ *
+ * \code
+   EventProfiler::Enable ();
+   Simulator::Run ();
+   std::ofstream os ("profile.folded");
+   EventProfiler::WriteFolded (os);
+   EventProfiler::WriteSummary (std::cout, 20); \endcode
+ */
+class EventProfiler
+{
+public:
+  /** The cost of the events of a kind, or of a node. */
+  struct Entry
+  {
+    std::string name;  //!< Name of the kind or of the node.
+    uint64_t count;    //!< Number of profiled events.
+    uint64_t ticks;    //!< Cycle counter ticks spent in the events.
+  };
+
+  /**
+   * Start profiling the events.
+   *
+   * \param [in] period Profile one event out of \p period, to lower
+   *             the overhead of long runs.
+   */
+  static void Enable (uint32_t period = 1);
+  /** Stop profiling the events, keeping the results. */
+  static void Disable (void);
+  /**
+   * \returns \c true if the events are profiled.
+   */
+  static bool IsEnabled (void)
+  {
+    return m_enabled;
+  }
+  /** Forget the results, outside of the events. */
+  static void Reset (void);
+
+  /**
+   * Invoke an event and charge its cost.
+   *
+   * \param [in] event The event.
+   * \param [in] context The context of the event.
+   */
+  static void Invoke (EventImpl *event, uint32_t context);
+
+  /**
+   * Get the cost of each kind of event, most expensive first.
+   *
+   * \returns The kinds of event.
+   */
+  static std::vector<Entry> GetKinds (void);
+  /**
+   * Get the cost of the events of each node, most expensive first.
+   *
+   * \returns The nodes.
+   */
+  static std::vector<Entry> GetNodes (void);
+  /**
+   * \returns The frequency of the cycle counter, in ticks per second.
+   */
+  static double GetTickRate (void);
+
+  /**
+   * Write the cost of each kind of event on each node, as folded stacks.
+   *
+   * \param [in] os The output stream.
+   */
+  static void WriteFolded (std::ostream &os);
+  /**
+   * Write the most expensive kinds of event and nodes, with the
+   * histograms of the cost of the kinds.
+   *
+   * \param [in] os The output stream.
+   * \param [in] top The number of kinds and nodes to write.
+   */
+  static void WriteSummary (std::ostream &os, uint32_t top = 20);
+
+private:
+  static bool m_enabled;  //!< Whether the events are profiled.
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
@@ -0,0 +1,334 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::LadderScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+namespace {
+
+/**
+ * \ingroup scheduler
+ * Largest bucket moved to Bottom as is; larger ones are spread over a
+ * new rung.  This is also the size above which Bottom is spread over a
+ * new rung.
+ */
+const uint32_t LADDER_THRESHOLD = 50;
+/** \ingroup scheduler Maximum number of rungs. */
+const uint32_t LADDER_MAX_RUNGS = 8;
+
+/**
+ * \ingroup scheduler
+ * Order the events of Bottom, earliest last.
+ * \param [in] a The first event.
+ * \param [in] b The second event.
+ * \returns \c true if \p a is later than \p b.
+ */
+bool
+LaterEvent (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  return a.key > b.key;
+}
+
+} // unnamed namespace
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderScheduler> ()
+  ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topStart (0),
+    m_topMin (0),
+    m_topMax (0),
+    m_rungs (LADDER_MAX_RUNGS),
+    m_nRungs (0),
+    m_qSize (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LadderScheduler::~LadderScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint64_t
+LadderScheduler::CurrentStart (const Rung &rung)
+{
+  return rung.m_start + rung.m_current * rung.m_width;
+}
+
+void
+LadderScheduler::InsertBottom (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.key.m_ts << ev.key.m_uid);
+  Bucket::iterator i = std::upper_bound (m_bottom.begin (), m_bottom.end (), ev, LaterEvent);
+  m_bottom.insert (i, ev);
+}
+
+void
+LadderScheduler::DoInsert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      if (m_top.empty ())
+        {
+          m_topMin = ts;
+          m_topMax = ts;
+        }
+      m_topMin = std::min (m_topMin, ts);
+      m_topMax = std::max (m_topMax, ts);
+      m_top.push_back (ev);
+      return;
+    }
+  for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+      Rung &rung = m_rungs[i];
+      if (ts >= CurrentStart (rung))
+        {
+          uint32_t bucket = (ts - rung.m_start) / rung.m_width;
+          NS_LOG_LOGIC ("insert in rung=" << i << ", bucket=" << bucket);
+          NS_ASSERT (bucket < rung.m_nBuckets);
+          rung.m_buckets[bucket].push_back (ev);
+          return;
+        }
+    }
+  InsertBottom (ev);
+  if (m_bottom.size () > LADDER_THRESHOLD
+      && m_nRungs < LADDER_MAX_RUNGS
+      && m_bottom.front ().key.m_ts != m_bottom.back ().key.m_ts)
+    {
+      // Bottom has grown too large to keep sorted: spread it over a new
+      // rung which ends where the lowest rung (or Top) starts.
+      uint64_t end = m_nRungs > 0 ? CurrentStart (m_rungs[m_nRungs - 1]) : m_topStart;
+      NS_LOG_LOGIC ("spread bottom of size " << m_bottom.size () << " over a new rung");
+      SpawnRung (m_bottom.back ().key.m_ts, end, m_bottom);
+      m_bottom.clear ();
+    }
+}
+
+void
+LadderScheduler::SpawnRung (uint64_t start, uint64_t end, const Bucket &events)
+{
+  NS_LOG_FUNCTION (this << start << end << events.size ());
+  NS_ASSERT (m_nRungs < LADDER_MAX_RUNGS);
+  NS_ASSERT (end > start);
+  NS_ASSERT (!events.empty ());
+
+  uint64_t span = end - start;
+  uint64_t width = (span + events.size () - 1) / events.size ();
+  width = std::max (width, (uint64_t)1);
+  uint32_t nBuckets = (span + width - 1) / width;
+
+  Rung &rung = m_rungs[m_nRungs];
+  rung.m_start = start;
+  rung.m_width = width;
+  rung.m_nBuckets = nBuckets;
+  rung.m_current = 0;
+  if (rung.m_buckets.size () < nBuckets)
+    {
+      rung.m_buckets.resize (nBuckets);
+    }
+  m_nRungs++;
+  NS_LOG_LOGIC ("rung=" << m_nRungs - 1 << ", buckets=" << nBuckets << ", width=" << width);
+
+  for (Bucket::const_iterator i = events.begin (); i != events.end (); ++i)
+    {
+      uint32_t bucket = (i->key.m_ts - start) / width;
+      NS_ASSERT (bucket < nBuckets);
+      rung.m_buckets[bucket].push_back (*i);
+    }
+}
+
+void
+LadderScheduler::SortBottom (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::sort (m_bottom.begin (), m_bottom.end (), LaterEvent);
+}
+
+void
+LadderScheduler::Refill (void)
+{
+  NS_LOG_FUNCTION (this);
+  while (m_bottom.empty ())
+    {
+      if (m_nRungs == 0)
+        {
+          if (m_top.empty ())
+            {
+              return;
+            }
+          if (m_topMin == m_topMax)
+            {
+              // Nothing to spread: Top goes straight to Bottom.
+              m_bottom.swap (m_top);
+              m_topStart = m_topMax + 1;
+              SortBottom ();
+            }
+          else
+            {
+              SpawnRung (m_topMin, m_topMax + 1, m_top);
+              m_top.clear ();
+              const Rung &rung = m_rungs[0];
+              m_topStart = rung.m_start + rung.m_nBuckets * rung.m_width;
+            }
+          continue;
+        }
+
+      Rung &rung = m_rungs[m_nRungs - 1];
+      while (rung.m_current < rung.m_nBuckets
+             && rung.m_buckets[rung.m_current].empty ())
+        {
+          rung.m_current++;
+        }
+      if (rung.m_current == rung.m_nBuckets)
+        {
+          m_nRungs--;
+          continue;
+        }
+      Bucket &bucket = rung.m_buckets[rung.m_current];
+      uint64_t start = CurrentStart (rung);
+      rung.m_current++;
+      if (bucket.size () <= LADDER_THRESHOLD
+          || rung.m_width == 1
+          || m_nRungs == LADDER_MAX_RUNGS)
+        {
+          m_bottom.swap (bucket);
+          SortBottom ();
+        }
+      else
+        {
+          SpawnRung (start, start + rung.m_width, bucket);
+          bucket.clear ();
+        }
+    }
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << &ev);
+  DoInsert (ev);
+  m_qSize++;
+  Refill ();
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_qSize == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  return m_bottom.back ();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  Scheduler::Event ev = m_bottom.back ();
+  m_bottom.pop_back ();
+  m_qSize--;
+  Refill ();
+  return ev;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << &ev);
+  NS_ASSERT (!IsEmpty ());
+  uint64_t ts = ev.key.m_ts;
+  Bucket *bucket = 0;
+  if (ts >= m_topStart)
+    {
+      bucket = &m_top;
+    }
+  else
+    {
+      for (uint32_t i = 0; i < m_nRungs; i++)
+        {
+          Rung &rung = m_rungs[i];
+          if (ts >= CurrentStart (rung))
+            {
+              bucket = &rung.m_buckets[(ts - rung.m_start) / rung.m_width];
+              break;
+            }
+        }
+    }
+
+  if (bucket != 0)
+    {
+      // Unsorted bucket: replace the event by the last one.
+      for (Bucket::iterator i = bucket->begin (); i != bucket->end (); ++i)
+        {
+          if (i->key.m_uid == ev.key.m_uid)
+            {
+              NS_ASSERT (ev.impl == i->impl);
+              *i = bucket->back ();
+              bucket->pop_back ();
+              m_qSize--;
+              return;
+            }
+        }
+    }
+  else
+    {
+      Bucket::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, LaterEvent);
+      if (i != m_bottom.end () && i->key.m_uid == ev.key.m_uid)
+        {
+          NS_ASSERT (ev.impl == i->impl);
+          m_bottom.erase (i);
+          m_qSize--;
+          Refill ();
+          return;
+        }
+    }
+  NS_ASSERT (false);
+}
+
+} // namespace ns3
@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderScheduler declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the ladder queue published in 2005 in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * The events are kept in three tiers:
+ *
+ *  - Top: an unsorted `std::vector` of the events scheduled after the
+ *    time span covered by the rungs.  Insertion is a `push_back`.
+ *  - Rungs: up to 8 calendars of unsorted buckets.  When the rungs are
+ *    exhausted, Top is spread over a new rung whose bucket width is the
+ *    span of Top divided by the number of events in it.  When the
+ *    earliest bucket of the lowest rung holds more than 50 events, it
+ *    is in turn spread over a new, finer, rung.  Unlike the
+ *    CalendarScheduler, the bucket width thus adapts to the local event
+ *    density, which suits bursts of events clustered within a few
+ *    microseconds, without ever resizing the whole queue.
+ *  - Bottom: the events of one bucket, sorted in a `std::vector`, from
+ *    which the events are dequeued.
+ *
+ * Every event is moved a bounded number of times before being sorted
+ * into Bottom, and is only ever sorted with the few events of its own
+ * bucket.  The buckets are `std::vector`s which keep their capacity when
+ * they are recycled for later rungs, so that, after warm up, insertion
+ * does not allocate memory and the events of a bucket are contiguous.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Append to Top or to a bucket
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Bottom kept non empty
+ * Remove()     | ~Constant       | Search within bucket
+ * RemoveNext() | ~Constant       | Spread Top and buckets over rungs
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 8 rungs of `std::vector`<br/>(~500 bytes) | Rung buckets
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderScheduler ();
+  /** Destructor. */
+  virtual ~LadderScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Ladder bucket type: an unsorted vector of Events. */
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  /** A rung of the ladder: a calendar of buckets of uniform width. */
+  struct Rung
+  {
+    /** Start of the first bucket, in dimensionless time units. */
+    uint64_t m_start;
+    /** Duration of a bucket, in dimensionless time units. */
+    uint64_t m_width;
+    /** Number of buckets in use. */
+    uint32_t m_nBuckets;
+    /** Index of the earliest bucket not yet dequeued. */
+    uint32_t m_current;
+    /** The buckets; may be larger than m_nBuckets. */
+    std::vector<Bucket> m_buckets;
+  };
+
+  /**
+   * Insert an event in to the correct tier, without refilling Bottom.
+   *
+   * \param [in] ev The new Event.
+   */
+  void DoInsert (const Scheduler::Event &ev);
+  /**
+   * Insert an event in to Bottom, keeping it sorted.
+   *
+   * \param [in] ev The new Event.
+   */
+  void InsertBottom (const Scheduler::Event &ev);
+  /**
+   * Get the start of the earliest bucket of a rung not yet dequeued.
+   *
+   * Events earlier than this belong to a lower rung or to Bottom.
+   *
+   * \param [in] rung The rung.
+   * \returns The start time of the current bucket.
+   */
+  static uint64_t CurrentStart (const Rung &rung);
+  /**
+   * Spread events over a new lowest rung.
+   *
+   * \param [in] start The start of the time span of the new rung.
+   * \param [in] end The end of the time span of the new rung.
+   * \param [in] events The events to spread, all within [start, end).
+   */
+  void SpawnRung (uint64_t start, uint64_t end, const Bucket &events);
+  /** Move the earliest events to Bottom, if it is empty. */
+  void Refill (void);
+  /** Sort Bottom, earliest event last. */
+  void SortBottom (void);
+
+  /** Events at or after m_topStart, unsorted. */
+  Bucket m_top;
+  /** Start of the time span of Top. */
+  uint64_t m_topStart;
+  /** Smallest time stamp in Top. */
+  uint64_t m_topMin;
+  /** Largest time stamp in Top. */
+  uint64_t m_topMax;
+  /** The rungs; m_rungs[0] is the coarsest one. */
+  std::vector<Rung> m_rungs;
+  /** Number of rungs in use. */
+  uint32_t m_nRungs;
+  /** The earliest events, sorted in decreasing order. */
+  Bucket m_bottom;
+  /** Number of events in queue. */
+  uint32_t m_qSize;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
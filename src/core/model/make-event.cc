@@ -51,6 +51,10 @@ EventImpl * MakeEvent (void (*f)(void))
     {
       (*m_function)();
     }
+    virtual Target GetTarget (void) const
+    {
+      return MakeEventTarget (m_function);
+    }
 
   private:
     F m_function;
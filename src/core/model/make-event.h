@@ -316,9 +316,130 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5,U6), T1 a1, T2 a2, T3 a3, T4 a4,
 
 #include "event-impl.h"
 #include "type-traits.h"
+#include <type_traits>
 
 namespace ns3 {
 
+/**
+ * \ingroup makeeventmemptr
+ * Get the ObjectBase of the object of a method event.
+ *
+ * \tparam T \deduced The class type, which derives from ObjectBase.
+ * \param [in] obj The object.
+ * \returns The object.
+ */
+template <typename T>
+const ObjectBase * MakeEventTargetObject (T *obj, std::true_type)
+{
+  return obj;
+}
+
+/**
+ * \ingroup makeeventmemptr
+ * Get the ObjectBase of the object of a method event.
+ *
+ * \tparam T \deduced The class type, which does not derive from ObjectBase.
+ * \param [in] obj The object.
+ * \returns 0.
+ */
+template <typename T>
+const ObjectBase * MakeEventTargetObject (T *obj, std::false_type)
+{
+  return 0;
+}
+
+/**
+ * \ingroup makeeventmemptr
+ * Get the target of an event calling a class method.
+ *
+ * \tparam C \deduced The class of the method.
+ * \tparam M \deduced The method pointer type.
+ * \tparam T \deduced The class type of the object.
+ * \param [in] method The method pointer.
+ * \param [in] obj The object.
+ * \returns The target of the event.
+ */
+template <typename C, typename M, typename T>
+EventImpl::Target MakeEventMethodTarget (M method, T *obj)
+{
+  EventImpl::Target target;
+  target.function = EventImpl::GetMethodAddress (&method, sizeof (method), static_cast<C *> (obj));
+  target.object = MakeEventTargetObject (obj, std::is_base_of<ObjectBase, T> ());
+  return target;
+}
+
+/**
+ * \ingroup makeeventmemptr
+ * Get the target of an event calling a class method.
+ *
+ * \tparam MEM \deduced The method pointer type.
+ * \tparam T \deduced The class type of the object.
+ * \param [in] method The method pointer.
+ * \param [in] obj The object.
+ * \returns The target of the event, with an unknown function.
+ */
+template <typename MEM, typename T>
+EventImpl::Target MakeEventTarget (MEM method, T *obj)
+{
+  EventImpl::Target target;
+  target.function = 0;
+  target.object = MakeEventTargetObject (obj, std::is_base_of<ObjectBase, T> ());
+  return target;
+}
+
+/**
+ * \ingroup makeeventmemptr
+ * Get the target of an event calling a class method.
+ *
+ * \tparam R \deduced The return type of the method.
+ * \tparam C \deduced The class of the method.
+ * \tparam Args \deduced The arguments of the method.
+ * \tparam T \deduced The class type of the object.
+ * \param [in] method The method pointer.
+ * \param [in] obj The object.
+ * \returns The target of the event.
+ */
+template <typename R, typename C, typename... Args, typename T>
+EventImpl::Target MakeEventTarget (R (C::*method)(Args...), T *obj)
+{
+  return MakeEventMethodTarget<C> (method, obj);
+}
+
+/**
+ * \ingroup makeeventmemptr
+ * Get the target of an event calling a const class method.
+ *
+ * \tparam R \deduced The return type of the method.
+ * \tparam C \deduced The class of the method.
+ * \tparam Args \deduced The arguments of the method.
+ * \tparam T \deduced The class type of the object.
+ * \param [in] method The method pointer.
+ * \param [in] obj The object.
+ * \returns The target of the event.
+ */
+template <typename R, typename C, typename... Args, typename T>
+EventImpl::Target MakeEventTarget (R (C::*method)(Args...) const, T *obj)
+{
+  return MakeEventMethodTarget<const C> (method, obj);
+}
+
+/**
+ * \ingroup makeeventfnptr
+ * Get the target of an event calling a function.
+ *
+ * \tparam F \deduced The function pointer type.
+ * \param [in] function The function pointer.
+ * \returns The target of the event.
+ */
+template <typename F>
+EventImpl::Target MakeEventTarget (F function)
+{
+  EventImpl::Target target;
+  target.function = EventImpl::GetFunctionAddress (&function, sizeof (function));
+  target.object = 0;
+  return target;
+}
+
 /**
  * \ingroup makeeventmemptr
  * Helper for the MakeEvent functions which take a class method.
@@ -374,6 +495,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)();
     }
+    virtual Target GetTarget (void) const
+    {
+      return MakeEventTarget (m_function, &EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
   } *ev = new EventMemberImpl0 (obj, mem_ptr);
@@ -404,6 +529,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1);
     }
+    virtual Target GetTarget (void) const
+    {
+      return MakeEventTarget (m_function, &EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -435,6 +564,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2);
     }
+    virtual Target GetTarget (void) const
+    {
+      return MakeEventTarget (m_function, &EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -468,6 +601,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual Target GetTarget (void) const
+    {
+      return MakeEventTarget (m_function, &EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -503,6 +640,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj, T1 a1, T2 a2, T3 a3, T4 a4)
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual Target GetTarget (void) const
+    {
+      return MakeEventTarget (m_function, &EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -541,6 +682,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual Target GetTarget (void) const
+    {
+      return MakeEventTarget (m_function, &EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -581,6 +726,10 @@ EventImpl * MakeEvent (MEM mem_ptr, OBJ obj,
     {
       (EventMemberImplObjTraits<OBJ>::GetReference (m_obj).*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
     }
+    virtual Target GetTarget (void) const
+    {
+      return MakeEventTarget (m_function, &EventMemberImplObjTraits<OBJ>::GetReference (m_obj));
+    }
     OBJ m_obj;
     MEM m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
@@ -616,6 +765,10 @@ EventImpl * MakeEvent (void (*f)(U1), T1 a1)
     {
       (*m_function)(m_a1);
     }
+    virtual Target GetTarget (void) const
+    {
+      return MakeEventTarget (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
   } *ev = new EventFunctionImpl1 (f, a1);
@@ -646,6 +799,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2), T1 a1, T2 a2)
     {
       (*m_function)(m_a1, m_a2);
     }
+    virtual Target GetTarget (void) const
+    {
+      return MakeEventTarget (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -679,6 +836,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3), T1 a1, T2 a2, T3 a3)
     {
       (*m_function)(m_a1, m_a2, m_a3);
     }
+    virtual Target GetTarget (void) const
+    {
+      return MakeEventTarget (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -714,6 +875,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4), T1 a1, T2 a2, T3 a3, T4 a4)
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4);
     }
+    virtual Target GetTarget (void) const
+    {
+      return MakeEventTarget (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -751,6 +916,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5), T1 a1, T2 a2, T3 a3, T4 a4, T5
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5);
     }
+    virtual Target GetTarget (void) const
+    {
+      return MakeEventTarget (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -790,6 +959,10 @@ EventImpl * MakeEvent (void (*f)(U1,U2,U3,U4,U5,U6), T1 a1, T2 a2, T3 a3, T4 a4,
     {
       (*m_function)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
     }
+    virtual Target GetTarget (void) const
+    {
+      return MakeEventTarget (m_function);
+    }
     F m_function;
     typename TypeTraits<T1>::ReferencedType m_a1;
     typename TypeTraits<T2>::ReferencedType m_a2;
@@ -0,0 +1,722 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+#include "simulator.h"
+#include "make-event.h"
+#include "scheduler.h"
+#include "event-impl.h"
+
+#include "ptr.h"
+#include "abort.h"
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3 {
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+namespace {
+
+/** Timestamp of an empty event list. */
+const uint64_t NO_EVENT = std::numeric_limits<uint64_t>::max ();
+/** Index of the partition of the events without a context. */
+const uint32_t GLOBAL_PARTITION = 0xffffffff;
+/** Number of polls of a busy wait before yielding the processor. */
+const uint32_t SPIN_LIMIT = 1000;
+
+/**
+ * Busy wait until a condition holds.
+ * \param [in] done The condition.
+ */
+template <typename CONDITION>
+void
+SpinUntil (CONDITION done)
+{
+  uint32_t spins = 0;
+  while (!done ())
+    {
+      if (++spins > SPIN_LIMIT)
+        {
+          std::this_thread::yield ();
+        }
+    }
+}
+
+} // unnamed namespace
+
+thread_local MultithreadedSimulatorImpl::Partition *MultithreadedSimulatorImpl::g_current = 0;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Core")
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("Lookahead",
+                   "The length of the synchronization windows of the partitions: "
+                   "no longer than the smallest delay between two partitions.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&MultithreadedSimulatorImpl::m_lookahead),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::Partition::Partition (uint32_t id)
+  : id (id),
+    inbox (0),
+    sent (0),
+    // uids are allocated from 4, as in DefaultSimulatorImpl.
+    uid (4),
+    currentUid (0),
+    currentTs (0),
+    currentContext (Simulator::NO_CONTEXT),
+    eventCount (0),
+    unscheduledEvents (0)
+{}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+  : m_global (new Partition (GLOBAL_PARTITION)),
+    m_nPartitions (1),
+    m_distributed (false),
+    m_nextWorker (1),
+    m_generation (0),
+    m_done (0),
+    m_exit (false),
+    m_inWindow (false),
+    m_windowEnd (0),
+    m_stop (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+  delete m_global;
+  for (uint32_t i = 0; i < m_partitions.size (); ++i)
+    {
+      delete m_partitions[i];
+    }
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<Partition *> all (m_partitions);
+  all.push_back (m_global);
+  for (uint32_t i = 0; i < all.size (); ++i)
+    {
+      Receive (all[i]);
+      if (all[i]->events == 0)
+        {
+          continue;
+        }
+      while (!all[i]->events->IsEmpty ())
+        {
+          Scheduler::Event next = all[i]->events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      all[i]->events = 0;
+    }
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  m_schedulerFactory = schedulerFactory;
+
+  std::vector<Partition *> all (m_partitions);
+  all.push_back (m_global);
+  for (uint32_t i = 0; i < all.size (); ++i)
+    {
+      Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+      if (all[i]->events != 0)
+        {
+          while (!all[i]->events->IsEmpty ())
+            {
+              scheduler->Insert (all[i]->events->RemoveNext ());
+            }
+        }
+      all[i]->events = scheduler;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetPartition (uint32_t context, uint32_t partition)
+{
+  NS_LOG_FUNCTION (this << context << partition);
+  NS_ABORT_MSG_IF (m_distributed, "MultithreadedSimulatorImpl::SetPartition(): "
+                   "the partitions can not be changed once the simulation has run");
+  NS_ABORT_MSG_IF (context == Simulator::NO_CONTEXT,
+                   "MultithreadedSimulatorImpl::SetPartition(): invalid context");
+  if (context >= m_contextPartition.size ())
+    {
+      m_contextPartition.resize (context + 1, 0);
+    }
+  m_contextPartition[context] = partition;
+  m_nPartitions = std::max (m_nPartitions, partition + 1);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition (uint32_t context) const
+{
+  if (context < m_contextPartition.size ())
+    {
+      return m_contextPartition[context];
+    }
+  return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNPartitions (void) const
+{
+  return m_nPartitions;
+}
+
+void
+MultithreadedSimulatorImpl::SetLookahead (const Time &lookahead)
+{
+  NS_LOG_FUNCTION (this << lookahead);
+  NS_ABORT_MSG_IF (lookahead.IsStrictlyNegative (),
+                   "MultithreadedSimulatorImpl::SetLookahead(): negative lookahead");
+  m_lookahead = lookahead;
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead (void) const
+{
+  return m_lookahead;
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::Current (void) const
+{
+  return g_current != 0 ? g_current : m_global;
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::Lookup (uint32_t context) const
+{
+  if (!m_distributed || context == Simulator::NO_CONTEXT)
+    {
+      return m_global;
+    }
+  return m_partitions[GetPartition (context)];
+}
+
+uint32_t
+MultithreadedSimulatorImpl::Insert (Partition *target, uint64_t ts, uint32_t context, EventImpl *event)
+{
+  Partition *self = Current ();
+  if (target == self || !m_inWindow)
+    {
+      Scheduler::Event ev;
+      ev.impl = event;
+      ev.key.m_ts = ts;
+      ev.key.m_context = context;
+      ev.key.m_uid = target->uid;
+      target->uid++;
+      target->unscheduledEvents++;
+      target->events->Insert (ev);
+      return ev.key.m_uid;
+    }
+
+  if (target == m_global)
+    {
+      // Run it once all the partitions are done with this window.
+      ts = std::max (ts, m_windowEnd);
+    }
+  NS_ABORT_MSG_IF (ts < m_windowEnd,
+                   "MultithreadedSimulatorImpl: event scheduled in partition " << target->id <<
+                   " by partition " << self->id << " at " << TimeStep (ts).As (Time::US) <<
+                   ", before the end of the window at " << TimeStep (m_windowEnd).As (Time::US) <<
+                   ": the Lookahead is longer than the delay between the partitions");
+
+  Message *message = new Message;
+  message->event.impl = event;
+  message->event.key.m_ts = ts;
+  message->event.key.m_context = context;
+  message->event.key.m_uid = 0;
+  message->source = self->id;
+  message->sequence = self->sent;
+  self->sent++;
+
+  message->next = target->inbox.load (std::memory_order_relaxed);
+  while (!target->inbox.compare_exchange_weak (message->next, message,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed))
+    {}
+  return 0;
+}
+
+void
+MultithreadedSimulatorImpl::Receive (Partition *partition)
+{
+  Message *message = partition->inbox.exchange (0, std::memory_order_acquire);
+  if (message == 0)
+    {
+      return;
+    }
+
+  // The queue is in no particular order: sort the messages before
+  // allocating their uids, so that the order of simultaneous events
+  // does not depend on the scheduling of the threads.
+  std::vector<Message *> messages;
+  for (; message != 0; message = message->next)
+    {
+      messages.push_back (message);
+    }
+  std::sort (messages.begin (), messages.end (),
+             [] (const Message *a, const Message *b)
+             {
+               if (a->event.key.m_ts != b->event.key.m_ts)
+                 {
+                   return a->event.key.m_ts < b->event.key.m_ts;
+                 }
+               if (a->source != b->source)
+                 {
+                   return a->source < b->source;
+                 }
+               return a->sequence < b->sequence;
+             });
+  for (uint32_t i = 0; i < messages.size (); ++i)
+    {
+      Scheduler::Event ev = messages[i]->event;
+      ev.key.m_uid = partition->uid;
+      partition->uid++;
+      partition->unscheduledEvents++;
+      partition->events->Insert (ev);
+      delete messages[i];
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Distribute (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t i = 0; i < m_nPartitions; ++i)
+    {
+      Partition *partition = new Partition (i);
+      partition->events = m_schedulerFactory.Create<Scheduler> ();
+      partition->uid = m_global->uid;
+      partition->currentTs = m_global->currentTs;
+      m_partitions.push_back (partition);
+    }
+  m_distributed = true;
+
+  std::vector<Scheduler::Event> global;
+  while (!m_global->events->IsEmpty ())
+    {
+      Scheduler::Event ev = m_global->events->RemoveNext ();
+      Partition *target = Lookup (ev.key.m_context);
+      if (target == m_global)
+        {
+          global.push_back (ev);
+          continue;
+        }
+      // Keep the uid, which may be held by an EventId.
+      m_global->unscheduledEvents--;
+      target->unscheduledEvents++;
+      target->events->Insert (ev);
+    }
+  for (uint32_t i = 0; i < global.size (); ++i)
+    {
+      m_global->events->Insert (global[i]);
+    }
+  NS_LOG_INFO ("Distributed the events over " << m_nPartitions << " partitions");
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent (Partition *partition)
+{
+  Scheduler::Event next = partition->events->RemoveNext ();
+
+  NS_ASSERT (next.key.m_ts >= partition->currentTs);
+  partition->unscheduledEvents--;
+  partition->eventCount++;
+
+  partition->currentTs = next.key.m_ts;
+  partition->currentContext = next.key.m_context;
+  partition->currentUid = next.key.m_uid;
+  next.impl->Invoke ();
+  next.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow (Partition *partition)
+{
+  g_current = partition;
+  while (!partition->events->IsEmpty ()
+         && partition->events->PeekNext ().key.m_ts < m_windowEnd
+         && !m_stop.load (std::memory_order_relaxed))
+    {
+      ProcessOneEvent (partition);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Worker (void)
+{
+  Partition *partition = m_partitions[m_nextWorker.fetch_add (1)];
+  uint64_t generation = 0;
+  while (true)
+    {
+      SpinUntil ([this, generation] ()
+                 {
+                   return m_generation.load (std::memory_order_acquire) != generation;
+                 });
+      generation++;
+      if (m_exit.load (std::memory_order_relaxed))
+        {
+          break;
+        }
+      ProcessWindow (partition);
+      m_done.fetch_add (1, std::memory_order_release);
+    }
+  g_current = 0;
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_distributed)
+    {
+      Distribute ();
+    }
+  m_stop = false;
+
+  uint32_t n = m_partitions.size ();
+  NS_ABORT_MSG_IF (n > 1 && !m_lookahead.IsStrictlyPositive (),
+                   "MultithreadedSimulatorImpl::Run(): the Lookahead must be positive "
+                   "to run several partitions");
+  uint64_t lookahead = m_lookahead.GetTimeStep ();
+
+  m_exit = false;
+  m_generation = 0;
+  m_nextWorker = 1;
+  for (uint32_t i = 1; i < n; ++i)
+    {
+      Ptr<SystemThread> thread =
+        Create<SystemThread> (MakeCallback (&MultithreadedSimulatorImpl::Worker, this));
+      thread->Start ();
+      m_threads.push_back (thread);
+    }
+
+  while (!m_stop)
+    {
+      g_current = m_global;
+      uint64_t next = NO_EVENT;
+      for (uint32_t i = 0; i < n; ++i)
+        {
+          Receive (m_partitions[i]);
+          if (!m_partitions[i]->events->IsEmpty ())
+            {
+              next = std::min (next, m_partitions[i]->events->PeekNext ().key.m_ts);
+            }
+        }
+      Receive (m_global);
+      uint64_t globalNext = NO_EVENT;
+      if (!m_global->events->IsEmpty ())
+        {
+          globalNext = m_global->events->PeekNext ().key.m_ts;
+        }
+      if (next == NO_EVENT && globalNext == NO_EVENT)
+        {
+          break;
+        }
+
+      if (globalNext <= next)
+        {
+          // All the partitions are stopped: run the events without a
+          // context on this thread.
+          while (!m_global->events->IsEmpty ()
+                 && m_global->events->PeekNext ().key.m_ts == globalNext
+                 && !m_stop)
+            {
+              ProcessOneEvent (m_global);
+            }
+          continue;
+        }
+
+      m_windowEnd = globalNext;
+      if (n > 1 && globalNext - next > lookahead)
+        {
+          m_windowEnd = next + lookahead;
+        }
+      m_inWindow = true;
+      m_done.store (0, std::memory_order_relaxed);
+      m_generation.fetch_add (1, std::memory_order_release);
+      ProcessWindow (m_partitions[0]);
+      SpinUntil ([this, n] ()
+                 {
+                   return m_done.load (std::memory_order_acquire) == n - 1;
+                 });
+      m_inWindow = false;
+    }
+  g_current = 0;
+
+  m_exit = true;
+  m_generation.fetch_add (1, std::memory_order_release);
+  for (uint32_t i = 0; i < m_threads.size (); ++i)
+    {
+      m_threads[i]->Join ();
+    }
+  m_threads.clear ();
+
+  // Simulator::Now is the time of the last event run.
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      m_global->currentTs = std::max (m_global->currentTs, m_partitions[i]->currentTs);
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  if (m_stop)
+    {
+      return true;
+    }
+  for (uint32_t i = 0; i < m_partitions.size (); ++i)
+    {
+      if (!m_partitions[i]->events->IsEmpty ())
+        {
+          return false;
+        }
+    }
+  return m_global->events->IsEmpty ();
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+  ScheduleWithContext (Simulator::NO_CONTEXT, delay,
+                       MakeEvent (static_cast<void (*)(void)> (&Simulator::Stop)));
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  NS_ASSERT_MSG (delay.IsPositive (), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+  Partition *self = Current ();
+  uint64_t ts = self->currentTs + delay.GetTimeStep ();
+  uint32_t uid = Insert (self, ts, self->currentContext, event);
+  return EventId (event, ts, self->currentContext, uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_ASSERT_MSG (delay.IsPositive (), "MultithreadedSimulatorImpl::ScheduleWithContext(): Negative delay");
+  uint64_t ts = Current ()->currentTs + delay.GetTimeStep ();
+  Insert (Lookup (context), ts, context, event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  Partition *self = Current ();
+  uint32_t uid = Insert (self, self->currentTs, self->currentContext, event);
+  return EventId (event, self->currentTs, self->currentContext, uid);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  EventId id (Ptr<EventImpl> (event, false), Current ()->currentTs, 0xffffffff, 2);
+  CriticalSection cs (m_destroyEventsMutex);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  // Do not add function logging here, to avoid stack overflow
+  return TimeStep (Current ()->currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - Current ()->currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      CriticalSection cs (m_destroyEventsMutex);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Partition *partition = Lookup (id.GetContext ());
+  NS_ASSERT_MSG (partition == Current () || !m_inWindow,
+                 "MultithreadedSimulatorImpl::Remove(): event of another partition");
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  partition->events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+
+  partition->unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      CriticalSection cs (m_destroyEventsMutex);
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  Partition *partition = Lookup (id.GetContext ());
+  if (id.PeekEventImpl () == 0
+      || id.GetTs () < partition->currentTs
+      || (id.GetTs () == partition->currentTs && id.GetUid () <= partition->currentUid)
+      || id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  return 0;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  return Current ()->currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount (void) const
+{
+  uint64_t count = m_global->eventCount;
+  for (uint32_t i = 0; i < m_partitions.size (); ++i)
+    {
+      count += m_partitions[i]->eventCount;
+    }
+  return count;
+}
+
+} // namespace ns3
@@ -0,0 +1,256 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "system-thread.h"
+#include "system-mutex.h"
+#include "nstime.h"
+#include "ptr.h"
+
+#include <atomic>
+#include <list>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * \brief A parallel simulator implementation running the partitions
+ * of a single simulation on the threads of one process.
+ *
+ * Every execution context (the node id, for the events of a node) is
+ * mapped to a partition with SetPartition().  Each partition has its
+ * own event list, and runs on its own thread.  The partitions are
+ * synchronized conservatively: they all run, in parallel, the events
+ * earlier than the end of a time window, starting at the earliest
+ * pending event and as long as the Lookahead, then wait for each other
+ * before the next window.  The Lookahead must thus be no longer than
+ * the smallest delay between an event of one partition and the event
+ * it schedules in another partition, typically the smallest delay of
+ * the channels linking two partitions.
+ *
+ * An event scheduled in another partition is pushed onto a lock-free
+ * queue of that partition, and inserted in its event list at the end of
+ * the window.  The events received during a window are inserted in a
+ * deterministic order, so that a simulation gives the same results
+ * whatever the interleaving of the threads.
+ *
+ * The events without a context, such as the ones scheduled with
+ * Simulator::Schedule before Simulator::Run, or by Simulator::Stop,
+ * are run on the main thread while all the partitions are stopped, and
+ * may thus access the state of any partition.  Such events scheduled
+ * from a partition are run at the end of the current window at the
+ * earliest.
+ *
+ * Until the first call to Run(), all events are kept in one event list;
+ * the partition of each context must be set before that call and can
+ * not be changed afterwards.  The contexts which were not given a
+ * partition belong to partition 0.
+ *
+ * The models run by the partitions must not share state: packets
+ * crossing partitions must for instance be copied rather than shared.
+ * MultithreadedSimulatorHelper, in the point-to-point module, assigns
+ * the partitions and configures the point-to-point channels accordingly.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  MultithreadedSimulatorImpl ();
+  /** Destructor. */
+  ~MultithreadedSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+  virtual uint64_t GetEventCount (void) const;
+
+  /**
+   * Assign an execution context to a partition.
+   *
+   * \param [in] context The context, usually a node id.
+   * \param [in] partition The partition of the context.
+   */
+  void SetPartition (uint32_t context, uint32_t partition);
+  /**
+   * \param [in] context An execution context.
+   * \returns The partition of the context.
+   */
+  uint32_t GetPartition (uint32_t context) const;
+  /**
+   * \returns The number of partitions, one more than the largest
+   * partition given to SetPartition().
+   */
+  uint32_t GetNPartitions (void) const;
+  /**
+   * \param [in] lookahead The length of the synchronization windows.
+   */
+  void SetLookahead (const Time &lookahead);
+  /**
+   * \returns The length of the synchronization windows.
+   */
+  Time GetLookahead (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** An event scheduled in a partition by another one. */
+  struct Message
+  {
+    Message *next;          /**< Next message of the queue. */
+    Scheduler::Event event; /**< The event; its uid is set on reception. */
+    uint32_t source;        /**< Partition which sent the message. */
+    uint64_t sequence;      /**< Rank of the message in its source. */
+  };
+
+  /** The state of one partition. */
+  struct Partition
+  {
+    /**
+     * Constructor.
+     * \param [in] id The partition index.
+     */
+    Partition (uint32_t id);
+
+    uint32_t id;                    /**< Partition index. */
+    Ptr<Scheduler> events;          /**< The event list. */
+    std::atomic<Message *> inbox;   /**< Events sent by other partitions. */
+    uint64_t sent;                  /**< Number of messages sent. */
+    uint32_t uid;                   /**< Next event unique id. */
+    uint32_t currentUid;            /**< Unique id of the current event. */
+    uint64_t currentTs;             /**< Timestamp of the current event. */
+    uint32_t currentContext;        /**< Context of the current event. */
+    uint64_t eventCount;            /**< The event count. */
+    int unscheduledEvents;          /**< Events inserted but not run. */
+  };
+
+  /** \returns The partition of the calling thread. */
+  Partition * Current (void) const;
+  /**
+   * \param [in] context An execution context.
+   * \returns The partition running the events of the context.
+   */
+  Partition * Lookup (uint32_t context) const;
+  /**
+   * Insert an event in the event list of its partition, or send it
+   * to that partition if it runs in another thread.
+   * \param [in] target The partition of the event.
+   * \param [in] ts The event timestamp.
+   * \param [in] context The event context.
+   * \param [in] event The event implementation.
+   * \returns The unique id of the event, or 0 if it was sent.
+   */
+  uint32_t Insert (Partition *target, uint64_t ts, uint32_t context, EventImpl *event);
+  /** Create the partitions and move every event into its partition. */
+  void Distribute (void);
+  /**
+   * Insert the events received by a partition in its event list.
+   * \param [in] partition The partition.
+   */
+  void Receive (Partition *partition);
+  /**
+   * Run the events of a partition up to the end of the current window.
+   * \param [in] partition The partition.
+   */
+  void ProcessWindow (Partition *partition);
+  /**
+   * Process the next event of a partition.
+   * \param [in] partition The partition.
+   */
+  void ProcessOneEvent (Partition *partition);
+  /** Entry point of the threads of partitions 1 and up. */
+  void Worker (void);
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Protect m_destroyEvents. */
+  mutable SystemMutex m_destroyEventsMutex;
+
+  /** The factory of the event lists. */
+  ObjectFactory m_schedulerFactory;
+  /** The events without a context, and all events before Distribute. */
+  Partition *m_global;
+  /** The partitions, once distributed. */
+  std::vector<Partition *> m_partitions;
+  /** The partition of each context. */
+  std::vector<uint32_t> m_contextPartition;
+  /** Number of partitions. */
+  uint32_t m_nPartitions;
+  /** Have the events been moved to their partitions. */
+  bool m_distributed;
+  /** The length of the synchronization windows. */
+  Time m_lookahead;
+
+  /** The threads of partitions 1 and up. */
+  std::vector<Ptr<SystemThread> > m_threads;
+  /** Index of the partition of the next worker thread to start. */
+  std::atomic<uint32_t> m_nextWorker;
+  /** Incremented to start a window, or to end the workers. */
+  std::atomic<uint64_t> m_generation;
+  /** Number of worker threads done with the current window. */
+  std::atomic<uint32_t> m_done;
+  /** Set to end the worker threads. */
+  std::atomic<bool> m_exit;
+  /** Are the partitions running a window. */
+  bool m_inWindow;
+  /** Timestamp of the end of the current window, excluded. */
+  uint64_t m_windowEnd;
+  /** Flag calling for the end of the simulation. */
+  std::atomic<bool> m_stop;
+
+  /** The partition run by the calling thread, if any. */
+  static thread_local Partition *g_current;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
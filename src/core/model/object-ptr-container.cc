@@ -127,6 +127,17 @@ ObjectPtrContainerAccessor::Get (const ObjectBase * object, AttributeValue &valu
     }
   return true;
 }
+Ptr<Object>
+ObjectPtrContainerAccessor::GetItem (const ObjectBase *object, std::size_t i, std::size_t *index) const
+{
+  NS_LOG_FUNCTION (this << object << i << index);
+  std::size_t n;
+  if (!DoGetN (object, &n) || i >= n)
+    {
+      return 0;
+    }
+  return DoGet (object, i, index);
+}
 bool
 ObjectPtrContainerAccessor::HasGetter (void) const
 {
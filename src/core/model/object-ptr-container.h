@@ -228,6 +228,16 @@ public:
   virtual bool Get (const ObjectBase * object, AttributeValue &value) const;
   virtual bool HasGetter (void) const;
   virtual bool HasSetter (void) const;
+  /**
+   * Get one instance of the container, without copying the others
+   * into an ObjectPtrContainerValue.
+   *
+   * \param [in] object The container object.
+   * \param [in] i The position of the instance in the container.
+   * \param [out] index The index of the instance.
+   * \returns The instance, or 0 if the container has no position \pname{i}.
+   */
+  Ptr<Object> GetItem (const ObjectBase *object, std::size_t i, std::size_t *index) const;
 
 private:
   /**
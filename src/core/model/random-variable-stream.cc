@@ -37,6 +37,10 @@
 #include <cmath>
 #include <iostream>
 #include <algorithm>    // upper_bound
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <mutex>
 
 /**
  * \file
@@ -1736,4 +1740,244 @@ EmpiricalRandomVariable::Validate (void)
   m_validated = true;
 }
 
+NS_OBJECT_ENSURE_REGISTERED (CdfFileRandomVariable);
+
+/** The bins of a CDF file and their alias table. */
+struct CdfFileRandomVariable::Table
+{
+  /** A bin between two lines of the file. */
+  struct Bin
+  {
+    double lower;     //!< The lower value of the bin
+    double upper;     //!< The upper value of the bin
+    double prob;      //!< The probability to keep this bin in its column
+    uint32_t alias;   //!< The bin drawn otherwise
+  };
+  std::vector<Bin> bins;      //!< The bins with a nonzero probability
+  double interpolatedMean;    //!< The mean in interpolating mode
+  double sampledMean;         //!< The mean in sampling mode
+};
+
+namespace {
+
+/**
+ * \ingroup randomvariable
+ * Read a CDF file and build the alias table of its bins.
+ * \param [in] file The name of the CDF file.
+ * \return The table of the file.
+ */
+std::shared_ptr<const CdfFileRandomVariable::Table>
+ReadCdfFile (const std::string &file)
+{
+  NS_LOG_FUNCTION (file);
+  std::ifstream in (file.c_str ());
+  if (!in.is_open ())
+    {
+      NS_FATAL_ERROR ("Cannot open the CDF file " << file);
+    }
+  std::vector<std::pair<double, double> > points;
+  std::string line;
+  while (std::getline (in, line))
+    {
+      std::istringstream iss (line);
+      double value;
+      double cdf;
+      if (!(iss >> value))
+        {
+          std::istringstream blank (line);
+          std::string word;
+          if (!(blank >> word) || word[0] == '#')
+            {
+              continue;
+            }
+          NS_FATAL_ERROR ("Malformed line \"" << line << "\" in the CDF file " << file);
+        }
+      if (!(iss >> cdf) || cdf < 0)
+        {
+          NS_FATAL_ERROR ("Malformed line \"" << line << "\" in the CDF file " << file);
+        }
+      if (!points.empty () && (value < points.back ().first || cdf < points.back ().second))
+        {
+          NS_FATAL_ERROR ("The CDF file " << file << " is not nondecreasing at \"" << line << "\"");
+        }
+      points.push_back (std::make_pair (value, cdf));
+    }
+  if (points.empty () || points.back ().second <= 0)
+    {
+      NS_FATAL_ERROR ("The CDF file " << file << " holds no distribution");
+    }
+
+  // The bins, the first one being the atom of the first line
+  std::shared_ptr<CdfFileRandomVariable::Table> table =
+    std::make_shared<CdfFileRandomVariable::Table> ();
+  std::vector<double> probs;
+  double total = points.back ().second;
+  table->interpolatedMean = 0;
+  table->sampledMean = 0;
+  for (std::size_t i = 0; i < points.size (); i++)
+    {
+      double lower = i ? points[i - 1].first : points[i].first;
+      double p = (points[i].second - (i ? points[i - 1].second : 0)) / total;
+      if (p <= 0)
+        {
+          continue;
+        }
+      CdfFileRandomVariable::Table::Bin bin;
+      bin.lower = lower;
+      bin.upper = points[i].first;
+      bin.prob = 1;
+      bin.alias = table->bins.size ();
+      table->bins.push_back (bin);
+      probs.push_back (p);
+      table->interpolatedMean += p * (bin.lower + bin.upper) / 2;
+      table->sampledMean += p * bin.upper;
+    }
+
+  // Vose's alias method: each column of height 1/n holds a part of its
+  // own bin and the rest of one larger bin
+  std::size_t n = probs.size ();
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  for (std::size_t i = 0; i < n; i++)
+    {
+      probs[i] *= n;
+      (probs[i] < 1 ? small : large).push_back (i);
+    }
+  while (!small.empty () && !large.empty ())
+    {
+      uint32_t s = small.back ();
+      uint32_t l = large.back ();
+      small.pop_back ();
+      large.pop_back ();
+      table->bins[s].prob = probs[s];
+      table->bins[s].alias = l;
+      probs[l] -= 1 - probs[s];
+      (probs[l] < 1 ? small : large).push_back (l);
+    }
+  // The rest are full columns, up to rounding errors
+  NS_LOG_LOGIC ("Read " << n << " bins from the CDF file " << file);
+  return table;
+}
+
+} // unnamed namespace
+
+TypeId
+CdfFileRandomVariable::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CdfFileRandomVariable")
+    .SetParent<RandomVariableStream>()
+    .SetGroupName ("Core")
+    .AddConstructor<CdfFileRandomVariable> ()
+    .AddAttribute ("File",
+                   "The CDF file, lines of a value and the probability "
+                   "to be less than or equal to it.",
+                   StringValue (""),
+                   MakeStringAccessor (&CdfFileRandomVariable::SetFile,
+                                       &CdfFileRandomVariable::GetFile),
+                   MakeStringChecker ())
+    .AddAttribute ("Interpolate",
+                   "Draw uniformly within the bins of the CDF, "
+                   "otherwise draw the values of the file.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&CdfFileRandomVariable::m_interpolate),
+                   MakeBooleanChecker ())
+  ;
+  return tid;
+}
+
+CdfFileRandomVariable::CdfFileRandomVariable (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+std::string
+CdfFileRandomVariable::GetFile (void) const
+{
+  return m_file;
+}
+
+void
+CdfFileRandomVariable::SetFile (std::string file)
+{
+  NS_LOG_FUNCTION (this << file);
+  if (file != m_file)
+    {
+      m_file = file;
+      m_table.reset ();
+    }
+}
+
+const CdfFileRandomVariable::Table &
+CdfFileRandomVariable::GetTable (void)
+{
+  if (!m_table)
+    {
+      NS_LOG_FUNCTION (this);
+      if (m_file.empty ())
+        {
+          NS_FATAL_ERROR ("The CDF file is not set");
+        }
+      // The tables stay cached while a variable uses them
+      static std::mutex mutex;
+      static std::map<std::string, std::weak_ptr<const Table> > tables;
+      std::lock_guard<std::mutex> lock (mutex);
+      m_table = tables[m_file].lock ();
+      if (!m_table)
+        {
+          m_table = ReadCdfFile (m_file);
+          tables[m_file] = m_table;
+        }
+    }
+  return *m_table;
+}
+
+double
+CdfFileRandomVariable::GetMean (void)
+{
+  NS_LOG_FUNCTION (this);
+  const Table &table = GetTable ();
+  return m_interpolate ? table.interpolatedMean : table.sampledMean;
+}
+
+double
+CdfFileRandomVariable::GetValue (void)
+{
+  NS_LOG_FUNCTION (this);
+  const Table &table = GetTable ();
+
+  // One uniform value picks both a column of the alias table and where
+  // in the column, hence the bin and where in the bin
+  double u = Peek ()->RandU01 ();
+  if (IsAntithetic ())
+    {
+      u = (1 - u);
+    }
+  double x = u * table.bins.size ();
+  std::size_t column = std::min (static_cast<std::size_t> (x), table.bins.size () - 1);
+  double f = x - column;
+  const Table::Bin *bin = &table.bins[column];
+  double w;
+  if (f < bin->prob)
+    {
+      w = f / bin->prob;
+    }
+  else
+    {
+      w = (f - bin->prob) / (1 - bin->prob);
+      bin = &table.bins[bin->alias];
+    }
+  if (!m_interpolate)
+    {
+      return bin->upper;
+    }
+  return bin->lower + std::min (w, 1.0) * (bin->upper - bin->lower);
+}
+
+uint32_t
+CdfFileRandomVariable::GetInteger (void)
+{
+  NS_LOG_FUNCTION (this);
+  return static_cast<uint32_t> (GetValue ());
+}
+
 } // namespace ns3
@@ -30,6 +30,8 @@
 #include "object.h"
 #include "attribute-helper.h"
 #include <stdint.h>
+#include <string>
+#include <memory>
 
 /**
  * \file
@@ -2635,6 +2637,120 @@ private:
 };  // class EmpiricalRandomVariable
 
 
+/**
+ * \ingroup randomvariable
+ * \brief The empirical distribution of a CDF file, shared by all
+ * the variables reading the same file.
+ *
+ * This class draws from the distribution of a CDF file, such as the
+ * flow sizes of a data center workload.  Each line of the file holds
+ * a value and the probability that the variable is less than or equal
+ * to it:
+ *
+ *     # flow size (bytes)   cdf
+ *     0                     0
+ *     10000                 0.15
+ *     ...
+ *     30000000              1
+ *
+ * Blank lines and lines starting with '#' are skipped.  Both columns
+ * must be nondecreasing.  The probabilities are normalized by the last
+ * one, so that a file in percents gives the same distribution.  As for
+ * EmpiricalRandomVariable, the first value carries the probability of
+ * the first line.
+ *
+ * The file is read once, on the first draw of any variable reading it,
+ * and its table is then shared by all these variables, so that each
+ * application of a workload of thousands of flows can have its own
+ * stream at the cost of a pointer.
+ *
+ * The draws take a constant time whatever the number of lines, through
+ * an alias table (Walker, Vose) of the bins between consecutive lines,
+ * and a single uniform value from the stream per draw.  The variable
+ * supports antithetic draws, but for the same stream the draws differ
+ * from those of an EmpiricalRandomVariable with the same CDF.
+ *
+ * In *interpolating* mode, the default, the value is uniform within its
+ * bin.  In *sampling* mode the upper value of the bin is returned, so
+ * that only the values of the file are drawn.
+ *
+ * Here is an example of how to use this class:
+ * \code
+ *   Ptr<CdfFileRandomVariable> x = CreateObject<CdfFileRandomVariable> ();
+ *   x->SetAttribute ("File", StringValue ("DCTCP_CDF.txt"));
+ *   x->SetStream (1);
+ *   double bytes = x->GetValue ();
+ *   double average = x->GetMean ();
+ * \endcode
+ */
+class CdfFileRandomVariable : public RandomVariableStream
+{
+public:
+  /**
+   * \brief Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /**
+   * \brief Creates a variable of an unset file, in interpolating mode.
+   */
+  CdfFileRandomVariable (void);
+
+  /**
+   * \brief Get the CDF file.
+   * \return The name of the CDF file.
+   */
+  std::string GetFile (void) const;
+
+  /**
+   * \brief Set the CDF file.
+   * \param [in] file The name of the CDF file.
+   */
+  void SetFile (std::string file);
+
+  /**
+   * \brief Get the mean of the distribution.
+   * \return The exact mean of the distribution in the current mode.
+   */
+  double GetMean (void);
+
+  /**
+   * \brief Returns the next value of the distribution.
+   * \return A floating point random value.
+   */
+  virtual double GetValue (void);
+
+  /**
+   * \brief Returns the next value of the distribution, truncated.
+   * \return An integer random value.
+   */
+  virtual uint32_t GetInteger (void);
+
+  /** The table of a CDF file, opaque to the users. */
+  struct Table;
+
+private:
+  /**
+   * \brief Get the table of the file, reading it on the first call
+   * for this file.
+   * \return The table.
+   */
+  const Table & GetTable (void);
+
+  /** The name of the CDF file. */
+  std::string m_file;
+  /** The table of the file, shared with the other variables. */
+  std::shared_ptr<const Table> m_table;
+  /**
+   * If \c true GetValue will interpolate,
+   * otherwise return the values of the file.
+   */
+  bool m_interpolate;
+
+};  // class CdfFileRandomVariable
+
+
 } // namespace ns3
 
 #endif /* RANDOM_VARIABLE_STREAM_H */
@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "trace-source-registry.h"
+#include "object-base.h"
+#include "fatal-error.h"
+
+/**
+ * \file
+ * \ingroup tracing
+ * ns3::MakePrunedTraceSourceAccessor implementation.
+ */
+
+namespace ns3 {
+
+namespace {
+
+/**
+ * \ingroup tracing
+ * The TraceSourceAccessor of the trace sources compiled out of the build.
+ */
+class PrunedTraceSourceAccessor : public TraceSourceAccessor
+{
+public:
+  virtual bool ConnectWithoutContext (ObjectBase *obj, const CallbackBase &cb) const
+  {
+    Fail (obj);
+    return false;
+  }
+  virtual bool Connect (ObjectBase *obj, std::string context, const CallbackBase &cb) const
+  {
+    Fail (obj);
+    return false;
+  }
+  virtual bool DisconnectWithoutContext (ObjectBase *obj, const CallbackBase &cb) const
+  {
+    return false;
+  }
+  virtual bool Disconnect (ObjectBase *obj, std::string context, const CallbackBase &cb) const
+  {
+    return false;
+  }
+
+private:
+  /**
+   * Report the connection to a trace source compiled out of the build.
+   * \param [in] obj The object holding the trace source.
+   */
+  void Fail (ObjectBase *obj) const
+  {
+    NS_FATAL_ERROR ("A trace source of " << obj->GetInstanceTypeId ().GetName ()
+                    << " was compiled out of this build: list it in the"
+                    << " --trace-sources option of waf configure");
+  }
+};
+
+} // unnamed namespace
+
+Ptr<const TraceSourceAccessor>
+MakePrunedTraceSourceAccessor (void)
+{
+  static Ptr<const TraceSourceAccessor> accessor = Create<PrunedTraceSourceAccessor> ();
+  return accessor;
+}
+
+} // namespace ns3
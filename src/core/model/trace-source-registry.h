@@ -0,0 +1,449 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef TRACE_SOURCE_REGISTRY_H
+#define TRACE_SOURCE_REGISTRY_H
+
+#include "traced-value.h"
+#include "traced-callback.h"
+#include "trace-source-accessor.h"
+#include <ostream>
+#include <type_traits>
+
+/**
+ * \file
+ * \ingroup tracing
+ * ns3::TraceSourceRegistry, ns3::OptionalTracedValue and
+ * ns3::OptionalTracedCallback declarations.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup tracing
+ * \brief The trace sources compiled in this build.
+ *
+ * A trace source declared with OptionalTracedValue or
+ * OptionalTracedCallback is registered here by its name, as
+ * \c TypeName::SourceName.  The registered sources are compiled unless
+ * the build selects the sources to keep, which the \c ultra build
+ * profile does:
+ * \verbatim
+   ./waf configure -d ultra --trace-sources=ns3::TcpSocketBase::CongestionWindow \endverbatim
+ * keeps the congestion window trace of the TCP sockets, and compiles
+ * the other registered sources to nothing: updating them costs no more
+ * than updating a plain variable.  The sources which are not
+ * registered are always compiled.
+ *
+ * A compiled out source is still listed by its TypeId, but connecting
+ * to it is a fatal error.
+ */
+namespace TraceSourceRegistry {
+
+/**
+ * \ingroup tracing
+ * Check whether an item of a list starts at \p list.
+ * \param [in] list The position in the comma-separated list.
+ * \param [in] name The name to find.
+ * \returns \c true if the item at \p list is \p name.
+ */
+constexpr bool
+IsItem (const char *list, const char *name)
+{
+  return *name == '\0'
+         ? (*list == ',' || *list == '\0')
+         : (*list == *name && IsItem (list + 1, name + 1));
+}
+
+/**
+ * \ingroup tracing
+ * Check whether an item of a list starts at \p list.
+ * \param [in] list The position in the comma-separated list.
+ * \param [in] type The name of the type of the trace source to find.
+ * \param [in] source The name of the trace source to find.
+ * \returns \c true if the item at \p list is \p type::source.
+ */
+constexpr bool
+IsItem (const char *list, const char *type, const char *source)
+{
+  return *type == '\0'
+         ? (list[0] == ':' && list[1] == ':' && IsItem (list + 2, source))
+         : (*list == *type && IsItem (list + 1, type + 1, source));
+}
+
+/**
+ * \ingroup tracing
+ * Skip to the next item of a list.
+ * \param [in] list The position in the comma-separated list.
+ * \returns The beginning of the next item, or the end of the list.
+ */
+constexpr const char *
+NextItem (const char *list)
+{
+  return *list == '\0'
+         ? list
+         : (*list == ',' ? list + 1 : NextItem (list + 1));
+}
+
+/**
+ * \ingroup tracing
+ * Find a name in a list.
+ * \param [in] list The comma-separated list.
+ * \param [in] name The name to find.
+ * \returns \c true if \p name is an item of \p list.
+ */
+constexpr bool
+Find (const char *list, const char *name)
+{
+  return *list != '\0'
+         && (IsItem (list, name) || Find (NextItem (list), name));
+}
+
+/**
+ * \ingroup tracing
+ * Find a trace source in a list.
+ * \param [in] list The comma-separated list.
+ * \param [in] type The name of the type of the trace source to find.
+ * \param [in] source The name of the trace source to find.
+ * \returns \c true if \p type::source is an item of \p list.
+ */
+constexpr bool
+Find (const char *list, const char *type, const char *source)
+{
+  return *list != '\0'
+         && (IsItem (list, type, source) || Find (NextItem (list), type, source));
+}
+
+/**
+ * \ingroup tracing
+ * Check at compile time whether a registered trace source is compiled.
+ * \param [in] name The name of the trace source, as \c TypeName::SourceName.
+ * \returns \c true if the trace source is compiled.
+ */
+constexpr bool
+IsCompiled (const char *name)
+{
+#ifdef NS3_TRACE_SOURCES
+  return Find (NS3_TRACE_SOURCES, name);
+#else
+  return true;
+#endif
+}
+
+/**
+ * \ingroup tracing
+ * Check at compile time whether a registered trace source is compiled.
+ * \param [in] type The name of the type of the trace source.
+ * \param [in] source The name of the trace source.
+ * \returns \c true if the trace source is compiled.
+ */
+constexpr bool
+IsCompiled (const char *type, const char *source)
+{
+#ifdef NS3_TRACE_SOURCES
+  return Find (NS3_TRACE_SOURCES, type, source);
+#else
+  return true;
+#endif
+}
+
+} // namespace TraceSourceRegistry
+
+
+/**
+ * \ingroup tracing
+ * \brief A TracedValue compiled out of the build.
+ *
+ * It holds a value of an arithmetic or enumeration type, with the
+ * assignment and conversion operators of TracedValue, and never calls
+ * anything.
+ *
+ * \tparam T \deduced The type of the value.
+ */
+template <typename T>
+class PrunedTracedValue
+{
+  static_assert (std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                 "Only the TracedValues of arithmetic and enumeration types can be compiled out");
+
+public:
+  /** Default constructor. */
+  PrunedTracedValue ()
+    : m_v ()
+  {}
+  /**
+   * Construct from an explicit variable.
+   * \param [in] v The variable to trace.
+   */
+  PrunedTracedValue (const T &v)
+    : m_v (v)
+  {}
+  /**
+   * Construct from another value of a compatible type.
+   * \tparam U \deduced The type of the other value.
+   * \param [in] other The other value.
+   */
+  template <typename U>
+  PrunedTracedValue (const PrunedTracedValue<U> &other)
+    : m_v ((T)other.Get ())
+  {}
+  /**
+   * Construct from a variable of a compatible type.
+   * \tparam U \deduced The type of the other variable.
+   * \param [in] other The other variable.
+   */
+  template <typename U>
+  PrunedTracedValue (const U &other)
+    : m_v ((T)other)
+  {}
+  /**
+   * Cast to the underlying type.
+   * \returns The underlying value.
+   */
+  operator T () const
+  {
+    return m_v;
+  }
+  /**
+   * Set the value.
+   * \param [in] v The new value.
+   */
+  void Set (const T &v)
+  {
+    m_v = v;
+  }
+  /**
+   * Get the value.
+   * \returns The value.
+   */
+  T Get (void) const
+  {
+    return m_v;
+  }
+
+  /**
+   * Pre/post- increment/decrement and assignment operators.
+   * \returns The value after, or before for the postfix operators.
+   * @{
+   */
+  PrunedTracedValue &operator++ ()
+  {
+    ++m_v;
+    return *this;
+  }
+  PrunedTracedValue &operator-- ()
+  {
+    --m_v;
+    return *this;
+  }
+  PrunedTracedValue operator++ (int)
+  {
+    PrunedTracedValue old (*this);
+    ++m_v;
+    return old;
+  }
+  PrunedTracedValue operator-- (int)
+  {
+    PrunedTracedValue old (*this);
+    --m_v;
+    return old;
+  }
+  template <typename U>
+  PrunedTracedValue &operator += (const U &rhs)
+  {
+    m_v += rhs;
+    return *this;
+  }
+  template <typename U>
+  PrunedTracedValue &operator -= (const U &rhs)
+  {
+    m_v -= rhs;
+    return *this;
+  }
+  template <typename U>
+  PrunedTracedValue &operator *= (const U &rhs)
+  {
+    m_v *= rhs;
+    return *this;
+  }
+  template <typename U>
+  PrunedTracedValue &operator /= (const U &rhs)
+  {
+    m_v /= rhs;
+    return *this;
+  }
+  template <typename U>
+  PrunedTracedValue &operator %= (const U &rhs)
+  {
+    m_v %= rhs;
+    return *this;
+  }
+  template <typename U>
+  PrunedTracedValue &operator <<= (const U &rhs)
+  {
+    m_v <<= rhs;
+    return *this;
+  }
+  template <typename U>
+  PrunedTracedValue &operator >>= (const U &rhs)
+  {
+    m_v >>= rhs;
+    return *this;
+  }
+  template <typename U>
+  PrunedTracedValue &operator &= (const U &rhs)
+  {
+    m_v &= rhs;
+    return *this;
+  }
+  template <typename U>
+  PrunedTracedValue &operator |= (const U &rhs)
+  {
+    m_v |= rhs;
+    return *this;
+  }
+  template <typename U>
+  PrunedTracedValue &operator ^= (const U &rhs)
+  {
+    m_v ^= rhs;
+    return *this;
+  }
+  /** @} */
+
+private:
+  T m_v;  //!< The underlying value.
+};
+
+/**
+ * Output streamer for PrunedTracedValue.
+ * \tparam T \deduced The underlying type.
+ * \param [in,out] os The output stream.
+ * \param [in] rhs The PrunedTracedValue to stream.
+ * \returns The stream.
+ */
+template <typename T>
+std::ostream& operator << (std::ostream& os, const PrunedTracedValue<T>& rhs)
+{
+  return os << rhs.Get ();
+}
+
+/**
+ * \ingroup tracing
+ * \brief A TracedCallback compiled out of the build.
+ *
+ * Invoking it does nothing, and does not even convert its arguments.
+ *
+ * \tparam Ts \explicit Types of the functor arguments.
+ */
+template <typename... Ts>
+class PrunedTracedCallback
+{
+public:
+  /**
+   * Do nothing.
+   * \tparam Us \deduced The types of the arguments.
+   */
+  template <typename... Us>
+  void operator() (Us&&...) const
+  {}
+};
+
+/**
+ * \ingroup tracing
+ * A TracedValue which is compiled out of the build unless \p COMPILED.
+ *
+ * \tparam COMPILED \explicit Whether the TracedValue is compiled,
+ *         usually TraceSourceRegistry::IsCompiled() of its name.
+ * \tparam T \explicit The type of the value.
+ */
+template <bool COMPILED, typename T>
+using OptionalTracedValue = typename std::conditional<COMPILED, TracedValue<T>, PrunedTracedValue<T> >::type;
+
+/**
+ * \ingroup tracing
+ * A TracedCallback which is compiled out of the build unless \p COMPILED.
+ *
+ * \tparam COMPILED \explicit Whether the TracedCallback is compiled,
+ *         usually TraceSourceRegistry::IsCompiled() of its name.
+ * \tparam Ts \explicit Types of the functor arguments.
+ */
+template <bool COMPILED, typename... Ts>
+using OptionalTracedCallback = typename std::conditional<COMPILED, TracedCallback<Ts...>, PrunedTracedCallback<Ts...> >::type;
+
+/**
+ * \ingroup tracing
+ * Check whether a trace source was compiled out of the build.
+ * \tparam T \deduced The type of the trace source.
+ * \returns \c true if the trace source was compiled out.
+ * @{
+ */
+template <typename T>
+bool IsPruned (const T &)
+{
+  return false;
+}
+template <typename T>
+bool IsPruned (const PrunedTracedValue<T> &)
+{
+  return true;
+}
+template <typename... Ts>
+bool IsPruned (const PrunedTracedCallback<Ts...> &)
+{
+  return true;
+}
+/** @} */
+
+/**
+ * \ingroup tracing
+ * Create the TraceSourceAccessor of the trace sources compiled out of
+ * the build, which fails to connect them.
+ * \returns The TraceSourceAccessor.
+ */
+Ptr<const TraceSourceAccessor> MakePrunedTraceSourceAccessor (void);
+
+/**
+ * \ingroup tracing
+ * Create a TraceSourceAccessor for a trace source compiled out of the build.
+ * \tparam T \deduced The class holding the trace source.
+ * \tparam U \deduced The type of the value.
+ * \returns The TraceSourceAccessor.
+ */
+template <typename T, typename U>
+Ptr<const TraceSourceAccessor>
+MakeTraceSourceAccessor (PrunedTracedValue<U> T::*)
+{
+  return MakePrunedTraceSourceAccessor ();
+}
+
+/**
+ * \ingroup tracing
+ * Create a TraceSourceAccessor for a trace source compiled out of the build.
+ * \tparam T \deduced The class holding the trace source.
+ * \tparam Ts \deduced The types of the arguments.
+ * \returns The TraceSourceAccessor.
+ */
+template <typename T, typename... Ts>
+Ptr<const TraceSourceAccessor>
+MakeTraceSourceAccessor (PrunedTracedCallback<Ts...> T::*)
+{
+  return MakePrunedTraceSourceAccessor ();
+}
+
+} // namespace ns3
+
+#endif /* TRACE_SOURCE_REGISTRY_H */
@@ -0,0 +1,190 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/random-variable-stream.h"
+#include <fstream>
+#include <map>
+
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup randomvariable
+ * \ingroup randomvariable-tests
+ * Test for the CDF file random variable.
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup randomvariable-tests
+ * Test case for the CDF file random variable
+ */
+class CdfFileRandomVariableTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  CdfFileRandomVariableTestCase ();
+  /** Destructor. */
+  virtual ~CdfFileRandomVariableTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Create a variable of a CDF file
+   * \param file the CDF file
+   * \param interpolate whether to interpolate
+   * \param stream the stream of the variable
+   * \returns the variable
+   */
+  Ptr<CdfFileRandomVariable> Create (std::string file, bool interpolate, int64_t stream);
+};
+
+CdfFileRandomVariableTestCase::CdfFileRandomVariableTestCase ()
+  : TestCase ("CDF file random variable")
+{}
+
+CdfFileRandomVariableTestCase::~CdfFileRandomVariableTestCase ()
+{}
+
+Ptr<CdfFileRandomVariable>
+CdfFileRandomVariableTestCase::Create (std::string file, bool interpolate, int64_t stream)
+{
+  Ptr<CdfFileRandomVariable> x = CreateObject<CdfFileRandomVariable> ();
+  x->SetAttribute ("File", StringValue (file));
+  x->SetAttribute ("Interpolate", BooleanValue (interpolate));
+  x->SetStream (stream);
+  return x;
+}
+
+void
+CdfFileRandomVariableTestCase::DoRun (void)
+{
+  std::string fractions = CreateTempDirFilename ("fractions.txt");
+  std::ofstream out (fractions.c_str ());
+  out << "# value cdf\n0 0\n10 0.25\n\n20 1\n";
+  out.close ();
+  std::string percents = CreateTempDirFilename ("percents.txt");
+  out.open (percents.c_str ());
+  out << "0 0\n10 25\n20 100\n";
+  out.close ();
+
+  const int count = 100000;
+
+  // Interpolating, the values are uniform within the bins
+  Ptr<CdfFileRandomVariable> x = Create (fractions, true, 1);
+  NS_TEST_ASSERT_MSG_EQ_TOL (x->GetMean (), 12.5, 1e-9, "Wrong mean of the interpolated CDF");
+  double sum = 0;
+  int below = 0;
+  for (int i = 0; i < count; i++)
+    {
+      double value = x->GetValue ();
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (value, 0, "Value less than the first value of the file");
+      NS_TEST_ASSERT_MSG_LT_OR_EQ (value, 20, "Value greater than the last value of the file");
+      sum += value;
+      below += value <= 5;
+    }
+  NS_TEST_EXPECT_MSG_EQ_TOL (sum / count, 12.5, 0.1, "Wrong average of the interpolated values");
+  NS_TEST_EXPECT_MSG_EQ_TOL (below / double (count), 0.125, 0.005, "Wrong share of the values below 5");
+
+  // Antithetic values have the same distribution
+  x->SetAttribute ("Antithetic", BooleanValue (true));
+  sum = 0;
+  for (int i = 0; i < count; i++)
+    {
+      sum += x->GetValue ();
+    }
+  NS_TEST_EXPECT_MSG_EQ_TOL (sum / count, 12.5, 0.1, "Wrong average of the antithetic values");
+
+  // Sampling, only the values of the file are drawn
+  x = Create (fractions, false, 2);
+  NS_TEST_ASSERT_MSG_EQ_TOL (x->GetMean (), 17.5, 1e-9, "Wrong mean of the sampled CDF");
+  std::map<double, int> counts;
+  for (int i = 0; i < count; i++)
+    {
+      counts[x->GetValue ()]++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (counts.size (), 2, "Only the values of bins of nonzero probability should be drawn");
+  NS_TEST_EXPECT_MSG_EQ_TOL (counts[10] / double (count), 0.25, 0.005, "Wrong share of the value 10");
+  NS_TEST_EXPECT_MSG_EQ_TOL (counts[20] / double (count), 0.75, 0.005, "Wrong share of the value 20");
+
+  // A file in percents is the same distribution, and the same stream
+  // draws the same values
+  Ptr<CdfFileRandomVariable> y = Create (fractions, true, 3);
+  Ptr<CdfFileRandomVariable> z = Create (percents, true, 3);
+  for (int i = 0; i < 1000; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL (y->GetValue (), z->GetValue (), 1e-9, "The files should give the same values");
+    }
+
+  // Variables of the same file are independent streams
+  y = Create (fractions, true, 4);
+  z = Create (fractions, true, 5);
+  int same = 0;
+  for (int i = 0; i < 1000; i++)
+    {
+      same += y->GetValue () == z->GetValue ();
+    }
+  NS_TEST_EXPECT_MSG_EQ (same, 0, "Different streams should draw different values");
+
+  // An atom at the first line
+  std::string atom = CreateTempDirFilename ("atom.txt");
+  out.open (atom.c_str ());
+  out << "100 0.5\n200 1\n";
+  out.close ();
+  x = Create (atom, true, 6);
+  NS_TEST_ASSERT_MSG_EQ_TOL (x->GetMean (), 125, 1e-9, "Wrong mean of the CDF with an atom");
+  int atoms = 0;
+  for (int i = 0; i < count; i++)
+    {
+      atoms += x->GetValue () == 100;
+    }
+  NS_TEST_EXPECT_MSG_EQ_TOL (atoms / double (count), 0.5, 0.005, "Wrong share of the first value");
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * Test suite for the CDF file random variable
+ */
+class CdfFileRandomVariableTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  CdfFileRandomVariableTestSuite ();
+};
+
+CdfFileRandomVariableTestSuite::CdfFileRandomVariableTestSuite ()
+  : TestSuite ("cdf-file-random-variable", UNIT)
+{
+  AddTestCase (new CdfFileRandomVariableTestCase);
+}
+
+/**
+ * \ingroup randomvariable-tests
+ * CdfFileRandomVariableTestSuite instance variable.
+ */
+static CdfFileRandomVariableTestSuite g_cdfFileRandomVariableTestSuite;
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -840,6 +840,73 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+/**
+ * \ingroup config-tests
+ * Test the resolution of single indices, ranges and wildcards in
+ * large object vectors.
+ */
+class ObjectVectorIndexConfigTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  ObjectVectorIndexConfigTestCase ();
+  /** Destructor. */
+  virtual ~ObjectVectorIndexConfigTestCase ()
+  {}
+
+private:
+  virtual void DoRun (void);
+};
+
+ObjectVectorIndexConfigTestCase::ObjectVectorIndexConfigTestCase ()
+  : TestCase ("Check the resolution of indices in a large vector of Object")
+{}
+
+void
+ObjectVectorIndexConfigTestCase::DoRun (void)
+{
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+  Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject> ();
+  root->SetNodeA (a);
+  std::vector<Ptr<ConfigTestObject> > objects;
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      objects.push_back (CreateObject<ConfigTestObject> ());
+      a->AddNodeB (objects.back ());
+    }
+
+  Config::MatchContainer matches = Config::LookupMatches ("/NodeA/NodesB/57");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetN (), 1, "A single index should match one object");
+  NS_TEST_ASSERT_MSG_EQ (matches.Get (0), objects[57], "Wrong object for the index");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetMatchedPath (0), "/NodeA/NodesB/57/", "Wrong matched path");
+
+  matches = Config::LookupMatches ("/NodeA/NodesB/100");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetN (), 0, "An index past the end should match nothing");
+
+  matches = Config::LookupMatches ("/NodeA/NodesB/*");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetN (), 100, "The wildcard should match all objects");
+  for (uint32_t i = 0; i < matches.GetN (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (matches.Get (i), objects[i], "Objects out of order");
+    }
+
+  matches = Config::LookupMatches ("/NodeA/NodesB/[10-19]|90|[30-29]");
+  NS_TEST_ASSERT_MSG_EQ (matches.GetN (), 11, "Wrong number of objects in the ranges");
+  NS_TEST_ASSERT_MSG_EQ (matches.Get (10), objects[90], "Wrong object for the last index");
+
+  // The attributes of the first object are reused for the others
+  Config::Set ("/NodeA/NodesB/[40-49]/A", IntegerValue (-3));
+  for (uint32_t i = 0; i < objects.size (); i++)
+    {
+      IntegerValue iv;
+      objects[i]->GetAttribute ("A", iv);
+      int32_t expected = (i >= 40 && i <= 49) ? -3 : 10;
+      NS_TEST_ASSERT_MSG_EQ (iv.Get (), expected, "Attribute \"A\" of " << i);
+    }
+  Config::UnregisterRootNamespaceObject (root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -858,6 +925,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase);
+  AddTestCase (new ObjectVectorIndexConfigTestCase);
 }
 
 /**
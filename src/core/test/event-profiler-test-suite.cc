@@ -0,0 +1,290 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/object.h"
+#include "ns3/simulator.h"
+#include "ns3/event-profiler.h"
+
+#include <algorithm>
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * \ingroup event-profiler-tests
+ * EventProfiler test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup event-profiler-tests EventProfiler test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup event-profiler-tests
+ * Base class of the objects run by the events.
+ */
+class EventProfilerBase : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+  /** Do some work, in a derived class. */
+  virtual void Work (void) = 0;
+};
+
+TypeId
+EventProfilerBase::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::tests::EventProfilerBase")
+    .SetParent<Object> ()
+    .SetGroupName ("Core")
+  ;
+  return tid;
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * Object run by the events.
+ */
+class EventProfilerWorker : public EventProfilerBase
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+  /** Constructor. */
+  EventProfilerWorker ();
+  virtual void Work (void);
+  /**
+   * Do some other work.
+   * \param [in] n The amount of work.
+   */
+  void Other (uint32_t n);
+
+  uint32_t m_work;  //!< The work done.
+};
+
+TypeId
+EventProfilerWorker::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::tests::EventProfilerWorker")
+    .SetParent<EventProfilerBase> ()
+    .SetGroupName ("Core")
+    .AddConstructor<EventProfilerWorker> ()
+  ;
+  return tid;
+}
+
+EventProfilerWorker::EventProfilerWorker ()
+  : m_work (0)
+{}
+
+void
+EventProfilerWorker::Work (void)
+{
+  m_work++;
+}
+
+void
+EventProfilerWorker::Other (uint32_t n)
+{
+  m_work += n;
+}
+
+/** Function run by the events without an object. */
+void
+EventProfilerFunction (void)
+{
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * Charge the events to their kinds and nodes.
+ */
+class EventProfilerTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  EventProfilerTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Count the events of some entries.
+   * \param [in] entries The entries.
+   * \param [in] name The beginning of the names of the entries.
+   * \returns The number of events of the entries.
+   */
+  uint64_t Find (const std::vector<EventProfiler::Entry> &entries, const std::string &name);
+};
+
+EventProfilerTestCase::EventProfilerTestCase ()
+  : TestCase ("Charge the events to their kinds and nodes")
+{}
+
+uint64_t
+EventProfilerTestCase::Find (const std::vector<EventProfiler::Entry> &entries, const std::string &name)
+{
+  uint64_t count = 0;
+  for (const EventProfiler::Entry &entry : entries)
+    {
+      if (entry.name.compare (0, name.size (), name) == 0)
+        {
+          count += entry.count;
+        }
+    }
+  return count;
+}
+
+void
+EventProfilerTestCase::DoRun (void)
+{
+  Ptr<EventProfilerWorker> worker = CreateObject<EventProfilerWorker> ();
+  Ptr<EventProfilerBase> base = worker;
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      // the virtual method is charged to the derived class
+      Simulator::ScheduleWithContext (3, Seconds (i), &EventProfilerBase::Work, base);
+    }
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Simulator::ScheduleWithContext (5, Seconds (i), &EventProfilerWorker::Other, worker, i);
+      Simulator::Schedule (Seconds (i), &EventProfilerFunction);
+    }
+
+  EventProfiler::Reset ();
+  EventProfiler::Enable ();
+  Simulator::Run ();
+  EventProfiler::Disable ();
+  Simulator::Destroy ();
+
+  std::vector<EventProfiler::Entry> kinds = EventProfiler::GetKinds ();
+  std::vector<EventProfiler::Entry> nodes = EventProfiler::GetNodes ();
+  NS_TEST_ASSERT_MSG_EQ (worker->m_work, 16, "Events not run");
+  NS_TEST_ASSERT_MSG_EQ (kinds.size (), 3, "Wrong number of kinds");
+  NS_TEST_ASSERT_MSG_EQ (nodes.size (), 3, "Wrong number of nodes");
+  NS_TEST_ASSERT_MSG_EQ (Find (nodes, "node 3"), 10, "Wrong events on node 3");
+  NS_TEST_ASSERT_MSG_EQ (Find (nodes, "node 5"), 4, "Wrong events on node 5");
+  NS_TEST_ASSERT_MSG_EQ (Find (nodes, "no node"), 4, "Wrong events without a node");
+  NS_TEST_ASSERT_MSG_EQ (Find (kinds, "ns3::tests::EventProfilerWorker;"), 10 + 4, "Wrong events of the worker");
+  NS_TEST_ASSERT_MSG_EQ (Find (kinds, "(no object);"), 4, "Wrong events without an object");
+#if defined (__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 34))
+  // the names are found by dladdr
+  NS_TEST_ASSERT_MSG_EQ (Find (kinds, "ns3::tests::EventProfilerWorker;ns3::tests::EventProfilerWorker::Work()"),
+                         10, "Virtual method not resolved");
+  NS_TEST_ASSERT_MSG_EQ (Find (kinds, "ns3::tests::EventProfilerWorker;ns3::tests::EventProfilerWorker::Other(unsigned int)"),
+                         4, "Method not named");
+  NS_TEST_ASSERT_MSG_EQ (Find (kinds, "(no object);ns3::tests::EventProfilerFunction()"),
+                         4, "Function not named");
+#endif
+
+  std::ostringstream folded;
+  EventProfiler::WriteFolded (folded);
+  std::istringstream lines (folded.str ());
+  std::string line;
+  uint32_t nLines = 0;
+  while (std::getline (lines, line))
+    {
+      nLines++;
+      std::size_t space = line.rfind (' ');
+      NS_TEST_ASSERT_MSG_NE (space, std::string::npos, "No value in " << line);
+      NS_TEST_ASSERT_MSG_EQ (line.find_first_not_of ("0123456789", space + 1), std::string::npos,
+                             "Bad value in " << line);
+      NS_TEST_ASSERT_MSG_EQ (std::count (line.begin (), line.end (), ';'), 2, "Bad stack in " << line);
+    }
+  NS_TEST_ASSERT_MSG_EQ (nLines, 3, "Wrong number of stacks");
+  EventProfiler::Reset ();
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * Profile a sample of the events.
+ */
+class EventProfilerPeriodTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  EventProfilerPeriodTestCase ();
+  virtual void DoRun (void);
+};
+
+EventProfilerPeriodTestCase::EventProfilerPeriodTestCase ()
+  : TestCase ("Profile a sample of the events")
+{}
+
+void
+EventProfilerPeriodTestCase::DoRun (void)
+{
+  Ptr<EventProfilerWorker> worker = CreateObject<EventProfilerWorker> ();
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      Simulator::Schedule (Seconds (i), &EventProfilerWorker::Work, worker);
+    }
+  EventProfiler::Reset ();
+  EventProfiler::Enable (3);
+  Simulator::Run ();
+  EventProfiler::Disable ();
+  Simulator::Destroy ();
+
+  std::vector<EventProfiler::Entry> kinds = EventProfiler::GetKinds ();
+  NS_TEST_ASSERT_MSG_EQ (worker->m_work, 10, "Events not run");
+  NS_TEST_ASSERT_MSG_EQ (kinds.size (), 1, "Wrong number of kinds");
+  NS_TEST_ASSERT_MSG_EQ (kinds[0].count, 4, "Events 0, 3, 6 and 9 should be profiled");
+  EventProfiler::Reset ();
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * EventProfiler test suite.
+ */
+class EventProfilerTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  EventProfilerTestSuite ();
+};
+
+EventProfilerTestSuite::EventProfilerTestSuite ()
+  : TestSuite ("event-profiler")
+{
+  AddTestCase (new EventProfilerTestCase ());
+  AddTestCase (new EventProfilerPeriodTestCase ());
+}
+
+/**
+ * \ingroup event-profiler-tests
+ * EventProfilerTestSuite instance variable.
+ */
+static EventProfilerTestSuite g_eventProfilerTestSuite;
+
+
+}    // namespace tests
+
+}    // namespace ns3
@@ -0,0 +1,301 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/nstime.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup core-tests
+ *
+ * Base class of the MultithreadedSimulatorImpl tests: each test case
+ * runs with four partitions, one per context, and records in
+ * m_trace[context] the events run in each context.
+ */
+class MultithreadedSimulatorTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param name The test case name.
+   */
+  MultithreadedSimulatorTestCase (std::string name);
+
+protected:
+  /** Number of contexts and partitions. */
+  static const uint32_t N = 4;
+
+  /** \returns The simulator implementation. */
+  Ptr<MultithreadedSimulatorImpl> GetImpl (void);
+  /**
+   * Record an event in the trace of the current context.
+   * \param tag The event tag.
+   */
+  void Record (uint32_t tag);
+
+  /** Trace of (time in ns, tag) of each context. */
+  std::vector<std::pair<int64_t, uint32_t> > m_trace[N];
+
+private:
+  virtual void DoSetup (void);
+  virtual void DoTeardown (void);
+};
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase (std::string name)
+  : TestCase (name)
+{}
+
+void
+MultithreadedSimulatorTestCase::DoSetup (void)
+{
+  Simulator::Destroy ();
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::MultithreadedSimulatorImpl"));
+  for (uint32_t i = 0; i < N; ++i)
+    {
+      m_trace[i].clear ();
+    }
+}
+
+void
+MultithreadedSimulatorTestCase::DoTeardown (void)
+{
+  Simulator::Destroy ();
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+}
+
+Ptr<MultithreadedSimulatorImpl>
+MultithreadedSimulatorTestCase::GetImpl (void)
+{
+  return DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+}
+
+void
+MultithreadedSimulatorTestCase::Record (uint32_t tag)
+{
+  uint32_t context = Simulator::GetContext ();
+  m_trace[context].push_back (std::make_pair (Simulator::Now ().GetNanoSeconds (), tag));
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * Check that events hop between partitions with the right timestamps.
+ */
+class MultithreadedSimulatorRingTestCase : public MultithreadedSimulatorTestCase
+{
+public:
+  MultithreadedSimulatorRingTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Forward a token to the next context.
+   * \param hops The number of hops left.
+   */
+  void Hop (uint32_t hops);
+};
+
+MultithreadedSimulatorRingTestCase::MultithreadedSimulatorRingTestCase ()
+  : MultithreadedSimulatorTestCase ("Check events exchanged between partitions")
+{}
+
+void
+MultithreadedSimulatorRingTestCase::Hop (uint32_t hops)
+{
+  Record (hops);
+  // A local event, shorter than the lookahead.
+  Simulator::Schedule (NanoSeconds (10), &MultithreadedSimulatorRingTestCase::Record, this, 0);
+  if (hops > 0)
+    {
+      uint32_t next = (Simulator::GetContext () + 1) % N;
+      Simulator::ScheduleWithContext (next, MicroSeconds (1), &MultithreadedSimulatorRingTestCase::Hop, this, hops - 1);
+    }
+}
+
+void
+MultithreadedSimulatorRingTestCase::DoRun (void)
+{
+  Ptr<MultithreadedSimulatorImpl> impl = GetImpl ();
+  NS_TEST_ASSERT_MSG_NE (impl, 0, "Wrong simulator implementation");
+  for (uint32_t i = 0; i < N; ++i)
+    {
+      impl->SetPartition (i, i);
+    }
+  impl->SetLookahead (MicroSeconds (1));
+  NS_TEST_EXPECT_MSG_EQ (impl->GetNPartitions (), N, "Wrong number of partitions");
+
+  const uint32_t hops = 100;
+  Simulator::ScheduleWithContext (0, MicroSeconds (5), &MultithreadedSimulatorRingTestCase::Hop, this, hops);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetEventCount (), 2 * (hops + 1), "Wrong number of events");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MicroSeconds (5 + hops) + NanoSeconds (10), "Wrong end time");
+  for (uint32_t hop = 0; hop <= hops; ++hop)
+    {
+      uint32_t context = hop % N;
+      uint32_t index = 2 * (hop / N);
+      NS_TEST_ASSERT_MSG_LT (index + 1, m_trace[context].size (), "Missing event in context " << context);
+      NS_TEST_EXPECT_MSG_EQ (m_trace[context][index].first, 1000 * (5 + hop), "Wrong hop time");
+      NS_TEST_EXPECT_MSG_EQ (m_trace[context][index].second, hops - hop, "Wrong hop");
+      NS_TEST_EXPECT_MSG_EQ (m_trace[context][index + 1].first, 1000 * (5 + hop) + 10, "Wrong local event time");
+    }
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * Check that simultaneous events sent by several partitions are run
+ * in a deterministic order.
+ */
+class MultithreadedSimulatorOrderTestCase : public MultithreadedSimulatorTestCase
+{
+public:
+  MultithreadedSimulatorOrderTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /** Send a burst of simultaneous events to context 0. */
+  void Burst (void);
+};
+
+MultithreadedSimulatorOrderTestCase::MultithreadedSimulatorOrderTestCase ()
+  : MultithreadedSimulatorTestCase ("Check the order of simultaneous events from several partitions")
+{}
+
+void
+MultithreadedSimulatorOrderTestCase::Burst (void)
+{
+  uint32_t context = Simulator::GetContext ();
+  for (uint32_t i = 0; i < 50; ++i)
+    {
+      Simulator::ScheduleWithContext (0, MicroSeconds (2), &MultithreadedSimulatorOrderTestCase::Record, this,
+                                      context * 100 + i);
+    }
+}
+
+void
+MultithreadedSimulatorOrderTestCase::DoRun (void)
+{
+  Ptr<MultithreadedSimulatorImpl> impl = GetImpl ();
+  for (uint32_t i = 0; i < N; ++i)
+    {
+      impl->SetPartition (i, i);
+    }
+  impl->SetLookahead (MicroSeconds (1));
+  for (uint32_t i = 1; i < N; ++i)
+    {
+      Simulator::ScheduleWithContext (i, MicroSeconds (1), &MultithreadedSimulatorOrderTestCase::Burst, this);
+    }
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_trace[0].size (), 50 * (N - 1), "Wrong number of events");
+  for (uint32_t i = 0; i < m_trace[0].size (); ++i)
+    {
+      uint32_t source = 1 + i / 50;
+      NS_TEST_EXPECT_MSG_EQ (m_trace[0][i].first, 3000, "Wrong event time");
+      NS_TEST_EXPECT_MSG_EQ (m_trace[0][i].second, source * 100 + i % 50, "Wrong event order");
+    }
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * Check the events without a context and Simulator::Stop.
+ */
+class MultithreadedSimulatorStopTestCase : public MultithreadedSimulatorTestCase
+{
+public:
+  MultithreadedSimulatorStopTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /** Reschedule itself every microsecond in the current context. */
+  void Tick (void);
+  /** Check the state of all contexts, from an event without context. */
+  void Check (void);
+};
+
+MultithreadedSimulatorStopTestCase::MultithreadedSimulatorStopTestCase ()
+  : MultithreadedSimulatorTestCase ("Check global events and Simulator::Stop with several partitions")
+{}
+
+void
+MultithreadedSimulatorStopTestCase::Tick (void)
+{
+  Record (0);
+  Simulator::Schedule (MicroSeconds (1), &MultithreadedSimulatorStopTestCase::Tick, this);
+}
+
+void
+MultithreadedSimulatorStopTestCase::Check (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetContext (), Simulator::NO_CONTEXT, "Wrong context");
+  for (uint32_t i = 0; i < N; ++i)
+    {
+      // The ticks at 1, 2, ..., 10 us have run, the one at 10.5 us has not.
+      NS_TEST_EXPECT_MSG_EQ (m_trace[i].size (), 10, "Partition " << i << " not synchronized");
+    }
+}
+
+void
+MultithreadedSimulatorStopTestCase::DoRun (void)
+{
+  Ptr<MultithreadedSimulatorImpl> impl = GetImpl ();
+  for (uint32_t i = 0; i < N; ++i)
+    {
+      impl->SetPartition (i, i);
+    }
+  impl->SetLookahead (MicroSeconds (3));
+  for (uint32_t i = 0; i < N; ++i)
+    {
+      Simulator::ScheduleWithContext (i, MicroSeconds (1), &MultithreadedSimulatorStopTestCase::Tick, this);
+    }
+  Simulator::Schedule (NanoSeconds (10500), &MultithreadedSimulatorStopTestCase::Check, this);
+  Simulator::Stop (MicroSeconds (20));
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MicroSeconds (20), "Wrong stop time");
+  for (uint32_t i = 0; i < N; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_trace[i].size (), 19, "Wrong number of ticks in partition " << i);
+    }
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * The MultithreadedSimulatorImpl TestSuite.
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+public:
+  MultithreadedSimulatorTestSuite ()
+    : TestSuite ("multithreaded-simulator")
+  {
+    AddTestCase (new MultithreadedSimulatorRingTestCase (), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorOrderTestCase (), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorStopTestCase (), TestCase::QUICK);
+  }
+};
+
+static MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite; //!< Static variable for test initialization
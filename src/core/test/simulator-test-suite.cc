@@ -23,7 +23,12 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/random-variable-stream.h"
+
+#include <map>
+#include <vector>
 
 using namespace ns3;
 
@@ -465,6 +470,213 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup core-tests
+ * \brief Check that the executed events are recycled by the
+ * per-thread free lists of EventImpl, and not when they are disabled.
+ */
+class SimulatorEventPoolTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  SimulatorEventPoolTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Reschedule itself until \p count reaches 0.
+   * \param count The number of events left to run.
+   */
+  void Chain (uint32_t count);
+};
+
+SimulatorEventPoolTestCase::SimulatorEventPoolTestCase ()
+  : TestCase ("Check that executed events are recycled")
+{}
+
+void
+SimulatorEventPoolTestCase::Chain (uint32_t count)
+{
+  if (count > 0)
+    {
+      Simulator::Schedule (NanoSeconds (1), &SimulatorEventPoolTestCase::Chain, this, count - 1);
+    }
+}
+
+void
+SimulatorEventPoolTestCase::DoRun (void)
+{
+  EventImpl::SetPoolEnabled (true);
+  Simulator::Schedule (Seconds (0.0), &SimulatorEventPoolTestCase::Chain, this, 1000);
+  EventImpl::PoolStats before = EventImpl::GetPoolStats ();
+  Simulator::Run ();
+  EventImpl::PoolStats after = EventImpl::GetPoolStats ();
+  NS_TEST_EXPECT_MSG_EQ (after.allocations - before.allocations, 1000, "Wrong number of events");
+  // Only the first event of the chain can miss the free list.
+  NS_TEST_EXPECT_MSG_LT_OR_EQ (after.heapAllocations - before.heapAllocations, 1,
+                               "Events were not recycled");
+
+  EventImpl::SetPoolEnabled (false);
+  Simulator::Schedule (Seconds (0.0), &SimulatorEventPoolTestCase::Chain, this, 10);
+  before = EventImpl::GetPoolStats ();
+  Simulator::Run ();
+  after = EventImpl::GetPoolStats ();
+  NS_TEST_EXPECT_MSG_EQ (after.heapAllocations - before.heapAllocations, 10,
+                         "Events were recycled with the pool disabled");
+  EventImpl::SetPoolEnabled (true);
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup core-tests
+ * \brief Check that the LadderScheduler dequeues the events in the same
+ * order as the MapScheduler, under random insertions and removals.
+ *
+ * Hundreds of events are kept pending, many with the same or close
+ * time stamps, so that Top, Bottom and the buckets of the rungs grow
+ * beyond the size at which they are spread over a new rung, and that
+ * the cancelled events are removed from all the tiers.
+ */
+class LadderSchedulerTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  LadderSchedulerTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Run random operations on both schedulers.
+   * \param stream The random variable stream.
+   */
+  void RunStream (int64_t stream);
+  /**
+   * Forget a pending event.
+   * \param uid The uid of the event.
+   */
+  void Forget (uint32_t uid);
+
+  std::vector<Scheduler::Event> m_pending;  //!< Events inserted and not removed.
+  std::map<uint32_t, uint32_t> m_index;     //!< Position of the pending events, by uid.
+};
+
+LadderSchedulerTestCase::LadderSchedulerTestCase ()
+  : TestCase ("Check the LadderScheduler against the MapScheduler")
+{}
+
+void
+LadderSchedulerTestCase::Forget (uint32_t uid)
+{
+  std::map<uint32_t, uint32_t>::iterator i = m_index.find (uid);
+  NS_ASSERT (i != m_index.end ());
+  uint32_t index = i->second;
+  m_index.erase (i);
+  if (index != m_pending.size () - 1)
+    {
+      m_pending[index] = m_pending.back ();
+      m_index[m_pending[index].key.m_uid] = index;
+    }
+  m_pending.pop_back ();
+}
+
+void
+LadderSchedulerTestCase::RunStream (int64_t stream)
+{
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (stream);
+  Ptr<Scheduler> ladder = CreateObject<LadderScheduler> ();
+  Ptr<Scheduler> map = CreateObject<MapScheduler> ();
+  m_pending.clear ();
+  m_index.clear ();
+
+  uint64_t now = 0;
+  uint32_t uid = 0;
+  bool growing = true;
+  uint32_t limit = rng->GetInteger (100, 2000);
+  for (uint32_t op = 0; op < 40000; op++)
+    {
+      // Alternately fill the queues up to two thousand events and
+      // drain them, down to empty now and then.
+      if (growing && m_pending.size () >= limit)
+        {
+          growing = false;
+          limit = rng->GetInteger (0, 1) == 0 ? 0 : rng->GetInteger (0, 60);
+        }
+      else if (!growing && m_pending.size () <= limit)
+        {
+          growing = true;
+          limit = rng->GetInteger (100, 2000);
+        }
+
+      uint32_t r = rng->GetInteger (0, 99);
+      if (m_pending.empty () || r < (growing ? 70u : 20u))
+        {
+          uint64_t delay;
+          uint32_t spread = rng->GetInteger (0, 9);
+          if (spread < 4)
+            {
+              delay = rng->GetInteger (0, 10);
+            }
+          else if (spread < 7)
+            {
+              delay = rng->GetInteger (0, 1000);
+            }
+          else if (spread < 9)
+            {
+              delay = rng->GetInteger (0, 1000000);
+            }
+          else
+            {
+              delay = rng->GetInteger (0, 1000000) * 100000000000ULL;
+            }
+          Scheduler::Event ev;
+          ev.impl = 0;
+          ev.key.m_ts = now + delay;
+          ev.key.m_uid = uid++;
+          ev.key.m_context = 0;
+          ladder->Insert (ev);
+          map->Insert (ev);
+          m_index[ev.key.m_uid] = m_pending.size ();
+          m_pending.push_back (ev);
+        }
+      else if (r < (growing ? 85u : 75u))
+        {
+          Scheduler::Event expected = map->RemoveNext ();
+          Scheduler::Event ev = ladder->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (ev.key.m_uid, expected.key.m_uid,
+                                 "Wrong event dequeued at operation " << op);
+          NS_TEST_ASSERT_MSG_EQ (ev.key.m_ts, expected.key.m_ts,
+                                 "Wrong time stamp at operation " << op);
+          now = ev.key.m_ts;
+          Forget (ev.key.m_uid);
+        }
+      else
+        {
+          Scheduler::Event ev = m_pending[rng->GetInteger (0, m_pending.size () - 1)];
+          ladder->Remove (ev);
+          map->Remove (ev);
+          Forget (ev.key.m_uid);
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (ladder->IsEmpty (), m_pending.empty (),
+                             "Wrong queue state at operation " << op);
+      if (!m_pending.empty ())
+        {
+          NS_TEST_ASSERT_MSG_EQ (ladder->PeekNext ().key.m_uid, map->PeekNext ().key.m_uid,
+                                 "Wrong next event at operation " << op);
+        }
+    }
+}
+
+void
+LadderSchedulerTestCase::DoRun (void)
+{
+  for (int64_t stream = 1; stream <= 10 && !IsStatusFailure (); stream++)
+    {
+      RunStream (stream);
+    }
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -481,7 +693,11 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SimulatorEventPoolTestCase (), TestCase::QUICK);
+    AddTestCase (new LadderSchedulerTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
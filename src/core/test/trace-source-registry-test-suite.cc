@@ -0,0 +1,210 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/object.h"
+#include "ns3/trace-source-registry.h"
+
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup tracing
+ * \ingroup trace-source-registry-tests
+ * TraceSourceRegistry test suite.
+ */
+
+/**
+ * \ingroup core-tests
+ * \defgroup trace-source-registry-tests TraceSourceRegistry test suite
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup trace-source-registry-tests
+ * Object with a compiled, a compiled out and a registered trace source.
+ */
+class TraceSourceRegistryObject : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  OptionalTracedValue<true, uint32_t> m_compiled;   //!< Compiled trace source.
+  OptionalTracedValue<false, uint32_t> m_pruned;    //!< Compiled out trace source.
+  OptionalTracedCallback<false, uint32_t> m_callback;  //!< Compiled out callback.
+  /** Trace source compiled only if listed in the build configuration. */
+  OptionalTracedValue<TraceSourceRegistry::IsCompiled ("ns3::tests::TraceSourceRegistryObject",
+                                                       "Registered"), uint32_t> m_registered;
+};
+
+TypeId
+TraceSourceRegistryObject::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::tests::TraceSourceRegistryObject")
+    .SetParent<Object> ()
+    .SetGroupName ("Core")
+    .AddTraceSource ("Compiled", "A compiled trace source",
+                     MakeTraceSourceAccessor (&TraceSourceRegistryObject::m_compiled),
+                     "ns3::TracedValueCallback::Uint32")
+    .AddTraceSource ("Pruned", "A compiled out trace source",
+                     MakeTraceSourceAccessor (&TraceSourceRegistryObject::m_pruned),
+                     "ns3::TracedValueCallback::Uint32")
+    .AddTraceSource ("Callback", "A compiled out callback",
+                     MakeTraceSourceAccessor (&TraceSourceRegistryObject::m_callback),
+                     "ns3::TracedValueCallback::Uint32")
+    .AddTraceSource ("Registered", "A trace source listed by the build configuration",
+                     MakeTraceSourceAccessor (&TraceSourceRegistryObject::m_registered),
+                     "ns3::TracedValueCallback::Uint32")
+  ;
+  return tid;
+}
+
+/**
+ * \ingroup trace-source-registry-tests
+ * Check the compile time lists and the compiled out trace sources.
+ */
+class TraceSourceRegistryTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  TraceSourceRegistryTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Sink of the compiled trace source.
+   * \param [in] oldValue The old value.
+   * \param [in] newValue The new value.
+   */
+  void Sink (uint32_t oldValue, uint32_t newValue);
+
+  uint32_t m_calls;  //!< Number of calls of the sink.
+};
+
+TraceSourceRegistryTestCase::TraceSourceRegistryTestCase ()
+  : TestCase ("Compile out the unlisted trace sources"),
+    m_calls (0)
+{}
+
+void
+TraceSourceRegistryTestCase::Sink (uint32_t oldValue, uint32_t newValue)
+{
+  m_calls++;
+}
+
+void
+TraceSourceRegistryTestCase::DoRun (void)
+{
+  static_assert (TraceSourceRegistry::Find ("ns3::A::X,ns3::B::Y", "ns3::B::Y"), "Last item not found");
+  static_assert (TraceSourceRegistry::Find ("ns3::A::X,ns3::B::Y", "ns3::A::X"), "First item not found");
+  static_assert (!TraceSourceRegistry::Find ("ns3::A::X,ns3::B::Y", "ns3::A::"), "Prefix found");
+  static_assert (!TraceSourceRegistry::Find ("ns3::A::XY", "ns3::A::X"), "Longer item found");
+  static_assert (!TraceSourceRegistry::Find ("", "ns3::A::X"), "Item found in an empty list");
+  static_assert (TraceSourceRegistry::Find ("ns3::A::X,ns3::B::Y", "ns3::B", "Y"), "Source not found");
+  static_assert (!TraceSourceRegistry::Find ("ns3::A::X,ns3::B::Y", "ns3::B", "X"), "Wrong source found");
+  static_assert (!TraceSourceRegistry::Find ("ns3::AB::X", "ns3::A", "X"), "Wrong type found");
+  static_assert (std::is_same<OptionalTracedValue<true, uint32_t>, TracedValue<uint32_t> >::value,
+                 "Compiled trace source not traced");
+
+  Ptr<TraceSourceRegistryObject> object = CreateObject<TraceSourceRegistryObject> ();
+  NS_TEST_ASSERT_MSG_EQ (IsPruned (object->m_compiled), false, "Compiled trace source pruned");
+  NS_TEST_ASSERT_MSG_EQ (IsPruned (object->m_pruned), true, "Trace source not pruned");
+  NS_TEST_ASSERT_MSG_EQ (IsPruned (object->m_callback), true, "Callback not pruned");
+
+  bool ok = object->TraceConnectWithoutContext ("Compiled",
+                                                MakeCallback (&TraceSourceRegistryTestCase::Sink, this));
+  NS_TEST_ASSERT_MSG_EQ (ok, true, "Could not connect the compiled trace source");
+  object->m_compiled = 10;
+  NS_TEST_ASSERT_MSG_EQ (m_calls, 1, "Compiled trace source not traced");
+
+  // a compiled out source still holds its value
+  object->m_pruned = 10;
+  object->m_pruned += 5;
+  object->m_pruned--;
+  NS_TEST_ASSERT_MSG_EQ (object->m_pruned, 14u, "Wrong value");
+  NS_TEST_ASSERT_MSG_EQ ((object->m_pruned < object->m_compiled), false, "Wrong comparison");
+  NS_TEST_ASSERT_MSG_EQ ((object->m_pruned + object->m_compiled), 24u, "Wrong sum");
+  std::ostringstream oss;
+  oss << object->m_pruned;
+  NS_TEST_ASSERT_MSG_EQ (oss.str (), "14", "Wrong output");
+  object->m_callback (1);
+
+  ok = object->TraceDisconnectWithoutContext ("Pruned",
+                                              MakeCallback (&TraceSourceRegistryTestCase::Sink, this));
+  NS_TEST_ASSERT_MSG_EQ (ok, false, "Disconnected a compiled out trace source");
+  NS_TEST_ASSERT_MSG_EQ (m_calls, 1, "Compiled out trace source traced");
+
+  // the ultra build profile compiles out every unlisted trace source,
+  // the other profiles compile them all unless given a list
+  bool registered = TraceSourceRegistry::IsCompiled ("ns3::tests::TraceSourceRegistryObject",
+                                                     "Registered");
+#ifndef NS3_TRACE_SOURCES
+  NS_TEST_ASSERT_MSG_EQ (registered, true, "Trace source compiled out without a list");
+#else
+  if (sizeof (NS3_TRACE_SOURCES) == 1)
+    {
+      NS_TEST_ASSERT_MSG_EQ (registered, false, "Trace source compiled with an empty list");
+    }
+#endif
+  NS_TEST_ASSERT_MSG_EQ (IsPruned (object->m_registered), !registered, "Wrong registered trace source");
+  if (registered)
+    {
+      ok = object->TraceConnectWithoutContext ("Registered",
+                                               MakeCallback (&TraceSourceRegistryTestCase::Sink, this));
+      NS_TEST_ASSERT_MSG_EQ (ok, true, "Could not connect the registered trace source");
+    }
+  object->m_registered = 3;
+  NS_TEST_ASSERT_MSG_EQ (object->m_registered, 3u, "Wrong registered value");
+  NS_TEST_ASSERT_MSG_EQ (m_calls, (registered ? 2u : 1u), "Wrong calls of the registered trace source");
+}
+
+/**
+ * \ingroup trace-source-registry-tests
+ * TraceSourceRegistry test suite.
+ */
+class TraceSourceRegistryTestSuite : public TestSuite
+{
+public:
+  /** Constructor. */
+  TraceSourceRegistryTestSuite ();
+};
+
+TraceSourceRegistryTestSuite::TraceSourceRegistryTestSuite ()
+  : TestSuite ("trace-source-registry")
+{
+  AddTestCase (new TraceSourceRegistryTestCase ());
+}
+
+/**
+ * \ingroup trace-source-registry-tests
+ * TraceSourceRegistryTestSuite instance variable.
+ */
+static TraceSourceRegistryTestSuite g_traceSourceRegistryTestSuite;
+
+
+}    // namespace tests
+
+}    // namespace ns3
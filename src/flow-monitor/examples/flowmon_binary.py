@@ -0,0 +1,192 @@
+#! /usr/bin/env python3
+## -*- Mode: python; py-indent-offset: 4; indent-tabs-mode: nil; coding: utf-8; -*-
+#
+# Reader of the binary FlowMonitor output written by
+# FlowMonitor::SerializeToBinaryFile and FlowMonitor::StartBinaryStream.
+#
+# The records are decoded one at a time with the struct module, so that the
+# flows of a large simulation can be reduced without building a document
+# tree.  The format is described in src/flow-monitor/model/flow-monitor-binary.h.
+#
+# Used as a module:
+#
+#   import flowmon_binary
+#   for flow in flowmon_binary.read_flows('flows.bin'):
+#       print(flow.flow_id, flow.fct_ns())
+#
+# Used as a program, it prints a summary of each flow of a file.
+#
+
+from __future__ import division, print_function
+import socket
+import struct
+import sys
+
+MAGIC = b'NS3FLOWM'
+VERSION = 1
+FLAG_HISTOGRAMS = 0x0001
+
+_HEADER = struct.Struct('<8sHH')
+_LENGTH = struct.Struct('<I')
+_STATS = struct.Struct('<7q2Q4I')
+_HISTOGRAMS = ('delay_histogram', 'jitter_histogram', 'packet_size_histogram',
+               'flow_interruptions_histogram')
+
+
+class FlowRecord(object):
+    '''The statistics of one flow, as written by FlowMonitor.
+
+    The times are integer nanoseconds.  The addresses and ports are None when
+    the flow was not described by a classifier.  Each histogram, present only
+    when the file holds histograms, is a (bin width, {bin index: count}) pair.
+    '''
+    __slots__ = ('flow_id', 'src', 'dst', 'protocol', 'sport', 'dport',
+                 'time_first_tx_ns', 'time_first_rx_ns', 'time_last_tx_ns',
+                 'time_last_rx_ns', 'delay_sum_ns', 'jitter_sum_ns',
+                 'last_delay_ns', 'tx_bytes', 'rx_bytes', 'tx_packets',
+                 'rx_packets', 'lost_packets', 'times_forwarded',
+                 'packets_dropped', 'bytes_dropped') + _HISTOGRAMS
+
+    def fct_ns(self):
+        '''@return The flow completion time, or None if nothing was received.'''
+        if self.rx_packets == 0:
+            return None
+        return self.time_last_rx_ns - self.time_first_tx_ns
+
+    def merge(self, other):
+        '''Add the statistics of a later record of the same flow.'''
+        if self.src is None:
+            self.src, self.dst = other.src, other.dst
+            self.protocol, self.sport, self.dport = other.protocol, other.sport, other.dport
+        if other.tx_packets and (not self.tx_packets or other.time_first_tx_ns < self.time_first_tx_ns):
+            self.time_first_tx_ns = other.time_first_tx_ns
+        if other.rx_packets and (not self.rx_packets or other.time_first_rx_ns < self.time_first_rx_ns):
+            self.time_first_rx_ns = other.time_first_rx_ns
+        self.time_last_tx_ns = max(self.time_last_tx_ns, other.time_last_tx_ns)
+        if other.rx_packets:
+            self.time_last_rx_ns = max(self.time_last_rx_ns, other.time_last_rx_ns)
+            self.last_delay_ns = other.last_delay_ns
+        for name in ('delay_sum_ns', 'jitter_sum_ns', 'tx_bytes', 'rx_bytes', 'tx_packets',
+                     'rx_packets', 'lost_packets', 'times_forwarded'):
+            setattr(self, name, getattr(self, name) + getattr(other, name))
+        for name in ('packets_dropped', 'bytes_dropped'):
+            mine, theirs = getattr(self, name), getattr(other, name)
+            mine.extend([0] * (len(theirs) - len(mine)))
+            for code, value in enumerate(theirs):
+                mine[code] += value
+        for name in _HISTOGRAMS:
+            mine, theirs = getattr(self, name), getattr(other, name)
+            if mine is None:
+                setattr(self, name, theirs)
+            elif theirs is not None:
+                for index, count in theirs[1].items():
+                    mine[1][index] = mine[1].get(index, 0) + count
+
+
+def _decode(body, histograms):
+    record = FlowRecord()
+    record.flow_id, family = struct.unpack_from('<IB', body, 0)
+    offset = 5
+    record.src = record.dst = record.protocol = record.sport = record.dport = None
+    if family in (4, 6):
+        size = 4 if family == 4 else 16
+        af = socket.AF_INET if family == 4 else socket.AF_INET6
+        record.src = socket.inet_ntop(af, body[offset:offset + size])
+        record.dst = socket.inet_ntop(af, body[offset + size:offset + 2 * size])
+        offset += 2 * size
+        record.protocol, record.sport, record.dport = struct.unpack_from('<BHH', body, offset)
+        offset += 5
+    (record.time_first_tx_ns, record.time_first_rx_ns, record.time_last_tx_ns,
+     record.time_last_rx_ns, record.delay_sum_ns, record.jitter_sum_ns,
+     record.last_delay_ns, record.tx_bytes, record.rx_bytes, record.tx_packets,
+     record.rx_packets, record.lost_packets, record.times_forwarded) = \
+        _STATS.unpack_from(body, offset)
+    offset += _STATS.size
+    reasons, = struct.unpack_from('<I', body, offset)
+    offset += 4
+    record.packets_dropped = []
+    record.bytes_dropped = []
+    for _ in range(reasons):
+        packets, nbytes = struct.unpack_from('<IQ', body, offset)
+        offset += 12
+        record.packets_dropped.append(packets)
+        record.bytes_dropped.append(nbytes)
+    for name in _HISTOGRAMS:
+        if not histograms:
+            setattr(record, name, None)
+            continue
+        width, bins = struct.unpack_from('<dI', body, offset)
+        offset += 12
+        counts = {}
+        for _ in range(bins):
+            index, count = struct.unpack_from('<II', body, offset)
+            offset += 8
+            counts[index] = count
+        setattr(record, name, (width, counts))
+    return record
+
+
+def read_records(path):
+    '''Yield the records of a file, in the order they were written.
+
+    A flow which resumed after being streamed appears in several records;
+    read_flows() merges them.  A record cut short by the end of the file, as
+    left by a simulation which did not terminate, ends the iteration.
+    '''
+    with open(path, 'rb') as f:
+        header = f.read(_HEADER.size)
+        if len(header) < _HEADER.size:
+            raise ValueError('%s: not a binary FlowMonitor file' % path)
+        magic, version, flags = _HEADER.unpack(header)
+        if magic != MAGIC:
+            raise ValueError('%s: not a binary FlowMonitor file' % path)
+        if version != VERSION:
+            raise ValueError('%s: unsupported version %d' % (path, version))
+        histograms = bool(flags & FLAG_HISTOGRAMS)
+        while True:
+            prefix = f.read(_LENGTH.size)
+            if len(prefix) < _LENGTH.size:
+                return
+            length, = _LENGTH.unpack(prefix)
+            body = f.read(length)
+            if len(body) < length:
+                return
+            yield _decode(body, histograms)
+
+
+def read_flows(path):
+    '''Yield the flows of a file, sorted by flow identifier.'''
+    flows = {}
+    for record in read_records(path):
+        if record.flow_id in flows:
+            flows[record.flow_id].merge(record)
+        else:
+            flows[record.flow_id] = record
+    for flow_id in sorted(flows):
+        yield flows[flow_id]
+
+
+def main(argv):
+    for path in argv[1:]:
+        print('Reading binary FlowMonitor file %r' % path)
+        for flow in read_flows(path):
+            proto = {6: 'TCP', 17: 'UDP'}.get(flow.protocol, flow.protocol)
+            print('FlowID: %i (%s %s/%s --> %s/%s)' %
+                  (flow.flow_id, proto, flow.src, flow.sport, flow.dst, flow.dport))
+            print('\tTX bitrate: %s' % (
+                '%.2f kbit/s' % (flow.tx_bytes * 8e6 / (flow.time_last_tx_ns - flow.time_first_tx_ns))
+                if flow.time_last_tx_ns > flow.time_first_tx_ns else 'None'))
+            print('\tRX bitrate: %s' % (
+                '%.2f kbit/s' % (flow.rx_bytes * 8e6 / (flow.time_last_rx_ns - flow.time_first_rx_ns))
+                if flow.time_last_rx_ns > flow.time_first_rx_ns else 'None'))
+            print('\tMean Delay: %s' % (
+                '%.2f ms' % (flow.delay_sum_ns / flow.rx_packets * 1e-6)
+                if flow.rx_packets else 'None'))
+            print('\tPacket Loss Ratio: %.2f %%' % (
+                flow.lost_packets * 100.0 / flow.tx_packets if flow.tx_packets else 0.0))
+            fct = flow.fct_ns()
+            print('\tFlow Completion Time: %s' % ('%.3f ms' % (fct * 1e-6) if fct is not None else 'None'))
+
+
+if __name__ == '__main__':
+    main(sys.argv)
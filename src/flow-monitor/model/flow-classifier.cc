@@ -19,6 +19,8 @@
 //
 
 #include "flow-classifier.h"
+#include "ns3/simulator.h"
+#include "ns3/simulator-impl.h"
 
 namespace ns3 {
 
@@ -26,6 +28,8 @@ FlowClassifier::FlowClassifier ()
   :
     m_lastNewFlowId (0)
 {
+  m_multithreaded = Simulator::GetImplementation ()->GetInstanceTypeId ().GetName ()
+    == "ns3::MultithreadedSimulatorImpl";
 }
 
 FlowClassifier::~FlowClassifier ()
@@ -38,6 +42,22 @@ FlowClassifier::GetNewFlowId ()
   return ++m_lastNewFlowId;
 }
 
+std::unique_lock<std::mutex>
+FlowClassifier::Lock ()
+{
+  if (m_multithreaded)
+    {
+      return std::unique_lock<std::mutex> (m_mutex);
+    }
+  return std::unique_lock<std::mutex> ();
+}
+
+bool
+FlowClassifier::GetFlowTuple (FlowId flowId, FlowTuple &tuple) const
+{
+  return false;
+}
+
 
 } // namespace ns3
 
@@ -22,7 +22,9 @@
 #define FLOW_CLASSIFIER_H
 
 #include "ns3/simple-ref-count.h"
+#include "ns3/address.h"
 #include <ostream>
+#include <mutex>
 
 namespace ns3 {
 
@@ -38,6 +40,21 @@ typedef uint32_t FlowId;
  */
 typedef uint32_t FlowPacketId;
 
+/**
+ * \ingroup flow-monitor
+ * \brief Classifier-independent description of the packets of a flow
+ *
+ * The addresses hold an Ipv4Address or an Ipv6Address, depending on
+ * the classifier which identified the flow.
+ */
+struct FlowTuple
+{
+  Address sourceAddress;      //!< Source address
+  Address destinationAddress; //!< Destination address
+  uint8_t protocol;           //!< Protocol
+  uint16_t sourcePort;        //!< Source port
+  uint16_t destinationPort;   //!< Destination port
+};
 
 /// \ingroup flow-monitor
 /// Provides a method to translate raw packet data into abstract
@@ -54,6 +71,8 @@ class FlowClassifier : public SimpleRefCount<FlowClassifier>
 {
 private:
   FlowId m_lastNewFlowId; //!< Last known Flow ID
+  std::mutex m_mutex; //!< Serializes the classification of packets
+  bool m_multithreaded; //!< Do several threads classify packets
 
   /// Defined and not implemented to avoid misuse
   FlowClassifier (FlowClassifier const &);
@@ -71,11 +90,24 @@ public:
   /// \param indent number of spaces to use as base indentation level
   virtual void SerializeToXmlStream (std::ostream &os, uint16_t indent) const = 0;
 
+  /// Describes a flow identified by this classifier, for the binary
+  /// output of FlowMonitor.  The default implementation knows no flow.
+  /// \param flowId the identifier of the flow
+  /// \param tuple the description of the flow, filled if known
+  /// \returns true if the flow was identified by this classifier
+  virtual bool GetFlowTuple (FlowId flowId, FlowTuple &tuple) const;
+
 protected:
   /// Returns a new, unique Flow Identifier
   /// \returns a new FlowId
   FlowId GetNewFlowId ();
 
+  /// Lock the classifier if the packets may be classified by several
+  /// threads, i.e., if the simulator implementation is
+  /// ns3::MultithreadedSimulatorImpl.
+  /// \returns a lock held until it goes out of scope, or an empty lock
+  std::unique_lock<std::mutex> Lock ();
+
   ///
   /// \brief Add a number of spaces for indentation purposes.
   /// \param os The stream to write to.
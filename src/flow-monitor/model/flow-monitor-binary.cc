@@ -0,0 +1,464 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "flow-monitor-binary.h"
+#include "ns3/log.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+#include <cstring>
+#include <algorithm>
+
+/// Magic bytes starting the binary FlowMonitor output
+#define FLOW_MONITOR_BINARY_MAGIC "NS3FLOWM"
+/// Version of the binary FlowMonitor output
+#define FLOW_MONITOR_BINARY_VERSION 1
+/// Flag telling that the records hold the histograms
+#define FLOW_MONITOR_BINARY_HISTOGRAMS 0x0001
+/// Size of the buffered records triggering a write to the file
+#define FLOW_MONITOR_BINARY_BUFFER_SIZE 65536
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FlowMonitorBinary");
+
+void
+FlowMonitorRecord::Merge (const FlowMonitorRecord &other)
+{
+  NS_ASSERT (flowId == other.flowId);
+  const FlowMonitor::FlowStats &o = other.stats;
+  if (!hasTuple && other.hasTuple)
+    {
+      hasTuple = true;
+      tuple = other.tuple;
+    }
+  if (stats.txPackets == 0 || (o.txPackets > 0 && o.timeFirstTxPacket < stats.timeFirstTxPacket))
+    {
+      stats.timeFirstTxPacket = o.timeFirstTxPacket;
+    }
+  if (stats.rxPackets == 0 || (o.rxPackets > 0 && o.timeFirstRxPacket < stats.timeFirstRxPacket))
+    {
+      stats.timeFirstRxPacket = o.timeFirstRxPacket;
+    }
+  stats.timeLastTxPacket = std::max (stats.timeLastTxPacket, o.timeLastTxPacket);
+  if (o.rxPackets > 0)
+    {
+      stats.timeLastRxPacket = std::max (stats.timeLastRxPacket, o.timeLastRxPacket);
+      stats.lastDelay = o.lastDelay;
+    }
+  stats.delaySum += o.delaySum;
+  stats.jitterSum += o.jitterSum;
+  stats.txBytes += o.txBytes;
+  stats.rxBytes += o.rxBytes;
+  stats.txPackets += o.txPackets;
+  stats.rxPackets += o.rxPackets;
+  stats.lostPackets += o.lostPackets;
+  stats.timesForwarded += o.timesForwarded;
+  if (stats.packetsDropped.size () < o.packetsDropped.size ())
+    {
+      stats.packetsDropped.resize (o.packetsDropped.size (), 0);
+      stats.bytesDropped.resize (o.bytesDropped.size (), 0);
+    }
+  for (uint32_t reasonCode = 0; reasonCode < o.packetsDropped.size (); reasonCode++)
+    {
+      stats.packetsDropped[reasonCode] += o.packetsDropped[reasonCode];
+      stats.bytesDropped[reasonCode] += o.bytesDropped[reasonCode];
+    }
+
+  Histogram FlowMonitor::FlowStats::*histograms[] = {
+    &FlowMonitor::FlowStats::delayHistogram,
+    &FlowMonitor::FlowStats::jitterHistogram,
+    &FlowMonitor::FlowStats::packetSizeHistogram,
+    &FlowMonitor::FlowStats::flowInterruptionsHistogram
+  };
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Histogram from = o.*histograms[i];
+      Histogram &to = stats.*histograms[i];
+      for (uint32_t index = 0; index < from.GetNBins (); index++)
+        {
+          for (uint32_t count = from.GetBinCount (index); count > 0; count--)
+            {
+              to.AddValue ((index + 0.5) * from.GetBinWidth (index));
+            }
+        }
+    }
+}
+
+
+FlowMonitorWriter::FlowMonitorWriter ()
+  : m_histograms (false)
+{
+}
+
+FlowMonitorWriter::~FlowMonitorWriter ()
+{
+  Close ();
+}
+
+bool
+FlowMonitorWriter::Open (std::string fileName, bool enableHistograms)
+{
+  NS_LOG_FUNCTION (this << fileName << enableHistograms);
+  Close ();
+  m_os.open (fileName.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_os.is_open ())
+    {
+      return false;
+    }
+  m_histograms = enableHistograms;
+  m_buffer.assign (FLOW_MONITOR_BINARY_MAGIC, 8);
+  m_record.clear ();
+  WriteInteger (FLOW_MONITOR_BINARY_VERSION, 2);
+  WriteInteger (enableHistograms ? FLOW_MONITOR_BINARY_HISTOGRAMS : 0, 2);
+  m_buffer += m_record;
+  return true;
+}
+
+bool
+FlowMonitorWriter::IsOpen (void) const
+{
+  return m_os.is_open ();
+}
+
+void
+FlowMonitorWriter::WriteInteger (uint64_t value, uint32_t bytes)
+{
+  for (uint32_t i = 0; i < bytes; i++)
+    {
+      m_record.push_back (static_cast<char> (value & 0xff));
+      value >>= 8;
+    }
+}
+
+void
+FlowMonitorWriter::WriteHistogram (Histogram histogram)
+{
+  double binWidth = histogram.GetBinWidth (0);
+  uint64_t bits;
+  std::memcpy (&bits, &binWidth, sizeof (bits));
+  WriteInteger (bits, 8);
+  uint32_t bins = 0;
+  for (uint32_t index = 0; index < histogram.GetNBins (); index++)
+    {
+      if (histogram.GetBinCount (index) > 0)
+        {
+          bins++;
+        }
+    }
+  WriteInteger (bins, 4);
+  for (uint32_t index = 0; index < histogram.GetNBins (); index++)
+    {
+      uint32_t count = histogram.GetBinCount (index);
+      if (count > 0)
+        {
+          WriteInteger (index, 4);
+          WriteInteger (count, 4);
+        }
+    }
+}
+
+void
+FlowMonitorWriter::Write (FlowId flowId, const FlowMonitor::FlowStats &stats, const FlowTuple *tuple)
+{
+  NS_LOG_FUNCTION (this << flowId);
+  NS_ASSERT_MSG (IsOpen (), "The binary FlowMonitor output is not open");
+  m_record.clear ();
+  WriteInteger (flowId, 4);
+
+  uint8_t family = 0;
+  if (tuple != 0 && Ipv4Address::IsMatchingType (tuple->sourceAddress))
+    {
+      family = 4;
+    }
+  else if (tuple != 0 && Ipv6Address::IsMatchingType (tuple->sourceAddress))
+    {
+      family = 6;
+    }
+  WriteInteger (family, 1);
+  if (family == 4)
+    {
+      uint8_t buf[4];
+      Ipv4Address::ConvertFrom (tuple->sourceAddress).Serialize (buf);
+      m_record.append (reinterpret_cast<const char *> (buf), 4);
+      Ipv4Address::ConvertFrom (tuple->destinationAddress).Serialize (buf);
+      m_record.append (reinterpret_cast<const char *> (buf), 4);
+    }
+  else if (family == 6)
+    {
+      uint8_t buf[16];
+      Ipv6Address::ConvertFrom (tuple->sourceAddress).Serialize (buf);
+      m_record.append (reinterpret_cast<const char *> (buf), 16);
+      Ipv6Address::ConvertFrom (tuple->destinationAddress).Serialize (buf);
+      m_record.append (reinterpret_cast<const char *> (buf), 16);
+    }
+  if (family != 0)
+    {
+      WriteInteger (tuple->protocol, 1);
+      WriteInteger (tuple->sourcePort, 2);
+      WriteInteger (tuple->destinationPort, 2);
+    }
+
+  WriteInteger (stats.timeFirstTxPacket.GetNanoSeconds (), 8);
+  WriteInteger (stats.timeFirstRxPacket.GetNanoSeconds (), 8);
+  WriteInteger (stats.timeLastTxPacket.GetNanoSeconds (), 8);
+  WriteInteger (stats.timeLastRxPacket.GetNanoSeconds (), 8);
+  WriteInteger (stats.delaySum.GetNanoSeconds (), 8);
+  WriteInteger (stats.jitterSum.GetNanoSeconds (), 8);
+  WriteInteger (stats.lastDelay.GetNanoSeconds (), 8);
+  WriteInteger (stats.txBytes, 8);
+  WriteInteger (stats.rxBytes, 8);
+  WriteInteger (stats.txPackets, 4);
+  WriteInteger (stats.rxPackets, 4);
+  WriteInteger (stats.lostPackets, 4);
+  WriteInteger (stats.timesForwarded, 4);
+
+  WriteInteger (stats.packetsDropped.size (), 4);
+  for (uint32_t reasonCode = 0; reasonCode < stats.packetsDropped.size (); reasonCode++)
+    {
+      WriteInteger (stats.packetsDropped[reasonCode], 4);
+      WriteInteger (stats.bytesDropped[reasonCode], 8);
+    }
+
+  if (m_histograms)
+    {
+      WriteHistogram (stats.delayHistogram);
+      WriteHistogram (stats.jitterHistogram);
+      WriteHistogram (stats.packetSizeHistogram);
+      WriteHistogram (stats.flowInterruptionsHistogram);
+    }
+
+  uint32_t length = m_record.size ();
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      m_buffer.push_back (static_cast<char> ((length >> (8 * i)) & 0xff));
+    }
+  m_buffer += m_record;
+  if (m_buffer.size () >= FLOW_MONITOR_BINARY_BUFFER_SIZE)
+    {
+      Flush ();
+    }
+}
+
+void
+FlowMonitorWriter::Flush (void)
+{
+  if (IsOpen () && !m_buffer.empty ())
+    {
+      m_os.write (m_buffer.data (), m_buffer.size ());
+      m_os.flush ();
+      m_buffer.clear ();
+    }
+}
+
+void
+FlowMonitorWriter::Close (void)
+{
+  if (IsOpen ())
+    {
+      NS_LOG_FUNCTION (this);
+      Flush ();
+      m_os.close ();
+    }
+}
+
+
+FlowMonitorReader::FlowMonitorReader (std::string fileName)
+  : m_valid (false),
+    m_histograms (false),
+    m_offset (0)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  m_is.open (fileName.c_str (), std::ios::in | std::ios::binary);
+  char header[12];
+  if (!m_is.read (header, sizeof (header))
+      || std::memcmp (header, FLOW_MONITOR_BINARY_MAGIC, 8) != 0)
+    {
+      NS_LOG_WARN ("Not a binary FlowMonitor file: " << fileName);
+      return;
+    }
+  m_record.assign (header + 8, header + 12);
+  m_offset = 0;
+  uint16_t version = ReadInteger (2);
+  uint16_t flags = ReadInteger (2);
+  if (version != FLOW_MONITOR_BINARY_VERSION)
+    {
+      NS_LOG_WARN ("Unsupported binary FlowMonitor version " << version);
+      return;
+    }
+  m_histograms = (flags & FLOW_MONITOR_BINARY_HISTOGRAMS) != 0;
+  m_valid = true;
+}
+
+bool
+FlowMonitorReader::IsOpen (void) const
+{
+  return m_valid;
+}
+
+bool
+FlowMonitorReader::HasHistograms (void) const
+{
+  return m_histograms;
+}
+
+uint64_t
+FlowMonitorReader::ReadInteger (uint32_t bytes)
+{
+  if (m_offset + bytes > m_record.size ())
+    {
+      m_offset = m_record.size () + 1;
+      return 0;
+    }
+  uint64_t value = 0;
+  for (uint32_t i = 0; i < bytes; i++)
+    {
+      value |= static_cast<uint64_t> (m_record[m_offset + i]) << (8 * i);
+    }
+  m_offset += bytes;
+  return value;
+}
+
+void
+FlowMonitorReader::ReadHistogram (Histogram &histogram)
+{
+  uint64_t bits = ReadInteger (8);
+  double binWidth;
+  std::memcpy (&binWidth, &bits, sizeof (binWidth));
+  histogram = Histogram (binWidth);
+  uint32_t bins = ReadInteger (4);
+  for (uint32_t i = 0; i < bins && m_offset <= m_record.size (); i++)
+    {
+      uint32_t index = ReadInteger (4);
+      for (uint32_t count = ReadInteger (4); count > 0; count--)
+        {
+          histogram.AddValue ((index + 0.5) * binWidth);
+        }
+    }
+}
+
+bool
+FlowMonitorReader::Read (FlowMonitorRecord &record)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_valid)
+    {
+      return false;
+    }
+  uint8_t prefix[4];
+  if (!m_is.read (reinterpret_cast<char *> (prefix), 4))
+    {
+      return false;
+    }
+  uint32_t length = prefix[0] | (prefix[1] << 8) | (prefix[2] << 16) | (static_cast<uint32_t> (prefix[3]) << 24);
+  m_record.resize (length);
+  if (length > 0 && !m_is.read (reinterpret_cast<char *> (&m_record[0]), length))
+    {
+      NS_LOG_WARN ("Truncated binary FlowMonitor record");
+      return false;
+    }
+  m_offset = 0;
+
+  record.flowId = ReadInteger (4);
+  uint8_t family = ReadInteger (1);
+  record.hasTuple = (family == 4 || family == 6) && m_offset + (family == 4 ? 13 : 37) <= length;
+  if (record.hasTuple)
+    {
+      if (family == 4)
+        {
+          record.tuple.sourceAddress = Ipv4Address::Deserialize (&m_record[m_offset]);
+          record.tuple.destinationAddress = Ipv4Address::Deserialize (&m_record[m_offset + 4]);
+          m_offset += 8;
+        }
+      else
+        {
+          record.tuple.sourceAddress = Ipv6Address::Deserialize (&m_record[m_offset]);
+          record.tuple.destinationAddress = Ipv6Address::Deserialize (&m_record[m_offset + 16]);
+          m_offset += 32;
+        }
+      record.tuple.protocol = ReadInteger (1);
+      record.tuple.sourcePort = ReadInteger (2);
+      record.tuple.destinationPort = ReadInteger (2);
+    }
+
+  FlowMonitor::FlowStats &stats = record.stats;
+  stats.timeFirstTxPacket = NanoSeconds (static_cast<int64_t> (ReadInteger (8)));
+  stats.timeFirstRxPacket = NanoSeconds (static_cast<int64_t> (ReadInteger (8)));
+  stats.timeLastTxPacket = NanoSeconds (static_cast<int64_t> (ReadInteger (8)));
+  stats.timeLastRxPacket = NanoSeconds (static_cast<int64_t> (ReadInteger (8)));
+  stats.delaySum = NanoSeconds (static_cast<int64_t> (ReadInteger (8)));
+  stats.jitterSum = NanoSeconds (static_cast<int64_t> (ReadInteger (8)));
+  stats.lastDelay = NanoSeconds (static_cast<int64_t> (ReadInteger (8)));
+  stats.txBytes = ReadInteger (8);
+  stats.rxBytes = ReadInteger (8);
+  stats.txPackets = ReadInteger (4);
+  stats.rxPackets = ReadInteger (4);
+  stats.lostPackets = ReadInteger (4);
+  stats.timesForwarded = ReadInteger (4);
+
+  uint32_t reasons = ReadInteger (4);
+  stats.packetsDropped.clear ();
+  stats.bytesDropped.clear ();
+  for (uint32_t reasonCode = 0; reasonCode < reasons && m_offset <= length; reasonCode++)
+    {
+      stats.packetsDropped.push_back (ReadInteger (4));
+      stats.bytesDropped.push_back (ReadInteger (8));
+    }
+
+  if (m_histograms)
+    {
+      ReadHistogram (stats.delayHistogram);
+      ReadHistogram (stats.jitterHistogram);
+      ReadHistogram (stats.packetSizeHistogram);
+      ReadHistogram (stats.flowInterruptionsHistogram);
+    }
+  else
+    {
+      stats.delayHistogram = Histogram ();
+      stats.jitterHistogram = Histogram ();
+      stats.packetSizeHistogram = Histogram ();
+      stats.flowInterruptionsHistogram = Histogram ();
+    }
+
+  if (m_offset > length)
+    {
+      NS_LOG_WARN ("Malformed binary FlowMonitor record of flow " << record.flowId);
+      return false;
+    }
+  return true;
+}
+
+std::map<FlowId, FlowMonitorRecord>
+FlowMonitorReader::ReadAll (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::map<FlowId, FlowMonitorRecord> flows;
+  FlowMonitorRecord record;
+  while (Read (record))
+    {
+      std::map<FlowId, FlowMonitorRecord>::iterator it = flows.find (record.flowId);
+      if (it == flows.end ())
+        {
+          flows.insert (std::make_pair (record.flowId, record));
+        }
+      else
+        {
+          it->second.Merge (record);
+        }
+    }
+  return flows;
+}
+
+} // namespace ns3
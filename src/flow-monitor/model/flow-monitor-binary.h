@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#ifndef FLOW_MONITOR_BINARY_H
+#define FLOW_MONITOR_BINARY_H
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-classifier.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup flow-monitor
+ * \brief A flow read from the binary output of FlowMonitor
+ */
+struct FlowMonitorRecord
+{
+  FlowId flowId;                //!< Flow identifier
+  bool hasTuple;                //!< Was the flow described by a classifier
+  FlowTuple tuple;              //!< Description of the flow, if hasTuple
+  FlowMonitor::FlowStats stats; //!< Statistics of the flow
+
+  /// Add the statistics of a later record of the same flow, written
+  /// after the flow resumed.  The jitter between the two parts of the
+  /// flow is not accounted for.
+  /// \param other the later record
+  void Merge (const FlowMonitorRecord &other);
+};
+
+/**
+ * \ingroup flow-monitor
+ * \brief Writes flow statistics as length-prefixed binary records
+ *
+ * The file starts with the 8 bytes "NS3FLOWM", a 16-bit version and
+ * 16 bits of flags, bit 0 telling whether the records hold the
+ * histograms.  Each record is a 32-bit length followed by that many
+ * bytes:
+ *
+ * - the flow identifier, on 32 bits;
+ * - the address family of the flow, 4, 6 or 0 if unknown, on 8 bits,
+ *   followed, unless 0, by the source and destination addresses in
+ *   network order, the protocol on 8 bits and the source and
+ *   destination ports on 16 bits;
+ * - timeFirstTxPacket, timeFirstRxPacket, timeLastTxPacket,
+ *   timeLastRxPacket, delaySum, jitterSum and lastDelay in nanoseconds,
+ *   on 64 bits;
+ * - txBytes and rxBytes on 64 bits, txPackets, rxPackets, lostPackets
+ *   and timesForwarded on 32 bits;
+ * - the number of drop reason codes on 32 bits followed, for each
+ *   code, by the packets on 32 bits and the bytes on 64 bits dropped;
+ * - if the histograms are written, the delay, jitter, packet size and
+ *   flow interruptions histograms, each one as its bin width (a 64-bit
+ *   IEEE 754 double), the number of non-empty bins on 32 bits and, for
+ *   each of them, its index and count on 32 bits.
+ *
+ * All the integers are little endian.  Readers must ignore the bytes
+ * of a record following the fields they know, so that fields can be
+ * appended in later versions.  A flow may be written in several
+ * records, which are to be merged, if it resumes after being written
+ * by FlowMonitor::StartBinaryStream.
+ */
+class FlowMonitorWriter
+{
+public:
+  FlowMonitorWriter ();
+  ~FlowMonitorWriter ();
+
+  /// Create the file and write its header
+  /// \param fileName name or path of the file
+  /// \param enableHistograms if true, the records hold the histograms
+  /// \returns false if the file could not be created
+  bool Open (std::string fileName, bool enableHistograms);
+  /// \returns true if the file is open
+  bool IsOpen (void) const;
+  /// Append a record
+  /// \param flowId the identifier of the flow
+  /// \param stats the statistics of the flow
+  /// \param tuple the description of the flow, or 0 if unknown
+  void Write (FlowId flowId, const FlowMonitor::FlowStats &stats, const FlowTuple *tuple);
+  /// Write the buffered records to the file
+  void Flush (void);
+  /// Flush and close the file
+  void Close (void);
+
+private:
+  /// Append a histogram to the record being built
+  /// \param histogram the histogram
+  void WriteHistogram (Histogram histogram);
+  /// Append a little endian integer to the record being built
+  /// \param value the value
+  /// \param bytes the number of bytes of the value
+  void WriteInteger (uint64_t value, uint32_t bytes);
+
+  std::ofstream m_os;     //!< Output file
+  bool m_histograms;      //!< Do the records hold the histograms
+  std::string m_record;   //!< Record being built
+  std::string m_buffer;   //!< Records not written yet
+};
+
+/**
+ * \ingroup flow-monitor
+ * \brief Reads the flows written by FlowMonitorWriter
+ *
+ * The records are read one at a time, so that files holding more flows
+ * than fit in memory can be processed:
+ *
+ * \code
+ *   FlowMonitorReader reader ("flows.bin");
+ *   FlowMonitorRecord record;
+ *   while (reader.Read (record))
+ *     {
+ *       Time fct = record.stats.timeLastRxPacket - record.stats.timeFirstTxPacket;
+ *     }
+ * \endcode
+ */
+class FlowMonitorReader
+{
+public:
+  /// Open a file and read its header
+  /// \param fileName name or path of the file
+  FlowMonitorReader (std::string fileName);
+
+  /// \returns true if the file was opened and has a valid header
+  bool IsOpen (void) const;
+  /// \returns true if the records hold the histograms
+  bool HasHistograms (void) const;
+  /// Read the next record
+  /// \param record the record to fill
+  /// \returns false at the end of the file or on a truncated record
+  bool Read (FlowMonitorRecord &record);
+  /// Read the remaining records, merging the records of the same flow
+  /// \returns the flows, by identifier
+  std::map<FlowId, FlowMonitorRecord> ReadAll (void);
+
+private:
+  /// Read a little endian integer from the current record
+  /// \param bytes the number of bytes of the integer
+  /// \returns the integer, or 0 past the end of the record
+  uint64_t ReadInteger (uint32_t bytes);
+  /// Read a histogram from the current record
+  /// \param histogram the histogram to fill
+  void ReadHistogram (Histogram &histogram);
+
+  std::ifstream m_is;             //!< Input file
+  bool m_valid;                   //!< Has the file a valid header
+  bool m_histograms;              //!< Do the records hold the histograms
+  std::vector<uint8_t> m_record;  //!< Current record
+  uint32_t m_offset;              //!< Read offset in the current record
+};
+
+} // namespace ns3
+
+#endif /* FLOW_MONITOR_BINARY_H */
@@ -19,11 +19,15 @@
 //
 
 #include "flow-monitor.h"
+#include "flow-monitor-binary.h"
 #include "ns3/simulator.h"
+#include "ns3/simulator-impl.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
 #include "ns3/double.h"
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 
 #define PERIODIC_CHECK_INTERVAL (Seconds (1))
 
@@ -80,9 +84,22 @@ FlowMonitor::GetInstanceTypeId (void) const
 }
 
 FlowMonitor::FlowMonitor ()
-  : m_enabled (false)
+  : m_enabled (false),
+    m_binaryStream (0)
 {
   NS_LOG_FUNCTION (this);
+  m_multithreaded = Simulator::GetImplementation ()->GetInstanceTypeId ().GetName ()
+    == "ns3::MultithreadedSimulatorImpl";
+}
+
+std::unique_lock<std::mutex>
+FlowMonitor::Lock ()
+{
+  if (m_multithreaded)
+    {
+      return std::unique_lock<std::mutex> (m_mutex);
+    }
+  return std::unique_lock<std::mutex> ();
 }
 
 void
@@ -91,6 +108,10 @@ FlowMonitor::DoDispose (void)
   NS_LOG_FUNCTION (this);
   Simulator::Cancel (m_startEvent);
   Simulator::Cancel (m_stopEvent);
+  if (m_binaryStream != 0)
+    {
+      StopBinaryStream ();
+    }
   for (std::list<Ptr<FlowClassifier> >::iterator iter = m_classifiers.begin ();
       iter != m_classifiers.end ();
       iter ++)
@@ -145,6 +166,7 @@ FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t pack
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
+  std::unique_lock<std::mutex> lock = Lock ();
   Time now = Simulator::Now ();
   TrackedPacket &tracked = m_trackedPackets[std::make_pair (flowId, packetId)];
   tracked.firstSeenTime = now;
@@ -175,6 +197,7 @@ FlowMonitor::ReportForwarding (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t p
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
+  std::unique_lock<std::mutex> lock = Lock ();
   std::pair<FlowId, FlowPacketId> key (flowId, packetId);
   TrackedPacketMap::iterator tracked = m_trackedPackets.find (key);
   if (tracked == m_trackedPackets.end ())
@@ -201,6 +224,7 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
+  std::unique_lock<std::mutex> lock = Lock ();
   TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
   if (tracked == m_trackedPackets.end ())
     {
@@ -267,6 +291,7 @@ FlowMonitor::ReportDrop (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetI
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
+  std::unique_lock<std::mutex> lock = Lock ();
 
   probe->AddPacketDropStats (flowId, packetSize, reasonCode);
 
@@ -528,5 +553,128 @@ FlowMonitor::SerializeToXmlFile (std::string fileName, bool enableHistograms, bo
 }
 
 
-} // namespace ns3
+void
+FlowMonitor::WriteBinaryFlow (FlowMonitorWriter &writer, FlowId flowId, const FlowStats &stats) const
+{
+  FlowTuple tuple;
+  for (std::list<Ptr<FlowClassifier> >::const_iterator iter = m_classifiers.begin ();
+       iter != m_classifiers.end ();
+       iter++)
+    {
+      if ((*iter)->GetFlowTuple (flowId, tuple))
+        {
+          writer.Write (flowId, stats, &tuple);
+          return;
+        }
+    }
+  writer.Write (flowId, stats, 0);
+}
+
+void
+FlowMonitor::SerializeToBinaryFile (std::string fileName, bool enableHistograms)
+{
+  NS_LOG_FUNCTION (this << fileName << enableHistograms);
+  CheckForLostPackets ();
+  FlowMonitorWriter writer;
+  if (!writer.Open (fileName, enableHistograms))
+    {
+      NS_LOG_ERROR ("Can not create " << fileName);
+      return;
+    }
+  for (FlowStatsContainerCI flowI = m_flowStats.begin ();
+       flowI != m_flowStats.end (); flowI++)
+    {
+      WriteBinaryFlow (writer, flowI->first, flowI->second);
+    }
+  writer.Close ();
+}
+
+void
+FlowMonitor::StartBinaryStream (std::string fileName, Time interval, bool enableHistograms)
+{
+  NS_LOG_FUNCTION (this << fileName << interval.As (Time::S) << enableHistograms);
+  NS_ABORT_MSG_IF (!interval.IsStrictlyPositive (), "The binary stream needs a positive interval");
+  if (m_binaryStream != 0)
+    {
+      StopBinaryStream ();
+    }
+  m_binaryStream = new FlowMonitorWriter ();
+  if (!m_binaryStream->Open (fileName, enableHistograms))
+    {
+      NS_LOG_ERROR ("Can not create " << fileName);
+      delete m_binaryStream;
+      m_binaryStream = 0;
+      return;
+    }
+  m_binaryStreamInterval = interval;
+  m_binaryStreamEvent = Simulator::Schedule (interval, &FlowMonitor::PeriodicWriteBinaryStream, this);
+}
 
+void
+FlowMonitor::PeriodicWriteBinaryStream ()
+{
+  NS_LOG_FUNCTION (this);
+  CheckForLostPackets ();
+
+  // The tracked packets are sorted by flow, so that the flows with
+  // packets in flight are found in one pass.
+  std::vector<FlowId> inFlight;
+  for (TrackedPacketMap::const_iterator iter = m_trackedPackets.begin ();
+       iter != m_trackedPackets.end (); iter++)
+    {
+      if (inFlight.empty () || inFlight.back () != iter->first.first)
+        {
+          inFlight.push_back (iter->first.first);
+        }
+    }
+
+  Time now = Simulator::Now ();
+  uint32_t written = 0;
+  for (FlowStatsContainerI flowI = m_flowStats.begin (); flowI != m_flowStats.end (); )
+    {
+      Time lastSeen = std::max (flowI->second.timeLastTxPacket, flowI->second.timeLastRxPacket);
+      if (now - lastSeen >= m_binaryStreamInterval
+          && !std::binary_search (inFlight.begin (), inFlight.end (), flowI->first))
+        {
+          WriteBinaryFlow (*m_binaryStream, flowI->first, flowI->second);
+          for (uint32_t i = 0; i < m_flowProbes.size (); i++)
+            {
+              m_flowProbes[i]->RemoveFlowStats (flowI->first);
+            }
+          m_flowStats.erase (flowI++);
+          written++;
+        }
+      else
+        {
+          flowI++;
+        }
+    }
+  m_binaryStream->Flush ();
+  NS_LOG_DEBUG ("Wrote " << written << " completed flows, " << m_flowStats.size () << " remaining");
+
+  m_binaryStreamEvent = Simulator::Schedule (m_binaryStreamInterval, &FlowMonitor::PeriodicWriteBinaryStream, this);
+}
+
+void
+FlowMonitor::StopBinaryStream (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_binaryStream == 0)
+    {
+      NS_LOG_DEBUG ("No binary stream; returning");
+      return;
+    }
+  Simulator::Cancel (m_binaryStreamEvent);
+  CheckForLostPackets ();
+  for (FlowStatsContainerCI flowI = m_flowStats.begin ();
+       flowI != m_flowStats.end (); flowI++)
+    {
+      WriteBinaryFlow (*m_binaryStream, flowI->first, flowI->second);
+    }
+  m_binaryStream->Close ();
+  delete m_binaryStream;
+  m_binaryStream = 0;
+}
+
+
+} // namespace ns3
@@ -23,6 +23,7 @@
 
 #include <vector>
 #include <map>
+#include <mutex>
 
 #include "ns3/ptr.h"
 #include "ns3/object.h"
@@ -34,6 +35,8 @@
 
 namespace ns3 {
 
+class FlowMonitorWriter;
+
 /**
  * \defgroup flow-monitor Flow Monitor
  * \brief  Collect and store performance data from a simulation
@@ -258,6 +261,33 @@ public:
   /// \param enableProbes if true, include also the per-probe/flow pair statistics in the output
   void SerializeToXmlFile (std::string fileName, bool enableHistograms, bool enableProbes);
 
+  /// Writes the statistics of the flows to a file in the compact
+  /// binary format described in FlowMonitorWriter, which can be read
+  /// with FlowMonitorReader
+  /// \param fileName name or path of the output file that will be created
+  /// \param enableHistograms if true, include also the histograms in the output
+  void SerializeToBinaryFile (std::string fileName, bool enableHistograms);
+
+  /// Streams the statistics of the completed flows to a binary file
+  /// during the simulation.  Every interval, the flows without packets
+  /// in flight which have not sent nor received packets for at least
+  /// that interval are written to the file and removed from the
+  /// statistics returned by GetFlowStats() and from the statistics of
+  /// the probes.  The classifiers still keep the five-tuple of every
+  /// flow, so that a flow resuming later keeps its identifier: it is
+  /// written again in another record, which FlowMonitorReader::ReadAll
+  /// merges.
+  /// \param fileName name or path of the output file that will be created
+  /// \param interval the interval between two writes, and the idle time
+  /// after which a flow is considered completed
+  /// \param enableHistograms if true, include also the histograms in the output
+  void StartBinaryStream (std::string fileName, Time interval, bool enableHistograms);
+
+  /// Writes the statistics of the flows not written yet to the binary
+  /// stream and closes it.  These flows remain available through
+  /// GetFlowStats().
+  void StopBinaryStream (void);
+
 
 protected:
 
@@ -294,6 +324,16 @@ private:
   double m_packetSizeBinWidth;  //!< packet size bin width (for histograms)
   double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
   Time m_flowInterruptionsMinTime; //!< Flow interruptions minimum time
+  std::mutex m_mutex;       //!< Serializes the reports of the probes
+  bool m_multithreaded;     //!< Do several threads report packets
+  FlowMonitorWriter *m_binaryStream; //!< Binary output of the completed flows
+  Time m_binaryStreamInterval; //!< Interval between two writes to the binary stream
+  EventId m_binaryStreamEvent; //!< Next write to the binary stream
+
+  /// Lock the monitor if the probes may report from several threads,
+  /// i.e., if the simulator implementation is ns3::MultithreadedSimulatorImpl.
+  /// \returns a lock held until it goes out of scope, or an empty lock
+  std::unique_lock<std::mutex> Lock ();
 
   /// Get the stats for a given flow
   /// \param flowId the Flow identification
@@ -302,6 +342,15 @@ private:
 
   /// Periodic function to check for lost packets and prune statistics
   void PeriodicCheckForLostPackets ();
+
+  /// Write the statistics of a flow to a binary output
+  /// \param writer the binary output
+  /// \param flowId the Flow identification
+  /// \param stats the stats of the flow
+  void WriteBinaryFlow (FlowMonitorWriter &writer, FlowId flowId, const FlowStats &stats) const;
+
+  /// Periodic function writing the completed flows to the binary stream
+  void PeriodicWriteBinaryStream ();
 };
 
 
@@ -31,6 +31,9 @@ namespace ns3 {
 const uint8_t TCP_PROT_NUMBER = 6;  //!< TCP Protocol number
 const uint8_t UDP_PROT_NUMBER = 17; //!< UDP Protocol number
 
+/// Initial number of slots of the flow lookup table
+const uint32_t INITIAL_SLOTS = 64;
+
 
 
 bool operator < (const Ipv4FlowClassifier::FiveTuple &t1,
@@ -98,6 +101,46 @@ bool operator == (const Ipv4FlowClassifier::FiveTuple &t1,
 
 Ipv4FlowClassifier::Ipv4FlowClassifier ()
 {
+  Slot empty = { 0, 0 };
+  m_slots.resize (INITIAL_SLOTS, empty);
+}
+
+uint32_t
+Ipv4FlowClassifier::Hash (const FiveTuple &tuple)
+{
+  uint64_t h = (static_cast<uint64_t> (tuple.sourceAddress.Get ()) << 32)
+    | tuple.destinationAddress.Get ();
+  h ^= ((static_cast<uint64_t> (tuple.sourcePort) << 24)
+        | (static_cast<uint64_t> (tuple.destinationPort) << 8)
+        | tuple.protocol) * 0x9e3779b97f4a7c15ULL;
+  // MurmurHash3 finalizer, mixing every input bit into the high bits
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return static_cast<uint32_t> (h);
+}
+
+void
+Ipv4FlowClassifier::Grow (void)
+{
+  Slot empty = { 0, 0 };
+  std::vector<Slot> slots (m_slots.size () * 2, empty);
+  uint32_t mask = slots.size () - 1;
+  for (std::vector<Slot>::const_iterator i = m_slots.begin (); i != m_slots.end (); i++)
+    {
+      if (i->flowId != 0)
+        {
+          uint32_t index = i->hash & mask;
+          while (slots[index].flowId != 0)
+            {
+              index = (index + 1) & mask;
+            }
+          slots[index] = *i;
+        }
+    }
+  m_slots.swap (slots);
 }
 
 bool
@@ -147,36 +190,64 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
   tuple.sourcePort = srcPort;
   tuple.destinationPort = dstPort;
 
-  // try to insert the tuple, but check if it already exists
-  std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert
-    = m_flowMap.insert (std::pair<FiveTuple, FlowId> (tuple, 0));
+  std::unique_lock<std::mutex> lock = Lock ();
+
+  uint32_t hash = Hash (tuple);
+  uint32_t mask = m_slots.size () - 1;
+  uint32_t index = hash & mask;
+  FlowId flowId = 0;
+  while (m_slots[index].flowId != 0)
+    {
+      if (m_slots[index].hash == hash && m_flows[m_slots[index].flowId - 1].tuple == tuple)
+        {
+          flowId = m_slots[index].flowId;
+          break;
+        }
+      index = (index + 1) & mask;
+    }
 
-  // if the insertion succeeded, we need to assign this tuple a new flow identifier
-  if (insert.second)
+  FlowState *flow;
+  if (flowId == 0)
     {
-      FlowId newFlowId = GetNewFlowId ();
-      insert.first->second = newFlowId;
-      m_flowPktIdMap[newFlowId] = 0;
-      m_flowDscpMap[newFlowId];
+      // a new tuple: assign it a new flow identifier
+      flowId = GetNewFlowId ();
+      NS_ASSERT (flowId == m_flows.size () + 1);
+      m_slots[index].hash = hash;
+      m_slots[index].flowId = flowId;
+      m_flows.push_back (FlowState ());
+      flow = &m_flows.back ();
+      flow->tuple = tuple;
+      flow->lastPacketId = 0;
+      // keep the table at most half full, so that the probe sequences stay short
+      if (m_flows.size () * 2 > m_slots.size ())
+        {
+          Grow ();
+        }
     }
   else
     {
-      m_flowPktIdMap[insert.first->second] ++;
+      flow = &m_flows[flowId - 1];
+      flow->lastPacketId++;
     }
 
   // increment the counter of packets with the same DSCP value
   Ipv4Header::DscpType dscp = ipHeader.GetDscp ();
-  std::pair<std::map<Ipv4Header::DscpType, uint32_t>::iterator, bool> dscpInserter
-    = m_flowDscpMap[insert.first->second].insert (std::pair<Ipv4Header::DscpType, uint32_t> (dscp, 1));
-
-  // if the insertion did not succeed, we need to increment the counter
-  if (!dscpInserter.second)
+  std::vector<std::pair<Ipv4Header::DscpType, uint32_t> >::iterator i = flow->dscpCounts.begin ();
+  while (i != flow->dscpCounts.end () && i->first < dscp)
+    {
+      i++;
+    }
+  if (i != flow->dscpCounts.end () && i->first == dscp)
+    {
+      i->second++;
+    }
+  else
     {
-      m_flowDscpMap[insert.first->second][dscp] ++;
+      flow->dscpCounts.insert (i, std::make_pair (dscp, 1));
     }
 
-  *out_flowId = insert.first->second;
-  *out_packetId = m_flowPktIdMap[*out_flowId];
+  *out_flowId = flowId;
+  *out_packetId = flow->lastPacketId;
 
   return true;
 }
@@ -185,17 +256,27 @@ Ipv4FlowClassifier::Classify (const Ipv4Header &ipHeader, Ptr<const Packet> ipPa
 Ipv4FlowClassifier::FiveTuple
 Ipv4FlowClassifier::FindFlow (FlowId flowId) const
 {
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  if (flowId == 0 || flowId > m_flows.size ())
     {
-      if (iter->second == flowId)
-        {
-          return iter->first;
-        }
+      NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
     }
-  NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
-  FiveTuple retval = { Ipv4Address::GetZero (), Ipv4Address::GetZero (), 0, 0, 0 };
-  return retval;
+  return m_flows[flowId - 1].tuple;
+}
+
+bool
+Ipv4FlowClassifier::GetFlowTuple (FlowId flowId, FlowTuple &tuple) const
+{
+  if (flowId == 0 || flowId > m_flows.size ())
+    {
+      return false;
+    }
+  const FiveTuple &fiveTuple = m_flows[flowId - 1].tuple;
+  tuple.sourceAddress = fiveTuple.sourceAddress;
+  tuple.destinationAddress = fiveTuple.destinationAddress;
+  tuple.protocol = fiveTuple.protocol;
+  tuple.sourcePort = fiveTuple.sourcePort;
+  tuple.destinationPort = fiveTuple.destinationPort;
+  return true;
 }
 
 bool
@@ -208,15 +289,12 @@ Ipv4FlowClassifier::SortByCount::operator() (std::pair<Ipv4Header::DscpType, uin
 std::vector<std::pair<Ipv4Header::DscpType, uint32_t> >
 Ipv4FlowClassifier::GetDscpCounts (FlowId flowId) const
 {
-  std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> >::const_iterator flow
-    = m_flowDscpMap.find (flowId);
-
-  if (flow == m_flowDscpMap.end ())
+  if (flowId == 0 || flowId > m_flows.size ())
     {
       NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
     }
 
-  std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > v (flow->second.begin (), flow->second.end ());
+  std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > v = m_flows[flowId - 1].dscpCounts;
   std::sort (v.begin (), v.end (), SortByCount ());
   return v;
 }
@@ -227,29 +305,24 @@ Ipv4FlowClassifier::SerializeToXmlStream (std::ostream &os, uint16_t indent) con
   Indent (os, indent); os << "<Ipv4FlowClassifier>\n";
 
   indent += 2;
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  for (uint32_t flowId = 1; flowId <= m_flows.size (); flowId++)
     {
+      const FlowState &flow = m_flows[flowId - 1];
       Indent (os, indent);
-      os << "<Flow flowId=\"" << iter->second << "\""
-         << " sourceAddress=\"" << iter->first.sourceAddress << "\""
-         << " destinationAddress=\"" << iter->first.destinationAddress << "\""
-         << " protocol=\"" << int(iter->first.protocol) << "\""
-         << " sourcePort=\"" << iter->first.sourcePort << "\""
-         << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
+      os << "<Flow flowId=\"" << flowId << "\""
+         << " sourceAddress=\"" << flow.tuple.sourceAddress << "\""
+         << " destinationAddress=\"" << flow.tuple.destinationAddress << "\""
+         << " protocol=\"" << int(flow.tuple.protocol) << "\""
+         << " sourcePort=\"" << flow.tuple.sourcePort << "\""
+         << " destinationPort=\"" << flow.tuple.destinationPort << "\">\n";
 
       indent += 2;
-      std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> >::const_iterator flow
-        = m_flowDscpMap.find (iter->second);
-
-      if (flow != m_flowDscpMap.end ())
+      for (std::vector<std::pair<Ipv4Header::DscpType, uint32_t> >::const_iterator i = flow.dscpCounts.begin ();
+           i != flow.dscpCounts.end (); i++)
         {
-          for (std::map<Ipv4Header::DscpType, uint32_t>::const_iterator i = flow->second.begin (); i != flow->second.end (); i++)
-            {
-              Indent (os, indent);
-              os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t> (i->first) << "\""
-                 << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+          Indent (os, indent);
+          os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t> (i->first) << "\""
+             << " packets=\"" << std::dec << i->second << "\" />\n";
         }
 
       indent -= 2;
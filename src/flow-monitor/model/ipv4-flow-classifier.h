@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 #include <map>
+#include <vector>
 
 #include "ns3/ipv4-header.h"
 #include "ns3/flow-classifier.h"
@@ -89,15 +90,39 @@ public:
   std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > GetDscpCounts (FlowId flowId) const;
 
   virtual void SerializeToXmlStream (std::ostream &os, uint16_t indent) const;
+  virtual bool GetFlowTuple (FlowId flowId, FlowTuple &tuple) const;
 
 private:
 
-  /// Map to Flows Identifiers to FlowIds
-  std::map<FiveTuple, FlowId> m_flowMap;
-  /// Map to FlowIds to FlowPacketId
-  std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-  /// Map FlowIds to (DSCP value, packet count) pairs
-  std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> > m_flowDscpMap;
+  /// State of a flow
+  struct FlowState
+  {
+    FiveTuple tuple;            //!< Five-tuple of the flow
+    FlowPacketId lastPacketId;  //!< Identifier of the last packet of the flow
+    /// (DSCP value, packet count) pairs, sorted by DSCP value
+    std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > dscpCounts;
+  };
+
+  /// Slot of the flow lookup table
+  struct Slot
+  {
+    uint32_t hash;  //!< Hash of the five-tuple of the flow
+    FlowId flowId;  //!< Flow of the slot, 0 if the slot is empty
+  };
+
+  /// Hash a five-tuple
+  /// \param tuple the five-tuple
+  /// \returns the hash of the five-tuple
+  static uint32_t Hash (const FiveTuple &tuple);
+
+  /// Double the size of the lookup table
+  void Grow (void);
+
+  /// State of each flow, indexed by FlowId - 1
+  std::vector<FlowState> m_flows;
+  /// Open-addressing table of the flows, probed linearly from the hash
+  /// of the five-tuple; its size is a power of two
+  std::vector<Slot> m_slots;
 
 };
 
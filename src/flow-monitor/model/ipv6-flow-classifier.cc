@@ -148,6 +148,8 @@ Ipv6FlowClassifier::Classify (const Ipv6Header &ipHeader, Ptr<const Packet> ipPa
   tuple.sourcePort = srcPort;
   tuple.destinationPort = dstPort;
 
+  std::unique_lock<std::mutex> lock = Lock ();
+
   // try to insert the tuple, but check if it already exists
   std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert
     = m_flowMap.insert (std::pair<FiveTuple, FlowId> (tuple, 0));
@@ -157,6 +159,8 @@ Ipv6FlowClassifier::Classify (const Ipv6Header &ipHeader, Ptr<const Packet> ipPa
     {
       FlowId newFlowId = GetNewFlowId ();
       insert.first->second = newFlowId;
+      NS_ASSERT (newFlowId == m_flowTuples.size () + 1);
+      m_flowTuples.push_back (tuple);
       m_flowPktIdMap[newFlowId] = 0;
       m_flowDscpMap[newFlowId];
     }
@@ -186,17 +190,27 @@ Ipv6FlowClassifier::Classify (const Ipv6Header &ipHeader, Ptr<const Packet> ipPa
 Ipv6FlowClassifier::FiveTuple
 Ipv6FlowClassifier::FindFlow (FlowId flowId) const
 {
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  if (flowId == 0 || flowId > m_flowTuples.size ())
     {
-      if (iter->second == flowId)
-        {
-          return iter->first;
-        }
+      NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
+    }
+  return m_flowTuples[flowId - 1];
+}
+
+bool
+Ipv6FlowClassifier::GetFlowTuple (FlowId flowId, FlowTuple &tuple) const
+{
+  if (flowId == 0 || flowId > m_flowTuples.size ())
+    {
+      return false;
     }
-  NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
-  FiveTuple retval = { Ipv6Address::GetZero (), Ipv6Address::GetZero (), 0, 0, 0 };
-  return retval;
+  const FiveTuple &fiveTuple = m_flowTuples[flowId - 1];
+  tuple.sourceAddress = fiveTuple.sourceAddress;
+  tuple.destinationAddress = fiveTuple.destinationAddress;
+  tuple.protocol = fiveTuple.protocol;
+  tuple.sourcePort = fiveTuple.sourcePort;
+  tuple.destinationPort = fiveTuple.destinationPort;
+  return true;
 }
 
 bool
@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include <map>
+#include <vector>
 
 #include "ns3/ipv6-header.h"
 #include "ns3/flow-classifier.h"
@@ -90,11 +91,14 @@ public:
   std::vector<std::pair<Ipv6Header::DscpType, uint32_t> > GetDscpCounts (FlowId flowId) const;
 
   virtual void SerializeToXmlStream (std::ostream &os, uint16_t indent) const;
+  virtual bool GetFlowTuple (FlowId flowId, FlowTuple &tuple) const;
 
 private:
 
   /// Map to Flows Identifiers to FlowIds
   std::map<FiveTuple, FlowId> m_flowMap;
+  /// FiveTuple of each flow, indexed by FlowId - 1
+  std::vector<FiveTuple> m_flowTuples;
   /// Map to FlowIds to FlowPacketId
   std::map<FlowId, FlowPacketId> m_flowPktIdMap;
   /// Map FlowIds to (DSCP value, packet count) pairs
@@ -0,0 +1,323 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include <fstream>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/flow-classifier.h"
+#include "ns3/flow-monitor-binary.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup flow-monitor
+ * \defgroup flow-monitor-test Flow Monitor module tests
+ */
+
+namespace {
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * Classifier describing flow N as 10.0.0.1:1000+N -> 10.0.0.2:80 over TCP.
+ */
+class TestFlowClassifier : public FlowClassifier
+{
+public:
+  virtual void SerializeToXmlStream (std::ostream &os, uint16_t indent) const
+  {
+  }
+  virtual bool GetFlowTuple (FlowId flowId, FlowTuple &tuple) const
+  {
+    tuple.sourceAddress = Ipv4Address ("10.0.0.1");
+    tuple.destinationAddress = Ipv4Address ("10.0.0.2");
+    tuple.protocol = 6;
+    tuple.sourcePort = 1000 + flowId;
+    tuple.destinationPort = 80;
+    return true;
+  }
+};
+
+/**
+ * \ingroup flow-monitor-test
+ *
+ * Probe reporting the packets scheduled by the tests.
+ */
+class TestFlowProbe : public FlowProbe
+{
+public:
+  /// \param monitor the monitor to report to
+  TestFlowProbe (Ptr<FlowMonitor> monitor)
+    : FlowProbe (monitor)
+  {
+  }
+};
+
+/**
+ * \param flowId the flow identifier
+ * \returns statistics with a distinct value in each field
+ */
+FlowMonitor::FlowStats
+MakeStats (FlowId flowId)
+{
+  FlowMonitor::FlowStats stats;
+  stats.timeFirstTxPacket = NanoSeconds (1000 * flowId + 1);
+  stats.timeFirstRxPacket = NanoSeconds (1000 * flowId + 2);
+  stats.timeLastTxPacket = NanoSeconds (1000 * flowId + 3);
+  stats.timeLastRxPacket = NanoSeconds (1000 * flowId + 4);
+  stats.delaySum = NanoSeconds (5);
+  stats.jitterSum = NanoSeconds (6);
+  stats.lastDelay = NanoSeconds (7);
+  stats.txBytes = 0x100000000ULL + flowId;
+  stats.rxBytes = 9;
+  stats.txPackets = 10;
+  stats.rxPackets = 11;
+  stats.lostPackets = 12;
+  stats.timesForwarded = 13;
+  stats.packetsDropped.resize (3, 0);
+  stats.bytesDropped.resize (3, 0);
+  stats.packetsDropped[2] = 14;
+  stats.bytesDropped[2] = 15;
+  stats.delayHistogram.SetDefaultBinWidth (0.001);
+  stats.delayHistogram.AddValue (0.0105);
+  stats.delayHistogram.AddValue (0.0105);
+  stats.jitterHistogram.SetDefaultBinWidth (0.001);
+  stats.packetSizeHistogram.SetDefaultBinWidth (20);
+  stats.packetSizeHistogram.AddValue (1500);
+  stats.flowInterruptionsHistogram.SetDefaultBinWidth (0.25);
+  return stats;
+}
+
+} // unnamed namespace
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Write flow records and read them back.
+ */
+class FlowMonitorBinaryRoundTripTestCase : public TestCase
+{
+public:
+  FlowMonitorBinaryRoundTripTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+FlowMonitorBinaryRoundTripTestCase::FlowMonitorBinaryRoundTripTestCase ()
+  : TestCase ("Write and read back flow records")
+{
+}
+
+void
+FlowMonitorBinaryRoundTripTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("flows.bin");
+  FlowMonitorWriter writer;
+  NS_TEST_ASSERT_MSG_EQ (writer.Open (fileName, true), true, "Can not create " << fileName);
+  FlowTuple tuple4;
+  tuple4.sourceAddress = Ipv4Address ("10.1.2.3");
+  tuple4.destinationAddress = Ipv4Address ("10.4.5.6");
+  tuple4.protocol = 17;
+  tuple4.sourcePort = 49153;
+  tuple4.destinationPort = 5001;
+  FlowTuple tuple6;
+  tuple6.sourceAddress = Ipv6Address ("2001:db8::1");
+  tuple6.destinationAddress = Ipv6Address ("2001:db8::2");
+  tuple6.protocol = 6;
+  tuple6.sourcePort = 1;
+  tuple6.destinationPort = 2;
+  writer.Write (1, MakeStats (1), &tuple4);
+  writer.Write (2, MakeStats (2), &tuple6);
+  writer.Write (3, MakeStats (3), 0);
+  writer.Close ();
+
+  FlowMonitorReader reader (fileName);
+  NS_TEST_ASSERT_MSG_EQ (reader.IsOpen (), true, "Invalid header");
+  NS_TEST_ASSERT_MSG_EQ (reader.HasHistograms (), true, "Histograms not flagged");
+  FlowMonitorRecord record;
+  for (FlowId flowId = 1; flowId <= 3; flowId++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (reader.Read (record), true, "Missing record " << flowId);
+      NS_TEST_ASSERT_MSG_EQ (record.flowId, flowId, "Wrong flow id");
+      FlowMonitor::FlowStats &stats = record.stats;
+      NS_TEST_ASSERT_MSG_EQ (stats.timeFirstTxPacket, NanoSeconds (1000 * flowId + 1), "Wrong timeFirstTxPacket");
+      NS_TEST_ASSERT_MSG_EQ (stats.timeFirstRxPacket, NanoSeconds (1000 * flowId + 2), "Wrong timeFirstRxPacket");
+      NS_TEST_ASSERT_MSG_EQ (stats.timeLastTxPacket, NanoSeconds (1000 * flowId + 3), "Wrong timeLastTxPacket");
+      NS_TEST_ASSERT_MSG_EQ (stats.timeLastRxPacket, NanoSeconds (1000 * flowId + 4), "Wrong timeLastRxPacket");
+      NS_TEST_ASSERT_MSG_EQ (stats.delaySum, NanoSeconds (5), "Wrong delaySum");
+      NS_TEST_ASSERT_MSG_EQ (stats.jitterSum, NanoSeconds (6), "Wrong jitterSum");
+      NS_TEST_ASSERT_MSG_EQ (stats.lastDelay, NanoSeconds (7), "Wrong lastDelay");
+      NS_TEST_ASSERT_MSG_EQ (stats.txBytes, 0x100000000ULL + flowId, "Wrong txBytes");
+      NS_TEST_ASSERT_MSG_EQ (stats.rxBytes, 9, "Wrong rxBytes");
+      NS_TEST_ASSERT_MSG_EQ (stats.txPackets, 10, "Wrong txPackets");
+      NS_TEST_ASSERT_MSG_EQ (stats.rxPackets, 11, "Wrong rxPackets");
+      NS_TEST_ASSERT_MSG_EQ (stats.lostPackets, 12, "Wrong lostPackets");
+      NS_TEST_ASSERT_MSG_EQ (stats.timesForwarded, 13, "Wrong timesForwarded");
+      NS_TEST_ASSERT_MSG_EQ (stats.packetsDropped.size (), 3, "Wrong drop reasons");
+      NS_TEST_ASSERT_MSG_EQ (stats.packetsDropped[2], 14, "Wrong packetsDropped");
+      NS_TEST_ASSERT_MSG_EQ (stats.bytesDropped[2], 15, "Wrong bytesDropped");
+      NS_TEST_ASSERT_MSG_EQ (stats.delayHistogram.GetNBins (), 11, "Wrong delay histogram");
+      NS_TEST_ASSERT_MSG_EQ (stats.delayHistogram.GetBinCount (10), 2, "Wrong delay histogram");
+      NS_TEST_ASSERT_MSG_EQ (stats.jitterHistogram.GetNBins (), 0, "Wrong jitter histogram");
+      NS_TEST_ASSERT_MSG_EQ (stats.packetSizeHistogram.GetBinCount (75), 1, "Wrong size histogram");
+      NS_TEST_ASSERT_MSG_EQ (stats.flowInterruptionsHistogram.GetBinWidth (0), 0.25, "Wrong bin width");
+      NS_TEST_ASSERT_MSG_EQ (record.hasTuple, (flowId != 3), "Wrong tuple presence");
+    }
+  NS_TEST_ASSERT_MSG_EQ (reader.Read (record), false, "Unexpected record");
+
+  FlowMonitorReader reader2 (fileName);
+  NS_TEST_ASSERT_MSG_EQ (reader2.Read (record), true, "Missing record");
+  NS_TEST_ASSERT_MSG_EQ (Ipv4Address::ConvertFrom (record.tuple.sourceAddress), Ipv4Address ("10.1.2.3"), "Wrong source");
+  NS_TEST_ASSERT_MSG_EQ (Ipv4Address::ConvertFrom (record.tuple.destinationAddress), Ipv4Address ("10.4.5.6"), "Wrong destination");
+  NS_TEST_ASSERT_MSG_EQ (uint32_t (record.tuple.protocol), 17, "Wrong protocol");
+  NS_TEST_ASSERT_MSG_EQ (record.tuple.sourcePort, 49153, "Wrong source port");
+  NS_TEST_ASSERT_MSG_EQ (record.tuple.destinationPort, 5001, "Wrong destination port");
+  NS_TEST_ASSERT_MSG_EQ (reader2.Read (record), true, "Missing record");
+  NS_TEST_ASSERT_MSG_EQ (Ipv6Address::ConvertFrom (record.tuple.destinationAddress), Ipv6Address ("2001:db8::2"), "Wrong destination");
+
+  // A record cut short by the end of the file is not returned.
+  std::ifstream in (fileName.c_str (), std::ios::binary);
+  std::string content ((std::istreambuf_iterator<char> (in)), std::istreambuf_iterator<char> ());
+  in.close ();
+  std::ofstream out (fileName.c_str (), std::ios::binary | std::ios::trunc);
+  out.write (content.data (), content.size () - 10);
+  out.close ();
+  FlowMonitorReader truncated (fileName);
+  NS_TEST_ASSERT_MSG_EQ (truncated.ReadAll ().size (), 2, "Truncated record returned");
+
+  FlowMonitorReader invalid (CreateTempDirFilename ("missing.bin"));
+  NS_TEST_ASSERT_MSG_EQ (invalid.IsOpen (), false, "Missing file opened");
+  NS_TEST_ASSERT_MSG_EQ (invalid.Read (record), false, "Record read from a missing file");
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Stream the completed flows during a simulation.
+ */
+class FlowMonitorBinaryStreamTestCase : public TestCase
+{
+public:
+  FlowMonitorBinaryStreamTestCase ();
+private:
+  virtual void DoRun (void);
+  /// Check the number of flows held by the monitor and by its probe
+  /// \param expected the expected number of flows
+  void CheckFlows (uint32_t expected);
+
+  Ptr<FlowMonitor> m_monitor; //!< Monitor under test
+  Ptr<FlowProbe> m_probe;     //!< Probe reporting the packets
+};
+
+FlowMonitorBinaryStreamTestCase::FlowMonitorBinaryStreamTestCase ()
+  : TestCase ("Stream the completed flows")
+{
+}
+
+void
+FlowMonitorBinaryStreamTestCase::CheckFlows (uint32_t expected)
+{
+  NS_TEST_EXPECT_MSG_EQ (m_monitor->GetFlowStats ().size (), expected,
+                         "Wrong number of flows held at " << Simulator::Now ().As (Time::S));
+  NS_TEST_EXPECT_MSG_EQ (m_probe->GetStats ().size (), expected,
+                         "Wrong number of flows held by the probe at " << Simulator::Now ().As (Time::S));
+}
+
+void
+FlowMonitorBinaryStreamTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("stream.bin");
+  m_monitor = CreateObject<FlowMonitor> ();
+  m_monitor->AddFlowClassifier (Create<TestFlowClassifier> ());
+  m_probe = CreateObject<TestFlowProbe> (m_monitor);
+  Ptr<FlowProbe> probe = m_probe;
+  m_monitor->StartRightNow ();
+  m_monitor->StartBinaryStream (fileName, MilliSeconds (100), false);
+
+  // Flow 1 completes at 11 ms.
+  Simulator::Schedule (MilliSeconds (10), &FlowMonitor::ReportFirstTx, m_monitor, probe, 1, 0, 100);
+  Simulator::Schedule (MilliSeconds (11), &FlowMonitor::ReportLastRx, m_monitor, probe, 1, 0, 100);
+  // Flow 2 is idle from 50 ms to 300 ms.
+  Simulator::Schedule (MilliSeconds (10), &FlowMonitor::ReportFirstTx, m_monitor, probe, 2, 0, 200);
+  Simulator::Schedule (MilliSeconds (50), &FlowMonitor::ReportLastRx, m_monitor, probe, 2, 0, 200);
+  Simulator::Schedule (MilliSeconds (300), &FlowMonitor::ReportFirstTx, m_monitor, probe, 2, 1, 200);
+  Simulator::Schedule (MilliSeconds (301), &FlowMonitor::ReportLastRx, m_monitor, probe, 2, 1, 200);
+  // Flow 3 has a packet in flight until the end.
+  Simulator::Schedule (MilliSeconds (100), &FlowMonitor::ReportFirstTx, m_monitor, probe, 3, 0, 300);
+
+  Simulator::Schedule (MilliSeconds (150), &FlowMonitorBinaryStreamTestCase::CheckFlows, this, 3);
+  Simulator::Schedule (MilliSeconds (250), &FlowMonitorBinaryStreamTestCase::CheckFlows, this, 1);
+  Simulator::Schedule (MilliSeconds (350), &FlowMonitorBinaryStreamTestCase::CheckFlows, this, 2);
+  Simulator::Stop (MilliSeconds (450));
+  Simulator::Run ();
+  m_monitor->StopBinaryStream ();
+  NS_TEST_ASSERT_MSG_EQ (m_monitor->GetFlowStats ().size (), 2, "Unwritten flows dropped");
+
+  FlowMonitorReader reader (fileName);
+  NS_TEST_ASSERT_MSG_EQ (reader.HasHistograms (), false, "Histograms flagged");
+  FlowMonitorRecord record;
+  uint32_t records = 0;
+  while (reader.Read (record))
+    {
+      records++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (records, 4, "Flow 2 not written twice");
+
+  FlowMonitorReader merged (fileName);
+  std::map<FlowId, FlowMonitorRecord> flows = merged.ReadAll ();
+  NS_TEST_ASSERT_MSG_EQ (flows.size (), 3, "Wrong number of flows");
+  NS_TEST_ASSERT_MSG_EQ (flows[1].stats.timeLastRxPacket, MilliSeconds (11), "Wrong flow 1");
+  NS_TEST_ASSERT_MSG_EQ (flows[2].stats.txPackets, 2, "Wrong flow 2 packets");
+  NS_TEST_ASSERT_MSG_EQ (flows[2].stats.rxBytes, 400, "Wrong flow 2 bytes");
+  NS_TEST_ASSERT_MSG_EQ (flows[2].stats.timeFirstTxPacket, MilliSeconds (10), "Wrong flow 2 start");
+  NS_TEST_ASSERT_MSG_EQ (flows[2].stats.timeLastRxPacket, MilliSeconds (301), "Wrong flow 2 end");
+  NS_TEST_ASSERT_MSG_EQ (flows[2].tuple.sourcePort, 1002, "Wrong flow 2 tuple");
+  NS_TEST_ASSERT_MSG_EQ (flows[3].stats.txPackets, 1, "Wrong flow 3 packets");
+  NS_TEST_ASSERT_MSG_EQ (flows[3].stats.rxPackets, 0, "Wrong flow 3 packets");
+
+  m_monitor->Dispose ();
+  m_monitor = 0;
+  m_probe = 0;
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Binary FlowMonitor output TestSuite
+ */
+class FlowMonitorBinaryTestSuite : public TestSuite
+{
+public:
+  FlowMonitorBinaryTestSuite ();
+};
+
+FlowMonitorBinaryTestSuite::FlowMonitorBinaryTestSuite ()
+  : TestSuite ("flow-monitor-binary", UNIT)
+{
+  AddTestCase (new FlowMonitorBinaryRoundTripTestCase, TestCase::QUICK);
+  AddTestCase (new FlowMonitorBinaryStreamTestCase, TestCase::QUICK);
+}
+
+static FlowMonitorBinaryTestSuite g_flowMonitorBinaryTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "ns3/test.h"
+#include "ns3/packet.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/udp-header.h"
+#include "ns3/ipv4-flow-classifier.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Ipv4FlowClassifier identifies the flows of many tuples.
+ */
+class Ipv4FlowClassifierTestCase : public TestCase
+{
+public:
+  Ipv4FlowClassifierTestCase ();
+private:
+  virtual void DoRun (void);
+  /// Classify a UDP packet
+  /// \param classifier the classifier
+  /// \param source the source address
+  /// \param sourcePort the source port
+  /// \param dscp the DSCP value
+  /// \param flowId the flow identifier, filled
+  /// \param packetId the packet identifier, filled
+  /// \returns true if the packet was classified
+  bool Classify (Ipv4FlowClassifier &classifier, Ipv4Address source, uint16_t sourcePort,
+                 Ipv4Header::DscpType dscp, FlowId *flowId, FlowPacketId *packetId);
+};
+
+Ipv4FlowClassifierTestCase::Ipv4FlowClassifierTestCase ()
+  : TestCase ("Classify the packets of many flows")
+{
+}
+
+bool
+Ipv4FlowClassifierTestCase::Classify (Ipv4FlowClassifier &classifier, Ipv4Address source,
+                                      uint16_t sourcePort, Ipv4Header::DscpType dscp,
+                                      FlowId *flowId, FlowPacketId *packetId)
+{
+  Ipv4Header ipHeader;
+  ipHeader.SetSource (source);
+  ipHeader.SetDestination (Ipv4Address ("10.0.0.1"));
+  ipHeader.SetProtocol (17);
+  ipHeader.SetDscp (dscp);
+  UdpHeader udpHeader;
+  udpHeader.SetSourcePort (sourcePort);
+  udpHeader.SetDestinationPort (9);
+  Ptr<Packet> payload = Create<Packet> (100);
+  payload->AddHeader (udpHeader);
+  return classifier.Classify (ipHeader, payload, flowId, packetId);
+}
+
+void
+Ipv4FlowClassifierTestCase::DoRun (void)
+{
+  Ipv4FlowClassifier classifier;
+  const uint32_t flows = 3000;
+  FlowId flowId;
+  FlowPacketId packetId;
+
+  // Enough flows to grow the lookup table several times.
+  for (uint32_t i = 0; i < flows; i++)
+    {
+      Ipv4Address source (0x0a010000 + i / 7);
+      NS_TEST_ASSERT_MSG_EQ (Classify (classifier, source, 1000 + i % 7, Ipv4Header::DscpDefault,
+                                       &flowId, &packetId), true, "Packet not classified");
+      NS_TEST_ASSERT_MSG_EQ (flowId, i + 1, "Wrong identifier for a new flow");
+      NS_TEST_ASSERT_MSG_EQ (packetId, 0, "Wrong identifier for the first packet");
+    }
+  for (uint32_t i = 0; i < flows; i++)
+    {
+      Ipv4Address source (0x0a010000 + i / 7);
+      Classify (classifier, source, 1000 + i % 7, Ipv4Header::DSCP_EF, &flowId, &packetId);
+      NS_TEST_ASSERT_MSG_EQ (flowId, i + 1, "Wrong identifier for a known flow");
+      NS_TEST_ASSERT_MSG_EQ (packetId, 1, "Wrong identifier for the second packet");
+      Ipv4FlowClassifier::FiveTuple tuple = classifier.FindFlow (flowId);
+      NS_TEST_ASSERT_MSG_EQ (tuple.sourceAddress, source, "Wrong source address");
+      NS_TEST_ASSERT_MSG_EQ (tuple.sourcePort, 1000 + i % 7, "Wrong source port");
+    }
+
+  Classify (classifier, Ipv4Address (0x0a010000), 1000, Ipv4Header::DSCP_EF, &flowId, &packetId);
+  NS_TEST_ASSERT_MSG_EQ (flowId, 1, "Wrong identifier for a known flow");
+  NS_TEST_ASSERT_MSG_EQ (packetId, 2, "Wrong identifier for the third packet");
+  std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > dscp = classifier.GetDscpCounts (1);
+  NS_TEST_ASSERT_MSG_EQ (dscp.size (), 2, "Wrong number of DSCP values");
+  NS_TEST_ASSERT_MSG_EQ (dscp[0].first, Ipv4Header::DSCP_EF, "Wrong most frequent DSCP value");
+  NS_TEST_ASSERT_MSG_EQ (dscp[0].second, 2, "Wrong DSCP count");
+  NS_TEST_ASSERT_MSG_EQ (dscp[1].second, 1, "Wrong DSCP count");
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Ipv4FlowClassifier TestSuite
+ */
+class Ipv4FlowClassifierTestSuite : public TestSuite
+{
+public:
+  Ipv4FlowClassifierTestSuite ();
+};
+
+Ipv4FlowClassifierTestSuite::Ipv4FlowClassifierTestSuite ()
+  : TestSuite ("ipv4-flow-classifier", UNIT)
+{
+  AddTestCase (new Ipv4FlowClassifierTestCase, TestCase::QUICK);
+}
+
+static Ipv4FlowClassifierTestSuite g_ipv4FlowClassifierTestSuite; //!< Static variable for test initialization
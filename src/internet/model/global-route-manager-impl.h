@@ -27,6 +27,7 @@
 #include <queue>
 #include <map>
 #include <vector>
+#include <unordered_map>
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 #include "ns3/ipv4-address.h"
@@ -38,6 +39,8 @@ const uint32_t SPF_INFINITY = 0xffffffff; //!< "infinite" distance between nodes
 
 class CandidateQueue;
 class Ipv4GlobalRouting;
+class Ipv4;
+class Node;
 
 /**
  * \ingroup globalrouting
@@ -708,6 +711,18 @@ private:
  * and finally configure each of the node's forwarding tables.
  *
  * The design is guided by OSPFv2 \RFC{2328} section 16.1.1 and quagga ospfd.
+ *
+ * The SPF calculations of the different roots are independent: each one only
+ * reads the LSDB and only writes to the forwarding table of its root.  When
+ * the "GlobalRoutingThreads" global value is not 1, InitializeRoutes ()
+ * spreads the roots over that many threads, each running its calculations
+ * in a worker GlobalRouteManagerImpl that shares (and does not copy) the
+ * LSDB and keeps its own SPF state.  The resulting routes are identical to
+ * those of the sequential computation.  Logging of this component should be
+ * disabled in that mode, since the threads would interleave their output.
+ *
+ * The wall-clock time spent building the LSDB, running the SPF calculations
+ * and compiling the forwarding tables is reported at the LOG_INFO level.
  */
 class GlobalRouteManagerImpl
 {
@@ -766,8 +781,65 @@ private:
  */
   GlobalRouteManagerImpl& operator= (GlobalRouteManagerImpl& srmi);
 
+/**
+ * @brief Construct a worker sharing the LSDB of another instance.
+ *
+ * The LSDB is not copied and is not deleted by the worker.
+ *
+ * @param lsdb the Link State DataBase to use
+ */
+  GlobalRouteManagerImpl (GlobalRouteManagerLSDB* lsdb);
+
+/**
+ * @brief A router for which routes are to be computed.
+ *
+ * The node objects are looked up once, before the SPF calculations, so that
+ * the calculation does not walk the node list for every vertex and does not
+ * touch any node other than its root.
+ */
+  struct SPFRoot
+  {
+    Ipv4Address m_routerId;           //!< router ID of the root
+    Ptr<Node> m_node;                 //!< node of the root
+    Ptr<Ipv4> m_ipv4;                 //!< Ipv4 of the root
+    Ptr<Ipv4GlobalRouting> m_routing; //!< global routing of the root
+  };
+
+/**
+ * @brief Find the node objects of the router with a given router ID.
+ * @param root the router ID
+ * @return the root description; its node is null if the router is not found
+ */
+  SPFRoot FindSPFRoot (Ipv4Address root) const;
+
+/**
+ * @brief Run the SPF calculation for every root in m_roots.
+ *
+ * This is the body of the worker threads.
+ */
+  void SPFCalculateRoots (void);
+
+/**
+ * @brief Get the SPF status of an LSA in the current calculation.
+ * @param lsa the LSA
+ * @return the status
+ */
+  GlobalRoutingLSA::SPFStatus GetLSAStatus (GlobalRoutingLSA* lsa) const;
+
+/**
+ * @brief Set the SPF status of an LSA in the current calculation.
+ * @param lsa the LSA
+ * @param status the status
+ */
+  void SetLSAStatus (GlobalRoutingLSA* lsa, GlobalRoutingLSA::SPFStatus status);
+
   SPFVertex* m_spfroot; //!< the root node
   GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+  bool m_ownsLsdb; //!< true if m_lsdb is deleted with this object
+  SPFRoot m_root; //!< the node objects of the root of the current calculation
+  std::vector<SPFRoot> m_roots; //!< roots to be processed by SPFCalculateRoots
+  /// SPF status of the LSAs in the current calculation; absent means not explored
+  std::unordered_map<GlobalRoutingLSA*, GlobalRoutingLSA::SPFStatus> m_lsaStatus;
 
   /**
    * \brief Test if a node is a stub, from an OSPF sense.
@@ -789,6 +861,13 @@ private:
    */
   void SPFCalculate (Ipv4Address root);
 
+/**
+ * @brief Calculate the shortest path first (SPF) tree for a root whose
+ * node objects are already known.
+ * @param root the root and its node objects
+ */
+  void SPFCalculate (const SPFRoot &root);
+
   /**
    * \brief Process Stub nodes
    *
@@ -17,6 +17,7 @@
 //
 
 #include <vector>
+#include <algorithm>
 #include <iomanip>
 #include "ns3/names.h"
 #include "ns3/log.h"
@@ -27,6 +28,9 @@
 #include "ns3/ipv4-route.h"
 #include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/uinteger.h"
+#include "ns3/hash.h"
 #include "ns3/node.h"
 #include "ipv4-global-routing.h"
 #include "global-route-manager.h"
@@ -53,13 +57,40 @@ Ipv4GlobalRouting::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&Ipv4GlobalRouting::m_respondToInterfaceEvents),
                    MakeBooleanChecker ())
+    .AddAttribute ("EcmpMode",
+                   "How a route is selected among equal-cost routes: PerPacket (first route, "
+                   "or random if RandomEcmpRouting is set), PerFlow (5-tuple hash) or Flowlet",
+                   EnumValue (ECMP_PER_PACKET),
+                   MakeEnumAccessor (&Ipv4GlobalRouting::m_ecmpMode),
+                   MakeEnumChecker (ECMP_PER_PACKET, "PerPacket",
+                                    ECMP_PER_FLOW, "PerFlow",
+                                    ECMP_FLOWLET, "Flowlet"))
+    .AddAttribute ("EcmpSalt",
+                   "Salt mixed with the node id into the per-flow ECMP hash",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&Ipv4GlobalRouting::SetEcmpSalt,
+                                         &Ipv4GlobalRouting::GetEcmpSalt),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("FlowletTimeout",
+                   "Idle time after which a flow may be moved to another route in Flowlet mode",
+                   TimeValue (MicroSeconds (100)),
+                   MakeTimeAccessor (&Ipv4GlobalRouting::m_flowletTimeout),
+                   MakeTimeChecker ())
   ;
   return tid;
 }
 
+const std::size_t Ipv4GlobalRouting::FLOWLET_SWEEP_MIN;
+
 Ipv4GlobalRouting::Ipv4GlobalRouting () 
   : m_randomEcmpRouting (false),
-    m_respondToInterfaceEvents (false)
+    m_respondToInterfaceEvents (false),
+    m_ecmpMode (ECMP_PER_PACKET),
+    m_ecmpSalt (0),
+    m_nodeSalt (0),
+    m_nodeSaltSet (false),
+    m_flowletSweepSize (FLOWLET_SWEEP_MIN),
+    m_forwardingTableValid (false)
 {
   NS_LOG_FUNCTION (this);
 
@@ -80,6 +111,7 @@ Ipv4GlobalRouting::AddHostRouteTo (Ipv4Address dest,
   Ipv4RoutingTableEntry *route = new Ipv4RoutingTableEntry ();
   *route = Ipv4RoutingTableEntry::CreateHostRouteTo (dest, nextHop, interface);
   m_hostRoutes.push_back (route);
+  m_forwardingTableValid = false;
 }
 
 void 
@@ -90,6 +122,7 @@ Ipv4GlobalRouting::AddHostRouteTo (Ipv4Address dest,
   Ipv4RoutingTableEntry *route = new Ipv4RoutingTableEntry ();
   *route = Ipv4RoutingTableEntry::CreateHostRouteTo (dest, interface);
   m_hostRoutes.push_back (route);
+  m_forwardingTableValid = false;
 }
 
 void 
@@ -105,6 +138,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo (Ipv4Address network,
                                                         nextHop,
                                                         interface);
   m_networkRoutes.push_back (route);
+  m_forwardingTableValid = false;
 }
 
 void 
@@ -118,6 +152,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo (Ipv4Address network,
                                                         networkMask,
                                                         interface);
   m_networkRoutes.push_back (route);
+  m_forwardingTableValid = false;
 }
 
 void 
@@ -136,11 +171,271 @@ Ipv4GlobalRouting::AddASExternalRouteTo (Ipv4Address network,
 }
 
 
+uint32_t
+Ipv4GlobalRouting::GetFlowHash (Ptr<const Packet> p, const Ipv4Header &header)
+{
+  NS_LOG_FUNCTION (this << p << header);
+  if (!m_nodeSaltSet)
+    {
+      Ptr<Node> node = m_ipv4->GetObject<Node> ();
+      m_nodeSalt = m_ecmpSalt ^ (node ? node->GetId () * 2654435761U : 0);
+      m_nodeSaltSet = true;
+    }
+
+  // src (4) | dst (4) | protocol (1) | ports (4) | salt (4)
+  uint8_t key[17];
+  header.GetSource ().Serialize (key);
+  header.GetDestination ().Serialize (key + 4);
+  key[8] = header.GetProtocol ();
+  key[9] = key[10] = key[11] = key[12] = 0;
+  if (p != 0 && header.GetFragmentOffset () == 0
+      && (header.GetProtocol () == 6 || header.GetProtocol () == 17)
+      && p->GetSize () >= 4)
+    {
+      // TCP and UDP both start with the source and destination ports
+      p->CopyData (key + 9, 4);
+    }
+  key[13] = (m_nodeSalt >> 24) & 0xff;
+  key[14] = (m_nodeSalt >> 16) & 0xff;
+  key[15] = (m_nodeSalt >> 8) & 0xff;
+  key[16] = m_nodeSalt & 0xff;
+  return Hash32 (reinterpret_cast<char *> (key), sizeof (key));
+}
+
+void
+Ipv4GlobalRouting::EvictIdleFlowlets (void)
+{
+  NS_LOG_FUNCTION (this);
+  Time now = Simulator::Now ();
+  for (std::unordered_map<uint32_t, Flowlet>::iterator it = m_flowlets.begin ();
+       it != m_flowlets.end (); )
+    {
+      if (now - it->second.m_lastSeen > m_flowletTimeout)
+        {
+          it = m_flowlets.erase (it);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+  // sweep again when the table has doubled, so that each insertion
+  // costs O(1) amortized
+  m_flowletSweepSize = std::max<std::size_t> (2 * m_flowlets.size (), FLOWLET_SWEEP_MIN);
+  NS_LOG_LOGIC (m_flowlets.size () << " active flowlets, next sweep at " << m_flowletSweepSize);
+}
+
+void
+Ipv4GlobalRouting::SetEcmpSalt (uint32_t salt)
+{
+  NS_LOG_FUNCTION (this << salt);
+  m_ecmpSalt = salt;
+  m_nodeSaltSet = false;
+}
+
+uint32_t
+Ipv4GlobalRouting::GetEcmpSalt (void) const
+{
+  return m_ecmpSalt;
+}
+
+uint32_t
+Ipv4GlobalRouting::GetNFlowlets (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_flowlets.size ();
+}
+
+uint32_t
+Ipv4GlobalRouting::SelectEcmpRoute (uint32_t nRoutes, uint32_t flowHash)
+{
+  NS_LOG_FUNCTION (this << nRoutes << flowHash);
+  if (nRoutes == 1)
+    {
+      return 0;
+    }
+  switch (m_ecmpMode)
+    {
+    case ECMP_PER_FLOW:
+      return flowHash % nRoutes;
+    case ECMP_FLOWLET:
+      {
+        Time now = Simulator::Now ();
+        std::unordered_map<uint32_t, Flowlet>::iterator it = m_flowlets.find (flowHash);
+        if (it == m_flowlets.end ())
+          {
+            if (m_flowlets.size () >= m_flowletSweepSize)
+              {
+                EvictIdleFlowlets ();
+              }
+            Flowlet flowlet;
+            flowlet.m_lastSeen = now;
+            flowlet.m_routeIndex = flowHash % nRoutes;
+            m_flowlets[flowHash] = flowlet;
+            return flowlet.m_routeIndex;
+          }
+        if (now - it->second.m_lastSeen > m_flowletTimeout
+            || it->second.m_routeIndex >= nRoutes)
+          {
+            it->second.m_routeIndex = m_rand->GetInteger (0, nRoutes - 1);
+            NS_LOG_LOGIC ("New flowlet for flow " << flowHash << " on route " << it->second.m_routeIndex);
+          }
+        it->second.m_lastSeen = now;
+        return it->second.m_routeIndex;
+      }
+    case ECMP_PER_PACKET:
+    default:
+      // pick up one of the routes uniformly at random if random
+      // ECMP routing is enabled, or always select the first route
+      // consistently if random ECMP routing is disabled
+      if (m_randomEcmpRouting)
+        {
+          return m_rand->GetInteger (0, nRoutes - 1);
+        }
+      return 0;
+    }
+}
+
 Ptr<Ipv4Route>
-Ipv4GlobalRouting::LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif)
+Ipv4GlobalRouting::MakeRoute (const Ipv4RoutingTableEntry *route) const
+{
+  Ptr<Ipv4Route> rtentry = Create<Ipv4Route> ();
+  rtentry->SetDestination (route->GetDest ());
+  /// \todo handle multi-address case
+  if (m_ipv4->GetNAddresses (route->GetInterface ()) > 0)
+    {
+      rtentry->SetSource (m_ipv4->GetAddress (route->GetInterface (), 0).GetLocal ());
+    }
+  rtentry->SetGateway (route->GetGateway ());
+  uint32_t interfaceIdx = route->GetInterface ();
+  rtentry->SetOutputDevice (m_ipv4->GetNetDevice (interfaceIdx));
+  return rtentry;
+}
+
+void
+Ipv4GlobalRouting::BuildForwardingTable (void)
 {
-  NS_LOG_FUNCTION (this << dest << oif);
+  NS_LOG_FUNCTION (this);
+  m_hostTable.clear ();
+  m_networkTable.clear ();
+
+  for (HostRoutesCI i = m_hostRoutes.begin (); i != m_hostRoutes.end (); i++)
+    {
+      NS_ASSERT ((*i)->IsHost ());
+      m_hostTable[(*i)->GetDest ().Get ()].m_routes.push_back (MakeRoute (*i));
+    }
+
+  // One table per prefix length in use, longest first
+  std::vector<uint16_t> lengths;
+  for (NetworkRoutesCI j = m_networkRoutes.begin (); j != m_networkRoutes.end (); j++)
+    {
+      lengths.push_back ((*j)->GetDestNetworkMask ().GetPrefixLength ());
+    }
+  std::sort (lengths.begin (), lengths.end (), std::greater<uint16_t> ());
+  lengths.erase (std::unique (lengths.begin (), lengths.end ()), lengths.end ());
+  for (std::vector<uint16_t>::const_iterator l = lengths.begin (); l != lengths.end (); l++)
+    {
+      PrefixTable table;
+      table.m_mask = *l == 0 ? 0 : ~0U << (32 - *l);
+      m_networkTable.push_back (table);
+    }
+
+  // Create one group per distinct network prefix
+  for (NetworkRoutesCI j = m_networkRoutes.begin (); j != m_networkRoutes.end (); j++)
+    {
+      uint32_t mask = (*j)->GetDestNetworkMask ().Get ();
+      for (std::vector<PrefixTable>::iterator t = m_networkTable.begin (); t != m_networkTable.end (); t++)
+        {
+          if (t->m_mask == mask)
+            {
+              t->m_groups[(*j)->GetDestNetwork ().Get () & mask];
+              break;
+            }
+        }
+    }
+
+  // Sorted group prefixes of each table, so that the groups covered by a
+  // shorter route are found by a range search instead of a scan
+  std::vector<std::vector<uint32_t> > keys (m_networkTable.size ());
+  for (uint32_t i = 0; i < m_networkTable.size (); i++)
+    {
+      keys[i].reserve (m_networkTable[i].m_groups.size ());
+      for (std::unordered_map<uint32_t, RouteGroup>::const_iterator g = m_networkTable[i].m_groups.begin ();
+           g != m_networkTable[i].m_groups.end (); g++)
+        {
+          keys[i].push_back (g->first);
+        }
+      std::sort (keys[i].begin (), keys[i].end ());
+    }
+
+  // A destination matching a group matches every route covering the group
+  // prefix, so each route is added, in table order, to all the groups it
+  // covers.  This reproduces the set of routes a linear scan would find.
+  for (NetworkRoutesCI j = m_networkRoutes.begin (); j != m_networkRoutes.end (); j++)
+    {
+      uint32_t mask = (*j)->GetDestNetworkMask ().Get ();
+      uint32_t network = (*j)->GetDestNetwork ().Get () & mask;
+      Ptr<Ipv4Route> rtentry = MakeRoute (*j);
+      for (uint32_t i = 0; i < m_networkTable.size (); i++)
+        {
+          PrefixTable &table = m_networkTable[i];
+          if (table.m_mask == mask)
+            {
+              // the route's own group; tables are sorted, so done
+              table.m_groups.find (network)->second.m_routes.push_back (rtentry);
+              break;
+            }
+          // longer prefix than the route: the covered groups are the
+          // contiguous range of the prefixes starting with its network
+          for (std::vector<uint32_t>::const_iterator k = std::lower_bound (keys[i].begin (), keys[i].end (), network);
+               k != keys[i].end () && (*k & mask) == network; k++)
+            {
+              table.m_groups.find (*k)->second.m_routes.push_back (rtentry);
+            }
+        }
+    }
+  m_forwardingTableValid = true;
+}
+
+const Ipv4GlobalRouting::RouteGroup *
+Ipv4GlobalRouting::FindRouteGroup (Ipv4Address dest)
+{
+  if (!m_forwardingTableValid)
+    {
+      BuildForwardingTable ();
+    }
+  uint32_t addr = dest.Get ();
+  std::unordered_map<uint32_t, RouteGroup>::const_iterator h = m_hostTable.find (addr);
+  if (h != m_hostTable.end ())
+    {
+      return &h->second;
+    }
+  for (std::vector<PrefixTable>::const_iterator t = m_networkTable.begin (); t != m_networkTable.end (); t++)
+    {
+      std::unordered_map<uint32_t, RouteGroup>::const_iterator g = t->m_groups.find (addr & t->m_mask);
+      if (g != t->m_groups.end ())
+        {
+          return &g->second;
+        }
+    }
+  return 0;
+}
+
+Ptr<Ipv4Route>
+Ipv4GlobalRouting::LookupGlobal (Ipv4Address dest, uint32_t flowHash, Ptr<NetDevice> oif)
+{
+  NS_LOG_FUNCTION (this << dest << flowHash << oif);
   NS_LOG_LOGIC ("Looking for route for destination " << dest);
+  if (oif == 0)
+    {
+      const RouteGroup *group = FindRouteGroup (dest);
+      if (group != 0)
+        {
+          NS_LOG_LOGIC ("Found " << group->m_routes.size () << " compiled routes");
+          return group->m_routes[SelectEcmpRoute (group->m_routes.size (), flowHash)];
+        }
+    }
+  // Requested output interface, or external routes: scan the route lists
   Ptr<Ipv4Route> rtentry = 0;
   // store all available routes that bring packets to their destination
   typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
@@ -216,27 +511,10 @@ Ipv4GlobalRouting::LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif)
     }
   if (allRoutes.size () > 0 ) // if route(s) is found
     {
-      // pick up one of the routes uniformly at random if random
-      // ECMP routing is enabled, or always select the first route
-      // consistently if random ECMP routing is disabled
-      uint32_t selectIndex;
-      if (m_randomEcmpRouting)
-        {
-          selectIndex = m_rand->GetInteger (0, allRoutes.size ()-1);
-        }
-      else 
-        {
-          selectIndex = 0;
-        }
+      uint32_t selectIndex = SelectEcmpRoute (allRoutes.size (), flowHash);
       Ipv4RoutingTableEntry* route = allRoutes.at (selectIndex); 
       // create a Ipv4Route object from the selected routing table entry
-      rtentry = Create<Ipv4Route> ();
-      rtentry->SetDestination (route->GetDest ());
-      /// \todo handle multi-address case
-      rtentry->SetSource (m_ipv4->GetAddress (route->GetInterface (), 0).GetLocal ());
-      rtentry->SetGateway (route->GetGateway ());
-      uint32_t interfaceIdx = route->GetInterface ();
-      rtentry->SetOutputDevice (m_ipv4->GetNetDevice (interfaceIdx));
+      rtentry = MakeRoute (route);
       return rtentry;
     }
   else 
@@ -321,6 +599,7 @@ Ipv4GlobalRouting::RemoveRoute (uint32_t index)
               NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_hostRoutes.size ());
               delete *i;
               m_hostRoutes.erase (i);
+              m_forwardingTableValid = false;
               NS_LOG_LOGIC ("Done removing host route " << index << "; host route remaining size = " << m_hostRoutes.size ());
               return;
             }
@@ -338,6 +617,7 @@ Ipv4GlobalRouting::RemoveRoute (uint32_t index)
           NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_networkRoutes.size ());
           delete *j;
           m_networkRoutes.erase (j);
+          m_forwardingTableValid = false;
           NS_LOG_LOGIC ("Done removing network route " << index << "; network route remaining size = " << m_networkRoutes.size ());
           return;
         }
@@ -374,6 +654,11 @@ void
 Ipv4GlobalRouting::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
+  m_flowlets.clear ();
+  m_flowletSweepSize = FLOWLET_SWEEP_MIN;
+  m_hostTable.clear ();
+  m_networkTable.clear ();
+  m_forwardingTableValid = false;
   for (HostRoutesI i = m_hostRoutes.begin (); 
        i != m_hostRoutes.end (); 
        i = m_hostRoutes.erase (i)) 
@@ -475,7 +760,8 @@ Ipv4GlobalRouting::RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<Net
 // See if this is a unicast packet we have a route for.
 //
   NS_LOG_LOGIC ("Unicast destination- looking up");
-  Ptr<Ipv4Route> rtentry = LookupGlobal (header.GetDestination (), oif);
+  uint32_t flowHash = m_ecmpMode == ECMP_PER_PACKET ? 0 : GetFlowHash (p, header);
+  Ptr<Ipv4Route> rtentry = LookupGlobal (header.GetDestination (), flowHash, oif);
   if (rtentry)
     {
       sockerr = Socket::ERROR_NOTERROR;
@@ -524,7 +810,8 @@ Ipv4GlobalRouting::RouteInput  (Ptr<const Packet> p, const Ipv4Header &header, P
     }
   // Next, try to find a route
   NS_LOG_LOGIC ("Unicast destination- looking up global route");
-  Ptr<Ipv4Route> rtentry = LookupGlobal (header.GetDestination ());
+  uint32_t flowHash = m_ecmpMode == ECMP_PER_PACKET ? 0 : GetFlowHash (p, header);
+  Ptr<Ipv4Route> rtentry = LookupGlobal (header.GetDestination (), flowHash);
   if (rtentry != 0)
     {
       NS_LOG_LOGIC ("Found unicast destination- calling unicast callback");
@@ -566,6 +853,8 @@ void
 Ipv4GlobalRouting::NotifyAddAddress (uint32_t interface, Ipv4InterfaceAddress address)
 {
   NS_LOG_FUNCTION (this << interface << address);
+  // the compiled routes cache the source address
+  m_forwardingTableValid = false;
   if (m_respondToInterfaceEvents && Simulator::Now ().GetSeconds () > 0)  // avoid startup events
     {
       GlobalRouteManager::DeleteGlobalRoutes ();
@@ -578,6 +867,8 @@ void
 Ipv4GlobalRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress address)
 {
   NS_LOG_FUNCTION (this << interface << address);
+  // the compiled routes cache the source address
+  m_forwardingTableValid = false;
   if (m_respondToInterfaceEvents && Simulator::Now ().GetSeconds () > 0)  // avoid startup events
     {
       GlobalRouteManager::DeleteGlobalRoutes ();
@@ -21,6 +21,8 @@
 #define IPV4_GLOBAL_ROUTING_H
 
 #include <list>
+#include <vector>
+#include <unordered_map>
 #include <stdint.h>
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv4-header.h"
@@ -28,6 +30,7 @@
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/nstime.h"
 
 namespace ns3 {
 
@@ -65,6 +68,19 @@ class Node;
  *
  * This class deals with Ipv4 unicast routes only.
  *
+ * When several equal-cost routes lead to a destination, the route is
+ * chosen according to the EcmpMode attribute:
+ *
+ * - PerPacket: the legacy behaviour; either the first route is always
+ *   used, or, if RandomEcmpRouting is true, a route is drawn at random for
+ *   every packet (which reorders TCP segments).
+ * - PerFlow: the route is selected by hashing the 5-tuple of the packet
+ *   together with a per-node salt, so that all packets of a transport flow
+ *   follow the same path and different switches do not polarize onto the
+ *   same choice.
+ * - Flowlet: like PerFlow, but a flow is allowed to move to a new, randomly
+ *   drawn route whenever it has been idle for longer than FlowletTimeout.
+ *
  * \see Ipv4RoutingProtocol
  * \see GlobalRouteManager
  */
@@ -76,6 +92,17 @@ public:
    * \return the object TypeId
    */
   static TypeId GetTypeId (void);
+
+  /**
+   * \brief How a route is chosen among equal-cost routes
+   */
+  enum EcmpMode
+  {
+    ECMP_PER_PACKET,    //!< First route, or random per packet (RandomEcmpRouting)
+    ECMP_PER_FLOW,      //!< Hash of the 5-tuple and the node salt
+    ECMP_FLOWLET        //!< Per-flow, re-drawn after an idle gap
+  };
+
   /**
    * \brief Construct an empty Ipv4GlobalRouting routing protocol,
    *
@@ -218,6 +245,37 @@ public:
    */
   void RemoveRoute (uint32_t i);
 
+  /**
+   * \brief Compile the host and network routes into the forwarding table.
+   *
+   * Unicast lookups without a requested output interface do not scan the
+   * route lists.  Host routes are indexed by destination, and network routes
+   * by prefix length and masked destination; each index entry holds the
+   * group of equal-cost routes to use, with the Ipv4Route objects already
+   * built, so that a lookup does not allocate.  A network group also holds
+   * the shorter-prefix routes covering it, which keeps the result identical
+   * to scanning the whole table.
+   *
+   * The table is marked stale whenever a route or an address is added or
+   * removed, and is rebuilt on the next lookup; GlobalRouteManager calls
+   * this method once the routes have been computed so that the first
+   * packets do not pay for it.
+   *
+   * The Ipv4Route objects returned for compiled routes are shared and must
+   * not be modified by the caller.
+   */
+  void BuildForwardingTable (void);
+
+  /**
+   * \brief Get the number of flows in the flowlet table.
+   *
+   * In Flowlet mode, each flow routed through this node keeps an entry
+   * until it is evicted, once idle for longer than FlowletTimeout.
+   *
+   * \return the number of flowlet table entries
+   */
+  uint32_t GetNFlowlets (void) const;
+
   /**
    * Assign a fixed random variable stream number to the random variables
    * used by this model.  Return the number of streams (possibly zero) that
@@ -238,6 +296,47 @@ private:
   bool m_respondToInterfaceEvents;
   /// A uniform random number generator for randomly routing packets among ECMP 
   Ptr<UniformRandomVariable> m_rand;
+  /// How a route is selected among equal-cost routes
+  EcmpMode m_ecmpMode;
+  /// Salt mixed into the flow hash; combined with the node id
+  uint32_t m_ecmpSalt;
+  /// Per-node salt actually used, computed on first use
+  uint32_t m_nodeSalt;
+  /// True once m_nodeSalt has been computed
+  bool m_nodeSaltSet;
+  /// Idle time after which a flowlet may be moved to another route
+  Time m_flowletTimeout;
+
+  /// State of a flowlet
+  struct Flowlet
+  {
+    Time m_lastSeen;         //!< Time the last packet of the flow was routed
+    uint32_t m_routeIndex;   //!< Index of the route among the equal-cost routes
+  };
+  /// Flowlet table, indexed by flow hash
+  std::unordered_map<uint32_t, Flowlet> m_flowlets;
+  /// Size of the flowlet table at which the idle flowlets are evicted
+  std::size_t m_flowletSweepSize;
+  /// Minimum size of the flowlet table before the idle flowlets are evicted
+  static const std::size_t FLOWLET_SWEEP_MIN = 1024;
+
+  /// Equal-cost routes to a destination, in routing table order
+  struct RouteGroup
+  {
+    std::vector<Ptr<Ipv4Route> > m_routes; //!< Prebuilt route for each entry
+  };
+  /// Compiled network routes sharing one prefix length
+  struct PrefixTable
+  {
+    uint32_t m_mask;                                   //!< Network mask
+    std::unordered_map<uint32_t, RouteGroup> m_groups; //!< Groups indexed by masked destination
+  };
+  /// Compiled host routes, indexed by destination
+  std::unordered_map<uint32_t, RouteGroup> m_hostTable;
+  /// Compiled network routes, longest prefix first
+  std::vector<PrefixTable> m_networkTable;
+  /// True if the compiled tables reflect the route lists
+  bool m_forwardingTableValid;
 
   /// container of Ipv4RoutingTableEntry (routes to hosts)
   typedef std::list<Ipv4RoutingTableEntry *> HostRoutes;
@@ -263,10 +362,72 @@ private:
   /**
    * \brief Lookup in the forwarding table for destination.
    * \param dest destination address
+   * \param flowHash hash of the packet 5-tuple, used by the per-flow modes
    * \param oif output interface if any (put 0 otherwise)
    * \return Ipv4Route to route the packet to reach dest address
    */
-  Ptr<Ipv4Route> LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif = 0);
+  Ptr<Ipv4Route> LookupGlobal (Ipv4Address dest, uint32_t flowHash, Ptr<NetDevice> oif = 0);
+
+  /**
+   * \brief Compute the salted hash of the 5-tuple of a packet.
+   *
+   * The transport ports are read from the first four bytes of the packet
+   * for TCP and UDP; they are taken as zero for other protocols, for
+   * non-first fragments, or when no packet is available.  The packets
+   * given to RouteOutput by the TCP and UDP stacks start at their
+   * transport header, so the ports are those of the flow.
+   *
+   * \param p the packet, starting at the transport header (may be null)
+   * \param header the IPv4 header of the packet
+   * \return the flow hash
+   */
+  uint32_t GetFlowHash (Ptr<const Packet> p, const Ipv4Header &header);
+
+  /**
+   * \brief Select one of nRoutes equal-cost routes.
+   * \param nRoutes number of candidate routes (at least one)
+   * \param flowHash hash of the packet 5-tuple
+   * \return the index of the selected route
+   */
+  uint32_t SelectEcmpRoute (uint32_t nRoutes, uint32_t flowHash);
+
+  /**
+   * \brief Remove the flowlets idle for longer than the flowlet timeout.
+   *
+   * A flow that shows up again after its flowlet was evicted starts a
+   * new flowlet, as it would have after that idle time anyway.  Called
+   * when the table reaches m_flowletSweepSize, which is then set to
+   * twice the number of remaining flowlets.
+   */
+  void EvictIdleFlowlets (void);
+
+  /**
+   * \brief Set the salt of the flow hash.
+   *
+   * The per-node salt is computed again on the next hash.
+   *
+   * \param salt the salt, mixed with the node id
+   */
+  void SetEcmpSalt (uint32_t salt);
+  /**
+   * \brief Get the salt of the flow hash.
+   * \return the salt
+   */
+  uint32_t GetEcmpSalt (void) const;
+
+  /**
+   * \brief Find the compiled equal-cost group for a destination.
+   * \param dest destination address
+   * \return the group, or 0 if no host or network route matches
+   */
+  const RouteGroup *FindRouteGroup (Ipv4Address dest);
+
+  /**
+   * \brief Build the Ipv4Route corresponding to a routing table entry.
+   * \param route the routing table entry
+   * \return the route
+   */
+  Ptr<Ipv4Route> MakeRoute (const Ipv4RoutingTableEntry *route) const;
 
   HostRoutes m_hostRoutes;             //!< Routes to hosts
   NetworkRoutes m_networkRoutes;       //!< Routes to networks
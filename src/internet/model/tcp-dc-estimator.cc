@@ -0,0 +1,279 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
+#include "tcp-dc-estimator.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TcpDcEstimatorReplay");
+
+TcpDcEstimatorReplay::Parameters::Parameters ()
+  : g (0.0625),
+    tdcv (5),
+    minRtt (MicroSeconds (100)),
+    alpha (1.0),
+    beta (1.0)
+{
+}
+
+TcpDcEstimatorReplay::TcpDcEstimatorReplay (Variant variant, uint32_t segmentSize)
+  : m_variant (variant),
+    m_segmentSize (segmentSize),
+    m_followCwnd (false),
+    m_ackedBytesEcn (0),
+    m_ackedBytesTotal (0),
+    m_acks (0),
+    m_windows (0),
+    m_bytesAcked (0)
+{
+  NS_LOG_FUNCTION (this << variant << segmentSize);
+  NS_ASSERT (segmentSize > 0);
+}
+
+void
+TcpDcEstimatorReplay::SetFollowRecordedCwnd (bool follow)
+{
+  NS_LOG_FUNCTION (this << follow);
+  m_followCwnd = follow;
+}
+
+uint32_t
+TcpDcEstimatorReplay::AddParameters (const Parameters &parameters)
+{
+  NS_LOG_FUNCTION (this << parameters.g << parameters.tdcv << parameters.minRtt);
+  m_parameters.push_back (parameters);
+  m_g.push_back (parameters.g);
+  m_tdcv.push_back (parameters.tdcv);
+  m_alpha.push_back (parameters.alpha);
+  m_beta.push_back (parameters.beta);
+  m_minRttUs.push_back (parameters.minRtt.GetMicroSeconds ());
+  m_cwnd.push_back (0);
+  m_ssThresh.push_back (std::numeric_limits<uint32_t>::max ());
+  m_cwndCnt.push_back (0);
+  m_ackedBytesRtt.push_back (0);
+  m_cwrEnd.push_back (0);
+  m_inCwr.push_back (0);
+  m_bytesRttMarked.push_back (0);
+  m_ecnReductions.push_back (0);
+  m_rttReductions.push_back (0);
+  m_alphaSum.push_back (0);
+  m_betaSum.push_back (0);
+  m_cwndSum.push_back (0);
+  return m_parameters.size () - 1;
+}
+
+uint32_t
+TcpDcEstimatorReplay::GetNParameters (void) const
+{
+  return m_parameters.size ();
+}
+
+void
+TcpDcEstimatorReplay::BeginFlow (uint32_t cwnd)
+{
+  NS_LOG_FUNCTION (this << cwnd);
+  for (uint32_t k = 0; k < m_parameters.size (); k++)
+    {
+      m_alpha[k] = m_parameters[k].alpha;
+      m_beta[k] = m_parameters[k].beta;
+      m_minRttUs[k] = m_parameters[k].minRtt.GetMicroSeconds ();
+    }
+  std::fill (m_cwnd.begin (), m_cwnd.end (), cwnd);
+  std::fill (m_ssThresh.begin (), m_ssThresh.end (), std::numeric_limits<uint32_t>::max ());
+  std::fill (m_cwndCnt.begin (), m_cwndCnt.end (), 0);
+  std::fill (m_ackedBytesRtt.begin (), m_ackedBytesRtt.end (), 0);
+  std::fill (m_inCwr.begin (), m_inCwr.end (), 0);
+  m_ackedBytesEcn = 0;
+  m_ackedBytesTotal = 0;
+}
+
+void
+TcpDcEstimatorReplay::Replay (const TcpRttSample &sample)
+{
+  const uint32_t n = m_parameters.size ();
+  const uint32_t segmentSize = m_segmentSize;
+  const uint32_t bytes = sample.bytesAcked;
+  const bool useEcn = m_variant != DCVEGAS;
+  const bool useRtt = m_variant != DCTCP;
+  const double rttUs = sample.rtt.GetMicroSeconds ();
+
+  double *alpha = m_alpha.data ();
+  double *beta = m_beta.data ();
+  double *minRttUs = m_minRttUs.data ();
+  uint32_t *cwnd = m_cwnd.data ();
+  uint32_t *ssThresh = m_ssThresh.data ();
+  uint32_t *ackedBytesRtt = m_ackedBytesRtt.data ();
+  const double *g = m_g.data ();
+  const uint32_t *tdcv = m_tdcv.data ();
+
+  m_acks++;
+  m_bytesAcked += bytes;
+  m_ackedBytesTotal += bytes;
+  if (useEcn && sample.ece)
+    {
+      m_ackedBytesEcn += bytes;
+    }
+  if (m_followCwnd)
+    {
+      std::fill (m_cwnd.begin (), m_cwnd.end (), sample.cwnd);
+    }
+  for (uint32_t k = 0; k < n; k++)
+    {
+      m_cwndSum[k] += cwnd[k];
+    }
+
+  // TcpDstcp::PktsAcked and TcpDcVegas::PktsAcked: RTT marks
+  if (useRtt && !sample.rtt.IsZero ())
+    {
+      for (uint32_t k = 0; k < n; k++)
+        {
+          minRttUs[k] = std::min (minRttUs[k], rttUs);
+          uint32_t nql = TcpDcEstimator::QueueLength (cwnd[k] / segmentSize, minRttUs[k], rttUs);
+          ackedBytesRtt[k] += nql >= tdcv[k] ? bytes : 0;
+        }
+    }
+
+  // End of an observation window: estimates and RTT reductions
+  if (sample.windowEnd)
+    {
+      m_windows++;
+      double fractionEcn = TcpDcEstimator::MarkedFraction (m_ackedBytesEcn, m_ackedBytesTotal);
+      for (uint32_t k = 0; k < n; k++)
+        {
+          double fractionRtt = TcpDcEstimator::MarkedFraction (ackedBytesRtt[k], m_ackedBytesTotal);
+          alpha[k] = useEcn ? TcpDcEstimator::UpdateEstimate (alpha[k], g[k], fractionEcn) : alpha[k];
+          beta[k] = useRtt ? TcpDcEstimator::UpdateEstimate (beta[k], g[k], fractionRtt) : beta[k];
+          // DSTCP leaves the windows marked by ECE to the ECN reaction
+          bool cut = fractionRtt > 0 && (m_variant == DCVEGAS || fractionEcn == 0);
+          uint32_t reduced = std::max (TcpDcEstimator::ReducedWindow (cwnd[k], beta[k]), 2 * segmentSize);
+          cwnd[k] = cut ? reduced : cwnd[k];
+          ssThresh[k] = cut ? reduced : ssThresh[k];
+          m_rttReductions[k] += cut;
+          m_bytesRttMarked[k] += ackedBytesRtt[k];
+          ackedBytesRtt[k] = 0;
+          m_alphaSum[k] += alpha[k];
+          m_betaSum[k] += beta[k];
+        }
+      m_ackedBytesEcn = 0;
+      m_ackedBytesTotal = 0;
+    }
+
+  if (m_followCwnd)
+    {
+      return;
+    }
+
+  // TcpSocketBase: one reduction to GetSsThresh () per window of ECE,
+  // applied at once rather than through the recovery algorithm
+  uint32_t *cwndCnt = m_cwndCnt.data ();
+  uint32_t *cwrEnd = m_cwrEnd.data ();
+  uint8_t *inCwr = m_inCwr.data ();
+  const uint32_t segmentsAcked = bytes / segmentSize;
+  for (uint32_t k = 0; k < n; k++)
+    {
+      bool exit = inCwr[k] && static_cast<int32_t> (sample.ackSeq - cwrEnd[k]) > 0;
+      bool enter = useEcn && sample.ece && !(inCwr[k] && !exit);
+      uint32_t reduced = TcpDcEstimator::ReducedWindow (cwnd[k], alpha[k]);
+      ssThresh[k] = enter ? reduced : ssThresh[k];
+      cwnd[k] = enter ? std::max (reduced, segmentSize) : cwnd[k];
+      cwrEnd[k] = enter ? sample.nextTxSeq : cwrEnd[k];
+      inCwr[k] = enter || (inCwr[k] && !exit);
+      m_ecnReductions[k] += enter;
+
+      // TcpLinuxReno::IncreaseWindow, outside of the reductions
+      bool grow = !inCwr[k] && segmentsAcked > 0;
+      bool slowStart = cwnd[k] < ssThresh[k];
+      uint32_t w = std::max (cwnd[k] / segmentSize, 1u);
+      uint32_t cnt = cwndCnt[k] >= w ? segmentsAcked : cwndCnt[k] + segmentsAcked;
+      uint32_t added = cwndCnt[k] >= w ? segmentSize : 0;
+      added += (cnt / w) * segmentSize;
+      cnt -= (cnt / w) * w;
+      uint32_t slowStartCwnd = std::min (cwnd[k] + segmentsAcked * segmentSize, ssThresh[k]);
+      cwnd[k] = grow ? (slowStart ? slowStartCwnd : cwnd[k] + added) : cwnd[k];
+      cwndCnt[k] = grow && !slowStart ? cnt : cwndCnt[k];
+    }
+}
+
+bool
+TcpDcEstimatorReplay::ReplayFile (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  std::vector<uint32_t> flowIds;
+  std::vector<TcpRttSample> samples;
+  if (!TcpRttRecorder::ReadFile (fileName, flowIds, samples))
+    {
+      return false;
+    }
+  // The samples of a socket are in order, but interleaved with the
+  // samples of the other sockets.
+  std::map<uint32_t, std::vector<uint32_t> > flows;
+  for (uint32_t i = 0; i < samples.size (); i++)
+    {
+      flows[flowIds[i]].push_back (i);
+    }
+  for (std::map<uint32_t, std::vector<uint32_t> >::const_iterator it = flows.begin (); it != flows.end (); ++it)
+    {
+      BeginFlow (samples[it->second.front ()].cwnd);
+      for (std::vector<uint32_t>::const_iterator i = it->second.begin (); i != it->second.end (); ++i)
+        {
+          Replay (samples[*i]);
+        }
+    }
+  return true;
+}
+
+double
+TcpDcEstimatorReplay::GetAlpha (uint32_t index) const
+{
+  return m_alpha.at (index);
+}
+
+double
+TcpDcEstimatorReplay::GetBeta (uint32_t index) const
+{
+  return m_beta.at (index);
+}
+
+uint32_t
+TcpDcEstimatorReplay::GetCwnd (uint32_t index) const
+{
+  return m_cwnd.at (index);
+}
+
+TcpDcEstimatorReplay::Result
+TcpDcEstimatorReplay::GetResult (uint32_t index) const
+{
+  Result result;
+  result.acks = m_acks;
+  result.windows = m_windows;
+  result.bytesAcked = m_bytesAcked;
+  result.bytesRttMarked = m_bytesRttMarked.at (index);
+  result.ecnReductions = m_ecnReductions.at (index);
+  result.rttReductions = m_rttReductions.at (index);
+  result.meanAlpha = m_windows > 0 ? m_alphaSum[index] / m_windows : m_parameters[index].alpha;
+  result.meanBeta = m_windows > 0 ? m_betaSum[index] / m_windows : m_parameters[index].beta;
+  result.meanCwnd = m_acks > 0 ? m_cwndSum[index] / m_acks : 0;
+  return result;
+}
+
+} // namespace ns3
@@ -0,0 +1,259 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef TCP_DC_ESTIMATOR_H
+#define TCP_DC_ESTIMATOR_H
+
+#include <string>
+#include <vector>
+
+#include "ns3/nstime.h"
+#include "ns3/tcp-rtt-recorder.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup tcp
+ *
+ * \brief The congestion estimates shared by TcpDctcp, TcpDstcp and
+ * TcpDcVegas
+ *
+ * Both the congestion controls and TcpDcEstimatorReplay compute their
+ * estimates with these functions, so that a replay gives the values the
+ * simulation would have given.
+ */
+class TcpDcEstimator
+{
+public:
+  /**
+   * \brief Fraction of the bytes of an observation window which were marked
+   * \param marked the marked bytes
+   * \param total the bytes acknowledged in the window
+   * \returns the fraction, 0 for an empty window
+   */
+  static double MarkedFraction (uint32_t marked, uint32_t total)
+  {
+    return total > 0 ? marked * 1.0 / total : 0.0;
+  }
+
+  /**
+   * \brief Moving average of a congestion estimate (alpha or beta)
+   * \param estimate the current estimate
+   * \param g the estimation gain
+   * \param fraction the marked fraction of the last observation window
+   * \returns the new estimate
+   */
+  static double UpdateEstimate (double estimate, double g, double fraction)
+  {
+    return (1.0 - g) * estimate + g * fraction;
+  }
+
+  /**
+   * \brief Network queue length estimated from an RTT sample
+   * \param segCwnd the congestion window in segments
+   * \param minRttUs the minimum RTT in microseconds
+   * \param rttUs the RTT sample in microseconds, greater than minRttUs
+   * \returns the segments of the window queued in the network
+   */
+  static uint32_t QueueLength (uint32_t segCwnd, double minRttUs, double rttUs)
+  {
+    double tmp = minRttUs * 1.0 / rttUs;
+    return segCwnd - static_cast<uint32_t> (segCwnd * tmp);
+  }
+
+  /**
+   * \brief Congestion window reduced in proportion to an estimate
+   * \param cwnd the congestion window in bytes
+   * \param estimate the congestion estimate
+   * \returns the reduced window in bytes
+   */
+  static uint32_t ReducedWindow (uint32_t cwnd, double estimate)
+  {
+    return static_cast<uint32_t> ((1 - estimate / 2.0) * cwnd);
+  }
+};
+
+/**
+ * \ingroup tcp
+ *
+ * \brief Replays recorded ACK streams through the estimators of many
+ * parameter combinations at once
+ *
+ * The ACKs recorded by TcpRttRecorder (acknowledged bytes, ECE flag, RTT
+ * sample and the end of the observation windows) are fed to the alpha,
+ * beta and congestion window updates of TcpDctcp, TcpDstcp or TcpDcVegas,
+ * once for each parameter combination.  The state of the combinations
+ * is kept in one array per variable, and each ACK updates all of them in
+ * a loop without dependencies between iterations, which the compiler can
+ * vectorize.
+ *
+ * The replay is open loop: the ACKs and the observation windows are those
+ * of the recorded simulation.  By default, the congestion window is
+ * replayed too, growing as TcpLinuxReno and reduced by the RTT marks and
+ * once per window of ECE marks, which estimates how each combination
+ * would have reacted.  With SetFollowRecordedCwnd, the recorded window is
+ * used instead, and the estimates of the combination used by the
+ * simulation are exactly those of the simulation.
+ *
+ * \code
+ *   TcpDcEstimatorReplay replay (TcpDcEstimatorReplay::DSTCP, 1448);
+ *   for (double g = 1.0 / 256; g <= 0.5; g *= 2)
+ *     {
+ *       TcpDcEstimatorReplay::Parameters p;
+ *       p.g = g;
+ *       replay.AddParameters (p);
+ *     }
+ *   replay.ReplayFile ("rtt.bin");
+ *   TcpDcEstimatorReplay::Result r = replay.GetResult (0);
+ * \endcode
+ */
+class TcpDcEstimatorReplay
+{
+public:
+  /// The congestion control replayed
+  enum Variant
+  {
+    DCTCP,   //!< TcpDctcp: alpha from the ECE marks
+    DSTCP,   //!< TcpDstcp: alpha from the ECE marks, beta from the RTT
+    DCVEGAS  //!< TcpDcVegas: beta from the RTT
+  };
+
+  /// A parameter combination
+  struct Parameters
+  {
+    Parameters ();
+    double g;       //!< Estimation gain
+    uint32_t tdcv;  //!< Queue length threshold of the RTT marks, in segments
+    Time minRtt;    //!< Initial minimum RTT
+    double alpha;   //!< Initial alpha
+    double beta;    //!< Initial beta
+  };
+
+  /// The outcome of a parameter combination over the replayed flows
+  struct Result
+  {
+    uint64_t acks;           //!< ACKs replayed
+    uint64_t windows;        //!< Observation windows replayed
+    uint64_t bytesAcked;     //!< Bytes acknowledged
+    uint64_t bytesRttMarked; //!< Bytes marked by the RTT
+    uint64_t ecnReductions;  //!< Window reductions due to ECE
+    uint64_t rttReductions;  //!< Window reductions due to the RTT marks
+    double meanAlpha;        //!< Mean of alpha at the end of the windows
+    double meanBeta;         //!< Mean of beta at the end of the windows
+    double meanCwnd;         //!< Mean congestion window upon the ACKs, in bytes
+  };
+
+  /**
+   * \brief Constructor
+   * \param variant the congestion control replayed
+   * \param segmentSize the segment size of the recorded sockets
+   */
+  TcpDcEstimatorReplay (Variant variant, uint32_t segmentSize);
+
+  /**
+   * \brief Use the recorded congestion window instead of replaying it
+   * \param follow true to use the recorded window
+   */
+  void SetFollowRecordedCwnd (bool follow);
+
+  /**
+   * \brief Add a parameter combination
+   * \param parameters the combination
+   * \returns the index of the combination
+   */
+  uint32_t AddParameters (const Parameters &parameters);
+  /// \returns the number of parameter combinations
+  uint32_t GetNParameters (void) const;
+
+  /**
+   * \brief Start a flow, resetting the state of every combination
+   * \param cwnd the initial congestion window in bytes
+   */
+  void BeginFlow (uint32_t cwnd);
+  /**
+   * \brief Replay an ACK of the current flow
+   * \param sample the recorded sample of the ACK
+   */
+  void Replay (const TcpRttSample &sample);
+
+  /**
+   * \brief Replay the flows of a sample file
+   * \param fileName name or path of a file written by TcpRttRecorder
+   * \returns false if the file could not be read
+   */
+  bool ReplayFile (std::string fileName);
+
+  /**
+   * \param index the index of a combination
+   * \returns the current alpha of the combination
+   */
+  double GetAlpha (uint32_t index) const;
+  /**
+   * \param index the index of a combination
+   * \returns the current beta of the combination
+   */
+  double GetBeta (uint32_t index) const;
+  /**
+   * \param index the index of a combination
+   * \returns the current congestion window of the combination
+   */
+  uint32_t GetCwnd (uint32_t index) const;
+  /**
+   * \param index the index of a combination
+   * \returns the outcome of the combination over the flows replayed
+   */
+  Result GetResult (uint32_t index) const;
+
+private:
+  Variant m_variant;         //!< Congestion control replayed
+  uint32_t m_segmentSize;    //!< Segment size of the recorded sockets
+  bool m_followCwnd;         //!< Use the recorded congestion window
+
+  // Parameters, one element per combination
+  std::vector<double> m_g;                //!< Estimation gains
+  std::vector<uint32_t> m_tdcv;           //!< Queue length thresholds
+  std::vector<Parameters> m_parameters;   //!< Combinations, for the initial values
+
+  // State of the current flow, one element per combination
+  std::vector<double> m_alpha;            //!< Alpha
+  std::vector<double> m_beta;             //!< Beta
+  std::vector<double> m_minRttUs;         //!< Minimum RTT, in microseconds
+  std::vector<uint32_t> m_cwnd;           //!< Congestion window
+  std::vector<uint32_t> m_ssThresh;       //!< Slow start threshold
+  std::vector<uint32_t> m_cwndCnt;        //!< Congestion avoidance ACK counter
+  std::vector<uint32_t> m_ackedBytesRtt;  //!< Bytes marked by the RTT in the window
+  std::vector<uint32_t> m_cwrEnd;         //!< End of the current ECE reduction
+  std::vector<uint8_t> m_inCwr;           //!< Is an ECE reduction in progress
+  // State shared by the combinations, which do not affect it
+  uint32_t m_ackedBytesEcn;               //!< Bytes marked by ECE in the window
+  uint32_t m_ackedBytesTotal;             //!< Bytes acknowledged in the window
+
+  // Outcome, one element per combination
+  std::vector<uint64_t> m_bytesRttMarked; //!< Bytes marked by the RTT
+  std::vector<uint64_t> m_ecnReductions;  //!< Window reductions due to ECE
+  std::vector<uint64_t> m_rttReductions;  //!< Window reductions due to the RTT
+  std::vector<double> m_alphaSum;         //!< Sum of alpha at the end of the windows
+  std::vector<double> m_betaSum;          //!< Sum of beta at the end of the windows
+  std::vector<double> m_cwndSum;          //!< Sum of the window upon the ACKs
+  uint64_t m_acks;                        //!< ACKs replayed
+  uint64_t m_windows;                     //!< Observation windows replayed
+  uint64_t m_bytesAcked;                  //!< Bytes acknowledged
+};
+
+} // namespace ns3
+
+#endif /* TCP_DC_ESTIMATOR_H */
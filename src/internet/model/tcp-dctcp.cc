@@ -23,6 +23,9 @@
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/tcp-socket-state.h"
+#include "ns3/tcp-dc-estimator.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
 
 namespace ns3 {
 
@@ -51,10 +54,19 @@ TypeId TcpDctcp::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&TcpDctcp::m_useEct0),
                    MakeBooleanChecker ())
+    .AddAttribute ("RttRecorder",
+                   "Recorder of the RTT samples, none if null",
+                   PointerValue (),
+                   MakePointerAccessor (&TcpDctcp::m_rttRecorder),
+                   MakePointerChecker<TcpRttRecorder> ())
     .AddTraceSource ("CongestionEstimate",
                      "Update sender-side congestion estimate state",
                      MakeTraceSourceAccessor (&TcpDctcp::m_traceCongestionEstimate),
                      "ns3::TcpDctcp::CongestionEstimateTracedCallback")
+    .AddTraceSource ("RttSample",
+                     "State of the congestion control upon each ACK",
+                     MakeTraceSourceAccessor (&TcpDctcp::m_traceRttSample),
+                     "ns3::TcpDctcp::RttSampleTracedCallback")
   ;
   return tid;
 }
@@ -92,7 +104,8 @@ TcpDctcp::TcpDctcp (const TcpDctcp& sock)
     m_delayedAckReserved (sock.m_delayedAckReserved),
     m_g (sock.m_g),
     m_useEct0 (sock.m_useEct0),
-    m_initialized (sock.m_initialized)
+    m_initialized (sock.m_initialized),
+    m_rttRecorder (sock.m_rttRecorder)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -126,14 +139,15 @@ uint32_t
 TcpDctcp::GetSsThresh (Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight)
 {
   NS_LOG_FUNCTION (this << tcb << bytesInFlight);
-  return static_cast<uint32_t> ((1 - m_alpha / 2.0) * tcb->m_cWnd);
+  return TcpDcEstimator::ReducedWindow (tcb->m_cWnd, m_alpha);
 }
 
 void
 TcpDctcp::PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time &rtt)
 {
   NS_LOG_FUNCTION (this << tcb << segmentsAcked << rtt);
-  std::cout << rtt.GetMicroSeconds() << std::endl;
+  uint32_t cwnd = tcb->m_cWnd;
+  bool windowEnd = false;
   m_ackedBytesTotal += segmentsAcked * tcb->m_segmentSize;
   if (tcb->m_ecnState == TcpSocketState::ECN_ECE_RCVD)
     {
@@ -146,16 +160,17 @@ TcpDctcp::PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time
     }
   if (tcb->m_lastAckedSeq >= m_nextSeq)
     {
-      double bytesEcn = 0.0; // Corresponds to variable M in RFC 8257
-      if (m_ackedBytesTotal >  0)
-        {
-          bytesEcn = static_cast<double> (m_ackedBytesEcn * 1.0 / m_ackedBytesTotal);
-        }
-      m_alpha = (1.0 - m_g) * m_alpha + m_g * bytesEcn;
+      windowEnd = true;
+      // Corresponds to variable M in RFC 8257
+      double bytesEcn = TcpDcEstimator::MarkedFraction (m_ackedBytesEcn, m_ackedBytesTotal);
+      m_alpha = TcpDcEstimator::UpdateEstimate (m_alpha, m_g, bytesEcn);
       m_traceCongestionEstimate (m_ackedBytesEcn, m_ackedBytesTotal, m_alpha);
       NS_LOG_INFO (this << "bytesEcn " << bytesEcn << ", m_alpha " << m_alpha);
       Reset (tcb);
     }
+  TcpRttRecorder::Fire (m_rttRecorder, m_rttStream, m_traceRttSample,
+                        TcpRttSample::FromAck (tcb, segmentsAcked, rtt, Time (0), cwnd,
+                                               m_alpha, 0.0, windowEnd));
 }
 
 void
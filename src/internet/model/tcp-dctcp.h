@@ -25,6 +25,7 @@
 #include "ns3/tcp-congestion-ops.h"
 #include "ns3/tcp-linux-reno.h"
 #include "ns3/traced-callback.h"
+#include "ns3/tcp-rtt-recorder.h"
 
 namespace ns3 {
 
@@ -82,6 +83,13 @@ public:
    */
   typedef void (* CongestionEstimateTracedCallback)(uint32_t bytesAcked, uint32_t bytesMarked, double alpha);
 
+  /**
+   * TracedCallback signature for the RTT samples
+   *
+   * \param [in] sample The state of the congestion control upon an ACK
+   */
+  typedef void (* RttSampleTracedCallback)(const TcpRttSample &sample);
+
   // Documented in base class
   virtual uint32_t GetSsThresh (Ptr<const TcpSocketState> tcb,
                                 uint32_t bytesInFlight);
@@ -144,6 +152,9 @@ private:
    * \brief Callback pointer for congestion state update
    */
   TracedCallback<uint32_t, uint32_t, double> m_traceCongestionEstimate;
+  Ptr<TcpRttRecorder> m_rttRecorder;    //!< Recorder of the RTT samples, if any
+  Ptr<TcpRttSampleStream> m_rttStream;  //!< Samples of this socket in m_rttRecorder
+  TracedCallback<const TcpRttSample &> m_traceRttSample; //!< Trace of the RTT samples
 };
 
 } // namespace ns3
@@ -23,6 +23,9 @@
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/tcp-socket-state.h"
+#include "ns3/tcp-dc-estimator.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
 
 namespace ns3 {
 
@@ -61,10 +64,19 @@ TypeId TcpDcVegas::GetTypeId (void)
                    BooleanValue (false),
                    MakeBooleanAccessor (&TcpDcVegas::m_useEct0),
                    MakeBooleanChecker ())
+    .AddAttribute ("RttRecorder",
+                   "Recorder of the RTT samples, none if null",
+                   PointerValue (),
+                   MakePointerAccessor (&TcpDcVegas::m_rttRecorder),
+                   MakePointerChecker<TcpRttRecorder> ())
     .AddTraceSource ("CongestionEstimate",
                      "Update sender-side congestion estimate state",
                      MakeTraceSourceAccessor (&TcpDcVegas::m_traceCongestionEstimate),
                      "ns3::TcpDcVegas::CongestionEstimateTracedCallback")
+    .AddTraceSource ("RttSample",
+                     "State of the congestion control upon each ACK",
+                     MakeTraceSourceAccessor (&TcpDcVegas::m_traceRttSample),
+                     "ns3::TcpDcVegas::RttSampleTracedCallback")
   ;
   return tid;
 }
@@ -104,7 +116,8 @@ TcpDcVegas::TcpDcVegas (const TcpDcVegas& sock)
     m_g (sock.m_g),
     m_useEct0 (sock.m_useEct0),
     m_initialized (sock.m_initialized),
-    m_minRtt (sock.m_minRtt)
+    m_minRtt (sock.m_minRtt),
+    m_rttRecorder (sock.m_rttRecorder)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -138,39 +151,32 @@ uint32_t
 TcpDcVegas::GetSsThresh (Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight)
 {
   NS_LOG_FUNCTION (this << tcb << bytesInFlight);
-  return static_cast<uint32_t> ((1 - m_beta / 2.0) * tcb->m_cWnd);
+  return TcpDcEstimator::ReducedWindow (tcb->m_cWnd, m_beta);
 }
 
 void
 TcpDcVegas::PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time &rtt)
 {
   NS_LOG_FUNCTION (this << tcb << segmentsAcked << rtt);
+  uint32_t cwnd = tcb->m_cWnd;
+  bool windowEnd = false;
   m_ackedBytesTotal += segmentsAcked * tcb->m_segmentSize;
 
   if (!rtt.IsZero ())
     {
       uint32_t nql;  //network queue length
-      uint32_t targetCwnd;
 
       uint32_t segCwnd = tcb->GetCwndInSegments ();
       NS_LOG_DEBUG ("Calculated current Cwnd = " << segCwnd);
 
       m_minRtt = std::min (m_minRtt, rtt);
       NS_LOG_DEBUG ("current rtt (us): " << rtt.GetMicroSeconds() << " Updated minRtt (us): " << m_minRtt.GetMicroSeconds());
-      std::cout << rtt.GetMicroSeconds() << " " << m_minRtt.GetMicroSeconds() << std::endl;
-
-      double tmp = m_minRtt.GetMicroSeconds() * 1.0 / rtt.GetMicroSeconds();
-      NS_LOG_INFO ("Calculated tmp = " << tmp);
-
-      targetCwnd = static_cast<uint32_t> (segCwnd * tmp);
-      NS_LOG_INFO ("Calculated targetCwnd = " << targetCwnd);
-
-      NS_ASSERT (segCwnd >= targetCwnd); // implies minRtt <= Rtt
 
       /*
        * Calculate the network queue length
        */
-      nql = segCwnd - targetCwnd;
+      nql = TcpDcEstimator::QueueLength (segCwnd, m_minRtt.GetMicroSeconds (), rtt.GetMicroSeconds ());
+      NS_ASSERT (segCwnd >= nql); // implies minRtt <= Rtt
       NS_LOG_DEBUG ("Calculated nql: " << nql);
 
       if (nql >= m_tdcv)
@@ -189,25 +195,26 @@ TcpDcVegas::PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Ti
   // rtt expire
   if (tcb->m_lastAckedSeq >= m_nextSeq)
     {
-      double bytesRtt = 0.0; // Corresponds to variable M in RFC 8257
-      if (m_ackedBytesTotal >  0)
-        {
-          bytesRtt = static_cast<double> (m_ackedBytesRtt * 1.0 / m_ackedBytesTotal);
-        }
-      m_beta = (1.0 - m_g) * m_beta + m_g * bytesRtt;
+      windowEnd = true;
+      // Corresponds to variable M in RFC 8257
+      double bytesRtt = TcpDcEstimator::MarkedFraction (m_ackedBytesRtt, m_ackedBytesTotal);
+      m_beta = TcpDcEstimator::UpdateEstimate (m_beta, m_g, bytesRtt);
       m_traceCongestionEstimate (m_ackedBytesRtt, m_ackedBytesTotal, m_beta);
       NS_LOG_DEBUG ("bytesRtt: " << bytesRtt << ", m_beta: " << m_beta);
 
       // decrease cwnd once in each rtt
       if(bytesRtt > 0)
         {
-          uint32_t val = static_cast<uint32_t> ( (1 - m_beta / 2.0) * tcb->m_cWnd );
+          uint32_t val = TcpDcEstimator::ReducedWindow (tcb->m_cWnd, m_beta);
           tcb->m_cWnd = std::max (val, 2 * tcb->m_segmentSize);
           tcb->m_ssThresh = tcb->m_cWnd;
           tcb->m_cWndInfl = tcb->m_cWnd;
         }
       Reset (tcb);
     }
+  TcpRttRecorder::Fire (m_rttRecorder, m_rttStream, m_traceRttSample,
+                        TcpRttSample::FromAck (tcb, segmentsAcked, rtt, m_minRtt, cwnd,
+                                               0.0, m_beta, windowEnd));
 }
 
 void
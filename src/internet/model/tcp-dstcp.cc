@@ -23,6 +23,9 @@
 #include "ns3/log.h"
 #include "ns3/abort.h"
 #include "ns3/tcp-socket-state.h"
+#include "ns3/tcp-dc-estimator.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
 
 namespace ns3 {
 
@@ -66,10 +69,19 @@ TypeId TcpDstcp::GetTypeId (void)
                    BooleanValue (true),
                    MakeBooleanAccessor (&TcpDstcp::m_useEct0),
                    MakeBooleanChecker ())
+    .AddAttribute ("RttRecorder",
+                   "Recorder of the RTT samples, none if null",
+                   PointerValue (),
+                   MakePointerAccessor (&TcpDstcp::m_rttRecorder),
+                   MakePointerChecker<TcpRttRecorder> ())
     .AddTraceSource ("CongestionEstimate",
                      "Update sender-side congestion estimate state",
                      MakeTraceSourceAccessor (&TcpDstcp::m_traceCongestionEstimate),
                      "ns3::TcpDstcp::CongestionEstimateTracedCallback")
+    .AddTraceSource ("RttSample",
+                     "State of the congestion control upon each ACK",
+                     MakeTraceSourceAccessor (&TcpDstcp::m_traceRttSample),
+                     "ns3::TcpDstcp::RttSampleTracedCallback")
   ;
   return tid;
 }
@@ -111,7 +123,8 @@ TcpDstcp::TcpDstcp (const TcpDstcp& sock)
     m_g (sock.m_g),
     m_useEct0 (sock.m_useEct0),
     m_initialized (sock.m_initialized),
-    m_minRtt (sock.m_minRtt)
+    m_minRtt (sock.m_minRtt),
+    m_rttRecorder (sock.m_rttRecorder)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -146,14 +159,15 @@ TcpDstcp::GetSsThresh (Ptr<const TcpSocketState> tcb, uint32_t bytesInFlight)
 {
   NS_LOG_FUNCTION (this << tcb << bytesInFlight);
   NS_LOG_DEBUG ("bytesEcn != 0, reduce Cwnd by Ecn" << ", m_alpha = " << m_alpha);
-  return static_cast<uint32_t> ( (1 - m_alpha / 2.0) * tcb->m_cWnd );
+  return TcpDcEstimator::ReducedWindow (tcb->m_cWnd, m_alpha);
 }
 
 void
 TcpDstcp::PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time &rtt)
 {
   NS_LOG_FUNCTION (this << tcb << segmentsAcked << rtt);
-  //std::cout << "dstcp rtt: " << rtt.GetMicroSeconds() << std::endl;
+  uint32_t cwnd = tcb->m_cWnd;
+  bool windowEnd = false;
 
   m_ackedBytesTotal += segmentsAcked * tcb->m_segmentSize;
 
@@ -161,27 +175,18 @@ TcpDstcp::PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time
   if (!rtt.IsZero ())
     {
       uint32_t nql;  //network queue length
-      uint32_t targetCwnd;
 
       uint32_t segCwnd = tcb->GetCwndInSegments ();
       NS_LOG_DEBUG ("Calculated current Cwnd = " << segCwnd);
 
       m_minRtt = std::min (m_minRtt, rtt);
       NS_LOG_DEBUG ("current rtt (us): " << rtt.GetMicroSeconds() << " Updated minRtt (us): " << m_minRtt.GetMicroSeconds());
-      std::cout << rtt.GetMicroSeconds() << " " << m_minRtt.GetMicroSeconds() << std::endl;
-
-      double tmp = m_minRtt.GetMicroSeconds() * 1.0 / rtt.GetMicroSeconds();
-      NS_LOG_DEBUG ("Calculated tmp = " << tmp);
-
-      targetCwnd = static_cast<uint32_t> (segCwnd * tmp);
-      NS_LOG_DEBUG ("Calculated targetCwnd = " << targetCwnd);
-
-      NS_ASSERT (segCwnd >= targetCwnd); // implies minRtt <= Rtt
 
       /*
        * Calculate the network queue length
        */
-      nql = segCwnd - targetCwnd;
+      nql = TcpDcEstimator::QueueLength (segCwnd, m_minRtt.GetMicroSeconds (), rtt.GetMicroSeconds ());
+      NS_ASSERT (segCwnd >= nql); // implies minRtt <= Rtt
       NS_LOG_DEBUG ("Calculated nql: " << nql);
 
       if (nql >= m_tdcv)
@@ -205,16 +210,12 @@ TcpDstcp::PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time
   // rtt expire
   if (tcb->m_lastAckedSeq >= m_nextSeq)
     {
-      double bytesEcn = 0.0; // Corresponds to variable M in RFC 8257
-      double bytesRtt = 0.0;
-      if (m_ackedBytesTotal >  0)
-        {
-          bytesEcn = static_cast<double> (m_ackedBytesEcn * 1.0 / m_ackedBytesTotal);
-          bytesRtt = static_cast<double> (m_ackedBytesRtt * 1.0 / m_ackedBytesTotal);
-          // NS_LOG_DEBUG ("bytesEcn " << bytesEcn <<", bytesRtt " << bytesRtt);
-        }
-      m_alpha = (1.0 - m_g) * m_alpha + m_g * bytesEcn;
-      m_beta = (1.0 - m_g) * m_beta + m_g * bytesRtt;
+      windowEnd = true;
+      // Corresponds to variable M in RFC 8257
+      double bytesEcn = TcpDcEstimator::MarkedFraction (m_ackedBytesEcn, m_ackedBytesTotal);
+      double bytesRtt = TcpDcEstimator::MarkedFraction (m_ackedBytesRtt, m_ackedBytesTotal);
+      m_alpha = TcpDcEstimator::UpdateEstimate (m_alpha, m_g, bytesEcn);
+      m_beta = TcpDcEstimator::UpdateEstimate (m_beta, m_g, bytesRtt);
       m_traceCongestionEstimate (m_ackedBytesEcn, m_ackedBytesTotal, m_alpha, m_beta);
 
       // n
@@ -228,7 +229,7 @@ TcpDstcp::PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time
           if(bytesRtt > 0 && bytesEcn == 0)
             {
               NS_LOG_DEBUG ("bytesRtt > 0 and bytesEcn = 0, reduce Cwnd by Rtt"  << ", m_beta = " << m_beta);
-              uint32_t val = static_cast<uint32_t> ( (1 - m_beta / 2.0) * tcb->m_cWnd );
+              uint32_t val = TcpDcEstimator::ReducedWindow (tcb->m_cWnd, m_beta);
               tcb->m_cWnd = std::max (val, 2 * tcb->m_segmentSize);
               tcb->m_ssThresh = tcb->m_cWnd;
               tcb->m_cWndInfl = tcb->m_cWnd;
@@ -244,6 +245,9 @@ TcpDstcp::PktsAcked (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time
 
       Reset (tcb);
     }
+  TcpRttRecorder::Fire (m_rttRecorder, m_rttStream, m_traceRttSample,
+                        TcpRttSample::FromAck (tcb, segmentsAcked, rtt, m_minRtt, cwnd,
+                                               m_alpha, m_beta, windowEnd));
 }
 
 void
@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "tcp-fluid-load.h"
+#include "ns3/log.h"
+#include "ns3/enum.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/queue-disc.h"
+#include <algorithm>
+#include <limits>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TcpFluidLoad");
+
+NS_OBJECT_ENSURE_REGISTERED (TcpFluidLoad);
+
+TypeId
+TcpFluidLoad::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TcpFluidLoad")
+    .SetParent<FluidLoad> ()
+    .SetGroupName ("Internet")
+    .AddConstructor<TcpFluidLoad> ()
+    .AddAttribute ("Variant",
+                   "The congestion control of the flows",
+                   EnumValue (TcpDcEstimatorReplay::DCTCP),
+                   MakeEnumAccessor (&TcpFluidLoad::m_variant),
+                   MakeEnumChecker (TcpDcEstimatorReplay::DCTCP, "TcpDctcp",
+                                    TcpDcEstimatorReplay::DSTCP, "TcpDstcp",
+                                    TcpDcEstimatorReplay::DCVEGAS, "TcpDcVegas"))
+    .AddAttribute ("Flows",
+                   "The number of flows",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&TcpFluidLoad::m_flows),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("SegmentSize",
+                   "The segment size of the flows",
+                   UintegerValue (1448),
+                   MakeUintegerAccessor (&TcpFluidLoad::m_segmentSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("InitialCwnd",
+                   "The initial congestion window of the flows, in segments",
+                   UintegerValue (10),
+                   MakeUintegerAccessor (&TcpFluidLoad::m_initialCwnd),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("BaseRtt",
+                   "The RTT of the flows without the queueing delay of this queue",
+                   TimeValue (MicroSeconds (100)),
+                   MakeTimeAccessor (&TcpFluidLoad::m_baseRtt),
+                   MakeTimeChecker (NanoSeconds (1)))
+    .AddAttribute ("MarkingThreshold",
+                   "The queue length from which the fluid is marked by ECN",
+                   QueueSizeValue (QueueSize ("65p")),
+                   MakeQueueSizeAccessor (&TcpFluidLoad::m_threshold),
+                   MakeQueueSizeChecker ())
+    .AddAttribute ("G",
+                   "The estimation gain of alpha and beta",
+                   DoubleValue (0.0625),
+                   MakeDoubleAccessor (&TcpFluidLoad::m_g),
+                   MakeDoubleChecker<double> (0, 1))
+    .AddAttribute ("Tdcv",
+                   "The network queue length from which the RTT marks, in segments",
+                   UintegerValue (5),
+                   MakeUintegerAccessor (&TcpFluidLoad::m_tdcv),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddTraceSource ("CongestionWindow",
+                     "The congestion window of each flow, in bytes",
+                     MakeTraceSourceAccessor (&TcpFluidLoad::m_cWnd),
+                     "ns3::TracedValueCallback::Uint32")
+  ;
+  return tid;
+}
+
+TcpFluidLoad::TcpFluidLoad ()
+  : m_cWnd (0),
+    m_ssThresh (std::numeric_limits<uint32_t>::max ()),
+    m_alpha (1.0),
+    m_beta (1.0),
+    m_roundTime (0),
+    m_ecnMarkedTime (0),
+    m_rttMarkedTime (0),
+    m_droppedBytes (0),
+    m_loss (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TcpFluidLoad::~TcpFluidLoad ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint32_t
+TcpFluidLoad::GetCwnd (void) const
+{
+  return m_cWnd;
+}
+
+double
+TcpFluidLoad::GetAlpha (void) const
+{
+  return m_alpha;
+}
+
+double
+TcpFluidLoad::GetBeta (void) const
+{
+  return m_beta;
+}
+
+double
+TcpFluidLoad::DoStep (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (m_cWnd.Get () == 0)
+    {
+      m_cWnd = m_initialCwnd * m_segmentSize;
+    }
+
+  Ptr<QueueDisc> qd = GetQueueDisc ();
+  uint32_t queued = qd->GetNBytes () + GetBacklog (QueueSizeUnit::BYTES);
+  double baseRtt = m_baseRtt.GetSeconds ();
+  double rtt = baseRtt + queued * 8.0 / GetDataRate ().GetBitRate ();
+  double dt = GetTimeStep ().GetSeconds ();
+  m_roundTime += dt;
+
+  uint32_t length = m_threshold.GetUnit () == QueueSizeUnit::BYTES
+    ? queued
+    : qd->GetNPackets () + GetBacklog (QueueSizeUnit::PACKETS);
+  if (length >= m_threshold.GetValue ())
+    {
+      m_ecnMarkedTime += dt;
+    }
+  uint32_t nql = TcpDcEstimator::QueueLength (m_cWnd / m_segmentSize, baseRtt * 1e6, rtt * 1e6);
+  if (nql >= m_tdcv)
+    {
+      m_rttMarkedTime += dt;
+    }
+  if (GetDroppedBytes () > m_droppedBytes)
+    {
+      m_droppedBytes = GetDroppedBytes ();
+      m_loss = true;
+    }
+
+  if (m_roundTime >= rtt)
+    {
+      EndRound ();
+    }
+  return m_flows * static_cast<double> (m_cWnd) / rtt;
+}
+
+void
+TcpFluidLoad::EndRound (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  bool useEcn = m_variant != TcpDcEstimatorReplay::DCVEGAS;
+  bool useRtt = m_variant != TcpDcEstimatorReplay::DCTCP;
+  double fractionEcn = useEcn ? m_ecnMarkedTime / m_roundTime : 0;
+  double fractionRtt = useRtt ? m_rttMarkedTime / m_roundTime : 0;
+  m_alpha = useEcn ? TcpDcEstimator::UpdateEstimate (m_alpha, m_g, fractionEcn) : m_alpha;
+  m_beta = useRtt ? TcpDcEstimator::UpdateEstimate (m_beta, m_g, fractionRtt) : m_beta;
+
+  uint32_t cwnd = m_cWnd;
+  if (m_loss)
+    {
+      m_ssThresh = std::max (cwnd / 2, 2 * m_segmentSize);
+      cwnd = m_ssThresh;
+    }
+  else if (fractionEcn > 0)
+    {
+      m_ssThresh = TcpDcEstimator::ReducedWindow (cwnd, m_alpha);
+      cwnd = std::max (m_ssThresh, m_segmentSize);
+    }
+  else if (fractionRtt > 0)
+    {
+      // DSTCP leaves the windows marked by ECE to the ECN reaction
+      cwnd = std::max (TcpDcEstimator::ReducedWindow (cwnd, m_beta), 2 * m_segmentSize);
+      m_ssThresh = cwnd;
+    }
+  else if (cwnd < m_ssThresh)
+    {
+      cwnd = std::min (2 * cwnd, std::max (m_ssThresh, cwnd));
+    }
+  else
+    {
+      cwnd += m_segmentSize;
+    }
+  m_cWnd = cwnd;
+
+  m_roundTime = 0;
+  m_ecnMarkedTime = 0;
+  m_rttMarkedTime = 0;
+  m_loss = false;
+}
+
+} // namespace ns3
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef TCP_FLUID_LOAD_H
+#define TCP_FLUID_LOAD_H
+
+#include "ns3/fluid-load.h"
+#include "ns3/tcp-dc-estimator.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup tcp
+ *
+ * \brief Long-lived data center TCP flows represented as a fluid
+ *
+ * The flows are bottlenecked by the queue disc holding the fluid and
+ * share its link with the packets of the queue disc.  They are identical,
+ * so that they are modeled by the congestion window of a single flow,
+ * and send the fluid at Flows * cwnd / RTT, where the RTT is the BaseRtt
+ * of the flows plus the queueing delay of the queue disc.
+ *
+ * The window follows the rules of TcpDctcp, TcpDstcp or TcpDcVegas once
+ * per RTT, with the functions of TcpDcEstimator:
+ *
+ * - the fraction of the RTT during which the queue, fluid and packets,
+ *   was at least MarkingThreshold is the ECN marked fraction, for the
+ *   alpha of TcpDctcp and TcpDstcp.  The threshold should be the one of
+ *   the queue disc, the fluid does not go through its marking;
+ * - the fraction of the RTT during which the network queue length
+ *   estimated from the RTT was at least Tdcv segments is the RTT marked
+ *   fraction, for the beta of TcpDstcp and TcpDcVegas;
+ * - the window is reduced by alpha / 2 after an RTT with ECN marks, by
+ *   beta / 2 after an RTT with RTT marks only (see
+ *   TcpDcEstimatorReplay), halved after an RTT with fluid dropped, and
+ *   grows as TcpLinuxReno otherwise, in slow start first.
+ *
+ * The marks and the reductions are synchronized across the flows, as in
+ * the fluid models of DCTCP (Alizadeh, Javanmard and Prabhakar).
+ */
+class TcpFluidLoad : public FluidLoad
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  TcpFluidLoad ();
+  virtual ~TcpFluidLoad ();
+
+  /**
+   * \return the congestion window of each flow, in bytes
+   */
+  uint32_t GetCwnd (void) const;
+
+  /**
+   * \return the alpha of the flows
+   */
+  double GetAlpha (void) const;
+
+  /**
+   * \return the beta of the flows
+   */
+  double GetBeta (void) const;
+
+private:
+  virtual double DoStep (void);
+
+  /**
+   * \brief Update the window at the end of an RTT
+   */
+  void EndRound (void);
+
+  TcpDcEstimatorReplay::Variant m_variant;  //!< The congestion control of the flows
+  uint32_t m_flows;             //!< The number of flows
+  uint32_t m_segmentSize;       //!< The segment size of the flows
+  uint32_t m_initialCwnd;       //!< The initial window of the flows, in segments
+  Time m_baseRtt;               //!< The RTT of the flows without this queue
+  QueueSize m_threshold;        //!< The ECN marking threshold of the queue
+  double m_g;                   //!< The estimation gain
+  uint32_t m_tdcv;              //!< The queue length threshold of the RTT marks, in segments
+  TracedValue<uint32_t> m_cWnd; //!< The congestion window of each flow, in bytes
+  uint32_t m_ssThresh;          //!< The slow start threshold of each flow, in bytes
+  double m_alpha;               //!< The ECN congestion estimate
+  double m_beta;                //!< The RTT congestion estimate
+  double m_roundTime;           //!< The time elapsed in the current RTT, in seconds
+  double m_ecnMarkedTime;       //!< The time marked by ECN in the current RTT, in seconds
+  double m_rttMarkedTime;       //!< The time marked by the RTT in the current RTT, in seconds
+  double m_droppedBytes;        //!< The fluid dropped before the current RTT
+  bool m_loss;                  //!< Fluid was dropped in the current RTT
+};
+
+} // namespace ns3
+
+#endif /* TCP_FLUID_LOAD_H */
@@ -109,7 +109,7 @@ TcpHybla::SlowStart (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked)
       uint32_t incr = static_cast<uint32_t> (increment * tcb->m_segmentSize);
       NS_LOG_INFO ("Slow start: inc=" << increment);
 
-      tcb->m_cWnd = std::min (tcb->m_cWnd + incr, tcb->m_ssThresh);
+      tcb->m_cWnd = std::min (tcb->m_cWnd.Get () + incr, tcb->m_ssThresh.Get ());
 
       NS_LOG_INFO ("In SlowStart, updated to cwnd " << tcb->m_cWnd <<
                    " ssthresh " << tcb->m_ssThresh <<
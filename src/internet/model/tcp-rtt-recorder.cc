@@ -0,0 +1,354 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <cstring>
+
+#include "tcp-rtt-recorder.h"
+#include "tcp-socket-state.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TcpRttRecorder");
+
+NS_OBJECT_ENSURE_REGISTERED (TcpRttRecorder);
+
+namespace {
+
+/// Magic bytes starting a file of RTT samples
+const char MAGIC[8] = { 'N', 'S', '3', 'R', 'T', 'T', 'S', 'R' };
+/// Version of the file format
+const uint16_t VERSION = 1;
+/// Flag of the samples of an ACK carrying ECE
+const uint32_t FLAG_ECE = 0x1;
+/// Flag of the samples ending an observation window
+const uint32_t FLAG_WINDOW_END = 0x2;
+
+/**
+ * \brief Append a little endian integer to a buffer
+ * \param block the buffer
+ * \param value the value
+ * \param bytes the number of bytes of the value
+ */
+void
+PutInteger (std::vector<uint8_t> &block, uint64_t value, uint32_t bytes)
+{
+  for (uint32_t i = 0; i < bytes; i++)
+    {
+      block.push_back (static_cast<uint8_t> (value >> (8 * i)));
+    }
+}
+
+/**
+ * \brief Read a little endian integer from a buffer
+ * \param data the buffer
+ * \param bytes the number of bytes of the integer
+ * \returns the integer
+ */
+uint64_t
+GetInteger (const uint8_t *data, uint32_t bytes)
+{
+  uint64_t value = 0;
+  for (uint32_t i = 0; i < bytes; i++)
+    {
+      value |= static_cast<uint64_t> (data[i]) << (8 * i);
+    }
+  return value;
+}
+
+/**
+ * \param value a double
+ * \returns the IEEE 754 representation of the double
+ */
+uint64_t
+DoubleBits (double value)
+{
+  uint64_t bits;
+  std::memcpy (&bits, &value, sizeof (bits));
+  return bits;
+}
+
+/**
+ * \param bits the IEEE 754 representation of a double
+ * \returns the double
+ */
+double
+BitsDouble (uint64_t bits)
+{
+  double value;
+  std::memcpy (&value, &bits, sizeof (value));
+  return value;
+}
+
+} // unnamed namespace
+
+TcpRttSample
+TcpRttSample::FromAck (Ptr<const TcpSocketState> tcb, uint32_t segmentsAcked,
+                       const Time &rtt, const Time &minRtt, uint32_t cwnd,
+                       double alpha, double beta, bool windowEnd)
+{
+  TcpRttSample sample;
+  sample.time = Simulator::Now ();
+  sample.rtt = rtt;
+  sample.minRtt = minRtt;
+  sample.cwnd = cwnd;
+  sample.alpha = alpha;
+  sample.beta = beta;
+  sample.bytesAcked = segmentsAcked * tcb->m_segmentSize;
+  sample.ackSeq = tcb->m_lastAckedSeq.GetValue ();
+  sample.nextTxSeq = tcb->m_nextTxSequence.Get ().GetValue ();
+  sample.ece = tcb->m_ecnState == TcpSocketState::ECN_ECE_RCVD;
+  sample.windowEnd = windowEnd;
+  return sample;
+}
+
+TcpRttSampleStream::TcpRttSampleStream (Ptr<TcpRttRecorder> recorder, uint32_t flowId)
+  : m_recorder (recorder),
+    m_flowId (flowId),
+    m_skipped (0),
+    m_lastRecorded (Time::Min ())
+{
+  NS_LOG_FUNCTION (this << recorder << flowId);
+  m_block.reserve (m_recorder->m_blockSize * TcpRttRecorder::RECORD_SIZE);
+}
+
+TcpRttSampleStream::~TcpRttSampleStream ()
+{
+  NS_LOG_FUNCTION (this);
+  Flush ();
+  m_recorder->RemoveStream (this);
+}
+
+void
+TcpRttSampleStream::Record (const TcpRttSample &sample)
+{
+  if (++m_skipped < m_recorder->m_sampleEvery)
+    {
+      return;
+    }
+  if (m_lastRecorded != Time::Min () && sample.time - m_lastRecorded < m_recorder->m_minInterval)
+    {
+      return;
+    }
+  m_skipped = 0;
+  m_lastRecorded = sample.time;
+  TcpRttRecorder::Encode (m_block, m_flowId, sample);
+  if (m_block.size () >= m_recorder->m_blockSize * TcpRttRecorder::RECORD_SIZE)
+    {
+      Flush ();
+    }
+}
+
+void
+TcpRttSampleStream::Flush (void)
+{
+  if (!m_block.empty ())
+    {
+      m_recorder->WriteBlock (m_block);
+      m_block.clear ();
+    }
+}
+
+uint32_t
+TcpRttSampleStream::GetFlowId (void) const
+{
+  return m_flowId;
+}
+
+TypeId
+TcpRttRecorder::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TcpRttRecorder")
+    .SetParent<Object> ()
+    .SetGroupName ("Internet")
+    .AddConstructor<TcpRttRecorder> ()
+    .AddAttribute ("BlockSize",
+                   "Number of records buffered by each socket before being written",
+                   UintegerValue (1024),
+                   MakeUintegerAccessor (&TcpRttRecorder::m_blockSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("SampleEvery",
+                   "Record one sample out of this many, for each socket",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&TcpRttRecorder::m_sampleEvery),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("MinInterval",
+                   "Minimum time between two recorded samples of a socket",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&TcpRttRecorder::m_minInterval),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+TcpRttRecorder::TcpRttRecorder ()
+  : m_nextFlowId (1)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TcpRttRecorder::~TcpRttRecorder ()
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+}
+
+void
+TcpRttRecorder::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  Close ();
+  Object::DoDispose ();
+}
+
+bool
+TcpRttRecorder::Open (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  Close ();
+  m_os.open (fileName.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_os.is_open ())
+    {
+      NS_LOG_WARN ("Failed to open " << fileName);
+      return false;
+    }
+  std::vector<uint8_t> header (MAGIC, MAGIC + sizeof (MAGIC));
+  PutInteger (header, VERSION, 2);
+  PutInteger (header, RECORD_SIZE, 2);
+  m_os.write (reinterpret_cast<const char *> (header.data ()), header.size ());
+  return true;
+}
+
+bool
+TcpRttRecorder::IsOpen (void) const
+{
+  return m_os.is_open ();
+}
+
+void
+TcpRttRecorder::Close (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_os.is_open ())
+    {
+      return;
+    }
+  // In identifier order, for the file not to depend on memory addresses
+  for (std::map<uint32_t, TcpRttSampleStream *>::iterator it = m_streams.begin (); it != m_streams.end (); ++it)
+    {
+      it->second->Flush ();
+    }
+  m_os.close ();
+}
+
+Ptr<TcpRttSampleStream>
+TcpRttRecorder::CreateStream (void)
+{
+  NS_LOG_FUNCTION (this);
+  Ptr<TcpRttSampleStream> stream = Create<TcpRttSampleStream> (this, m_nextFlowId++);
+  m_streams[stream->GetFlowId ()] = PeekPointer (stream);
+  return stream;
+}
+
+void
+TcpRttRecorder::Fire (Ptr<TcpRttRecorder> recorder, Ptr<TcpRttSampleStream> &stream,
+                      TracedCallback<const TcpRttSample &> &trace, const TcpRttSample &sample)
+{
+  if (recorder && !stream)
+    {
+      stream = recorder->CreateStream ();
+      trace.ConnectWithoutContext (MakeCallback (&TcpRttSampleStream::Record, stream));
+    }
+  trace (sample);
+}
+
+void
+TcpRttRecorder::RemoveStream (TcpRttSampleStream *stream)
+{
+  m_streams.erase (stream->GetFlowId ());
+}
+
+void
+TcpRttRecorder::WriteBlock (const std::vector<uint8_t> &block)
+{
+  if (m_os.is_open ())
+    {
+      m_os.write (reinterpret_cast<const char *> (block.data ()), block.size ());
+    }
+}
+
+void
+TcpRttRecorder::Encode (std::vector<uint8_t> &block, uint32_t flowId, const TcpRttSample &sample)
+{
+  uint32_t flags = (sample.ece ? FLAG_ECE : 0) | (sample.windowEnd ? FLAG_WINDOW_END : 0);
+  PutInteger (block, sample.time.GetNanoSeconds (), 8);
+  PutInteger (block, flowId, 4);
+  PutInteger (block, sample.cwnd, 4);
+  PutInteger (block, sample.rtt.GetNanoSeconds (), 8);
+  PutInteger (block, sample.minRtt.GetNanoSeconds (), 8);
+  PutInteger (block, DoubleBits (sample.alpha), 8);
+  PutInteger (block, DoubleBits (sample.beta), 8);
+  PutInteger (block, sample.bytesAcked, 4);
+  PutInteger (block, sample.ackSeq, 4);
+  PutInteger (block, sample.nextTxSeq, 4);
+  PutInteger (block, flags, 4);
+}
+
+bool
+TcpRttRecorder::ReadFile (std::string fileName, std::vector<uint32_t> &flowIds,
+                          std::vector<TcpRttSample> &samples)
+{
+  NS_LOG_FUNCTION (fileName);
+  std::ifstream is (fileName.c_str (), std::ios::in | std::ios::binary);
+  uint8_t header[12];
+  if (!is.read (reinterpret_cast<char *> (header), sizeof (header))
+      || std::memcmp (header, MAGIC, sizeof (MAGIC)) != 0
+      || GetInteger (header + 8, 2) != VERSION)
+    {
+      return false;
+    }
+  uint32_t recordSize = GetInteger (header + 10, 2);
+  if (recordSize < RECORD_SIZE)
+    {
+      return false;
+    }
+  std::vector<uint8_t> record (recordSize);
+  while (is.read (reinterpret_cast<char *> (record.data ()), recordSize))
+    {
+      const uint8_t *data = record.data ();
+      TcpRttSample sample;
+      sample.time = NanoSeconds (static_cast<int64_t> (GetInteger (data, 8)));
+      flowIds.push_back (GetInteger (data + 8, 4));
+      sample.cwnd = GetInteger (data + 12, 4);
+      sample.rtt = NanoSeconds (static_cast<int64_t> (GetInteger (data + 16, 8)));
+      sample.minRtt = NanoSeconds (static_cast<int64_t> (GetInteger (data + 24, 8)));
+      sample.alpha = BitsDouble (GetInteger (data + 32, 8));
+      sample.beta = BitsDouble (GetInteger (data + 40, 8));
+      sample.bytesAcked = GetInteger (data + 48, 4);
+      sample.ackSeq = GetInteger (data + 52, 4);
+      sample.nextTxSeq = GetInteger (data + 56, 4);
+      uint32_t flags = GetInteger (data + 60, 4);
+      sample.ece = (flags & FLAG_ECE) != 0;
+      sample.windowEnd = (flags & FLAG_WINDOW_END) != 0;
+      samples.push_back (sample);
+    }
+  return true;
+}
+
+} // namespace ns3
@@ -0,0 +1,247 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef TCP_RTT_RECORDER_H
+#define TCP_RTT_RECORDER_H
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3 {
+
+class TcpSocketState;
+
+/**
+ * \ingroup tcp
+ *
+ * \brief The state of a delay-sensitive congestion control upon an ACK
+ *
+ * Emitted by the "RttSample" trace source of TcpDctcp, TcpDstcp and
+ * TcpDcVegas once per call to PktsAcked, after the congestion estimates
+ * were updated.
+ */
+struct TcpRttSample
+{
+  Time time;             //!< Time of the ACK
+  Time rtt;              //!< RTT sample of the ACK, zero if none
+  Time minRtt;           //!< Minimum RTT, including this sample
+  uint32_t cwnd;         //!< Congestion window upon the ACK, in bytes
+  double alpha;          //!< ECN congestion estimate, 0 if not used
+  double beta;           //!< RTT congestion estimate, 0 if not used
+  uint32_t bytesAcked;   //!< Bytes acknowledged by the ACK
+  uint32_t ackSeq;       //!< Highest acknowledged sequence number
+  uint32_t nextTxSeq;    //!< Next sequence number to send
+  bool ece;              //!< Did the ACK carry ECE
+  bool windowEnd;        //!< Did the ACK end an observation window
+
+  /**
+   * \brief Build the sample of an ACK, at the current time
+   * \param tcb internal congestion state, after the ACK
+   * \param segmentsAcked count of segments acked
+   * \param rtt the RTT sample, zero if none
+   * \param minRtt the minimum RTT, zero if not used
+   * \param cwnd the congestion window upon the ACK
+   * \param alpha the ECN congestion estimate, 0 if not used
+   * \param beta the RTT congestion estimate, 0 if not used
+   * \param windowEnd whether the ACK ended an observation window
+   * \returns the sample
+   */
+  static TcpRttSample FromAck (Ptr<const TcpSocketState> tcb, uint32_t segmentsAcked,
+                               const Time &rtt, const Time &minRtt, uint32_t cwnd,
+                               double alpha, double beta, bool windowEnd);
+};
+
+class TcpRttRecorder;
+
+/**
+ * \ingroup tcp
+ *
+ * \brief The samples of one socket, buffered before being written by a
+ * TcpRttRecorder
+ *
+ * Connected to the "RttSample" trace source of a congestion control.
+ * The samples are kept in a block of TcpRttRecorder::BlockSize records,
+ * written to the file when full, so that the file is written once per
+ * block rather than on each ACK.
+ */
+class TcpRttSampleStream : public SimpleRefCount<TcpRttSampleStream>
+{
+public:
+  /**
+   * \brief Constructor
+   * \param recorder the recorder writing the samples
+   * \param flowId the identifier of the stream in the file
+   */
+  TcpRttSampleStream (Ptr<TcpRttRecorder> recorder, uint32_t flowId);
+  /// Write the samples left in the block
+  ~TcpRttSampleStream ();
+
+  /**
+   * \brief Record a sample, unless it is skipped by the downsampling
+   * \param sample the sample
+   */
+  void Record (const TcpRttSample &sample);
+  /// Write the buffered samples to the recorder
+  void Flush (void);
+  /// \returns the identifier of the stream in the file
+  uint32_t GetFlowId (void) const;
+
+private:
+  Ptr<TcpRttRecorder> m_recorder;   //!< Recorder writing the samples
+  uint32_t m_flowId;                //!< Identifier of the stream
+  uint32_t m_skipped;               //!< Samples skipped since the last one recorded
+  Time m_lastRecorded;              //!< Time of the last sample recorded
+  std::vector<uint8_t> m_block;     //!< Samples not written yet
+};
+
+/**
+ * \ingroup tcp
+ *
+ * \brief Writes the RTT samples of TCP sockets as fixed-size binary
+ * records
+ *
+ * A recorder is given to the congestion controls through their
+ * "RttRecorder" attribute, usually for all the sockets at once:
+ *
+ * \code
+ *   Ptr<TcpRttRecorder> recorder = CreateObject<TcpRttRecorder> ();
+ *   recorder->Open ("rtt.bin");
+ *   Config::SetDefault ("ns3::TcpDstcp::RttRecorder", PointerValue (recorder));
+ *   Simulator::Run ();
+ *   recorder->Close ();
+ * \endcode
+ *
+ * The file starts with the 8 bytes "NS3RTTSR", a 16-bit version and the
+ * size of the records on 16 bits.  Each record holds:
+ *
+ * - the time of the ACK in nanoseconds on 64 bits;
+ * - the identifier of the socket on 32 bits, numbered from 1 in the
+ *   order the sockets recorded their first sample;
+ * - the congestion window in bytes on 32 bits;
+ * - the RTT sample and the minimum RTT in nanoseconds on 64 bits;
+ * - alpha and beta as 64-bit IEEE 754 doubles;
+ * - the bytes acknowledged, the highest acknowledged sequence number and
+ *   the next sequence number to send on 32 bits;
+ * - flags on 32 bits: bit 0 for ECE, bit 1 for the end of an observation
+ *   window.
+ *
+ * All the integers are little endian.  Close() must be called for the
+ * samples of the sockets still alive to be written, as the default value
+ * of an attribute keeps the recorder alive until the program exits.
+ *
+ * A recorder and its streams are not thread-safe: they cannot record the
+ * sockets of a multithreaded simulation, whose partitions would share
+ * them.
+ */
+class TcpRttRecorder : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  TcpRttRecorder ();
+  virtual ~TcpRttRecorder ();
+
+  /// Size of a record, in bytes
+  static const uint32_t RECORD_SIZE = 64;
+
+  /**
+   * \brief Create the file and write its header
+   * \param fileName name or path of the file
+   * \returns false if the file could not be created
+   */
+  bool Open (std::string fileName);
+  /// \returns true if the file is open
+  bool IsOpen (void) const;
+  /// Write the samples buffered by the streams and close the file
+  void Close (void);
+
+  /**
+   * \brief Create the stream of a socket
+   * \returns the stream, with a new identifier
+   */
+  Ptr<TcpRttSampleStream> CreateStream (void);
+
+  /**
+   * \brief Fire the "RttSample" trace source of a congestion control
+   *
+   * On the first sample, if the congestion control was given a recorder,
+   * the stream of the socket is created and connected to the trace source.
+   *
+   * \param recorder the recorder of the congestion control, if any
+   * \param stream the stream of the socket, created if null
+   * \param trace the trace source
+   * \param sample the sample
+   */
+  static void Fire (Ptr<TcpRttRecorder> recorder, Ptr<TcpRttSampleStream> &stream,
+                    TracedCallback<const TcpRttSample &> &trace, const TcpRttSample &sample);
+
+  /**
+   * \brief Read the records of a file
+   * \param fileName name or path of the file
+   * \param flowIds the socket identifiers of the records, filled
+   * \param samples the samples, filled
+   * \returns false if the file could not be read or has no valid header
+   */
+  static bool ReadFile (std::string fileName, std::vector<uint32_t> &flowIds,
+                        std::vector<TcpRttSample> &samples);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  friend class TcpRttSampleStream;
+
+  /**
+   * \brief Append a sample to a block of records
+   * \param block the block
+   * \param flowId the identifier of the socket
+   * \param sample the sample
+   */
+  static void Encode (std::vector<uint8_t> &block, uint32_t flowId, const TcpRttSample &sample);
+  /**
+   * \brief Write a block of records to the file
+   * \param block the block
+   */
+  void WriteBlock (const std::vector<uint8_t> &block);
+  /**
+   * \brief Forget a stream being destroyed
+   * \param stream the stream
+   */
+  void RemoveStream (TcpRttSampleStream *stream);
+
+  uint32_t m_blockSize;                     //!< Records buffered by each stream
+  uint32_t m_sampleEvery;                   //!< Record one sample out of this many
+  Time m_minInterval;                       //!< Minimum time between the samples of a stream
+  std::ofstream m_os;                       //!< Output file
+  uint32_t m_nextFlowId;                    //!< Identifier of the next stream
+  std::map<uint32_t, TcpRttSampleStream *> m_streams; //!< Streams alive, by identifier
+};
+
+} // namespace ns3
+
+#endif /* TCP_RTT_RECORDER_H */
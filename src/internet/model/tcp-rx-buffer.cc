@@ -18,6 +18,8 @@
  * Author: Adrian Sai-wah Tam <adrian.sw.tam@gmail.com>
  */
 
+#include <algorithm>
+
 #include "ns3/packet.h"
 #include "ns3/log.h"
 #include "tcp-rx-buffer.h"
@@ -51,7 +53,8 @@ TcpRxBuffer::GetTypeId (void)
  * initialized below is insignificant.
  */
 TcpRxBuffer::TcpRxBuffer (uint32_t n)
-  : m_nextRxSeq (n), m_gotFin (false), m_size (0), m_maxBuffer (32768), m_availBytes (0)
+  : m_nextRxSeq (n), m_gotFin (false), m_size (0), m_maxBuffer (32768), m_availBytes (0),
+    m_virtualPayload (false)
 {
 }
 
@@ -83,6 +86,18 @@ TcpRxBuffer::SetMaxBufferSize (uint32_t s)
   m_maxBuffer = s;
 }
 
+bool
+TcpRxBuffer::IsVirtualPayload (void) const
+{
+  return m_virtualPayload;
+}
+
+void
+TcpRxBuffer::SetVirtualPayload (bool enabled)
+{
+  m_virtualPayload = enabled;
+}
+
 uint32_t
 TcpRxBuffer::Size (void) const
 {
@@ -155,16 +170,21 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
       if (maxSeq < tailSeq) tailSeq = maxSeq;
       if (tailSeq < headSeq) headSeq = tailSeq;
     }
-  // Remove overlapped bytes from packet
-  BufIterator i = m_data.begin ();
+  // Remove overlapped bytes from packet. The blocks before the one holding
+  // headSeq end before it.
+  BufIterator i = m_data.upper_bound (headSeq);
+  if (i != m_data.begin ())
+    {
+      --i;
+    }
   while (i != m_data.end () && i->first <= tailSeq)
     {
-      SequenceNumber32 lastByteSeq = i->first + SequenceNumber32 (i->second->GetSize ());
+      SequenceNumber32 lastByteSeq = i->second.m_end;
       if (lastByteSeq > headSeq)
         {
           if (i->first > headSeq && lastByteSeq < tailSeq)
-            { // Rare case: Existing packet is embedded fully in the new packet
-              m_size -= i->second->GetSize ();
+            { // Rare case: Existing block is embedded fully in the new packet
+              m_size -= static_cast<uint32_t> (lastByteSeq - i->first);
               m_data.erase (i++);
               continue;
             }
@@ -179,22 +199,47 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
         }
       ++i;
     }
-  // We now know how much we are going to store, trim the packet
+  // We now know how much we are going to store
   if (headSeq >= tailSeq)
     {
       NS_LOG_LOGIC ("Nothing to buffer");
       return false; // Nothing to buffer anyway
     }
-  else
+  Piece piece;
+  piece.m_packet = p;
+  piece.m_offset = static_cast<uint32_t> (headSeq - tcph.GetSequenceNumber ());
+  piece.m_length = static_cast<uint32_t> (tailSeq - headSeq);
+
+  // Insert the piece into buffer, appending it to the block ending at
+  // headSeq if any, and merging the block starting at tailSeq if any
+  BufIterator next = m_data.lower_bound (tailSeq);
+  BufIterator block = next;
+  if (next == m_data.begin () || (--block)->second.m_end != headSeq)
     {
-      uint32_t start = static_cast<uint32_t> (headSeq - tcph.GetSequenceNumber ());
-      uint32_t length = static_cast<uint32_t> (tailSeq - headSeq);
-      p = p->CreateFragment (start, length);
-      NS_ASSERT (length == p->GetSize ());
+      block = m_data.emplace_hint (next, headSeq, Block ());
+    }
+  block->second.m_end = tailSeq;
+  if (!m_virtualPayload)
+    {
+      block->second.m_pieces.push_back (piece);
+    }
+  if (next != m_data.end () && next->first == tailSeq)
+    {
+      // Move the pieces of the smallest block into the other one
+      std::deque<Piece> &pieces = block->second.m_pieces;
+      std::deque<Piece> &nextPieces = next->second.m_pieces;
+      if (pieces.size () >= nextPieces.size ())
+        {
+          pieces.insert (pieces.end (), nextPieces.begin (), nextPieces.end ());
+        }
+      else
+        {
+          nextPieces.insert (nextPieces.begin (), pieces.begin (), pieces.end ());
+          pieces.swap (nextPieces);
+        }
+      block->second.m_end = next->second.m_end;
+      m_data.erase (next);
     }
-  // Insert packet into buffer
-  NS_ASSERT (m_data.find (headSeq) == m_data.end ()); // Shouldn't be there yet
-  m_data [ headSeq ] = p;
 
   if (headSeq > m_nextRxSeq)
     {
@@ -202,21 +247,15 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
       UpdateSackList (headSeq, tailSeq);
     }
 
-  NS_LOG_LOGIC ("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize ());
+  NS_LOG_LOGIC ("Buffered packet of seqno=" << headSeq << " len=" << piece.m_length);
   // Update variables
-  m_size += p->GetSize ();      // Occupancy
-  for (i = m_data.begin (); i != m_data.end (); ++i)
+  m_size += piece.m_length;     // Occupancy
+  i = m_data.upper_bound (m_nextRxSeq);
+  if (i != m_data.begin () && (--i)->second.m_end > m_nextRxSeq)
     {
-      if (i->first < m_nextRxSeq)
-        {
-          continue;
-        }
-      else if (i->first > m_nextRxSeq)
-        {
-          break;
-        };
-      m_nextRxSeq = i->first + SequenceNumber32 (i->second->GetSize ());
-      m_availBytes += i->second->GetSize ();
+      // The block holding nextRxSeq is contiguous up to its end
+      m_availBytes += static_cast<uint32_t> (i->second.m_end - m_nextRxSeq);
+      m_nextRxSeq = i->second.m_end;
       ClearSackList (m_nextRxSeq);
     }
   NS_LOG_LOGIC ("Updated buffer occupancy=" << m_size << " nextRxSeq=" << m_nextRxSeq);
@@ -354,7 +393,7 @@ TcpRxBuffer::ClearSackList (const SequenceNumber32 &seq)
     }
 }
 
-TcpOptionSack::SackList
+const TcpOptionSack::SackList &
 TcpRxBuffer::GetSackList () const
 {
   return m_sackList;
@@ -369,31 +408,66 @@ TcpRxBuffer::Extract (uint32_t maxSize)
   NS_LOG_LOGIC ("Requested to extract " << extractSize << " bytes from TcpRxBuffer of size=" << m_size);
   if (extractSize == 0) return nullptr;  // No contiguous block to return
   NS_ASSERT (m_data.size ()); // At least we have something to extract
-  Ptr<Packet> outPkt = Create<Packet> (); // The packet that contains all the data to return
-  BufIterator i;
-  while (extractSize)
-    { // Check the buffered data for delivery
-      i = m_data.begin ();
-      NS_ASSERT (i->first <= m_nextRxSeq); // in-sequence data expected
-      // Check if we send the whole pkt or just a partial
-      uint32_t pktSize = i->second->GetSize ();
-      if (pktSize <= extractSize)
-        { // Whole packet is extracted
-          outPkt->AddAtEnd (i->second);
-          m_data.erase (i);
-          m_size -= pktSize;
-          m_availBytes -= pktSize;
-          extractSize -= pktSize;
-        }
-      else
-        { // Partial is extracted and done
-          outPkt->AddAtEnd (i->second->CreateFragment (0, extractSize));
-          m_data[i->first + SequenceNumber32 (extractSize)] = i->second->CreateFragment (extractSize, pktSize - extractSize);
-          m_data.erase (i);
-          m_size -= extractSize;
-          m_availBytes -= extractSize;
-          extractSize = 0;
+  BufIterator i = m_data.begin ();
+  NS_ASSERT (i->first <= m_nextRxSeq); // in-sequence data expected
+  std::deque<Piece> &pieces = i->second.m_pieces;
+  Ptr<Packet> outPkt; // The packet that contains all the data to return
+  if (m_virtualPayload)
+    { // Only the size of the data was kept
+      outPkt = Create<Packet> (extractSize);
+    }
+  else
+    {
+      uint32_t extracted = 0;
+      while (extracted < extractSize)
+        { // Check the buffered data for delivery
+          Piece &piece = pieces.front ();
+          uint32_t length = std::min (piece.m_length, extractSize - extracted);
+          Ptr<Packet> part;
+          if (piece.m_offset == 0 && length == piece.m_packet->GetSize ())
+            { // Whole packet is extracted, its copy shares the buffer
+              part = piece.m_packet->Copy ();
+            }
+          else
+            {
+              part = piece.m_packet->CreateFragment (piece.m_offset, length);
+            }
+          if (outPkt == nullptr)
+            {
+              outPkt = part;
+            }
+          else
+            {
+              outPkt->AddAtEnd (part);
+            }
+          extracted += length;
+          if (length == piece.m_length)
+            {
+              pieces.pop_front ();
+            }
+          else
+            { // Partial is extracted and done
+              piece.m_offset += length;
+              piece.m_length -= length;
+            }
         }
+      // As if the data was appended to a new packet
+      outPkt->RemoveAllPacketTags ();
+    }
+  m_size -= extractSize;
+  m_availBytes -= extractSize;
+  if (i->first + SequenceNumber32 (extractSize) == i->second.m_end)
+    {
+      m_data.erase (i);
+    }
+  else
+    { // The rest of the block starts after the extracted data
+      SequenceNumber32 start = i->first + SequenceNumber32 (extractSize);
+      Block rest;
+      rest.m_end = i->second.m_end;
+      rest.m_pieces.swap (pieces);
+      m_data.erase (i);
+      m_data.emplace_hint (m_data.begin (), start, std::move (rest));
     }
   if (outPkt->GetSize () == 0)
     {
@@ -401,7 +475,7 @@ TcpRxBuffer::Extract (uint32_t maxSize)
       return nullptr;
     }
   NS_LOG_LOGIC ("Extracted " << outPkt->GetSize ( ) << " bytes, bufsize=" << m_size
-                             << ", num pkts in buffer=" << m_data.size ());
+                             << ", num blocks in buffer=" << m_data.size ());
   return outPkt;
 }
 
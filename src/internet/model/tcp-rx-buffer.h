@@ -21,6 +21,7 @@
 #ifndef TCP_RX_BUFFER_H
 #define TCP_RX_BUFFER_H
 
+#include <deque>
 #include <map>
 #include "ns3/traced-value.h"
 #include "ns3/trace-source-accessor.h"
@@ -53,6 +54,12 @@ class Packet;
  * To store data, use Add; for retrieving a certain amount of ordered data, use
  * the method Extract.
  *
+ * The received data is kept as blocks of contiguous bytes, which are merged
+ * when a segment fills the hole between them. A block references the parts
+ * of the received packets it is made of instead of fragmenting them, so that
+ * storing a segment never allocates a Packet; fragments are only created by
+ * Extract, when the application reads a part of a segment.
+ *
  * SACK list
  * ---------
  *
@@ -120,6 +127,21 @@ public:
    * \param s the Maximum buffer size
    */
   void SetMaxBufferSize (uint32_t s);
+  /**
+   * \brief Check whether the buffer keeps only the size of the data
+   * \returns true if the content of the received data is discarded
+   */
+  bool IsVirtualPayload (void) const;
+  /**
+   * \brief Keep only the size of the received data
+   *
+   * The received packets are not referenced by the buffer and Extract
+   * returns zero-filled packets whose payload is never allocated (see
+   * Buffer).
+   *
+   * \param enabled whether the content of the received data is discarded
+   */
+  void SetVirtualPayload (bool enabled);
   /**
    * \brief Get the actual buffer occupancy
    * \returns buffer occupancy (in bytes)
@@ -166,7 +188,7 @@ public:
    *
    * \return a list of isolated blocks
    */
-  TcpOptionSack::SackList GetSackList () const;
+  const TcpOptionSack::SackList & GetSackList () const;
 
   /**
    * \brief Get the size of Sack list
@@ -217,15 +239,31 @@ private:
 
   TcpOptionSack::SackList m_sackList; //!< Sack list (updated constantly)
 
+  /// Part of a received packet, referenced without being fragmented
+  struct Piece
+  {
+    Ptr<Packet> m_packet;  //!< Received packet
+    uint32_t m_offset;     //!< Offset of the first byte of the piece in the packet
+    uint32_t m_length;     //!< Length of the piece
+  };
+
+  /// Contiguous bytes received, starting at the key of the block in m_data
+  struct Block
+  {
+    SequenceNumber32 m_end;      //!< Sequence number following the last byte
+    std::deque<Piece> m_pieces;  //!< Pieces of the block, in sequence order
+  };
+
   /// container for data stored in the buffer
-  typedef std::map<SequenceNumber32, Ptr<Packet> >::iterator BufIterator;
+  typedef std::map<SequenceNumber32, Block>::iterator BufIterator;
   TracedValue<SequenceNumber32> m_nextRxSeq; //!< Seqnum of the first missing byte in data (RCV.NXT)
   SequenceNumber32 m_finSeq;                 //!< Seqnum of the FIN packet
   bool m_gotFin;                             //!< Did I received FIN packet?
   uint32_t m_size;                           //!< Number of total data bytes in the buffer, not necessarily contiguous
   uint32_t m_maxBuffer;                      //!< Upper bound of the number of data bytes in buffer (RCV.WND)
   uint32_t m_availBytes;                     //!< Number of bytes available to read, i.e. contiguous block at head
-  std::map<SequenceNumber32, Ptr<Packet> > m_data; //!< Corresponding data (may be null)
+  bool m_virtualPayload;                     //!< Are the blocks kept without their pieces?
+  std::map<SequenceNumber32, Block> m_data; //!< Disjoint, non-contiguous blocks of data, by starting sequence
 };
 
 } //namespace ns3
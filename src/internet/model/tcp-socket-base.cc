@@ -153,6 +153,11 @@ TcpSocketBase::GetTypeId (void)
                    MakeEnumChecker (TcpSocketState::Off, "Off",
                                     TcpSocketState::On, "On",
                                     TcpSocketState::AcceptOnly, "AcceptOnly"))
+    .AddAttribute ("VirtualPayload",
+                   "Keep only the size of the data in the buffers, discarding its content",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&TcpSocketBase::SetVirtualPayload),
+                   MakeBooleanChecker ())
     .AddTraceSource ("RTO",
                      "Retransmission timeout",
                      MakeTraceSourceAccessor (&TcpSocketBase::m_rto),
@@ -269,25 +274,40 @@ TcpSocketBase::TcpSocketBase (void)
                                           MakeCallback (&TcpSocketBase::UpdatePacingRateTrace, this));
   NS_ASSERT (ok == true);
 
-  ok = m_tcb->TraceConnectWithoutContext ("CongestionWindow",
-                                          MakeCallback (&TcpSocketBase::UpdateCwnd, this));
-  NS_ASSERT (ok == true);
+  if (!IsPruned (m_cWndTrace))
+    {
+      ok = m_tcb->TraceConnectWithoutContext ("CongestionWindow",
+                                              MakeCallback (&TcpSocketBase::UpdateCwnd, this));
+      NS_ASSERT (ok == true);
+    }
 
-  ok = m_tcb->TraceConnectWithoutContext ("CongestionWindowInflated",
-                                          MakeCallback (&TcpSocketBase::UpdateCwndInfl, this));
-  NS_ASSERT (ok == true);
+  if (!IsPruned (m_cWndInflTrace))
+    {
+      ok = m_tcb->TraceConnectWithoutContext ("CongestionWindowInflated",
+                                              MakeCallback (&TcpSocketBase::UpdateCwndInfl, this));
+      NS_ASSERT (ok == true);
+    }
 
-  ok = m_tcb->TraceConnectWithoutContext ("SlowStartThreshold",
-                                          MakeCallback (&TcpSocketBase::UpdateSsThresh, this));
-  NS_ASSERT (ok == true);
+  if (!IsPruned (m_ssThTrace))
+    {
+      ok = m_tcb->TraceConnectWithoutContext ("SlowStartThreshold",
+                                              MakeCallback (&TcpSocketBase::UpdateSsThresh, this));
+      NS_ASSERT (ok == true);
+    }
 
-  ok = m_tcb->TraceConnectWithoutContext ("CongState",
-                                          MakeCallback (&TcpSocketBase::UpdateCongState, this));
-  NS_ASSERT (ok == true);
+  if (!IsPruned (m_congStateTrace))
+    {
+      ok = m_tcb->TraceConnectWithoutContext ("CongState",
+                                              MakeCallback (&TcpSocketBase::UpdateCongState, this));
+      NS_ASSERT (ok == true);
+    }
 
-  ok = m_tcb->TraceConnectWithoutContext ("EcnState",
-                                          MakeCallback (&TcpSocketBase::UpdateEcnState, this));
-  NS_ASSERT (ok == true);
+  if (!IsPruned (m_ecnStateTrace))
+    {
+      ok = m_tcb->TraceConnectWithoutContext ("EcnState",
+                                              MakeCallback (&TcpSocketBase::UpdateEcnState, this));
+      NS_ASSERT (ok == true);
+    }
 
   ok = m_tcb->TraceConnectWithoutContext ("NextTxSequence",
                                           MakeCallback (&TcpSocketBase::UpdateNextTxSequence, this));
@@ -297,9 +317,12 @@ TcpSocketBase::TcpSocketBase (void)
                                           MakeCallback (&TcpSocketBase::UpdateHighTxMark, this));
   NS_ASSERT (ok == true);
 
-  ok = m_tcb->TraceConnectWithoutContext ("BytesInFlight",
-                                          MakeCallback (&TcpSocketBase::UpdateBytesInFlight, this));
-  NS_ASSERT (ok == true);
+  if (!IsPruned (m_bytesInFlightTrace))
+    {
+      ok = m_tcb->TraceConnectWithoutContext ("BytesInFlight",
+                                              MakeCallback (&TcpSocketBase::UpdateBytesInFlight, this));
+      NS_ASSERT (ok == true);
+    }
 
   ok = m_tcb->TraceConnectWithoutContext ("RTT",
                                           MakeCallback (&TcpSocketBase::UpdateRtt, this));
@@ -403,25 +426,40 @@ TcpSocketBase::TcpSocketBase (const TcpSocketBase& sock)
   ok = m_tcb->TraceConnectWithoutContext ("PacingRate",
                                           MakeCallback (&TcpSocketBase::UpdatePacingRateTrace, this));
 
-  ok = m_tcb->TraceConnectWithoutContext ("CongestionWindow",
-                                          MakeCallback (&TcpSocketBase::UpdateCwnd, this));
-  NS_ASSERT (ok == true);
+  if (!IsPruned (m_cWndTrace))
+    {
+      ok = m_tcb->TraceConnectWithoutContext ("CongestionWindow",
+                                              MakeCallback (&TcpSocketBase::UpdateCwnd, this));
+      NS_ASSERT (ok == true);
+    }
 
-  ok = m_tcb->TraceConnectWithoutContext ("CongestionWindowInflated",
-                                          MakeCallback (&TcpSocketBase::UpdateCwndInfl, this));
-  NS_ASSERT (ok == true);
+  if (!IsPruned (m_cWndInflTrace))
+    {
+      ok = m_tcb->TraceConnectWithoutContext ("CongestionWindowInflated",
+                                              MakeCallback (&TcpSocketBase::UpdateCwndInfl, this));
+      NS_ASSERT (ok == true);
+    }
 
-  ok = m_tcb->TraceConnectWithoutContext ("SlowStartThreshold",
-                                          MakeCallback (&TcpSocketBase::UpdateSsThresh, this));
-  NS_ASSERT (ok == true);
+  if (!IsPruned (m_ssThTrace))
+    {
+      ok = m_tcb->TraceConnectWithoutContext ("SlowStartThreshold",
+                                              MakeCallback (&TcpSocketBase::UpdateSsThresh, this));
+      NS_ASSERT (ok == true);
+    }
 
-  ok = m_tcb->TraceConnectWithoutContext ("CongState",
-                                          MakeCallback (&TcpSocketBase::UpdateCongState, this));
-  NS_ASSERT (ok == true);
+  if (!IsPruned (m_congStateTrace))
+    {
+      ok = m_tcb->TraceConnectWithoutContext ("CongState",
+                                              MakeCallback (&TcpSocketBase::UpdateCongState, this));
+      NS_ASSERT (ok == true);
+    }
 
-  ok = m_tcb->TraceConnectWithoutContext ("EcnState",
-                                          MakeCallback (&TcpSocketBase::UpdateEcnState, this));
-  NS_ASSERT (ok == true);
+  if (!IsPruned (m_ecnStateTrace))
+    {
+      ok = m_tcb->TraceConnectWithoutContext ("EcnState",
+                                              MakeCallback (&TcpSocketBase::UpdateEcnState, this));
+      NS_ASSERT (ok == true);
+    }
 
   ok = m_tcb->TraceConnectWithoutContext ("NextTxSequence",
                                           MakeCallback (&TcpSocketBase::UpdateNextTxSequence, this));
@@ -431,9 +469,12 @@ TcpSocketBase::TcpSocketBase (const TcpSocketBase& sock)
                                           MakeCallback (&TcpSocketBase::UpdateHighTxMark, this));
   NS_ASSERT (ok == true);
 
-  ok = m_tcb->TraceConnectWithoutContext ("BytesInFlight",
-                                          MakeCallback (&TcpSocketBase::UpdateBytesInFlight, this));
-  NS_ASSERT (ok == true);
+  if (!IsPruned (m_bytesInFlightTrace))
+    {
+      ok = m_tcb->TraceConnectWithoutContext ("BytesInFlight",
+                                              MakeCallback (&TcpSocketBase::UpdateBytesInFlight, this));
+      NS_ASSERT (ok == true);
+    }
 
   ok = m_tcb->TraceConnectWithoutContext ("RTT",
                                           MakeCallback (&TcpSocketBase::UpdateRtt, this));
@@ -4201,7 +4242,7 @@ TcpSocketBase::AddOptionSack (TcpHeader& header)
   uint8_t optionLenAvail = header.GetMaxOptionLength () - header.GetOptionLength ();
   uint8_t allowedSackBlocks = (optionLenAvail - 2) / 8;
 
-  TcpOptionSack::SackList sackList = m_tcb->m_rxBuffer->GetSackList ();
+  const TcpOptionSack::SackList &sackList = m_tcb->m_rxBuffer->GetSackList ();
   if (allowedSackBlocks == 0 || sackList.empty ())
     {
       NS_LOG_LOGIC ("No space available or sack list empty, not adding sack blocks");
@@ -4210,7 +4251,7 @@ TcpSocketBase::AddOptionSack (TcpHeader& header)
 
   // Append the allowed number of SACK blocks
   Ptr<TcpOptionSack> option = CreateObject<TcpOptionSack> ();
-  TcpOptionSack::SackList::iterator i;
+  TcpOptionSack::SackList::const_iterator i;
   for (i = sackList.begin (); allowedSackBlocks > 0 && i != sackList.end (); ++i)
     {
       option->AddSackBlock (*i);
@@ -4513,7 +4554,7 @@ TcpSocketBase::UpdatePacingRate (void)
   NS_LOG_DEBUG ("Last RTT is " << lastRtt.GetSeconds ());
   
   // Multiply by 8 to convert from bytes per second to bits per second
-  DataRate pacingRate ((std::max (m_tcb->m_cWnd, m_tcb->m_bytesInFlight) * 8 * factor) / lastRtt.GetSeconds ());
+  DataRate pacingRate ((std::max (m_tcb->m_cWnd.Get (), m_tcb->m_bytesInFlight.Get ()) * 8 * factor) / lastRtt.GetSeconds ());
   if (pacingRate < m_tcb->m_maxPacingRate)
     {
       NS_LOG_DEBUG ("Pacing rate updated to: " << pacingRate);
@@ -4540,6 +4581,14 @@ TcpSocketBase::SetPaceInitialWindow (bool paceWindow)
   m_tcb->m_paceInitialWindow = paceWindow;
 }
 
+void
+TcpSocketBase::SetVirtualPayload (bool enabled)
+{
+  NS_LOG_FUNCTION (this << enabled);
+  m_txBuffer->SetVirtualPayload (enabled);
+  m_tcb->m_rxBuffer->SetVirtualPayload (enabled);
+}
+
 void
 TcpSocketBase::SetUseEcn (TcpSocketState::UseEcn_t useEcn)
 {
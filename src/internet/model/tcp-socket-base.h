@@ -325,27 +325,29 @@ public:
   /**
    * \brief Callback pointer for cWnd trace chaining
    */
-  TracedCallback<uint32_t, uint32_t> m_cWndTrace;
+  OptionalTracedCallback<IsTcpStateTraceCompiled ("CongestionWindow"), uint32_t, uint32_t> m_cWndTrace;
 
   /**
    * \brief Callback pointer for cWndInfl trace chaining
    */
-  TracedCallback<uint32_t, uint32_t> m_cWndInflTrace;
+  OptionalTracedCallback<IsTcpStateTraceCompiled ("CongestionWindowInflated"), uint32_t, uint32_t> m_cWndInflTrace;
 
   /**
    * \brief Callback pointer for ssTh trace chaining
    */
-  TracedCallback<uint32_t, uint32_t> m_ssThTrace;
+  OptionalTracedCallback<IsTcpStateTraceCompiled ("SlowStartThreshold"), uint32_t, uint32_t> m_ssThTrace;
 
   /**
    * \brief Callback pointer for congestion state trace chaining
    */
-  TracedCallback<TcpSocketState::TcpCongState_t, TcpSocketState::TcpCongState_t> m_congStateTrace;
+  OptionalTracedCallback<IsTcpStateTraceCompiled ("CongState"),
+                         TcpSocketState::TcpCongState_t, TcpSocketState::TcpCongState_t> m_congStateTrace;
 
    /**
    * \brief Callback pointer for ECN state trace chaining
    */
-  TracedCallback<TcpSocketState::EcnState_t, TcpSocketState::EcnState_t> m_ecnStateTrace;
+  OptionalTracedCallback<IsTcpStateTraceCompiled ("EcnState"),
+                         TcpSocketState::EcnState_t, TcpSocketState::EcnState_t> m_ecnStateTrace;
 
   /**
    * \brief Callback pointer for high tx mark chaining
@@ -360,7 +362,7 @@ public:
   /**
    * \brief Callback pointer for bytesInFlight trace chaining
    */
-  TracedCallback<uint32_t, uint32_t> m_bytesInFlightTrace;
+  OptionalTracedCallback<IsTcpStateTraceCompiled ("BytesInFlight"), uint32_t, uint32_t> m_bytesInFlightTrace;
 
   /**
    * \brief Callback pointer for RTT trace chaining
@@ -571,6 +573,18 @@ public:
    */
   void SetPaceInitialWindow (bool paceWindow);
 
+  /**
+   * \brief Keep only the size of the data in the Tx and Rx buffers
+   *
+   * The data sent and received is then zero-filled, whatever the content
+   * of the packets given by the application; only suited to applications
+   * that do not read the data, such as BulkSendApplication and PacketSink
+   * without SeqTsSizeHeader.
+   *
+   * \param enabled whether the content of the data is discarded
+   */
+  void SetVirtualPayload (bool enabled);
+
   // Necessary implementations of null functions from ns3::Socket
   virtual enum SocketErrno GetErrno (void) const;    // returns m_errno
   virtual enum SocketType GetSocketType (void) const; // returns socket type
@@ -1302,8 +1316,10 @@ protected:
   uint16_t         m_maxWinSize              {0};  //!< Maximum window size to advertise
   uint32_t         m_bytesAckedNotProcessed  {0};  //!< Bytes acked, but not processed
   SequenceNumber32 m_highTxAck               {0};  //!< Highest ack sent
-  TracedValue<uint32_t> m_rWnd               {0};  //!< Receiver window (RCV.WND in RFC793)
-  TracedValue<uint32_t> m_advWnd             {0};  //!< Advertised Window size
+  OptionalTracedValue<TraceSourceRegistry::IsCompiled ("ns3::TcpSocketBase", "RWND"), uint32_t>
+                        m_rWnd               {0};  //!< Receiver window (RCV.WND in RFC793)
+  OptionalTracedValue<TraceSourceRegistry::IsCompiled ("ns3::TcpSocketBase", "AdvWND"), uint32_t>
+                        m_advWnd             {0};  //!< Advertised Window size
   TracedValue<SequenceNumber32> m_highRxMark {0};  //!< Highest seqno received
   TracedValue<SequenceNumber32> m_highRxAckMark {0}; //!< Highest ack received
 
@@ -1335,11 +1351,13 @@ protected:
   bool m_isFirstPartialAck {true}; //!< First partial ACK during RECOVERY
 
   // The following two traces pass a packet with a TCP header
-  TracedCallback<Ptr<const Packet>, const TcpHeader&,
-                 Ptr<const TcpSocketBase> > m_txTrace; //!< Trace of transmitted packets
+  OptionalTracedCallback<TraceSourceRegistry::IsCompiled ("ns3::TcpSocketBase", "Tx"),
+                         Ptr<const Packet>, const TcpHeader&,
+                         Ptr<const TcpSocketBase> > m_txTrace; //!< Trace of transmitted packets
 
-  TracedCallback<Ptr<const Packet>, const TcpHeader&,
-                 Ptr<const TcpSocketBase> > m_rxTrace; //!< Trace of received packets
+  OptionalTracedCallback<TraceSourceRegistry::IsCompiled ("ns3::TcpSocketBase", "Rx"),
+                         Ptr<const Packet>, const TcpHeader&,
+                         Ptr<const TcpSocketBase> > m_rxTrace; //!< Trace of received packets
 
   // Pacing related variable
   Timer m_pacingTimer {Timer::CANCEL_ON_DESTROY}; //!< Pacing Event
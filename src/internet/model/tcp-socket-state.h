@@ -21,11 +21,28 @@
 #include "ns3/object.h"
 #include "ns3/data-rate.h"
 #include "ns3/traced-value.h"
+#include "ns3/trace-source-registry.h"
 #include "ns3/sequence-number.h"
 #include "tcp-rx-buffer.h"
 
 namespace ns3 {
 
+/**
+ * \brief Check whether a trace source of TcpSocketState is compiled
+ *
+ * TcpSocketBase chains the trace sources of its TcpSocketState to its own
+ * sources of the same name, so listing either one compiles both.
+ *
+ * \param source the name of the trace source
+ * \return true if the trace source is compiled
+ */
+constexpr bool
+IsTcpStateTraceCompiled (const char *source)
+{
+  return TraceSourceRegistry::IsCompiled ("ns3::TcpSocketState", source)
+         || TraceSourceRegistry::IsCompiled ("ns3::TcpSocketBase", source);
+}
+
 /**
  * \brief Data structure that records the congestion state of a connection
  *
@@ -159,9 +176,12 @@ public:
   static const char* const EcnStateName[TcpSocketState::ECN_CWR_SENT + 1];
 
   // Congestion control
-  TracedValue<uint32_t>  m_cWnd             {0}; //!< Congestion window
-  TracedValue<uint32_t>  m_cWndInfl         {0}; //!< Inflated congestion window trace (used only for backward compatibility purpose)
-  TracedValue<uint32_t>  m_ssThresh         {0}; //!< Slow start threshold
+  OptionalTracedValue<IsTcpStateTraceCompiled ("CongestionWindow"), uint32_t>
+                         m_cWnd             {0}; //!< Congestion window
+  OptionalTracedValue<IsTcpStateTraceCompiled ("CongestionWindowInflated"), uint32_t>
+                         m_cWndInfl         {0}; //!< Inflated congestion window trace (used only for backward compatibility purpose)
+  OptionalTracedValue<IsTcpStateTraceCompiled ("SlowStartThreshold"), uint32_t>
+                         m_ssThresh         {0}; //!< Slow start threshold
   uint32_t               m_initialCWnd      {0}; //!< Initial cWnd value
   uint32_t               m_initialSsThresh  {0}; //!< Initial Slow Start Threshold value
 
@@ -174,9 +194,11 @@ public:
   uint32_t               m_segmentSize   {0}; //!< Segment size
   SequenceNumber32       m_lastAckedSeq  {0}; //!< Last sequence ACKed
 
-  TracedValue<TcpCongState_t> m_congState {CA_OPEN}; //!< State in the Congestion state machine
+  OptionalTracedValue<IsTcpStateTraceCompiled ("CongState"), TcpCongState_t>
+  m_congState {CA_OPEN}; //!< State in the Congestion state machine
 
-  TracedValue<EcnState_t> m_ecnState {ECN_DISABLED}; //!< Current ECN State, represented as combination of EcnState values
+  OptionalTracedValue<IsTcpStateTraceCompiled ("EcnState"), EcnState_t>
+  m_ecnState {ECN_DISABLED}; //!< Current ECN State, represented as combination of EcnState values
 
   TracedValue<SequenceNumber32> m_highTxMark     {0}; //!< Highest seqno ever sent, regardless of ReTx
   TracedValue<SequenceNumber32> m_nextTxSequence {0}; //!< Next seqnum to be sent (SND.NXT), ReTx pushes it back
@@ -194,7 +216,8 @@ public:
 
   Time                   m_minRtt  {Time::Max ()};   //!< Minimum RTT observed throughout the connection
 
-  TracedValue<uint32_t>  m_bytesInFlight {0};        //!< Bytes in flight
+  OptionalTracedValue<IsTcpStateTraceCompiled ("BytesInFlight"), uint32_t>
+                         m_bytesInFlight {0};        //!< Bytes in flight
   TracedValue<Time>      m_lastRtt {Seconds (0.0)};  //!< Last RTT sample collected
 
   Ptr<TcpRxBuffer>       m_rxBuffer;                 //!< Rx buffer (reordering buffer)
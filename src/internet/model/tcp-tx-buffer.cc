@@ -58,7 +58,8 @@ TcpTxBuffer::GetTypeId (void)
  * initialized below is insignificant.
  */
 TcpTxBuffer::TcpTxBuffer (uint32_t n)
-  : m_maxBuffer (32768), m_size (0), m_sentSize (0), m_firstByteSeq (n)
+  : m_maxBuffer (32768), m_size (0), m_sentSize (0), m_firstByteSeq (n),
+    m_lostUpTo (n)
 {
   m_rWndCallback = MakeNullCallback<uint32_t> ();
 }
@@ -80,6 +81,11 @@ TcpTxBuffer::~TcpTxBuffer (void)
       m_size -= item->m_packet->GetSize ();
       delete item;
     }
+
+  for (auto item : m_freeItems)
+    {
+      delete item;
+    }
 }
 
 SequenceNumber32
@@ -124,6 +130,18 @@ TcpTxBuffer::SetSackEnabled (bool enabled)
   m_sackEnabled = enabled;
 }
 
+bool
+TcpTxBuffer::IsVirtualPayload (void) const
+{
+  return m_virtualPayload;
+}
+
+void
+TcpTxBuffer::SetVirtualPayload (bool enabled)
+{
+  m_virtualPayload = enabled;
+}
+
 uint32_t
 TcpTxBuffer::Available (void) const
 {
@@ -173,7 +191,8 @@ TcpTxBuffer::SetHeadSequence (const SequenceNumber32& seq)
 
   // if you change the head with data already sent, something bad will happen
   NS_ASSERT (m_sentList.size () == 0);
-  m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  m_highestSack = std::make_pair (nullptr, SequenceNumber32 (0));
+  m_lostUpTo = seq;
 }
 
 bool
@@ -184,11 +203,21 @@ TcpTxBuffer::Add (Ptr<Packet> p)
                                 << m_firstByteSeq << ", availSize=" << Available ());
   if (p->GetSize () <= Available ())
     {
-      if (p->GetSize () > 0)
+      if (p->GetSize () > 0 && m_virtualPayload && !m_appList.empty ()
+          && m_appList.back ()->m_lastSent == Time::Max ())
         {
-          TcpTxItem *item = new TcpTxItem ();
-          item->m_packet = p->Copy ();
-          m_appList.insert (m_appList.end (), item);
+          TcpTxItem *item = m_appList.back ();
+          item->m_packet = Create<Packet> (item->m_packet->GetSize () + p->GetSize ());
+          m_size += p->GetSize ();
+
+          NS_LOG_LOGIC ("Updated size=" << m_size << ", lastSeq=" <<
+                        m_firstByteSeq + SequenceNumber32 (m_size));
+        }
+      else if (p->GetSize () > 0)
+        {
+          TcpTxItem *item = NewItem ();
+          item->m_packet = m_virtualPayload ? Create<Packet> (p->GetSize ()) : p->Copy ();
+          m_appList.push_back (item);
           m_size += p->GetSize ();
 
           NS_LOG_LOGIC ("Updated size=" << m_size << ", lastSeq=" <<
@@ -291,12 +320,12 @@ TcpTxBuffer::GetNewSegment (uint32_t numBytes)
                                        numBytes, startOfAppList);
   item->m_startSeq = startOfAppList;
 
-  // Move item from AppList to SentList (should be the first, not too complex)
-  auto it = std::find (m_appList.begin (), m_appList.end (), item);
-  NS_ASSERT (it != m_appList.end ());
+  // Move item from AppList to SentList (it is the first, as the block
+  // starts at the beginning of AppList)
+  NS_ASSERT (m_appList.front () == item);
 
-  m_appList.erase (it);
-  m_sentList.insert (m_sentList.end (), item);
+  m_appList.pop_front ();
+  m_sentList.push_back (item);
   m_sentSize += item->m_packet->GetSize ();
 
   return item;
@@ -310,36 +339,32 @@ TcpTxBuffer::GetTransmittedSegment (uint32_t numBytes, const SequenceNumber32 &s
   NS_ASSERT (numBytes <= m_sentSize);
   NS_ASSERT (m_sentList.size () >= 1);
 
-  auto it = m_sentList.begin ();
+  auto it = m_sentList.begin () + FindSentIndex (seq);
   bool listEdited = false;
   uint32_t s = numBytes;
 
   // Avoid to merge different packet for this retransmission if flags are
   // different.
-  for (; it != m_sentList.end(); ++it)
+  if ((*it)->m_startSeq == seq)
     {
-      if ((*it)->m_startSeq == seq)
+      auto next = it;
+      next++;
+      if (next != m_sentList.end ())
         {
-          auto next = it;
-          next++;
-          if (next != m_sentList.end ())
+          // Next is not sacked and have the same value for m_lost ... there is the possibility to merge
+          if ((! (*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-              // Next is not sacked and have the same value for m_lost ... there is the possibility to merge
-              if ((! (*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                  s = std::min(s, (*it)->m_packet->GetSize () + (*next)->m_packet->GetSize ());
-                }
-              else
-                {
-                  // Next is sacked... better to retransmit only the first segment
-                  s = std::min(s, (*it)->m_packet->GetSize ());
-                }
+              s = std::min(s, (*it)->m_packet->GetSize () + (*next)->m_packet->GetSize ());
             }
           else
             {
+              // Next is sacked... better to retransmit only the first segment
               s = std::min(s, (*it)->m_packet->GetSize ());
             }
-          break;
+        }
+      else
+        {
+          s = std::min(s, (*it)->m_packet->GetSize ());
         }
     }
 
@@ -354,26 +379,56 @@ TcpTxBuffer::GetTransmittedSegment (uint32_t numBytes, const SequenceNumber32 &s
   return item;
 }
 
-std::pair <TcpTxBuffer::PacketList::const_iterator, SequenceNumber32>
+std::pair <TcpTxItem*, SequenceNumber32>
 TcpTxBuffer::FindHighestSacked () const
 {
   NS_LOG_FUNCTION (this);
 
-  SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
-  auto ret = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
-
-  for (auto it = m_sentList.begin (); it != m_sentList.end (); ++it)
+  for (auto it = m_sentList.rbegin (); it != m_sentList.rend (); ++it)
     {
-      const TcpTxItem *item = *it;
-      if (item->m_sacked)
+      if ((*it)->m_sacked)
         {
-          ret = std::make_pair (it, beginOfCurrentPacket);
+          return std::make_pair (*it, (*it)->m_startSeq);
         }
-      beginOfCurrentPacket += item->m_packet->GetSize ();
     }
 
-  return ret;
+  return std::make_pair (nullptr, SequenceNumber32 (0));
+}
+
+uint32_t
+TcpTxBuffer::FindSentIndex (const SequenceNumber32 &seq) const
+{
+  // The sent items are contiguous, and sorted by their starting sequence
+  auto it = std::upper_bound (m_sentList.begin (), m_sentList.end (), seq,
+                              [] (const SequenceNumber32 &s, const TcpTxItem *item)
+                              {
+                                return s < item->m_startSeq;
+                              });
+  if (it != m_sentList.begin ())
+    {
+      --it;
+    }
+  return it - m_sentList.begin ();
+}
+
+TcpTxItem*
+TcpTxBuffer::NewItem (void)
+{
+  if (m_freeItems.empty ())
+    {
+      return new TcpTxItem ();
+    }
+  TcpTxItem *item = m_freeItems.back ();
+  m_freeItems.pop_back ();
+  *item = TcpTxItem ();
+  return item;
+}
+
+void
+TcpTxBuffer::FreeItem (TcpTxItem *item)
+{
+  item->m_packet = nullptr;
+  m_freeItems.push_back (item);
 }
 
 
@@ -400,7 +455,7 @@ TcpTxBuffer::SplitItems (TcpTxItem *t1, TcpTxItem *t2, uint32_t size) const
 TcpTxItem*
 TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listStartFrom,
                                 uint32_t numBytes, const SequenceNumber32 &seq,
-                                bool *listEdited) const
+                                bool *listEdited)
 {
   NS_LOG_FUNCTION (this << numBytes << seq);
 
@@ -437,11 +492,18 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
   PacketList::iterator it = list.begin ();
   SequenceNumber32 beginOfCurrentPacket = listStartFrom;
 
+  if (&list == &m_sentList && !list.empty ())
+    {
+      // Jump to the item holding seq instead of walking from the head
+      it += FindSentIndex (seq);
+      beginOfCurrentPacket = (*it)->m_startSeq;
+    }
+
   while (it != list.end ())
     {
       currentItem = *it;
       currentPacket = currentItem->m_packet;
-      NS_ASSERT_MSG (list != m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
+      NS_ASSERT_MSG (&list != &m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
                      "start: " << m_firstByteSeq << " currentItem start: " <<
                      currentItem->m_startSeq);
 
@@ -467,7 +529,7 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
                            " searching for " << seq <<
                            " and now we recurse because packet ends at "
                                         << beginOfCurrentPacket + currentPacket->GetSize ());
-              TcpTxItem *firstPart = new TcpTxItem ();
+              TcpTxItem *firstPart = NewItem ();
               SplitItems (firstPart, currentItem, seq - beginOfCurrentPacket);
 
               // insert firstPart before currentItem
@@ -520,7 +582,7 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
                   list.erase (it);
 
                   MergeItems (previous, currentItem);
-                  delete currentItem;
+                  FreeItem (currentItem);
                   if (listEdited)
                     {
                       *listEdited = true;
@@ -533,7 +595,7 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
             {
               // the end is inside the current packet, but it isn't exactly
               // the packet end. Just fragment, fix the list, and return.
-              TcpTxItem *firstPart = new TcpTxItem ();
+              TcpTxItem *firstPart = NewItem ();
               SplitItems (firstPart, currentItem, numBytes);
 
               // insert firstPart before currentItem
@@ -568,7 +630,7 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
           MergeItems (currentItem, next);
           list.erase (it);
 
-          delete next;
+          FreeItem (next);
 
           if (listEdited)
             {
@@ -624,7 +686,14 @@ TcpTxBuffer::MergeItems (TcpTxItem *t1, TcpTxItem *t2) const
       t1->m_lastSent = t2->m_lastSent;
     }
 
-  t1->m_packet->AddAtEnd (t2->m_packet);
+  if (m_virtualPayload)
+    {
+      t1->m_packet = Create<Packet> (t1->m_packet->GetSize () + t2->m_packet->GetSize ());
+    }
+  else
+    {
+      t1->m_packet->AddAtEnd (t2->m_packet);
+    }
 
   NS_LOG_INFO ("Situation after the merge: " << *t1);
 }
@@ -724,7 +793,7 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
               beforeDelCb (item);
             }
 
-          delete item;
+          FreeItem (item);
         }
       else if (offset > 0)
         { // Part of the packet is behind the seqnum. Fragment
@@ -774,7 +843,12 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
 
   if (m_highestSack.second <= m_firstByteSeq)
     {
-      m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+      m_highestSack = std::make_pair (nullptr, SequenceNumber32 (0));
+    }
+
+  if (m_lostUpTo < m_firstByteSeq)
+    {
+      m_lostUpTo = m_firstByteSeq;
     }
 
   NS_LOG_DEBUG ("Discarded up to " << seq << " lost: " << m_lostOut <<
@@ -796,15 +870,21 @@ TcpTxBuffer::Update (const TcpOptionSack::SackList &list,
 
   for (auto option_it = list.begin (); option_it != list.end (); ++option_it)
     {
-      PacketList::iterator item_it = m_sentList.begin ();
-      SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
       if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
           NS_LOG_INFO ("Not updating scoreboard, the option block is outside the sent list");
           return bytesSacked;
         }
 
+      // Start from the item holding the beginning of the block: the ones
+      // before cannot be mapped over it
+      PacketList::iterator item_it = m_sentList.begin () + FindSentIndex ((*option_it).first);
+      SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
+      if (item_it != m_sentList.end ())
+        {
+          beginOfCurrentPacket = (*item_it)->m_startSeq;
+        }
+
       while (item_it != m_sentList.end ())
         {
           uint32_t pktSize = (*item_it)->m_packet->GetSize ();
@@ -836,10 +916,10 @@ TcpTxBuffer::Update (const TcpOptionSack::SackList &list,
                   m_sackedOut += (*item_it)->m_packet->GetSize ();
                   bytesSacked += (*item_it)->m_packet->GetSize ();
 
-                  if (m_highestSack.first == m_sentList.end()
+                  if (m_highestSack.first == nullptr
                       || m_highestSack.second <= beginOfCurrentPacket + pktSize)
                     {
-                      m_highestSack = std::make_pair (item_it, beginOfCurrentPacket);
+                      m_highestSack = std::make_pair (*item_it, beginOfCurrentPacket);
                     }
 
                   NS_LOG_INFO ("Received block " << *option_it <<
@@ -869,7 +949,7 @@ TcpTxBuffer::Update (const TcpOptionSack::SackList &list,
 
   if (bytesSacked > 0)
     {
-      NS_ASSERT_MSG (m_highestSack.first != m_sentList.end(), "Buffer status: " << *this);
+      NS_ASSERT_MSG (m_highestSack.first != nullptr, "Buffer status: " << *this);
       UpdateLostCount ();
     }
 
@@ -886,24 +966,36 @@ TcpTxBuffer::UpdateLostCount ()
 {
   NS_LOG_FUNCTION (this);
   uint32_t sacked = 0;
-  SequenceNumber32 beginOfCurrentPacket = m_highestSack.second;
-  if (m_highestSack.first == m_sentList.end ())
+  auto highestSack = m_sentList.end ();
+  if (m_highestSack.first == nullptr)
     {
       NS_LOG_INFO ("Status before the update: " << *this <<
                    ", will start from the latest sent item");
     }
   else
     {
+      highestSack = m_sentList.begin () + FindSentIndex (m_highestSack.second);
       NS_LOG_INFO ("Status before the update: " << *this <<
-                   ", will start from item " << *(*m_highestSack.first));
+                   ", will start from item " << *(*highestSack));
     }
 
-  for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
+  SequenceNumber32 lostUpTo = m_lostUpTo;
+  for (auto it = highestSack; it != m_sentList.begin(); --it)
     {
       TcpTxItem *item = *it;
+      if (item->m_startSeq < m_lostUpTo)
+        {
+          // Marked by a previous update, as the head
+          break;
+        }
+
       if (item->m_sacked)
         {
           sacked++;
+          if (sacked == m_dupAckThresh && item->m_startSeq > lostUpTo)
+            {
+              lostUpTo = item->m_startSeq;
+            }
         }
 
       if (sacked >= m_dupAckThresh)
@@ -914,8 +1006,8 @@ TcpTxBuffer::UpdateLostCount ()
               m_lostOut += item->m_packet->GetSize ();
             }
         }
-      beginOfCurrentPacket -= item->m_packet->GetSize ();
     }
+  m_lostUpTo = lostUpTo;
 
   if (sacked >= m_dupAckThresh)
     {
@@ -935,7 +1027,6 @@ TcpTxBuffer::IsLost (const SequenceNumber32 &seq) const
 {
   NS_LOG_FUNCTION (this << seq);
 
-  SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
   PacketList::const_iterator it;
 
   if (seq >= m_highestSack.second)
@@ -943,12 +1034,11 @@ TcpTxBuffer::IsLost (const SequenceNumber32 &seq) const
       return false;
     }
 
-  // In theory, using a map and hints when inserting elements can improve
-  // performance
-  for (it = m_sentList.begin (); it != m_sentList.end (); ++it)
+  // Start from the item holding seq, the ones before are not considered
+  for (it = m_sentList.begin () + FindSentIndex (seq); it != m_sentList.end (); ++it)
     {
       // Search for the right iterator before calling IsLost()
-      if (beginOfCurrentPacket >= seq)
+      if ((*it)->m_startSeq >= seq)
         {
           if ((*it)->m_lost == true)
             {
@@ -962,8 +1052,6 @@ TcpTxBuffer::IsLost (const SequenceNumber32 &seq) const
               return false;
             }
         }
-
-      beginOfCurrentPacket += (*it)->m_packet->GetSize ();
     }
 
   return false;
@@ -1211,7 +1299,7 @@ TcpTxBuffer::IsLostRFC (const SequenceNumber32 &seq, const PacketList::const_ite
 
       beginOfCurrentPacket += current->GetSize ();
     }
-  if (it == m_highestSack.first)
+  if (it == m_sentList.end ())
     {
       NS_LOG_INFO ("seq=" << seq << " is not lost because there are no sacked segment ahead " << m_highestSack.second);
     }
@@ -1229,7 +1317,8 @@ TcpTxBuffer::ResetRenoSack ()
       (*it)->m_sacked = false;
     }
 
-  m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  m_highestSack = std::make_pair (nullptr, SequenceNumber32 (0));
+  m_lostUpTo = m_firstByteSeq;
 }
 
 void
@@ -1258,7 +1347,8 @@ TcpTxBuffer::ResetSentList ()
   m_lostOut = 0;
   m_retrans = 0;
   m_sackedOut = 0;
-  m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  m_highestSack = std::make_pair (nullptr, SequenceNumber32 (0));
+  m_lostUpTo = m_firstByteSeq;
 }
 
 void
@@ -1290,7 +1380,7 @@ TcpTxBuffer::SetSentListLost (bool resetSack)
     {
       m_sackedOut = 0;
       m_lostOut = m_sentSize;
-      m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+      m_highestSack = std::make_pair (nullptr, SequenceNumber32 (0));
     }
   else
     {
@@ -1417,7 +1507,7 @@ TcpTxBuffer::AddRenoSack (void)
     {
       (*it)->m_sacked = true;
       m_sackedOut += (*it)->m_packet->GetSize ();
-      m_highestSack = std::make_pair (it, (*it)->m_startSeq);
+      m_highestSack = std::make_pair (*it, (*it)->m_startSeq);
       NS_LOG_INFO ("Added a Reno SACK, status: " << *this);
     }
   else
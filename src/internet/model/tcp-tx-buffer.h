@@ -22,6 +22,9 @@
 #ifndef TCP_TX_BUFFER_H
 #define TCP_TX_BUFFER_H
 
+#include <deque>
+#include <vector>
+
 #include "ns3/object.h"
 #include "ns3/traced-value.h"
 #include "ns3/sequence-number.h"
@@ -178,6 +181,23 @@ public:
    */
   void SetSackEnabled (bool enabled);
 
+  /**
+   * \brief check whether the buffer keeps only the size of the data
+   */
+  bool IsVirtualPayload (void) const;
+
+  /**
+   * \brief tell tx-buffer whether to keep only the size of the data
+   *
+   * In this mode the content of the packets given to Add() is discarded
+   * and the segments carry zero-filled payload that is never allocated
+   * (see Buffer); the data added while the last unsent item was never
+   * transmitted extends that item instead of creating a new one.
+   *
+   * \param enabled whether the content of the data is discarded
+   */
+  void SetVirtualPayload (bool enabled);
+
   /**
    * \brief Returns the available capacity of this buffer
    * \returns available capacity in this Tx window
@@ -411,7 +431,15 @@ public:
 private:
   friend std::ostream & operator<< (std::ostream & os, TcpTxBuffer const & tcpTxBuf);
 
-  typedef std::list<TcpTxItem*> PacketList; //!< container for data stored in the buffer
+  /**
+   * \brief Container for data stored in the buffer
+   *
+   * A deque rather than a list: the sent items are contiguous and sorted by
+   * their starting sequence, so the item holding a sequence is found with a
+   * binary search (see FindSentIndex), and splits and merges only move
+   * pointers.
+   */
+  typedef std::deque<TcpTxItem*> PacketList;
 
   /**
    * \brief Update the lost count
@@ -428,8 +456,9 @@ private:
    * The {New}Reno cases, for now, are managed in TcpSocketBase through the
    * call to MarkHeadAsLost.
    * This function is, therefore, called after a SACK option has been received,
-   * and updates the lost count. It can be probably optimized by not walking
-   * the entire list, but a subset.
+   * and updates the lost count. The walk goes down from the highest sacked
+   * item and stops at m_lostUpTo, below which a previous update already
+   * marked every item which is not sacked.
    *
    */
   void UpdateLostCount ();
@@ -562,7 +591,28 @@ private:
    */
   TcpTxItem* GetPacketFromList (PacketList &list, const SequenceNumber32 &startingSeq,
                                 uint32_t numBytes, const SequenceNumber32 &requestedSeq,
-                                bool *listEdited = nullptr) const;
+                                bool *listEdited = nullptr);
+
+  /**
+   * \brief Find the sent item holding a sequence
+   *
+   * \param seq the sequence
+   * \return the index in m_sentList of the item holding seq; 0 if seq is
+   * before the first item, the index of the last item if seq is after it
+   */
+  uint32_t FindSentIndex (const SequenceNumber32 &seq) const;
+
+  /**
+   * \brief Get an item, recycled from the discarded ones if possible
+   * \return an item with default values
+   */
+  TcpTxItem* NewItem (void);
+
+  /**
+   * \brief Keep a discarded item for NewItem
+   * \param item the item, not referenced by the lists anymore
+   */
+  void FreeItem (TcpTxItem *item);
 
   /**
    * \brief Merge two TcpTxItem
@@ -596,10 +646,10 @@ private:
 
   /**
    * \brief Find the highest SACK byte
-   * \return a pair with the highest byte and an iterator inside m_sentList
+   * \return a pair with the highest sacked item (nullptr if none) and its
+   * starting sequence
    */
-  std::pair <TcpTxBuffer::PacketList::const_iterator, SequenceNumber32>
-  FindHighestSacked () const;
+  std::pair <TcpTxItem*, SequenceNumber32> FindHighestSacked () const;
 
   PacketList m_appList;  //!< Buffer for application data
   PacketList m_sentList; //!< Buffer for sent (but not acked) data
@@ -609,7 +659,9 @@ private:
   Callback<uint32_t> m_rWndCallback; //!< Callback to obtain RCV.WND value
 
   TracedValue<SequenceNumber32> m_firstByteSeq; //!< Sequence number of the first byte in data (SND.UNA)
-  std::pair <PacketList::const_iterator, SequenceNumber32> m_highestSack; //!< Highest SACK byte
+  std::pair <TcpTxItem*, SequenceNumber32> m_highestSack; //!< Highest SACKed item (nullptr if none) and its starting sequence
+  std::vector<TcpTxItem*> m_freeItems; //!< Discarded items, recycled by NewItem
+  SequenceNumber32 m_lostUpTo; //!< Every item before it is sacked or lost, UpdateLostCount stops there
 
   uint32_t m_lostOut   {0}; //!< Number of lost bytes
   uint32_t m_sackedOut {0}; //!< Number of sacked bytes
@@ -619,6 +671,7 @@ private:
   uint32_t m_segmentSize {0}; //!< Segment size from TcpSocketBase
   bool     m_renoSack {false}; //!< Indicates if AddRenoSack was called
   bool     m_sackEnabled {true}; //!< Indicates if SACK is enabled on this connection
+  bool     m_virtualPayload {false}; //!< Indicates if only the size of the data is kept
 
   static Callback<void, TcpTxItem *> m_nullCb; //!< Null callback for an item
 };
@@ -266,7 +266,7 @@ TcpVegas::IncreaseWindow (Ptr<TcpSocketState> tcb, uint32_t segmentsAcked)
                   NS_LOG_LOGIC ("We are sending at the right speed");
                 }
             }
-          tcb->m_ssThresh = std::max (tcb->m_ssThresh, 3 * tcb->m_cWnd / 4);
+          tcb->m_ssThresh = std::max (tcb->m_ssThresh.Get (), 3 * tcb->m_cWnd.Get () / 4);
           NS_LOG_DEBUG ("Updated ssThresh = " << tcb->m_ssThresh);
         }
 
@@ -36,6 +36,7 @@
 #include "ns3/ipv6-packet-info-tag.h"
 #include "udp-socket-impl.h"
 #include "udp-l4-protocol.h"
+#include "udp-header.h"
 #include "ipv4-end-point.h"
 #include "ipv6-end-point.h"
 #include <limits>
@@ -617,8 +618,19 @@ UdpSocketImpl::DoSendTo (Ptr<Packet> p, Ipv4Address dest, uint16_t port, uint8_t
       Socket::SocketErrno errno_;
       Ptr<Ipv4Route> route;
       Ptr<NetDevice> oif = m_boundnetdevice; //specify non-zero if bound to a specific device
+      // The route request starts at the transport header, as it does
+      // for the packets sent without a route: routing protocols hashing
+      // flows (e.g., Ipv4GlobalRouting in the PerFlow ECMP mode) read
+      // the ports there.  The header is removed again before sending,
+      // and the tags the routing protocol adds stay on the copy sent.
+      Ptr<Packet> copy = p->Copy ();
+      UdpHeader udpHeader;
+      udpHeader.SetSourcePort (m_endPoint->GetLocalPort ());
+      udpHeader.SetDestinationPort (port);
+      copy->AddHeader (udpHeader);
       // TBD-- we could cache the route and just check its validity
-      route = ipv4->GetRoutingProtocol ()->RouteOutput (p, header, oif, errno_); 
+      route = ipv4->GetRoutingProtocol ()->RouteOutput (copy, header, oif, errno_); 
+      copy->RemoveHeader (udpHeader);
       if (route != 0)
         {
           NS_LOG_LOGIC ("Route exists");
@@ -639,7 +651,7 @@ UdpSocketImpl::DoSendTo (Ptr<Packet> p, Ipv4Address dest, uint16_t port, uint8_t
             }
 
           header.SetSource (route->GetSource ());
-          m_udp->Send (p->Copy (), header.GetSource (), header.GetDestination (),
+          m_udp->Send (copy, header.GetSource (), header.GetDestination (),
                        m_endPoint->GetLocalPort (), port, route);
           NotifyDataSent (p->GetSize ());
           return p->GetSize ();
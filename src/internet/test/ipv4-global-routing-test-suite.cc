@@ -14,7 +14,10 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include <map>
 #include <vector>
+#include <set>
+#include <sstream>
 #include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/inet-socket-address.h"
@@ -42,6 +45,8 @@
 #include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/ipv4-global-routing.h"
 #include "ns3/bridge-helper.h"
+#include "ns3/enum.h"
+#include "ns3/udp-header.h"
 
 using namespace ns3;
 
@@ -115,6 +120,16 @@ NS_LOG_COMPONENT_DEFINE ("Ipv4GlobalRoutingTestSuite");
 //              route to 10.1.2.0 gw 10.1.1.2
 //         n4:  route to 10.1.2.0 gw 0.0.0.0
 //              route to 10.1.1.0 gw 10.1.2.1
+//  ECMP test:
+//                 +--- n2 ---+
+//      n0 <---> n1 -+          +- n4 <---> n5  (point-to-point links)
+//                 +--- n3 ---+
+//      Expected behaviour with EcmpMode=PerFlow on n1:
+//         every packet of a flow to n5 uses the same next hop, and
+//         different flows are spread over both n2 and n3, including
+//         the flows of UDP sockets on n1
+//      Expected behaviour with EcmpMode=Flowlet on n1:
+//         a flow keeps its next hop until idle for FlowletTimeout
 
 
 /**
@@ -823,6 +838,566 @@ TwoBridgeTest::DoRun ()
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Base class of the IPv4 GlobalRouting ECMP tests, on the ECMP
+ * test topology
+ */
+class EcmpTest : public TestCase
+{
+public:
+  virtual void DoSetup (void);
+  /**
+   * Constructor.
+   * \param name the test case name
+   */
+  EcmpTest (std::string name);
+protected:
+  /**
+   * \brief Ask n1 for a route for a UDP packet.
+   * \param sport the source port
+   * \param dport the destination port
+   * \return the gateway chosen
+   */
+  Ipv4Address Route (uint16_t sport, uint16_t dport);
+  /**
+   * \brief Get the global routing of n1, after populating the routing tables.
+   * \param mode the ECMP mode of n1
+   * \return the global routing of n1
+   */
+  Ptr<Ipv4GlobalRouting> GetRouting (Ipv4GlobalRouting::EcmpMode mode);
+  NodeContainer m_nodes; //!< Nodes used in the test.
+  Ipv4Address m_src;     //!< Address of n0.
+  Ipv4Address m_dst;     //!< Address of n5.
+};
+
+EcmpTest::EcmpTest (std::string name)
+  : TestCase (name)
+{
+}
+
+void
+EcmpTest::DoSetup ()
+{
+  m_nodes.Create (6);
+
+  SimpleNetDeviceHelper simpleHelper;
+  simpleHelper.SetNetDevicePointToPointMode (true);
+  uint32_t links[5][2] = { {0, 1}, {1, 2}, {1, 3}, {2, 4}, {3, 4} };
+  std::vector<NetDeviceContainer> nets;
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      Ptr<SimpleChannel> channel = CreateObject <SimpleChannel> ();
+      NetDeviceContainer net = simpleHelper.Install (m_nodes.Get (links[i][0]), channel);
+      net.Add (simpleHelper.Install (m_nodes.Get (links[i][1]), channel));
+      nets.push_back (net);
+    }
+  Ptr<SimpleChannel> channel = CreateObject <SimpleChannel> ();
+  NetDeviceContainer net = simpleHelper.Install (m_nodes.Get (4), channel);
+  net.Add (simpleHelper.Install (m_nodes.Get (5), channel));
+  nets.push_back (net);
+
+  InternetStackHelper internet;
+  Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+  internet.SetRoutingHelper (ipv4RoutingHelper);
+  internet.Install (m_nodes);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  for (uint32_t i = 0; i < nets.size (); i++)
+    {
+      Ipv4InterfaceContainer ifaces = ipv4.Assign (nets[i]);
+      if (i == 0)
+        {
+          m_src = ifaces.GetAddress (0);
+        }
+      if (i == nets.size () - 1)
+        {
+          m_dst = ifaces.GetAddress (1);
+        }
+      ipv4.NewNetwork ();
+    }
+}
+
+Ipv4Address
+EcmpTest::Route (uint16_t sport, uint16_t dport)
+{
+  Ptr<Packet> p = Create<Packet> (100);
+  UdpHeader udp;
+  udp.SetSourcePort (sport);
+  udp.SetDestinationPort (dport);
+  p->AddHeader (udp);
+
+  Ipv4Header header;
+  header.SetSource (m_src);
+  header.SetDestination (m_dst);
+  header.SetProtocol (17);
+
+  Socket::SocketErrno err;
+  Ptr<Ipv4RoutingProtocol> routing = m_nodes.Get (1)->GetObject<Ipv4> ()->GetRoutingProtocol ();
+  Ptr<Ipv4Route> route = routing->RouteOutput (p, header, 0, err);
+  NS_ASSERT (route != 0);
+  return route->GetGateway ();
+}
+
+Ptr<Ipv4GlobalRouting>
+EcmpTest::GetRouting (Ipv4GlobalRouting::EcmpMode mode)
+{
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  Ptr<Ipv4GlobalRouting> globalRouting1 =
+    m_nodes.Get (1)->GetObject<Ipv4> ()->GetRoutingProtocol ()->GetObject<Ipv4GlobalRouting> ();
+  NS_ASSERT_MSG (globalRouting1 != 0, "Error-- no Ipv4GlobalRouting object");
+  globalRouting1->SetAttribute ("EcmpMode", EnumValue (mode));
+  return globalRouting1;
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting per-flow ECMP test
+ *
+ * Also checks that changing EcmpSalt moves the flows.
+ */
+class EcmpPerFlowTest : public EcmpTest
+{
+public:
+  virtual void DoRun (void);
+  EcmpPerFlowTest ();
+};
+
+EcmpPerFlowTest::EcmpPerFlowTest ()
+  : EcmpTest ("Global routing with per-flow ECMP")
+{
+}
+
+void
+EcmpPerFlowTest::DoRun ()
+{
+  Ptr<Ipv4GlobalRouting> globalRouting1 = GetRouting (Ipv4GlobalRouting::ECMP_PER_FLOW);
+
+  std::set<Ipv4Address> gateways;
+  std::vector<Ipv4Address> paths;
+  for (uint16_t sport = 1000; sport < 1064; sport++)
+    {
+      Ipv4Address gw = Route (sport, 80);
+      gateways.insert (gw);
+      paths.push_back (gw);
+      for (uint32_t i = 0; i < 10; i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (Route (sport, 80), gw, "Error-- flow changed path");
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (gateways.size (), 2, "Error-- flows not spread over both paths");
+
+  // the salt is taken into account once the node salt was computed
+  globalRouting1->SetAttribute ("EcmpSalt", UintegerValue (12345));
+  uint32_t moved = 0;
+  for (uint16_t sport = 1000; sport < 1064; sport++)
+    {
+      if (Route (sport, 80) != paths[sport - 1000])
+        {
+          moved++;
+        }
+    }
+  NS_TEST_ASSERT_MSG_GT (moved, 0, "Error-- no flow moved by a new salt");
+  globalRouting1->SetAttribute ("EcmpSalt", UintegerValue (0));
+  for (uint16_t sport = 1000; sport < 1064; sport++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (Route (sport, 80), paths[sport - 1000], "Error-- flow not back on its path");
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting flowlet ECMP test
+ *
+ * Checks that a flow keeps its route while its packets are closer than
+ * FlowletTimeout, may move to another route after a longer gap, and that
+ * the flowlet table is swept once it holds enough idle flows.
+ */
+class EcmpFlowletTest : public EcmpTest
+{
+public:
+  virtual void DoRun (void);
+  EcmpFlowletTest ();
+private:
+  /**
+   * \brief Route one packet of some flows.
+   * \param first the source port of the first flow
+   * \param flows the number of flows, with consecutive source ports
+   * \param paths the gateways chosen, filled
+   */
+  void RouteFlows (uint16_t first, uint16_t flows, std::vector<Ipv4Address> *paths);
+  /**
+   * \brief Record the size of the flowlet table of n1.
+   * \param size the size, filled
+   */
+  void GetNFlowlets (uint32_t *size);
+  Ptr<Ipv4GlobalRouting> m_routing; //!< Global routing of n1.
+};
+
+EcmpFlowletTest::EcmpFlowletTest ()
+  : EcmpTest ("Global routing with flowlet ECMP")
+{
+}
+
+void
+EcmpFlowletTest::RouteFlows (uint16_t first, uint16_t flows, std::vector<Ipv4Address> *paths)
+{
+  paths->clear ();
+  for (uint16_t sport = first; sport < first + flows; sport++)
+    {
+      paths->push_back (Route (sport, 80));
+    }
+}
+
+void
+EcmpFlowletTest::GetNFlowlets (uint32_t *size)
+{
+  *size = m_routing->GetNFlowlets ();
+}
+
+void
+EcmpFlowletTest::DoRun ()
+{
+  m_routing = GetRouting (Ipv4GlobalRouting::ECMP_FLOWLET);
+  m_routing->SetAttribute ("FlowletTimeout", TimeValue (MicroSeconds (100)));
+
+  const uint16_t flows = 64;
+  std::vector<Ipv4Address> first;
+  std::vector<Ipv4Address> inGap;
+  std::vector<Ipv4Address> afterGap;
+  std::vector<Ipv4Address> others;
+  uint32_t size = 0;
+  uint32_t sweptSize = 0;
+  // 50us between the first two packets, then 150us
+  Simulator::Schedule (MicroSeconds (0), &EcmpFlowletTest::RouteFlows, this, 1000, flows, &first);
+  Simulator::Schedule (MicroSeconds (50), &EcmpFlowletTest::RouteFlows, this, 1000, flows, &inGap);
+  Simulator::Schedule (MicroSeconds (200), &EcmpFlowletTest::RouteFlows, this, 1000, flows, &afterGap);
+  // fill the table up to the sweep size, then add one flow once all are idle
+  Simulator::Schedule (MilliSeconds (1), &EcmpFlowletTest::RouteFlows, this, 2000, 1024 - flows, &others);
+  Simulator::Schedule (MilliSeconds (1), &EcmpFlowletTest::GetNFlowlets, this, &size);
+  Simulator::Schedule (MilliSeconds (2), &EcmpFlowletTest::RouteFlows, this, 5000, 1, &others);
+  Simulator::Schedule (MilliSeconds (2), &EcmpFlowletTest::GetNFlowlets, this, &sweptSize);
+  Simulator::Run ();
+
+  uint32_t moved = 0;
+  for (uint16_t i = 0; i < flows; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (inGap[i], first[i], "Error-- flow moved within a flowlet");
+      if (afterGap[i] != first[i])
+        {
+          moved++;
+        }
+    }
+  NS_TEST_ASSERT_MSG_GT (moved, 0, "Error-- no flow moved after the flowlet timeout");
+  NS_TEST_ASSERT_MSG_EQ (size, 1024, "Error-- wrong number of flowlets");
+  NS_TEST_ASSERT_MSG_EQ (sweptSize, 1, "Error-- idle flowlets not evicted");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting per-flow ECMP test of the packets sent by a
+ * UDP socket
+ *
+ * The UDP socket routes its packets before adding their UDP header; the
+ * ports must still be part of the flow hash.  Sockets on n1 with
+ * different source ports must be spread over both paths, and each socket
+ * must keep its path.
+ */
+class EcmpUdpSocketTest : public EcmpTest
+{
+public:
+  virtual void DoRun (void);
+  EcmpUdpSocketTest ();
+private:
+  /**
+   * \brief Record the interface of a packet sent by n1.
+   * \param packet the packet, with its IPv4 header
+   * \param ipv4 the IPv4 protocol of n1
+   * \param interface the output interface
+   */
+  void Tx (Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface);
+  /**
+   * \brief Send a packet from a socket to n5.
+   * \param socket the socket
+   */
+  void Send (Ptr<Socket> socket);
+  std::map<uint16_t, std::set<uint32_t> > m_interfaces; //!< Output interfaces, by source port.
+};
+
+EcmpUdpSocketTest::EcmpUdpSocketTest ()
+  : EcmpTest ("Global routing with per-flow ECMP of UDP sockets")
+{
+}
+
+void
+EcmpUdpSocketTest::Tx (Ptr<const Packet> packet, Ptr<Ipv4> ipv4, uint32_t interface)
+{
+  Ptr<Packet> copy = packet->Copy ();
+  Ipv4Header ipHeader;
+  copy->RemoveHeader (ipHeader);
+  UdpHeader udpHeader;
+  copy->RemoveHeader (udpHeader);
+  m_interfaces[udpHeader.GetSourcePort ()].insert (interface);
+}
+
+void
+EcmpUdpSocketTest::Send (Ptr<Socket> socket)
+{
+  socket->SendTo (Create<Packet> (100), 0, InetSocketAddress (m_dst, 80));
+}
+
+void
+EcmpUdpSocketTest::DoRun ()
+{
+  GetRouting (Ipv4GlobalRouting::ECMP_PER_FLOW);
+  m_nodes.Get (1)->GetObject<Ipv4L3Protocol> ()->TraceConnectWithoutContext ("Tx",
+    MakeCallback (&EcmpUdpSocketTest::Tx, this));
+
+  std::vector<Ptr<Socket> > sockets;
+  for (uint16_t sport = 1000; sport < 1064; sport++)
+    {
+      Ptr<Socket> socket = Socket::CreateSocket (m_nodes.Get (1), UdpSocketFactory::GetTypeId ());
+      socket->Bind (InetSocketAddress (Ipv4Address::GetAny (), sport));
+      sockets.push_back (socket);
+      for (uint32_t i = 0; i < 3; i++)
+        {
+          Simulator::Schedule (MicroSeconds (i), &EcmpUdpSocketTest::Send, this, socket);
+        }
+    }
+  Simulator::Run ();
+
+  std::set<uint32_t> interfaces;
+  NS_TEST_ASSERT_MSG_EQ (m_interfaces.size (), 64, "Error-- missing flows");
+  for (std::map<uint16_t, std::set<uint32_t> >::iterator it = m_interfaces.begin ();
+       it != m_interfaces.end (); ++it)
+    {
+      NS_TEST_ASSERT_MSG_EQ (it->second.size (), 1, "Error-- flow changed path");
+      interfaces.insert (it->second.begin (), it->second.end ());
+    }
+  NS_TEST_ASSERT_MSG_EQ (interfaces.size (), 2, "Error-- flows not spread over both paths");
+
+  for (uint32_t i = 0; i < sockets.size (); i++)
+    {
+      sockets[i]->Close ();
+    }
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting compiled forwarding table test
+ *
+ * Checks that lookups through the compiled forwarding table select the
+ * same routes as a scan of the route lists, including when routes of
+ * different prefix lengths overlap, and that the table follows route
+ * additions and removals.
+ */
+class CompiledTableTest : public TestCase
+{
+public:
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+  CompiledTableTest ();
+private:
+  /**
+   * \brief Ask n0 for a route.
+   * \param dest the destination
+   * \return the gateway chosen, or 0.0.0.0 if there is no route
+   */
+  Ipv4Address Route (Ipv4Address dest);
+  NodeContainer m_nodes; //!< Nodes used in the test.
+};
+
+CompiledTableTest::CompiledTableTest ()
+  : TestCase ("Global routing compiled forwarding table")
+{
+}
+
+void
+CompiledTableTest::DoSetup ()
+{
+  m_nodes.Create (3);
+
+  SimpleNetDeviceHelper simpleHelper;
+  simpleHelper.SetNetDevicePointToPointMode (true);
+  Ptr<SimpleChannel> channel = CreateObject <SimpleChannel> ();
+  NetDeviceContainer net = simpleHelper.Install (m_nodes.Get (0), channel);
+  net.Add (simpleHelper.Install (m_nodes.Get (1), channel));
+  Ptr<SimpleChannel> channel2 = CreateObject <SimpleChannel> ();
+  NetDeviceContainer net2 = simpleHelper.Install (m_nodes.Get (0), channel2);
+  net2.Add (simpleHelper.Install (m_nodes.Get (2), channel2));
+
+  InternetStackHelper internet;
+  Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+  internet.SetRoutingHelper (ipv4RoutingHelper);
+  internet.Install (m_nodes);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("192.168.1.0", "255.255.255.0");
+  ipv4.Assign (net);
+  ipv4.SetBase ("192.168.2.0", "255.255.255.0");
+  ipv4.Assign (net2);
+}
+
+Ipv4Address
+CompiledTableTest::Route (Ipv4Address dest)
+{
+  Ipv4Header header;
+  header.SetDestination (dest);
+  Socket::SocketErrno err;
+  Ptr<Ipv4RoutingProtocol> routing = m_nodes.Get (0)->GetObject<Ipv4> ()->GetRoutingProtocol ();
+  Ptr<Ipv4Route> route = routing->RouteOutput (0, header, 0, err);
+  return route ? route->GetGateway () : Ipv4Address ();
+}
+
+void
+CompiledTableTest::DoRun ()
+{
+  Ptr<Ipv4GlobalRouting> globalRouting0 =
+    m_nodes.Get (0)->GetObject<Ipv4> ()->GetRoutingProtocol ()->GetObject<Ipv4GlobalRouting> ();
+  NS_TEST_ASSERT_MSG_NE (globalRouting0, 0, "Error-- no Ipv4GlobalRouting object");
+  globalRouting0->SetAttribute ("RandomEcmpRouting", BooleanValue (false));
+
+  Ipv4Address gw1 ("192.168.1.2");
+  Ipv4Address gw2 ("192.168.2.2");
+  globalRouting0->AddNetworkRouteTo ("10.0.0.0", "255.0.0.0", gw1, 1);
+  globalRouting0->AddNetworkRouteTo ("10.5.0.0", "255.255.0.0", gw2, 2);
+
+  // Both routes match; the first one in the table is used
+  NS_TEST_ASSERT_MSG_EQ (Route ("10.5.1.1"), gw1, "Error-- wrong gateway for overlapping prefixes");
+  NS_TEST_ASSERT_MSG_EQ (Route ("10.6.1.1"), gw1, "Error-- wrong gateway for /8");
+  NS_TEST_ASSERT_MSG_EQ (Route ("11.0.0.1"), Ipv4Address (), "Error-- unexpected route");
+
+  // Removing the /8 leaves the /16
+  globalRouting0->RemoveRoute (0);
+  NS_TEST_ASSERT_MSG_EQ (Route ("10.5.1.1"), gw2, "Error-- wrong gateway for /16");
+  NS_TEST_ASSERT_MSG_EQ (Route ("10.6.1.1"), Ipv4Address (), "Error-- removed route still used");
+
+  // Host routes take precedence over network routes
+  globalRouting0->AddHostRouteTo ("10.5.1.1", gw1, 1);
+  NS_TEST_ASSERT_MSG_EQ (Route ("10.5.1.1"), gw1, "Error-- host route not preferred");
+  NS_TEST_ASSERT_MSG_EQ (Route ("10.5.1.2"), gw2, "Error-- wrong gateway for /16");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting multithreaded SPF test
+ *
+ * Checks that the routes computed with several "GlobalRoutingThreads"
+ * are the same as those computed sequentially, on a 3x3 grid with
+ * equal-cost paths.
+ */
+class ParallelSpfTest : public TestCase
+{
+public:
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+  ParallelSpfTest ();
+private:
+  /**
+   * \brief Dump the routing tables of all the nodes.
+   * \return the routes, one per line
+   */
+  std::string GetRoutes (void);
+  NodeContainer m_nodes; //!< Nodes used in the test.
+};
+
+ParallelSpfTest::ParallelSpfTest ()
+  : TestCase ("Global routing with multithreaded SPF")
+{
+}
+
+void
+ParallelSpfTest::DoSetup ()
+{
+  m_nodes.Create (9);
+
+  SimpleNetDeviceHelper simpleHelper;
+  simpleHelper.SetNetDevicePointToPointMode (true);
+  std::vector<NetDeviceContainer> nets;
+  for (uint32_t i = 0; i < 9; i++)
+    {
+      // Link to the right and downwards neighbours
+      uint32_t neighbours[2] = { i % 3 < 2 ? i + 1 : 9, i + 3 };
+      for (uint32_t j = 0; j < 2; j++)
+        {
+          if (neighbours[j] >= 9)
+            {
+              continue;
+            }
+          Ptr<SimpleChannel> channel = CreateObject <SimpleChannel> ();
+          NetDeviceContainer net = simpleHelper.Install (m_nodes.Get (i), channel);
+          net.Add (simpleHelper.Install (m_nodes.Get (neighbours[j]), channel));
+          nets.push_back (net);
+        }
+    }
+
+  InternetStackHelper internet;
+  Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+  internet.SetRoutingHelper (ipv4RoutingHelper);
+  internet.Install (m_nodes);
+
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  for (uint32_t i = 0; i < nets.size (); i++)
+    {
+      ipv4.Assign (nets[i]);
+      ipv4.NewNetwork ();
+    }
+}
+
+std::string
+ParallelSpfTest::GetRoutes ()
+{
+  std::ostringstream oss;
+  for (uint32_t i = 0; i < m_nodes.GetN (); i++)
+    {
+      Ptr<Ipv4GlobalRouting> globalRouting =
+        m_nodes.Get (i)->GetObject<Ipv4> ()->GetRoutingProtocol ()->GetObject<Ipv4GlobalRouting> ();
+      for (uint32_t j = 0; j < globalRouting->GetNRoutes (); j++)
+        {
+          oss << i << ": " << *globalRouting->GetRoute (j) << std::endl;
+        }
+    }
+  return oss.str ();
+}
+
+void
+ParallelSpfTest::DoRun ()
+{
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+  std::string sequential = GetRoutes ();
+  NS_TEST_ASSERT_MSG_NE (sequential.size (), 0, "Error-- no routes computed");
+
+  Config::SetGlobal ("GlobalRoutingThreads", UintegerValue (4));
+  Ipv4GlobalRoutingHelper::RecomputeRoutingTables ();
+  std::string parallel = GetRoutes ();
+  Config::SetGlobal ("GlobalRoutingThreads", UintegerValue (1));
+  NS_TEST_ASSERT_MSG_EQ (parallel, sequential, "Error-- routes differ from the sequential computation");
+
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -1265,6 +1840,11 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite ()
     AddTestCase (new TwoLanTest, TestCase::QUICK);
     AddTestCase (new BridgeTest, TestCase::QUICK);
     AddTestCase (new TwoBridgeTest, TestCase::QUICK);
+    AddTestCase (new EcmpPerFlowTest, TestCase::QUICK);
+    AddTestCase (new EcmpFlowletTest, TestCase::QUICK);
+    AddTestCase (new EcmpUdpSocketTest, TestCase::QUICK);
+    AddTestCase (new CompiledTableTest, TestCase::QUICK);
+    AddTestCase (new ParallelSpfTest, TestCase::QUICK);
     AddTestCase (new Ipv4DynamicGlobalRoutingTestCase, TestCase::QUICK);
     AddTestCase (new Ipv4GlobalRoutingSlash32TestCase, TestCase::QUICK);
   }
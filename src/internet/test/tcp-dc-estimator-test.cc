@@ -0,0 +1,263 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
+#include "ns3/tcp-socket-state.h"
+#include "ns3/tcp-linux-reno.h"
+#include "ns3/tcp-dctcp.h"
+#include "ns3/tcp-dstcp.h"
+#include "ns3/tcp-dcvegas.h"
+#include "ns3/tcp-dc-estimator.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TcpDcEstimatorTestSuite");
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief A replay following the recorded window gives the estimates of
+ * the congestion controls, for every parameter combination
+ */
+class TcpDcEstimatorReplayTest : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   *
+   * \param variant the congestion control replayed
+   * \param name Name of the test
+   */
+  TcpDcEstimatorReplayTest (TcpDcEstimatorReplay::Variant variant, const std::string &name);
+
+private:
+  virtual void DoRun (void);
+  /** \brief Acknowledge segments and compare the estimates
+   */
+  void ExecuteTest (void);
+  /**
+   * \brief Create the congestion control of a combination
+   * \param p the parameters
+   * \returns the congestion control
+   */
+  Ptr<TcpCongestionOps> CreateCongestionOps (const TcpDcEstimatorReplay::Parameters &p);
+  /**
+   * \brief Trace sink of the RTT samples
+   * \param sample the sample
+   */
+  void RttSample (const TcpRttSample &sample);
+
+  TcpDcEstimatorReplay::Variant m_variant;  //!< Congestion control replayed
+  TcpRttSample m_sample;                    //!< Last sample traced
+};
+
+TcpDcEstimatorReplayTest::TcpDcEstimatorReplayTest (TcpDcEstimatorReplay::Variant variant,
+                                                    const std::string &name)
+  : TestCase (name),
+    m_variant (variant)
+{
+}
+
+void
+TcpDcEstimatorReplayTest::DoRun ()
+{
+  Simulator::Schedule (Seconds (0.0), &TcpDcEstimatorReplayTest::ExecuteTest, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+TcpDcEstimatorReplayTest::RttSample (const TcpRttSample &sample)
+{
+  m_sample = sample;
+}
+
+Ptr<TcpCongestionOps>
+TcpDcEstimatorReplayTest::CreateCongestionOps (const TcpDcEstimatorReplay::Parameters &p)
+{
+  Ptr<TcpCongestionOps> cong;
+  switch (m_variant)
+    {
+    case TcpDcEstimatorReplay::DCTCP:
+      cong = CreateObjectWithAttributes<TcpDctcp> ("DctcpShiftG", DoubleValue (p.g),
+                                                   "DctcpAlphaOnInit", DoubleValue (p.alpha));
+      break;
+    case TcpDcEstimatorReplay::DSTCP:
+      cong = CreateObjectWithAttributes<TcpDstcp> ("DstcpShiftG", DoubleValue (p.g),
+                                                   "DstcpAlphaOnInit", DoubleValue (p.alpha),
+                                                   "DstcpBetaOnInit", DoubleValue (p.beta),
+                                                   "DstcpTdcvOnInit", UintegerValue (p.tdcv),
+                                                   "DstcpMinRtt", TimeValue (p.minRtt));
+      break;
+    case TcpDcEstimatorReplay::DCVEGAS:
+      cong = CreateObjectWithAttributes<TcpDcVegas> ("DcVegasShiftG", DoubleValue (p.g),
+                                                     "DcVegasBetaOnInit", DoubleValue (p.beta),
+                                                     "DcVegasTdcvOnInit", UintegerValue (p.tdcv),
+                                                     "DcVegasMinRtt", TimeValue (p.minRtt));
+      break;
+    }
+  cong->TraceConnectWithoutContext ("RttSample", MakeCallback (&TcpDcEstimatorReplayTest::RttSample, this));
+  return cong;
+}
+
+void
+TcpDcEstimatorReplayTest::ExecuteTest ()
+{
+  const uint32_t segmentSize = 1000;
+  const uint32_t acks = 400;
+  TcpDcEstimatorReplay replay (m_variant, segmentSize);
+  replay.SetFollowRecordedCwnd (true);
+
+  std::vector<Ptr<TcpCongestionOps> > congs;
+  std::vector<Ptr<TcpSocketState> > states;
+  for (uint32_t i = 0; i < 12; i++)
+    {
+      TcpDcEstimatorReplay::Parameters p;
+      p.g = 1.0 / (4 << (i % 4));
+      p.tdcv = 2 + 3 * (i % 3);
+      p.minRtt = MicroSeconds (60 + 20 * (i % 2));
+      p.alpha = 0.5;
+      p.beta = 0.25;
+      replay.AddParameters (p);
+      congs.push_back (CreateCongestionOps (p));
+      Ptr<TcpSocketState> state = CreateObject<TcpSocketState> ();
+      state->m_segmentSize = segmentSize;
+      states.push_back (state);
+    }
+  NS_TEST_ASSERT_MSG_EQ (replay.GetNParameters (), 12, "Parameters not added");
+
+  replay.BeginFlow (10 * segmentSize);
+  for (uint32_t i = 1; i <= acks; i++)
+    {
+      // A window oscillating between 10 and 40 segments, ACKs of one or
+      // two segments, bursts of ECE and a queue building up and draining.
+      uint32_t cwnd = (10 + (i * 7) % 31) * segmentSize;
+      uint32_t segments = 1 + i % 2;
+      Time rtt = (i % 9 == 0) ? Time (0) : MicroSeconds (80 + (i * 37) % 200);
+      for (uint32_t k = 0; k < congs.size (); k++)
+        {
+          states[k]->m_cWnd = cwnd;
+          states[k]->m_lastAckedSeq = SequenceNumber32 (i * 2 * segmentSize);
+          states[k]->m_nextTxSequence = SequenceNumber32 ((i / 10 + 1) * 20 * segmentSize);
+          states[k]->m_ecnState = (i % 17 < 4) ? TcpSocketState::ECN_ECE_RCVD : TcpSocketState::ECN_IDLE;
+          congs[k]->PktsAcked (states[k], segments, rtt);
+          if (k == 0)
+            {
+              replay.Replay (m_sample);
+            }
+          double alpha = m_variant == TcpDcEstimatorReplay::DCVEGAS ? 0.5 : m_sample.alpha;
+          double beta = m_variant == TcpDcEstimatorReplay::DCTCP ? 0.25 : m_sample.beta;
+          NS_TEST_ASSERT_MSG_EQ (replay.GetAlpha (k), alpha, "Alpha differs from the congestion control");
+          NS_TEST_ASSERT_MSG_EQ (replay.GetBeta (k), beta, "Beta differs from the congestion control");
+        }
+    }
+  TcpDcEstimatorReplay::Result result = replay.GetResult (0);
+  NS_TEST_ASSERT_MSG_EQ (result.acks, acks, "Wrong number of ACKs");
+  NS_TEST_ASSERT_MSG_GT (result.windows, 0, "No observation window replayed");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Without marks, the replayed window grows as TcpLinuxReno
+ */
+class TcpDcEstimatorGrowthTest : public TestCase
+{
+public:
+  TcpDcEstimatorGrowthTest ();
+
+private:
+  virtual void DoRun (void);
+};
+
+TcpDcEstimatorGrowthTest::TcpDcEstimatorGrowthTest ()
+  : TestCase ("Replayed window grows as TcpLinuxReno")
+{
+}
+
+void
+TcpDcEstimatorGrowthTest::DoRun ()
+{
+  const uint32_t segmentSize = 1000;
+  TcpDcEstimatorReplay replay (TcpDcEstimatorReplay::DCTCP, segmentSize);
+  replay.AddParameters (TcpDcEstimatorReplay::Parameters ());
+  replay.BeginFlow (4 * segmentSize);
+
+  Ptr<TcpLinuxReno> reno = CreateObject<TcpLinuxReno> ();
+  Ptr<TcpSocketState> state = CreateObject<TcpSocketState> ();
+  state->m_segmentSize = segmentSize;
+  state->m_cWnd = 4 * segmentSize;
+  state->m_ssThresh = 20 * segmentSize;
+
+  TcpRttSample sample;
+  sample.rtt = MicroSeconds (100);
+  sample.ece = false;
+  sample.windowEnd = false;
+  for (uint32_t i = 1; i <= 200; i++)
+    {
+      uint32_t segments = 1 + i % 3;
+      sample.bytesAcked = segments * segmentSize;
+      sample.cwnd = state->m_cWnd;
+      sample.ackSeq = i * 3 * segmentSize;
+      sample.nextTxSeq = sample.ackSeq + 10 * segmentSize;
+      // A single ECE, when the windows are equal, sets the same slow
+      // start threshold in both.
+      if (i == 1)
+        {
+          sample.ece = true;
+          state->m_ssThresh = TcpDcEstimator::ReducedWindow (state->m_cWnd, 1.0);
+          state->m_cWnd = state->m_ssThresh;
+        }
+      else
+        {
+          sample.ece = false;
+          if (sample.ackSeq > 13 * segmentSize)
+            {
+              reno->IncreaseWindow (state, segments);
+            }
+        }
+      replay.Replay (sample);
+      NS_TEST_ASSERT_MSG_EQ (replay.GetCwnd (0), state->m_cWnd.Get (), "Window differs from TcpLinuxReno");
+    }
+  NS_TEST_ASSERT_MSG_EQ (replay.GetResult (0).ecnReductions, 1, "Wrong number of ECE reductions");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief TcpDcEstimator TestSuite
+ */
+class TcpDcEstimatorTestSuite : public TestSuite
+{
+public:
+  TcpDcEstimatorTestSuite () : TestSuite ("tcp-dc-estimator", UNIT)
+  {
+    AddTestCase (new TcpDcEstimatorReplayTest (TcpDcEstimatorReplay::DCTCP, "Replay DCTCP estimates"), TestCase::QUICK);
+    AddTestCase (new TcpDcEstimatorReplayTest (TcpDcEstimatorReplay::DSTCP, "Replay DSTCP estimates"), TestCase::QUICK);
+    AddTestCase (new TcpDcEstimatorReplayTest (TcpDcEstimatorReplay::DCVEGAS, "Replay DcVegas estimates"), TestCase::QUICK);
+    AddTestCase (new TcpDcEstimatorGrowthTest, TestCase::QUICK);
+  }
+};
+
+static TcpDcEstimatorTestSuite g_tcpDcEstimatorTest; //!< Static variable for test initialization
@@ -0,0 +1,152 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/enum.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
+#include "ns3/fifo-queue-disc.h"
+#include "ns3/tcp-fluid-load.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TcpFluidLoadTestSuite");
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Long-lived flows fill the link and keep the queue around the
+ * threshold of their congestion control
+ */
+class TcpFluidLoadTest : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   *
+   * \param variant the congestion control of the flows
+   * \param maxSize the buffer of the queue disc
+   * \param minBacklog the lowest mean backlog expected, in packets
+   * \param maxBacklog the highest mean backlog expected, in packets
+   * \param drops whether the fluid should be dropped
+   * \param name Name of the test
+   */
+  TcpFluidLoadTest (TcpDcEstimatorReplay::Variant variant, const std::string &maxSize,
+                    double minBacklog, double maxBacklog, bool drops, const std::string &name);
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Sample the backlog of the fluid
+   * \param load the fluid load
+   */
+  void Sample (Ptr<TcpFluidLoad> load);
+
+  TcpDcEstimatorReplay::Variant m_variant;  //!< Congestion control of the flows
+  std::string m_maxSize;                    //!< Buffer of the queue disc
+  double m_minBacklog;                      //!< Lowest mean backlog expected
+  double m_maxBacklog;                      //!< Highest mean backlog expected
+  bool m_drops;                             //!< Whether the fluid should be dropped
+  double m_backlogSum;                      //!< Sum of the samples, in packets
+  uint32_t m_samples;                       //!< Number of samples
+};
+
+TcpFluidLoadTest::TcpFluidLoadTest (TcpDcEstimatorReplay::Variant variant, const std::string &maxSize,
+                                    double minBacklog, double maxBacklog, bool drops,
+                                    const std::string &name)
+  : TestCase (name),
+    m_variant (variant),
+    m_maxSize (maxSize),
+    m_minBacklog (minBacklog),
+    m_maxBacklog (maxBacklog),
+    m_drops (drops),
+    m_backlogSum (0),
+    m_samples (0)
+{
+}
+
+void
+TcpFluidLoadTest::Sample (Ptr<TcpFluidLoad> load)
+{
+  m_backlogSum += load->GetBacklog (QueueSizeUnit::PACKETS);
+  m_samples++;
+}
+
+void
+TcpFluidLoadTest::DoRun (void)
+{
+  // 10 flows over a 1 Gbps link with a marking threshold of 20 packets
+  Ptr<QueueDisc> qd = CreateObjectWithAttributes<FifoQueueDisc> ("MaxSize", StringValue (m_maxSize));
+  qd->Initialize ();
+  Ptr<TcpFluidLoad> load = CreateObjectWithAttributes<TcpFluidLoad> ("Variant", EnumValue (m_variant),
+                                                                     "Flows", UintegerValue (10),
+                                                                     "MarkingThreshold", StringValue ("20p"),
+                                                                     "DataRate", StringValue ("1Gbps"));
+  qd->SetFluidLoad (load);
+  Simulator::Schedule (Seconds (0), &FluidLoad::Start, load);
+  for (Time t = MilliSeconds (20); t < MilliSeconds (50); t += MicroSeconds (100))
+    {
+      Simulator::Schedule (t, &TcpFluidLoadTest::Sample, this, load);
+    }
+  Simulator::Stop (MilliSeconds (50));
+  Simulator::Run ();
+
+  FluidLoad::Stats stats = load->GetStats ();
+  double mean = m_backlogSum / m_samples;
+  NS_LOG_INFO ("mean backlog " << mean << " served " << stats.nServedBytes
+               << " dropped " << stats.nDroppedBytes << " cwnd " << load->GetCwnd ());
+  NS_TEST_ASSERT_MSG_GT (stats.nServedBytes, 0.9 * 1e9 / 8 * 0.05, "The flows should fill the link");
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (mean, m_minBacklog, "The queue is shorter than expected");
+  NS_TEST_ASSERT_MSG_LT_OR_EQ (mean, m_maxBacklog, "The queue is longer than expected");
+  NS_TEST_ASSERT_MSG_EQ ((stats.nDroppedBytes > 0), m_drops, "Unexpected fluid drops");
+  if (m_variant != TcpDcEstimatorReplay::DCVEGAS)
+    {
+      NS_TEST_ASSERT_MSG_LT (load->GetAlpha (), 1, "alpha should follow the marks");
+    }
+
+  qd->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief TestSuite for the fluid data center TCP flows
+ */
+static class TcpFluidLoadTestSuite : public TestSuite
+{
+public:
+  TcpFluidLoadTestSuite () : TestSuite ("tcp-fluid-load", UNIT)
+  {
+    AddTestCase (new TcpFluidLoadTest (TcpDcEstimatorReplay::DCTCP, "1000p", 5, 40, false,
+                                       "DCTCP flows around the marking threshold"),
+                 TestCase::QUICK);
+    AddTestCase (new TcpFluidLoadTest (TcpDcEstimatorReplay::DSTCP, "1000p", 1, 40, false,
+                                       "DSTCP flows around the RTT threshold"),
+                 TestCase::QUICK);
+    AddTestCase (new TcpFluidLoadTest (TcpDcEstimatorReplay::DCVEGAS, "1000p", 1, 40, false,
+                                       "DCVegas flows around the RTT threshold"),
+                 TestCase::QUICK);
+    AddTestCase (new TcpFluidLoadTest (TcpDcEstimatorReplay::DCTCP, "15p", 0, 15, true,
+                                       "DCTCP flows dropped by a short buffer"),
+                 TestCase::QUICK);
+  }
+} g_tcpFluidLoadTestSuite; ///< Static variable for test initialization
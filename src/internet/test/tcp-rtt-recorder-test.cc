@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
+#include "ns3/tcp-socket-state.h"
+#include "ns3/tcp-dstcp.h"
+#include "ns3/tcp-rtt-recorder.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TcpRttRecorderTestSuite");
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief The RTT samples of DSTCP are traced and written to a file
+ */
+class TcpRttRecorderTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   *
+   * \param sampleEvery record one sample out of this many
+   * \param name Name of the test
+   */
+  TcpRttRecorderTestCase (uint32_t sampleEvery, const std::string &name);
+
+private:
+  virtual void DoRun (void);
+  /** \brief Acknowledge segments on two sockets
+   */
+  void ExecuteTest (void);
+  /**
+   * \brief Trace sink of the RTT samples of the first socket
+   * \param sample the sample
+   */
+  void RttSample (const TcpRttSample &sample);
+
+  uint32_t m_sampleEvery;               //!< Record one sample out of this many
+  std::vector<TcpRttSample> m_traced;   //!< Samples traced on the first socket
+};
+
+TcpRttRecorderTestCase::TcpRttRecorderTestCase (uint32_t sampleEvery, const std::string &name)
+  : TestCase (name),
+    m_sampleEvery (sampleEvery)
+{
+}
+
+void
+TcpRttRecorderTestCase::RttSample (const TcpRttSample &sample)
+{
+  m_traced.push_back (sample);
+}
+
+void
+TcpRttRecorderTestCase::DoRun ()
+{
+  Simulator::Schedule (MilliSeconds (1), &TcpRttRecorderTestCase::ExecuteTest, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+TcpRttRecorderTestCase::ExecuteTest ()
+{
+  std::string fileName = CreateTempDirFilename ("tcp-rtt-recorder.bin");
+  Ptr<TcpRttRecorder> recorder = CreateObject<TcpRttRecorder> ();
+  recorder->SetAttribute ("BlockSize", UintegerValue (4));
+  recorder->SetAttribute ("SampleEvery", UintegerValue (m_sampleEvery));
+  NS_TEST_ASSERT_MSG_EQ (recorder->Open (fileName), true, "File not created");
+
+  Ptr<TcpDstcp> first = CreateObject<TcpDstcp> ();
+  first->SetAttribute ("RttRecorder", PointerValue (recorder));
+  first->TraceConnectWithoutContext ("RttSample", MakeCallback (&TcpRttRecorderTestCase::RttSample, this));
+  Ptr<TcpCongestionOps> second = first->Fork ();
+
+  const uint32_t acks = 10;
+  const uint32_t segmentSize = 1000;
+  Ptr<TcpSocketState> state = CreateObject<TcpSocketState> ();
+  state->m_segmentSize = segmentSize;
+  state->m_cWnd = 10 * segmentSize;
+  state->m_nextTxSequence = SequenceNumber32 (5 * segmentSize);
+  for (uint32_t i = 1; i <= acks; i++)
+    {
+      state->m_lastAckedSeq = SequenceNumber32 (i * segmentSize);
+      state->m_ecnState = (i % 2) ? TcpSocketState::ECN_ECE_RCVD : TcpSocketState::ECN_IDLE;
+      first->PktsAcked (state, 1, MicroSeconds (100 + 10 * i));
+      second->PktsAcked (state, 1, MicroSeconds (200));
+    }
+  recorder->Close ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_traced.size (), acks, "Not every ACK was traced");
+  std::vector<uint32_t> flowIds;
+  std::vector<TcpRttSample> samples;
+  NS_TEST_ASSERT_MSG_EQ (TcpRttRecorder::ReadFile (fileName, flowIds, samples), true, "File not read");
+  NS_TEST_ASSERT_MSG_EQ (samples.size (), 2 * (acks / m_sampleEvery), "Wrong number of records");
+
+  uint32_t read = 0;
+  for (uint32_t i = 0; i < samples.size (); i++)
+    {
+      if (flowIds[i] != 1)
+        {
+          NS_TEST_ASSERT_MSG_EQ (flowIds[i], 2, "Wrong socket identifier");
+          NS_TEST_ASSERT_MSG_EQ (samples[i].rtt, MicroSeconds (200), "Wrong RTT");
+          continue;
+        }
+      const TcpRttSample &traced = m_traced[(read + 1) * m_sampleEvery - 1];
+      read++;
+      NS_TEST_ASSERT_MSG_EQ (samples[i].time, MilliSeconds (1), "Wrong time");
+      NS_TEST_ASSERT_MSG_EQ (samples[i].rtt, traced.rtt, "Wrong RTT");
+      NS_TEST_ASSERT_MSG_EQ (samples[i].minRtt, MicroSeconds (100), "Wrong minimum RTT");
+      NS_TEST_ASSERT_MSG_EQ (samples[i].cwnd, traced.cwnd, "Wrong congestion window");
+      NS_TEST_ASSERT_MSG_EQ (samples[i].alpha, traced.alpha, "Wrong alpha");
+      NS_TEST_ASSERT_MSG_EQ (samples[i].beta, traced.beta, "Wrong beta");
+      NS_TEST_ASSERT_MSG_EQ (samples[i].bytesAcked, segmentSize, "Wrong acknowledged bytes");
+      NS_TEST_ASSERT_MSG_EQ (samples[i].ackSeq, traced.ackSeq, "Wrong acknowledged sequence");
+      NS_TEST_ASSERT_MSG_EQ (samples[i].nextTxSeq, 5 * segmentSize, "Wrong next sequence");
+      NS_TEST_ASSERT_MSG_EQ (samples[i].ece, ((traced.ackSeq / segmentSize) % 2 == 1), "Wrong ECE flag");
+      NS_TEST_ASSERT_MSG_EQ (samples[i].windowEnd, traced.windowEnd, "Wrong window end flag");
+    }
+  NS_TEST_ASSERT_MSG_EQ (read, acks / m_sampleEvery, "Wrong number of records of the first socket");
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief TcpRttRecorder TestSuite
+ */
+class TcpRttRecorderTestSuite : public TestSuite
+{
+public:
+  TcpRttRecorderTestSuite () : TestSuite ("tcp-rtt-recorder", UNIT)
+  {
+    AddTestCase (new TcpRttRecorderTestCase (1, "Record every RTT sample"), TestCase::QUICK);
+    AddTestCase (new TcpRttRecorderTestCase (3, "Record one RTT sample out of three"), TestCase::QUICK);
+  }
+};
+
+static TcpRttRecorderTestSuite g_tcpRttRecorderTest; //!< Static variable for test initialization
@@ -18,6 +18,7 @@
 #include "ns3/test.h"
 #include "ns3/packet.h"
 #include "ns3/log.h"
+#include "ns3/random-variable-stream.h"
 
 #include "ns3/tcp-rx-buffer.h"
 
@@ -343,6 +344,132 @@ TcpRxBufferTestCase::DoTeardown ()
 {
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Reordered, duplicated and overlapping segments are delivered
+ * in order, with their content
+ */
+class TcpRxBufferReassemblyTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param virtualPayload whether the buffer keeps only the size of the data
+   * \param name Name of the test
+   */
+  TcpRxBufferReassemblyTestCase (bool virtualPayload, const std::string &name);
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Extract data and check it follows the data already extracted
+   * \param rxBuf the buffer
+   * \param maxSize maximum number of bytes to extract
+   */
+  void Extract (TcpRxBuffer &rxBuf, uint32_t maxSize);
+
+  bool m_virtualPayload;          //!< Does the buffer keep only the size of the data
+  std::vector<uint8_t> m_stream;  //!< Bytes sent
+  uint32_t m_extracted;           //!< Bytes extracted so far
+};
+
+TcpRxBufferReassemblyTestCase::TcpRxBufferReassemblyTestCase (bool virtualPayload,
+                                                              const std::string &name)
+  : TestCase (name),
+    m_virtualPayload (virtualPayload),
+    m_extracted (0)
+{
+}
+
+void
+TcpRxBufferReassemblyTestCase::Extract (TcpRxBuffer &rxBuf, uint32_t maxSize)
+{
+  uint32_t available = rxBuf.Available ();
+  Ptr<Packet> p = rxBuf.Extract (maxSize);
+  uint32_t size = std::min (available, maxSize);
+  if (size == 0)
+    {
+      NS_TEST_ASSERT_MSG_EQ (p, 0, "Extracted data while none is available");
+      return;
+    }
+  NS_TEST_ASSERT_MSG_EQ (p->GetSize (), size, "Extracted size differs from expected");
+  std::vector<uint8_t> data (size);
+  p->CopyData (data.data (), size);
+  for (uint32_t i = 0; i < size; i++)
+    {
+      uint32_t expected = m_virtualPayload ? 0 : m_stream[m_extracted + i];
+      NS_TEST_ASSERT_MSG_EQ (static_cast<uint32_t> (data[i]), expected,
+                             "Extracted data differs from the data sent");
+    }
+  m_extracted += size;
+}
+
+void
+TcpRxBufferReassemblyTestCase::DoRun ()
+{
+  const uint32_t streamSize = 50000;
+  const SequenceNumber32 isn (4294960000U);  // Wraps around
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+
+  m_stream.resize (streamSize);
+  for (uint32_t i = 0; i < streamSize; i++)
+    {
+      m_stream[i] = static_cast<uint8_t> (i % 251);
+    }
+
+  // Segments of 500 bytes, in a random order, half of them sent twice
+  // with other boundaries
+  std::vector<std::pair<uint32_t, uint32_t> > segments;
+  for (uint32_t start = 0; start < streamSize; start += 500)
+    {
+      segments.push_back (std::make_pair (start, std::min (500u, streamSize - start)));
+      if (rng->GetInteger (0, 1) == 1)
+        {
+          uint32_t shifted = start + rng->GetInteger (0, 499);
+          uint32_t length = rng->GetInteger (1, 1500);
+          if (shifted < streamSize)
+            {
+              segments.push_back (std::make_pair (shifted, std::min (length, streamSize - shifted)));
+            }
+        }
+    }
+  for (uint32_t i = segments.size () - 1; i > 0; i--)
+    {
+      std::swap (segments[i], segments[rng->GetInteger (0, i)]);
+    }
+
+  TcpRxBuffer rxBuf;
+  rxBuf.SetMaxBufferSize (streamSize);
+  rxBuf.SetNextRxSequence (isn);
+  rxBuf.SetVirtualPayload (m_virtualPayload);
+  TcpHeader h;
+  for (uint32_t k = 0; k < segments.size (); k++)
+    {
+      h.SetSequenceNumber (isn + SequenceNumber32 (segments[k].first));
+      Ptr<Packet> p = Create<Packet> (&m_stream[segments[k].first], segments[k].second);
+      rxBuf.Add (p, h);
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (rxBuf.Size (), rxBuf.Available (), "More data available than buffered");
+      NS_TEST_ASSERT_MSG_EQ (rxBuf.NextRxSequence (), isn + SequenceNumber32 (m_extracted + rxBuf.Available ()),
+                             "Next sequence does not follow the available data");
+      if (rng->GetInteger (0, 3) == 0)
+        {
+          Extract (rxBuf, rng->GetInteger (1, 3000));
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.NextRxSequence (), isn + SequenceNumber32 (streamSize),
+                         "Not all the data was received");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.GetSackListSize (), 0, "SACK blocks left without holes");
+  while (m_extracted < streamSize)
+    {
+      Extract (rxBuf, rng->GetInteger (1, 3000));
+    }
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), 0, "Data left in the buffer");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Available (), 0, "Data left available");
+}
+
 
 /**
  * \ingroup internet-test
@@ -357,6 +484,8 @@ public:
     : TestSuite ("tcp-rx-buffer", UNIT)
   {
     AddTestCase (new TcpRxBufferTestCase, TestCase::QUICK);
+    AddTestCase (new TcpRxBufferReassemblyTestCase (false, "TcpRxBuffer reassembly Test"), TestCase::QUICK);
+    AddTestCase (new TcpRxBufferReassemblyTestCase (true, "TcpRxBuffer virtual payload reassembly Test"), TestCase::QUICK);
   }
 };
 static TcpRxBufferTestSuite  g_tcpRxBufferTestSuite;
@@ -15,9 +15,14 @@
  *
  */
 
+#include <algorithm>
 #include <limits>
+#include <set>
+#include <vector>
 #include "ns3/test.h"
 #include "ns3/tcp-tx-buffer.h"
+#include "ns3/tcp-option-sack.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
@@ -53,6 +58,8 @@ private:
   /** \brief Test the logic of merging items in GetTransmittedSegment()
    * which is triggered by CopyFromSequence()*/
   void TestMergeItemsWhenGetTransmittedSegment ();
+  /** \brief Test the segments of a buffer keeping only the size of the data */
+  void TestVirtualPayload ();
   /** \brief Callback to provide a value of receiver window */
   uint32_t GetRWnd (void) const;
 };
@@ -98,6 +105,14 @@ TcpTxBufferTestCase::DoRun ()
   Simulator::Schedule (Seconds (0.0),
                          &TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment, this);
 
+  /*
+   * Case for a buffer keeping only the size of the data:
+   *  -> the segments have the requested size and a zero-filled payload
+   *  -> a segment put back in the list is not extended by new data
+   */
+  Simulator::Schedule (Seconds (0.0),
+                       &TcpTxBufferTestCase::TestVirtualPayload, this);
+
   Simulator::Run ();
   Simulator::Destroy ();
 }
@@ -387,11 +402,733 @@ TcpTxBufferTestCase::TestTransmittedBlock ()
 {
 }
 
+void
+TcpTxBufferTestCase::TestVirtualPayload ()
+{
+  Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer> ();
+  txBuf->SetRWndCallback (MakeCallback (&TcpTxBufferTestCase::GetRWnd, this));
+  txBuf->SetHeadSequence (SequenceNumber32 (1));
+  txBuf->SetMaxBufferSize (20000);
+  txBuf->SetSegmentSize (1000);
+  txBuf->SetDupAckThresh (3);
+  txBuf->SetVirtualPayload (true);
+
+  std::vector<uint8_t> content (700, 0x5a);
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (txBuf->Add (Create<Packet> (content.data (), content.size ())), true,
+                             "Data not added");
+    }
+  NS_TEST_ASSERT_MSG_EQ (txBuf->Size (), 7000, "Wrong size of the buffer");
+
+  std::vector<uint8_t> data (1000);
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      Ptr<Packet> p = txBuf->CopyFromSequence (1000, SequenceNumber32 (1 + i * 1000))->GetPacketCopy ();
+      NS_TEST_ASSERT_MSG_EQ (p->GetSize (), 1000, "Wrong size of the segment");
+      p->CopyData (data.data (), p->GetSize ());
+      NS_TEST_ASSERT_MSG_EQ ((std::count (data.begin (), data.end (), 0) == 1000), true,
+                             "Content of the data sent");
+    }
+
+  // The last segment goes back to the unsent data, which is then sent
+  // again along with new data
+  txBuf->ResetLastSegmentSent ();
+  Ptr<Packet> p = txBuf->CopyFromSequence (3000, SequenceNumber32 (4001))->GetPacketCopy ();
+  NS_TEST_ASSERT_MSG_EQ (p->GetSize (), 3000, "Wrong size of the segment");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->Add (Create<Packet> (content.data (), content.size ())), true,
+                         "Data not added");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->Size (), 7700, "Wrong size of the buffer");
+  p = txBuf->CopyFromSequence (1000, SequenceNumber32 (7001))->GetPacketCopy ();
+  NS_TEST_ASSERT_MSG_EQ (p->GetSize (), 700, "Wrong size of the new data");
+
+  txBuf->DiscardUpTo (SequenceNumber32 (7701));
+  NS_TEST_ASSERT_MSG_EQ (txBuf->Size (), 0, "Data left in the buffer");
+}
+
 void
 TcpTxBufferTestCase::DoTeardown ()
 {
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Reference scoreboard for segments of the same size
+ *
+ * The flags of the sent segments are kept in a vector, and updated by
+ * walking the whole list as the TcpTxBuffer did before searching the sent
+ * list and stopping the loss marking at the items already marked.
+ */
+class TcpTxBufferScoreboardModel
+{
+public:
+  /**
+   * \brief Constructor
+   * \param head the sequence number of the first byte
+   * \param segmentSize the size of every segment
+   * \param dupAckThresh the number of sacked segments that mark the previous ones as lost
+   */
+  TcpTxBufferScoreboardModel (const SequenceNumber32 &head, uint32_t segmentSize,
+                              uint32_t dupAckThresh);
+
+  /**
+   * \brief Add data from the application
+   * \param size the number of bytes
+   */
+  void Add (uint32_t size);
+  /** \brief Send a new segment */
+  void Transmit (void);
+  /**
+   * \brief Send a segment again
+   * \param index the position of the segment in the sent list
+   */
+  void Retransmit (uint32_t index);
+  /**
+   * \brief Discard the first sent segments
+   * \param count the number of segments
+   */
+  void DiscardUpTo (uint32_t count);
+  /**
+   * \brief Update the scoreboard
+   * \param list the SACK blocks
+   * \return the number of bytes newly sacked
+   */
+  uint32_t Update (const TcpOptionSack::SackList &list);
+  /**
+   * \brief Check if a sequence number is lost
+   * \param seq the sequence number
+   * \return true if the segment starting at or after seq is lost
+   */
+  bool IsLost (const SequenceNumber32 &seq) const;
+  /**
+   * \brief Get the next segment to send
+   * \param seq the first sequence number to send
+   * \param seqHigh the end of the segment to send
+   * \param isRecovery true if in recovery
+   * \return true if there is a segment to send
+   */
+  bool NextSeg (SequenceNumber32 *seq, SequenceNumber32 *seqHigh, bool isRecovery) const;
+  /**
+   * \brief Mark the sent segments as lost
+   * \param resetSack true to forget the sacked segments as well
+   */
+  void SetSentListLost (bool resetSack);
+  /** \brief Clear the retransmitted flag of the head */
+  void DeleteRetransmittedFlagFromHead (void);
+  /** \brief Mark the head as lost */
+  void MarkHeadAsLost (void);
+  /** \brief Sack the first segment not sacked after the head */
+  void AddRenoSack (void);
+  /** \brief Forget the sacked segments */
+  void ResetRenoSack (void);
+
+  /** \return the sequence number of the first byte */
+  SequenceNumber32 HeadSequence (void) const;
+  /** \return the number of bytes in the buffer */
+  uint32_t Size (void) const;
+  /** \return the number of sent segments */
+  uint32_t GetNSent (void) const;
+  /**
+   * \param index the position of the segment in the sent list
+   * \return true if the segment is sacked
+   */
+  bool IsSacked (uint32_t index) const;
+  /** \return true if the head was retransmitted */
+  bool IsHeadRetransmitted (void) const;
+  /** \return the number of sacked bytes */
+  uint32_t GetSacked (void) const;
+  /** \return the number of lost bytes */
+  uint32_t GetLost (void) const;
+  /** \return the number of retransmitted bytes */
+  uint32_t GetRetransmitsCount (void) const;
+  /** \return the number of bytes in flight */
+  uint32_t BytesInFlight (void) const;
+
+private:
+  /** \brief Mark as lost the segments before the dupAckThresh-th sacked one */
+  void UpdateLostCount (void);
+
+  /** \brief Flags of a sent segment */
+  struct Segment
+  {
+    bool m_sacked {false};  //!< Segment sacked
+    bool m_lost {false};    //!< Segment lost
+    bool m_retrans {false}; //!< Segment retransmitted
+  };
+
+  std::vector<Segment> m_sent;         //!< Sent segments
+  SequenceNumber32 m_head;             //!< Sequence number of the first byte
+  uint32_t m_unsent;                   //!< Bytes not sent yet
+  uint32_t m_segmentSize;              //!< Size of every segment
+  uint32_t m_dupAckThresh;             //!< Sacked segments marking the previous ones as lost
+  bool m_highestSackValid;             //!< A segment was sacked
+  uint32_t m_highestSack;              //!< Position of the highest sacked segment
+  SequenceNumber32 m_highestSackSeq;   //!< Start of the highest sacked segment
+};
+
+TcpTxBufferScoreboardModel::TcpTxBufferScoreboardModel (const SequenceNumber32 &head,
+                                                        uint32_t segmentSize,
+                                                        uint32_t dupAckThresh)
+  : m_head (head),
+    m_unsent (0),
+    m_segmentSize (segmentSize),
+    m_dupAckThresh (dupAckThresh),
+    m_highestSackValid (false),
+    m_highestSack (0),
+    m_highestSackSeq (0)
+{
+}
+
+void
+TcpTxBufferScoreboardModel::Add (uint32_t size)
+{
+  m_unsent += size;
+}
+
+void
+TcpTxBufferScoreboardModel::Transmit (void)
+{
+  m_unsent -= m_segmentSize;
+  m_sent.push_back (Segment ());
+}
+
+void
+TcpTxBufferScoreboardModel::Retransmit (uint32_t index)
+{
+  m_sent[index].m_retrans = true;
+}
+
+void
+TcpTxBufferScoreboardModel::DiscardUpTo (uint32_t count)
+{
+  m_sent.erase (m_sent.begin (), m_sent.begin () + count);
+  m_head += count * m_segmentSize;
+  if (m_highestSackValid && m_highestSack >= count)
+    {
+      m_highestSack -= count;
+    }
+
+  if (!m_sent.empty () && m_sent[0].m_sacked)
+    {
+      m_sent[0].m_sacked = false;
+      AddRenoSack ();
+      MarkHeadAsLost ();
+    }
+
+  if (m_highestSackSeq <= m_head)
+    {
+      m_highestSackValid = false;
+      m_highestSackSeq = SequenceNumber32 (0);
+    }
+}
+
+uint32_t
+TcpTxBufferScoreboardModel::Update (const TcpOptionSack::SackList &list)
+{
+  uint32_t bytesSacked = 0;
+  for (auto block = list.begin (); block != list.end (); ++block)
+    {
+      if (m_head + GetNSent () * m_segmentSize < block->first)
+        {
+          return bytesSacked;
+        }
+      for (uint32_t i = 0; i < GetNSent (); i++)
+        {
+          SequenceNumber32 begin = m_head + i * m_segmentSize;
+          if (begin >= block->first && begin + m_segmentSize <= block->second)
+            {
+              if (!m_sent[i].m_sacked)
+                {
+                  m_sent[i].m_lost = false;
+                  m_sent[i].m_sacked = true;
+                  bytesSacked += m_segmentSize;
+                  if (!m_highestSackValid || m_highestSackSeq <= begin + m_segmentSize)
+                    {
+                      m_highestSackValid = true;
+                      m_highestSack = i;
+                      m_highestSackSeq = begin;
+                    }
+                }
+            }
+          else if (begin + m_segmentSize > block->second)
+            {
+              break;
+            }
+        }
+    }
+  if (bytesSacked > 0)
+    {
+      UpdateLostCount ();
+    }
+  return bytesSacked;
+}
+
+void
+TcpTxBufferScoreboardModel::UpdateLostCount (void)
+{
+  uint32_t sacked = 0;
+  for (uint32_t i = m_highestSack; i > 0; i--)
+    {
+      if (m_sent[i].m_sacked)
+        {
+          sacked++;
+        }
+      if (sacked >= m_dupAckThresh && !m_sent[i].m_sacked)
+        {
+          m_sent[i].m_lost = true;
+        }
+    }
+  if (sacked >= m_dupAckThresh)
+    {
+      m_sent[0].m_lost = true;
+    }
+}
+
+bool
+TcpTxBufferScoreboardModel::IsLost (const SequenceNumber32 &seq) const
+{
+  if (seq >= m_highestSackSeq)
+    {
+      return false;
+    }
+  for (uint32_t i = 0; i < GetNSent (); i++)
+    {
+      if (m_head + i * m_segmentSize >= seq)
+        {
+          if (m_sent[i].m_lost)
+            {
+              return true;
+            }
+          if (m_sent[i].m_sacked)
+            {
+              return false;
+            }
+        }
+    }
+  return false;
+}
+
+bool
+TcpTxBufferScoreboardModel::NextSeg (SequenceNumber32 *seq, SequenceNumber32 *seqHigh,
+                                     bool isRecovery) const
+{
+  SequenceNumber32 seqPerRule3;
+  bool isSeqPerRule3Valid = false;
+  for (uint32_t i = 0; i < GetNSent (); i++)
+    {
+      if (!m_sent[i].m_retrans && !m_sent[i].m_sacked)
+        {
+          if (m_sent[i].m_lost)
+            {
+              *seq = m_head + i * m_segmentSize;
+              *seqHigh = *seq + m_segmentSize;
+              return true;
+            }
+          else if (seqPerRule3.GetValue () == 0 && isRecovery)
+            {
+              isSeqPerRule3Valid = true;
+              seqPerRule3 = m_head + i * m_segmentSize;
+            }
+        }
+    }
+  if (m_unsent > 0)
+    {
+      *seq = m_head + GetNSent () * m_segmentSize;
+      *seqHigh = *seq + m_segmentSize;
+      return true;
+    }
+  if (isSeqPerRule3Valid)
+    {
+      *seq = seqPerRule3;
+      *seqHigh = *seq + m_segmentSize;
+      return true;
+    }
+  return false;
+}
+
+void
+TcpTxBufferScoreboardModel::SetSentListLost (bool resetSack)
+{
+  if (resetSack)
+    {
+      m_highestSackValid = false;
+      m_highestSackSeq = SequenceNumber32 (0);
+    }
+  for (auto it = m_sent.begin (); it != m_sent.end (); ++it)
+    {
+      if (resetSack)
+        {
+          it->m_sacked = false;
+          it->m_lost = true;
+        }
+      else if (!it->m_sacked)
+        {
+          it->m_lost = true;
+        }
+      it->m_retrans = false;
+    }
+}
+
+void
+TcpTxBufferScoreboardModel::DeleteRetransmittedFlagFromHead (void)
+{
+  if (!m_sent.empty ())
+    {
+      m_sent[0].m_retrans = false;
+    }
+}
+
+void
+TcpTxBufferScoreboardModel::MarkHeadAsLost (void)
+{
+  if (!m_sent.empty ())
+    {
+      m_sent[0].m_sacked = false;
+      m_sent[0].m_retrans = false;
+      m_sent[0].m_lost = true;
+    }
+}
+
+void
+TcpTxBufferScoreboardModel::AddRenoSack (void)
+{
+  for (uint32_t i = 1; i < GetNSent (); i++)
+    {
+      if (!m_sent[i].m_sacked)
+        {
+          m_sent[i].m_sacked = true;
+          m_highestSackValid = true;
+          m_highestSack = i;
+          m_highestSackSeq = m_head + i * m_segmentSize;
+          return;
+        }
+    }
+}
+
+void
+TcpTxBufferScoreboardModel::ResetRenoSack (void)
+{
+  for (auto it = m_sent.begin (); it != m_sent.end (); ++it)
+    {
+      it->m_sacked = false;
+    }
+  m_highestSackValid = false;
+  m_highestSackSeq = SequenceNumber32 (0);
+}
+
+SequenceNumber32
+TcpTxBufferScoreboardModel::HeadSequence (void) const
+{
+  return m_head;
+}
+
+uint32_t
+TcpTxBufferScoreboardModel::Size (void) const
+{
+  return GetNSent () * m_segmentSize + m_unsent;
+}
+
+uint32_t
+TcpTxBufferScoreboardModel::GetNSent (void) const
+{
+  return static_cast<uint32_t> (m_sent.size ());
+}
+
+bool
+TcpTxBufferScoreboardModel::IsSacked (uint32_t index) const
+{
+  return m_sent[index].m_sacked;
+}
+
+bool
+TcpTxBufferScoreboardModel::IsHeadRetransmitted (void) const
+{
+  return !m_sent.empty () && m_sent[0].m_retrans;
+}
+
+uint32_t
+TcpTxBufferScoreboardModel::GetSacked (void) const
+{
+  uint32_t sacked = 0;
+  for (auto it = m_sent.begin (); it != m_sent.end (); ++it)
+    {
+      sacked += it->m_sacked ? m_segmentSize : 0;
+    }
+  return sacked;
+}
+
+uint32_t
+TcpTxBufferScoreboardModel::GetLost (void) const
+{
+  uint32_t lost = 0;
+  for (auto it = m_sent.begin (); it != m_sent.end (); ++it)
+    {
+      lost += it->m_lost ? m_segmentSize : 0;
+    }
+  return lost;
+}
+
+uint32_t
+TcpTxBufferScoreboardModel::GetRetransmitsCount (void) const
+{
+  uint32_t retrans = 0;
+  for (auto it = m_sent.begin (); it != m_sent.end (); ++it)
+    {
+      retrans += it->m_retrans ? m_segmentSize : 0;
+    }
+  return retrans;
+}
+
+uint32_t
+TcpTxBufferScoreboardModel::BytesInFlight (void) const
+{
+  return GetNSent () * m_segmentSize - GetSacked () - GetLost () + GetRetransmitsCount ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Random transmissions, SACK blocks, acknowledgments and losses
+ * give the same scoreboard as the reference one
+ */
+class TcpTxBufferScoreboardTestCase : public TestCase
+{
+public:
+  /**
+   * \brief Constructor
+   * \param sackEnabled whether the receiver sends SACK blocks
+   * \param name Name of the test
+   */
+  TcpTxBufferScoreboardTestCase (bool sackEnabled, const std::string &name);
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Run random operations on a buffer and on the reference scoreboard
+   * \param stream the random variable stream
+   */
+  void RunStream (int64_t stream);
+  /**
+   * \brief Compare the buffer with the reference scoreboard
+   * \param txBuf the buffer
+   * \param model the reference scoreboard
+   */
+  void Check (Ptr<const TcpTxBuffer> txBuf, const TcpTxBufferScoreboardModel &model);
+  /** \brief Callback to provide a value of receiver window */
+  uint32_t GetRWnd (void) const;
+
+  bool m_sackEnabled;      //!< Does the receiver send SACK blocks
+  uint32_t m_segmentSize;  //!< Size of every segment
+};
+
+TcpTxBufferScoreboardTestCase::TcpTxBufferScoreboardTestCase (bool sackEnabled,
+                                                              const std::string &name)
+  : TestCase (name),
+    m_sackEnabled (sackEnabled),
+    m_segmentSize (1000)
+{
+}
+
+uint32_t
+TcpTxBufferScoreboardTestCase::GetRWnd (void) const
+{
+  return std::numeric_limits<uint32_t>::max ();
+}
+
+void
+TcpTxBufferScoreboardTestCase::Check (Ptr<const TcpTxBuffer> txBuf,
+                                      const TcpTxBufferScoreboardModel &model)
+{
+  NS_TEST_ASSERT_MSG_EQ (txBuf->HeadSequence (), model.HeadSequence (), "Wrong head");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->Size (), model.Size (), "Wrong size");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->GetSacked (), model.GetSacked (), "Wrong sacked bytes");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->GetLost (), model.GetLost (), "Wrong lost bytes");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->GetRetransmitsCount (), model.GetRetransmitsCount (),
+                         "Wrong retransmitted bytes");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->BytesInFlight (), model.BytesInFlight (), "Wrong bytes in flight");
+  NS_TEST_ASSERT_MSG_EQ (txBuf->IsHeadRetransmitted (), model.IsHeadRetransmitted (),
+                         "Wrong head retransmitted flag");
+
+  for (uint32_t offset = 0; offset < model.GetNSent () * m_segmentSize; offset += m_segmentSize / 2)
+    {
+      SequenceNumber32 seq = model.HeadSequence () + offset;
+      NS_TEST_ASSERT_MSG_EQ (txBuf->IsLost (seq), model.IsLost (seq),
+                             "Wrong lost state of " << seq);
+    }
+
+  for (uint32_t isRecovery = 0; isRecovery < 2; isRecovery++)
+    {
+      SequenceNumber32 seq, seqHigh, expectedSeq, expectedSeqHigh;
+      bool found = txBuf->NextSeg (&seq, &seqHigh, isRecovery);
+      bool expected = model.NextSeg (&expectedSeq, &expectedSeqHigh, isRecovery);
+      NS_TEST_ASSERT_MSG_EQ (found, expected, "Wrong next segment availability");
+      if (found)
+        {
+          NS_TEST_ASSERT_MSG_EQ (seq, expectedSeq, "Wrong next segment");
+          NS_TEST_ASSERT_MSG_EQ (seqHigh, expectedSeqHigh, "Wrong next segment end");
+        }
+    }
+}
+
+void
+TcpTxBufferScoreboardTestCase::RunStream (int64_t stream)
+{
+  const uint32_t maxSent = 32;
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (stream);
+
+  // Wraps around during the run
+  SequenceNumber32 isn (std::numeric_limits<uint32_t>::max () - rng->GetInteger (0, 1000000));
+  Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer> ();
+  txBuf->SetRWndCallback (MakeCallback (&TcpTxBufferScoreboardTestCase::GetRWnd, this));
+  txBuf->SetHeadSequence (isn);
+  txBuf->SetMaxBufferSize (1 << 24);
+  txBuf->SetSegmentSize (m_segmentSize);
+  txBuf->SetDupAckThresh (3);
+  txBuf->SetSackEnabled (m_sackEnabled);
+  TcpTxBufferScoreboardModel model (isn, m_segmentSize, 3);
+
+  std::set<uint32_t> received;  // Segments held by the receiver, numbered from the isn
+  uint32_t acked = 0;           // Segments acknowledged
+  for (uint32_t op = 0; op < 3000; op++)
+    {
+      uint32_t r = rng->GetInteger (0, 99);
+      uint32_t sent = model.GetNSent ();
+      if (r < 15)
+        {
+          uint32_t size = rng->GetInteger (1, 3000);
+          txBuf->Add (Create<Packet> (size));
+          model.Add (size);
+        }
+      else if (r < 40)
+        {
+          if (model.Size () - sent * m_segmentSize >= m_segmentSize && sent < maxSent)
+            {
+              TcpTxItem *item = txBuf->CopyFromSequence (m_segmentSize, model.HeadSequence () + sent * m_segmentSize);
+              NS_TEST_ASSERT_MSG_EQ (item->GetSeqSize (), m_segmentSize, "Wrong segment size");
+              model.Transmit ();
+              if (rng->GetInteger (0, 9) != 0)
+                {
+                  received.insert (acked + sent);
+                }
+            }
+        }
+      else if (r < 55)
+        {
+          if (m_sackEnabled)
+            {
+              // Blocks of received segments after the first hole, reported in
+              // a random order
+              uint32_t hole = acked;
+              while (received.count (hole) > 0)
+                {
+                  hole++;
+                }
+              std::vector<std::pair<uint32_t, uint32_t> > runs;
+              for (auto it = received.upper_bound (hole); it != received.end (); ++it)
+                {
+                  if (!runs.empty () && runs.back ().second == *it)
+                    {
+                      runs.back ().second++;
+                    }
+                  else
+                    {
+                      runs.push_back (std::make_pair (*it, *it + 1));
+                    }
+                }
+              TcpOptionSack::SackList list;
+              while (list.size () < 3 && !runs.empty ())
+                {
+                  uint32_t i = rng->GetInteger (0, runs.size () - 1);
+                  list.push_back (std::make_pair (isn + runs[i].first * m_segmentSize,
+                                                  isn + runs[i].second * m_segmentSize));
+                  runs.erase (runs.begin () + i);
+                }
+              NS_TEST_ASSERT_MSG_EQ (txBuf->Update (list), model.Update (list), "Wrong sacked bytes");
+            }
+          else if (sent > 1)
+            {
+              txBuf->AddRenoSack ();
+              model.AddRenoSack ();
+            }
+        }
+      else if (r < 65)
+        {
+          SequenceNumber32 seq, seqHigh;
+          uint32_t index = rng->GetInteger (0, std::max (sent, 1u) - 1);
+          if (rng->GetInteger (0, 1) == 0
+              && model.NextSeg (&seq, &seqHigh, rng->GetInteger (0, 1) == 1))
+            {
+              index = (seq - model.HeadSequence ()) / m_segmentSize;
+            }
+          if (index < sent && !model.IsSacked (index))
+            {
+              TcpTxItem *item = txBuf->CopyFromSequence (m_segmentSize, model.HeadSequence () + index * m_segmentSize);
+              NS_TEST_ASSERT_MSG_EQ (item->GetSeqSize (), m_segmentSize, "Wrong segment size");
+              model.Retransmit (index);
+              received.insert (acked + index);
+            }
+        }
+      else if (r < 80)
+        {
+          uint32_t ack = acked;
+          while (ack < acked + sent && received.count (ack) > 0)
+            {
+              ack++;
+            }
+          if (ack > acked)
+            {
+              txBuf->DiscardUpTo (isn + ack * m_segmentSize);
+              model.DiscardUpTo (ack - acked);
+              received.erase (received.begin (), received.lower_bound (ack));
+              acked = ack;
+            }
+        }
+      else if (r < 83)
+        {
+          txBuf->MarkHeadAsLost ();
+          model.MarkHeadAsLost ();
+        }
+      else if (r < 84)
+        {
+          bool resetSack = rng->GetInteger (0, 1) == 1;
+          txBuf->SetSentListLost (resetSack);
+          model.SetSentListLost (resetSack);
+          received.clear ();
+        }
+      else if (r < 86 && !m_sackEnabled)
+        {
+          txBuf->ResetRenoSack ();
+          model.ResetRenoSack ();
+        }
+      else if (r < 88)
+        {
+          txBuf->DeleteRetransmittedFlagFromHead ();
+          model.DeleteRetransmittedFlagFromHead ();
+        }
+
+      Check (txBuf, model);
+      if (IsStatusFailure ())
+        {
+          NS_LOG_INFO ("Stream " << stream << " differs after operation " << op << ": " << *txBuf);
+          return;
+        }
+    }
+}
+
+void
+TcpTxBufferScoreboardTestCase::DoRun ()
+{
+  for (int64_t stream = 1; stream <= 10 && !IsStatusFailure (); stream++)
+    {
+      RunStream (stream);
+    }
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -405,6 +1142,8 @@ public:
     : TestSuite ("tcp-tx-buffer", UNIT)
   {
     AddTestCase (new TcpTxBufferTestCase, TestCase::QUICK);
+    AddTestCase (new TcpTxBufferScoreboardTestCase (true, "TcpTxBuffer SACK scoreboard Test"), TestCase::QUICK);
+    AddTestCase (new TcpTxBufferScoreboardTestCase (false, "TcpTxBuffer Reno scoreboard Test"), TestCase::QUICK);
   }
 };
 
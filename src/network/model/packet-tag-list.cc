@@ -29,11 +29,47 @@
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 #include <cstring>
+#include <vector>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PacketTagList");
 
+namespace {
+
+/// Size of the data area of the TagData kept in the free list
+const uint32_t SMALL_TAG_DATA_SIZE = 20;
+/// Maximum number of TagData kept in the free list
+const uint32_t FREE_LIST_SIZE = 1000;
+
+/**
+ * \ingroup packet
+ *
+ * \brief Container of the TagData of small tags, ready for reuse
+ *
+ * Internal use only.  The free list is kept per thread, so that the
+ * partitions of a multithreaded simulation can each use their own.
+ */
+class TagDataFreeList : public std::vector<PacketTagList::TagData *>
+{
+public:
+  ~TagDataFreeList ();
+};
+
+thread_local TagDataFreeList g_freeList;        //!< TagData of small tags, ready for reuse
+thread_local bool g_freeListDestroyed = false;  //!< Is the free list of this thread destroyed
+
+TagDataFreeList::~TagDataFreeList ()
+{
+  for (iterator i = begin (); i != end (); ++i)
+    {
+      std::free (*i);
+    }
+  g_freeListDestroyed = true;
+}
+
+} // unnamed namespace
+
 PacketTagList::TagData *
 PacketTagList::CreateTagData (size_t dataSize)
 {
@@ -43,14 +79,42 @@ PacketTagList::CreateTagData (size_t dataSize)
                  << " exceeds maximum "
                  << std::numeric_limits<decltype(TagData::size)>::max () );
 
-  void * p = std::malloc (sizeof (TagData) + dataSize - 1);
-  // The matching frees are in RemoveAll and RemoveWriter
+  // The matching frees are in FreeTagData
+  void * p;
+  if (dataSize > SMALL_TAG_DATA_SIZE)
+    {
+      p = std::malloc (sizeof (TagData) + dataSize - 1);
+    }
+  else if (!g_freeListDestroyed && !g_freeList.empty ())
+    {
+      p = g_freeList.back ();
+      g_freeList.pop_back ();
+    }
+  else
+    {
+      p = std::malloc (sizeof (TagData) + SMALL_TAG_DATA_SIZE - 1);
+    }
 
   TagData * tag = new (p) TagData;
   tag->size = dataSize;
   return tag;
 }
 
+void
+PacketTagList::FreeTagData (TagData * data)
+{
+  bool small = data->size <= SMALL_TAG_DATA_SIZE;
+  data->~TagData ();
+  if (small && !g_freeListDestroyed && g_freeList.size () < FREE_LIST_SIZE)
+    {
+      g_freeList.push_back (data);
+    }
+  else
+    {
+      std::free (data);
+    }
+}
+
 bool
 PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
 {
@@ -194,8 +258,7 @@ PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
   if (preMerge)
     {
       // found tid before first merge, so delete cur
-      cur->~TagData ();
-      std::free (cur);
+      FreeTagData (cur);
     }
   else
     {
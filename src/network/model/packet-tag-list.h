@@ -252,6 +252,16 @@ private:
    */
   static
   TagData * CreateTagData (size_t dataSize);
+  /**
+   * Destroy a TagData struct created by CreateTagData.
+   *
+   * The structs of the small tags, which all have the same size, are
+   * kept in a per-thread free list for CreateTagData to reuse them
+   * instead of allocating memory for each tag.
+   *
+   * \param [in] data The TagData to destroy.
+   */
+  static void FreeTagData (TagData * data);
   
   /**
    * Typedef of method function pointer for copy-on-write operations
@@ -365,15 +375,13 @@ PacketTagList::RemoveAll (void)
         }
       if (prev != 0) 
         {
-          prev->~TagData ();
-          std::free (prev);
+          FreeTagData (prev);
         }
       prev = cur;
     }
   if (prev != 0) 
     {
-      prev->~TagData ();
-      std::free (prev);
+      FreeTagData (prev);
     }
   m_next = 0;
 }
@@ -387,6 +387,28 @@ BufferTest::DoRun (void)
   val2 <<= 8;
   val2 |= i.ReadU8 ();
   NS_TEST_ASSERT_MSG_EQ (val1, val2, "Bad ReadNtohU16()");
+
+  // Fragments sharing their data are merged without writing the zero area
+  buffer = Buffer (1000);
+  buffer.AddAtStart (2);
+  i = buffer.Begin ();
+  i.WriteU8 (0x12);
+  i.WriteU8 (0x34);
+  Buffer head = buffer.CreateFragment (0, 502);
+  Buffer tail = buffer.CreateFragment (502, 500);
+  head.AddAtEnd (tail);
+  NS_TEST_ASSERT_MSG_EQ (head.GetSize (), 1002, "Bad size of the merged fragments");
+  NS_TEST_ASSERT_MSG_EQ (head.GetSerializedSize (), buffer.GetSerializedSize (),
+                         "Zero area written by the merge");
+  i = head.Begin ();
+  NS_TEST_ASSERT_MSG_EQ (i.ReadNtohU16 (), 0x1234, "Bad data of the merged fragments");
+  uint32_t nonZero = 0;
+  while (!i.IsEnd ())
+    {
+      nonZero += (i.ReadU8 () != 0);
+    }
+  NS_TEST_ASSERT_MSG_EQ (nonZero, 0, "Bad zero area of the merged fragments");
+  ENSURE_WRITTEN_BYTES (buffer, 2, 0x12, 0x34);
 }
 
 /**
@@ -20,6 +20,8 @@
 #include <cstdarg>
 #include <iostream>
 #include <sstream>
+#include <thread>
+#include <vector>
 #include "ns3/test.h"
 #include "ns3/header.h"
 #include "ns3/trailer.h"
@@ -903,6 +905,94 @@ PacketMetadataTest::DoRun (void)
 }
 
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Packet metadata built on several threads at once, as by the partitions
+ * of a multithreaded simulation.
+ */
+class PacketMetadataThreadsTest : public TestCase {
+public:
+  PacketMetadataThreadsTest ();
+  virtual void DoRun (void);
+private:
+  /**
+   * Build packets and check their metadata.
+   * \param [in] packets The number of packets to build.
+   * \returns The number of packets with a wrong metadata.
+   */
+  static uint32_t BuildPackets (uint32_t packets);
+  /**
+   * Check the sizes of the items of a packet.
+   * \param [in] p The packet.
+   * \param [in] expected The expected item sizes.
+   * \returns \c true if the item sizes are the expected ones.
+   */
+  static bool CheckItems (Ptr<const Packet> p, const std::vector<uint32_t> &expected);
+};
+
+PacketMetadataThreadsTest::PacketMetadataThreadsTest ()
+  : TestCase ("Packet metadata on several threads")
+{
+}
+
+bool
+PacketMetadataThreadsTest::CheckItems (Ptr<const Packet> p, const std::vector<uint32_t> &expected)
+{
+  PacketMetadata::ItemIterator k = p->BeginItem ();
+  std::vector<uint32_t> got;
+  while (k.HasNext ())
+    {
+      got.push_back (k.Next ().currentSize);
+    }
+  return got == expected;
+}
+
+uint32_t
+PacketMetadataThreadsTest::BuildPackets (uint32_t packets)
+{
+  uint32_t errors = 0;
+  for (uint32_t i = 0; i < packets; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (10 + i % 7);
+      ADD_HEADER (p, 8);
+      ADD_HEADER (p, 20);
+      ADD_TRAILER (p, 4);
+      Ptr<Packet> copy = p->Copy ();
+      REM_HEADER (copy, 20);
+      copy->AddAtEnd (p->CreateFragment (0, 28));
+      if (!CheckItems (p, {20, 8, 10 + i % 7, 4})
+          || !CheckItems (copy, {8, 10 + i % 7, 4, 20, 8}))
+        {
+          errors++;
+        }
+    }
+  return errors;
+}
+
+void
+PacketMetadataThreadsTest::DoRun (void)
+{
+  PacketMetadata::Enable ();
+  // register the header types before the threads look them up
+  NS_TEST_ASSERT_MSG_EQ (BuildPackets (1), 0u, "Wrong metadata");
+
+  const uint32_t threads = 4;
+  std::vector<uint32_t> errors (threads, 0);
+  std::vector<std::thread> workers;
+  for (uint32_t t = 0; t < threads; t++)
+    {
+      workers.push_back (std::thread ([&errors, t] () { errors[t] = BuildPackets (20000); }));
+    }
+  for (uint32_t t = 0; t < threads; t++)
+    {
+      workers[t].join ();
+      NS_TEST_EXPECT_MSG_EQ (errors[t], 0u, "Wrong metadata built by thread " << t);
+    }
+}
+
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -919,6 +1009,7 @@ PacketMetadataTestSuite::PacketMetadataTestSuite ()
   : TestSuite ("packet-metadata", UNIT)
 {
   AddTestCase (new PacketMetadataTest, TestCase::QUICK);
+  AddTestCase (new PacketMetadataThreadsTest, TestCase::QUICK);
 }
 
 static PacketMetadataTestSuite g_packetMetadataTest; //!< Static variable for test initialization
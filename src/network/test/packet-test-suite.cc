@@ -850,7 +850,28 @@ PacketTest::DoRun (void)
   {
     Ptr<Packet> tmp = Create<Packet> (0);
     ALargeTestTag a;
-    tmp->AddPacketTag (a); 
+    tmp->AddPacketTag (a);
+  }
+
+  /* Test packet tags stored in recycled tag data */
+  {
+    for (uint32_t i = 0; i < 10; ++i)
+      {
+        Ptr<Packet> tmp = Create<Packet> (100);
+        tmp->AddPacketTag (ATestTag<1> (i));
+        tmp->AddPacketTag (ATestTag<15> (i));
+        tmp->AddPacketTag (ATestTag<40> (i));
+        Ptr<Packet> copy = tmp->Copy ();
+        ATestTag<15> small;
+        NS_TEST_EXPECT_MSG_EQ (copy->RemovePacketTag (small), true, "tag not found");
+        NS_TEST_EXPECT_MSG_EQ ((uint32_t)small.m_data, i, "wrong tag data");
+        NS_TEST_EXPECT_MSG_EQ (small.m_error, false, "corrupted tag");
+        ATestTag<40> large;
+        NS_TEST_EXPECT_MSG_EQ (copy->PeekPacketTag (large), true, "tag not found");
+        NS_TEST_EXPECT_MSG_EQ ((uint32_t)large.m_data, i, "wrong tag data");
+        NS_TEST_EXPECT_MSG_EQ (large.m_error, false, "corrupted tag");
+        NS_TEST_EXPECT_MSG_EQ (tmp->PeekPacketTag (small), true, "tag removed from the original");
+      }
   }
 }
 
@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node.h"
+#include "ns3/net-device.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/point-to-point-channel.h"
+
+#include "multithreaded-simulator-helper.h"
+
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorHelper");
+
+MultithreadedSimulatorHelper::MultithreadedSimulatorHelper ()
+  : m_lookahead (Seconds (0))
+{
+}
+
+void
+MultithreadedSimulatorHelper::Enable (void)
+{
+  GlobalValue::Bind ("SimulatorImplementationType",
+                     StringValue ("ns3::MultithreadedSimulatorImpl"));
+}
+
+void
+MultithreadedSimulatorHelper::SetPartition (Ptr<Node> node, uint32_t partition)
+{
+  NS_LOG_FUNCTION (this << node << partition);
+  m_partitions[node->GetId ()] = partition;
+}
+
+void
+MultithreadedSimulatorHelper::SetPartition (NodeContainer nodes, uint32_t partition)
+{
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i)
+    {
+      SetPartition (*i, partition);
+    }
+}
+
+void
+MultithreadedSimulatorHelper::Install (NodeContainer nodes, uint32_t partitions)
+{
+  NS_LOG_FUNCTION (this << partitions);
+  NS_ABORT_MSG_IF (partitions == 0, "At least one partition is needed");
+  Ptr<MultithreadedSimulatorImpl> impl =
+    DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  NS_ABORT_MSG_IF (impl == 0, "MultithreadedSimulatorHelper::Enable must be called first");
+
+  // Spread the nodes without an explicit partition in contiguous blocks.
+  uint32_t unassigned = 0;
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i)
+    {
+      if (m_partitions.find ((*i)->GetId ()) == m_partitions.end ())
+        {
+          unassigned++;
+        }
+    }
+  uint32_t block = (unassigned + partitions - 1) / partitions;
+  uint32_t rank = 0;
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i)
+    {
+      uint32_t id = (*i)->GetId ();
+      std::map<uint32_t, uint32_t>::const_iterator it = m_partitions.find (id);
+      uint32_t partition;
+      if (it != m_partitions.end ())
+        {
+          partition = it->second;
+        }
+      else
+        {
+          partition = rank++ / block;
+        }
+      NS_LOG_LOGIC ("Node " << id << " in partition " << partition);
+      impl->SetPartition (id, partition);
+    }
+
+  // Configure the channels linking two partitions.
+  bool cut = false;
+  Time lookahead = Time::Max ();
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i)
+    {
+      Ptr<Node> node = *i;
+      uint32_t partition = impl->GetPartition (node->GetId ());
+      for (uint32_t j = 0; j < node->GetNDevices (); ++j)
+        {
+          Ptr<NetDevice> device = node->GetDevice (j);
+          Ptr<Channel> channel = device->GetChannel ();
+          if (channel == 0)
+            {
+              continue;
+            }
+          for (std::size_t k = 0; k < channel->GetNDevices (); ++k)
+            {
+              Ptr<NetDevice> peer = channel->GetDevice (k);
+              if (impl->GetPartition (peer->GetNode ()->GetId ()) == partition)
+                {
+                  continue;
+                }
+              Ptr<PointToPointChannel> p2p = DynamicCast<PointToPointChannel> (channel);
+              NS_ABORT_MSG_IF (p2p == 0, "Channel " << channel->GetInstanceTypeId ().GetName ()
+                               << " of node " << node->GetId () << " links two partitions");
+              p2p->SetCrossPartition (true);
+              TimeValue delay;
+              p2p->GetAttribute ("Delay", delay);
+              lookahead = std::min (lookahead, delay.Get ());
+              cut = true;
+            }
+        }
+    }
+
+  if (cut)
+    {
+      NS_ABORT_MSG_IF (lookahead.IsZero (), "A channel linking two partitions has no delay");
+      NS_LOG_LOGIC ("Lookahead " << lookahead);
+      m_lookahead = lookahead;
+      impl->SetLookahead (lookahead);
+    }
+}
+
+Time
+MultithreadedSimulatorHelper::GetLookahead (void) const
+{
+  return m_lookahead;
+}
+
+} // namespace ns3
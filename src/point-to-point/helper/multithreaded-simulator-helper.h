@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_HELPER_H
+#define MULTITHREADED_SIMULATOR_HELPER_H
+
+#include <map>
+
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+/**
+ * \brief Split a simulation of point-to-point networks into the
+ * partitions of a MultithreadedSimulatorImpl
+ *
+ * The nodes can be given a partition explicitly with SetPartition(),
+ * for instance one partition per pod of a fat tree; Install() spreads
+ * the other nodes in contiguous blocks of node ids.  Install() then
+ * marks the point-to-point channels linking two partitions, and sets
+ * the lookahead of the simulator to the smallest delay of these
+ * channels.  Only point-to-point channels may link two partitions.
+ *
+ * \code
+ *   MultithreadedSimulatorHelper::Enable ();
+ *   NodeContainer nodes;
+ *   nodes.Create (64);
+ *   // ... build the topology ...
+ *   MultithreadedSimulatorHelper mt;
+ *   mt.Install (NodeContainer::GetGlobal (), 4);
+ *   Simulator::Run ();
+ * \endcode
+ */
+class MultithreadedSimulatorHelper
+{
+public:
+  MultithreadedSimulatorHelper ();
+
+  /**
+   * Select ns3::MultithreadedSimulatorImpl as the simulator
+   * implementation.  This must be called before any event is scheduled,
+   * hence before the nodes are created.
+   */
+  static void Enable (void);
+
+  /**
+   * \param node A node.
+   * \param partition The partition of the node.
+   */
+  void SetPartition (Ptr<Node> node, uint32_t partition);
+  /**
+   * \param nodes A set of nodes.
+   * \param partition The partition of the nodes.
+   */
+  void SetPartition (NodeContainer nodes, uint32_t partition);
+
+  /**
+   * Assign the partitions of the simulator implementation, and configure
+   * the channels linking two partitions.  This must be called after
+   * the topology is built and before Simulator::Run.
+   *
+   * \param nodes The nodes of the simulation.
+   * \param partitions The number of partitions among which to spread
+   * the nodes not given a partition with SetPartition().
+   */
+  void Install (NodeContainer nodes, uint32_t partitions);
+
+  /**
+   * \returns The lookahead found by Install(), or zero if no channel
+   * links two partitions.
+   */
+  Time GetLookahead (void) const;
+
+private:
+  std::map<uint32_t, uint32_t> m_partitions; //!< Partition of each node id
+  Time m_lookahead; //!< Smallest delay of the channels linking two partitions
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_HELPER_H */
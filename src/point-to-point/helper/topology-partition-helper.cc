@@ -0,0 +1,603 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "ns3/data-rate.h"
+#include "ns3/node.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/point-to-point-channel.h"
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#include "ns3/mpi-receiver.h"
+#include "ns3/point-to-point-remote-channel.h"
+#endif
+
+#include "topology-partition-helper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <queue>
+#include <set>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TopologyPartitionHelper");
+
+namespace {
+
+/** A point-to-point channel between two nodes of the graph. */
+struct Edge
+{
+  uint32_t u;     //!< First vertex
+  uint32_t v;     //!< Second vertex
+  Time delay;     //!< Delay of the channel
+  double rate;    //!< Data rate of the channel, in bit/s
+};
+
+/**
+ * \param vertices The vertices of a subgraph, by local index.
+ * \param adjacency The adjacency of the whole graph.
+ * \param local The local index of each vertex of the graph, or -1.
+ * \param start The local index of the first vertex.
+ * \returns The local index of the last vertex reached by a
+ * breadth-first search, i.e., a vertex far from the first one.
+ */
+uint32_t
+FarthestVertex (const std::vector<uint32_t> &vertices,
+                const std::vector<std::vector<std::pair<uint32_t, double> > > &adjacency,
+                const std::vector<int32_t> &local, uint32_t start)
+{
+  std::vector<bool> seen (vertices.size (), false);
+  std::queue<uint32_t> queue;
+  queue.push (start);
+  seen[start] = true;
+  uint32_t last = start;
+  while (!queue.empty ())
+    {
+      last = queue.front ();
+      queue.pop ();
+      const std::vector<std::pair<uint32_t, double> > &neighbors = adjacency[vertices[last]];
+      for (std::size_t i = 0; i < neighbors.size (); ++i)
+        {
+          int32_t j = local[neighbors[i].first];
+          if (j >= 0 && !seen[j])
+            {
+              seen[j] = true;
+              queue.push (j);
+            }
+        }
+    }
+  return last;
+}
+
+/**
+ * Order of the vertices in a GainQueue: decreasing gain, then increasing
+ * local index, so that the first vertex is the one a scan of the
+ * vertices in index order would pick.
+ */
+struct GainOrder
+{
+  /**
+   * \param a A gain and a local index.
+   * \param b Another gain and local index.
+   * \returns \c true if \p a comes before \p b.
+   */
+  bool operator() (const std::pair<double, uint32_t> &a, const std::pair<double, uint32_t> &b) const
+  {
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+  }
+};
+
+/**
+ * Vertices keyed on their gain, as the gain buckets of the
+ * Fiduccia-Mattheyses algorithm: the best vertex is found in constant
+ * time, and the gain of a vertex is updated in logarithmic time.  The
+ * gains are weights of channels, not integers, so a balanced tree takes
+ * the place of the array of buckets.
+ */
+typedef std::set<std::pair<double, uint32_t>, GainOrder> GainQueue;
+
+} // anonymous namespace
+
+TopologyPartitionHelper::TopologyPartitionHelper ()
+  : m_imbalance (0.05),
+    m_cutSize (0),
+    m_lookahead (Seconds (0))
+{
+}
+
+void
+TopologyPartitionHelper::SetImbalance (double imbalance)
+{
+  NS_LOG_FUNCTION (this << imbalance);
+  NS_ABORT_MSG_IF (imbalance < 0, "The imbalance can not be negative");
+  m_imbalance = imbalance;
+}
+
+uint32_t
+TopologyPartitionHelper::GetCutSize (void) const
+{
+  return m_cutSize;
+}
+
+Time
+TopologyPartitionHelper::GetLookahead (void) const
+{
+  return m_lookahead;
+}
+
+bool
+TopologyPartitionHelper::IsLocal (Ptr<Node> node)
+{
+  return node->GetSystemId () == Simulator::GetSystemId ();
+}
+
+std::vector<uint32_t>
+TopologyPartitionHelper::Partition (NodeContainer nodes, uint32_t parts)
+{
+  NS_LOG_FUNCTION (this << parts);
+  NS_ABORT_MSG_IF (parts == 0, "At least one part is needed");
+
+  std::map<uint32_t, uint32_t> index;
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      index[nodes.Get (i)->GetId ()] = i;
+    }
+
+  // Collect the channels between the nodes, each one once.
+  std::vector<Edge> edges;
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      Ptr<Node> node = nodes.Get (i);
+      for (uint32_t j = 0; j < node->GetNDevices (); ++j)
+        {
+          Ptr<PointToPointNetDevice> device = DynamicCast<PointToPointNetDevice> (node->GetDevice (j));
+          if (device == 0)
+            {
+              continue;
+            }
+          Ptr<PointToPointChannel> channel = DynamicCast<PointToPointChannel> (device->GetChannel ());
+          if (channel == 0 || channel->GetNDevices () != 2)
+            {
+              continue;
+            }
+          Ptr<PointToPointNetDevice> peer =
+            DynamicCast<PointToPointNetDevice> (channel->GetDevice (channel->GetDevice (0) == device ? 1 : 0));
+          std::map<uint32_t, uint32_t>::const_iterator it = index.find (peer->GetNode ()->GetId ());
+          if (it == index.end () || it->second <= i)
+            {
+              continue;
+            }
+          Edge edge;
+          edge.u = i;
+          edge.v = it->second;
+          TimeValue delay;
+          channel->GetAttribute ("Delay", delay);
+          edge.delay = delay.Get ();
+          DataRateValue rate, peerRate;
+          device->GetAttribute ("DataRate", rate);
+          peer->GetAttribute ("DataRate", peerRate);
+          edge.rate = std::max (rate.Get ().GetBitRate (), peerRate.Get ().GetBitRate ());
+          edges.push_back (edge);
+        }
+    }
+
+  // Weigh the channels: the fastest link with the smallest non-zero
+  // delay weighs 1; cutting a link without delay is a last resort.
+  double maxRate = 1;
+  Time minDelay = Time::Max ();
+  for (std::size_t i = 0; i < edges.size (); ++i)
+    {
+      maxRate = std::max (maxRate, edges[i].rate);
+      if (edges[i].delay.IsStrictlyPositive ())
+        {
+          minDelay = std::min (minDelay, edges[i].delay);
+        }
+    }
+  Graph graph;
+  graph.vertexWeight.assign (nodes.GetN (), 0);
+  graph.adjacency.resize (nodes.GetN ());
+  std::vector<double> weight (edges.size (), 0);
+  double totalWeight = 0;
+  for (std::size_t i = 0; i < edges.size (); ++i)
+    {
+      if (edges[i].delay.IsStrictlyPositive ())
+        {
+          weight[i] = std::max (edges[i].rate, 1.0) / maxRate
+            * (minDelay.GetDouble () / edges[i].delay.GetDouble ());
+          totalWeight += weight[i];
+        }
+    }
+  for (std::size_t i = 0; i < edges.size (); ++i)
+    {
+      if (!edges[i].delay.IsStrictlyPositive ())
+        {
+          weight[i] = totalWeight + 1;
+        }
+      graph.adjacency[edges[i].u].push_back (std::make_pair (edges[i].v, weight[i]));
+      graph.adjacency[edges[i].v].push_back (std::make_pair (edges[i].u, weight[i]));
+      graph.vertexWeight[edges[i].u]++;
+      graph.vertexWeight[edges[i].v]++;
+    }
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      graph.vertexWeight[i] = std::max (graph.vertexWeight[i], 1.0);
+    }
+
+  std::vector<uint32_t> vertices (nodes.GetN ());
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      vertices[i] = i;
+    }
+  std::vector<uint32_t> part (nodes.GetN (), 0);
+  Split (graph, vertices, 0, parts, part);
+
+  m_cutSize = 0;
+  m_lookahead = Time::Max ();
+  for (std::size_t i = 0; i < edges.size (); ++i)
+    {
+      if (part[edges[i].u] != part[edges[i].v])
+        {
+          m_cutSize++;
+          m_lookahead = std::min (m_lookahead, edges[i].delay);
+        }
+    }
+  if (m_cutSize == 0)
+    {
+      m_lookahead = Seconds (0);
+    }
+  NS_LOG_INFO ("Split " << nodes.GetN () << " nodes and " << edges.size () << " channels in "
+               << parts << " parts, cutting " << m_cutSize << " channels, lookahead " << m_lookahead);
+  return part;
+}
+
+void
+TopologyPartitionHelper::Split (const Graph &graph, const std::vector<uint32_t> &vertices,
+                                uint32_t firstPart, uint32_t parts, std::vector<uint32_t> &part) const
+{
+  if (parts == 1 || vertices.size () <= 1)
+    {
+      for (std::size_t i = 0; i < vertices.size (); ++i)
+        {
+          part[vertices[i]] = firstPart;
+        }
+      return;
+    }
+  uint32_t firstParts = parts / 2;
+  std::vector<bool> first = Bisect (graph, vertices, static_cast<double> (firstParts) / parts);
+  std::vector<uint32_t> firstVertices, secondVertices;
+  for (std::size_t i = 0; i < vertices.size (); ++i)
+    {
+      (first[i] ? firstVertices : secondVertices).push_back (vertices[i]);
+    }
+  Split (graph, firstVertices, firstPart, firstParts, part);
+  Split (graph, secondVertices, firstPart + firstParts, parts - firstParts, part);
+}
+
+std::vector<bool>
+TopologyPartitionHelper::Bisect (const Graph &graph, const std::vector<uint32_t> &vertices,
+                                 double fraction) const
+{
+  const uint32_t n = vertices.size ();
+  std::vector<int32_t> local (graph.vertexWeight.size (), -1);
+  double total = 0;
+  double maxVertexWeight = 0;
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      local[vertices[i]] = i;
+      total += graph.vertexWeight[vertices[i]];
+      maxVertexWeight = std::max (maxVertexWeight, graph.vertexWeight[vertices[i]]);
+    }
+  const double target = fraction * total;
+  const double tolerance = std::max (m_imbalance * std::min (target, total - target), maxVertexWeight);
+
+  // Grow the first side from a few seeds far apart, then refine it.
+  std::vector<uint32_t> seeds;
+  seeds.push_back (FarthestVertex (vertices, graph.adjacency, local, 0));
+  seeds.push_back (FarthestVertex (vertices, graph.adjacency, local, seeds[0]));
+  seeds.push_back (0);
+  std::sort (seeds.begin (), seeds.end ());
+  seeds.erase (std::unique (seeds.begin (), seeds.end ()), seeds.end ());
+
+  std::vector<bool> best;
+  double bestCut = std::numeric_limits<double>::max ();
+  double bestImbalance = std::numeric_limits<double>::max ();
+  for (std::size_t s = 0; s < seeds.size (); ++s)
+    {
+      std::vector<bool> side (n, false);
+      // gain[v]: weight of the edges of v to the first side, minus the
+      // weight of the other edges.
+      std::vector<double> gain (n, 0);
+      for (uint32_t v = 0; v < n; ++v)
+        {
+          const std::vector<std::pair<uint32_t, double> > &neighbors = graph.adjacency[vertices[v]];
+          for (std::size_t i = 0; i < neighbors.size (); ++i)
+            {
+              if (local[neighbors[i].first] >= 0)
+                {
+                  gain[v] -= neighbors[i].second;
+                }
+            }
+        }
+
+      // Greedy growth: add the vertex most connected to the first side.
+      GainQueue outside;
+      for (uint32_t v = 0; v < n; ++v)
+        {
+          outside.insert (std::make_pair (gain[v], v));
+        }
+      double weight = 0;
+      uint32_t next = seeds[s];
+      while (true)
+        {
+          double w = graph.vertexWeight[vertices[next]];
+          if (std::abs (weight + w - target) >= std::abs (weight - target))
+            {
+              break;
+            }
+          side[next] = true;
+          outside.erase (std::make_pair (gain[next], next));
+          weight += w;
+          const std::vector<std::pair<uint32_t, double> > &neighbors = graph.adjacency[vertices[next]];
+          for (std::size_t i = 0; i < neighbors.size (); ++i)
+            {
+              int32_t j = local[neighbors[i].first];
+              if (j < 0)
+                {
+                  continue;
+                }
+              if (!side[j])
+                {
+                  outside.erase (std::make_pair (gain[j], j));
+                }
+              gain[j] += 2 * neighbors[i].second;
+              if (!side[j])
+                {
+                  outside.insert (std::make_pair (gain[j], j));
+                }
+            }
+          if (outside.empty ())
+            {
+              break;
+            }
+          next = outside.begin ()->second;
+        }
+
+      // Fiduccia-Mattheyses refinement: move the vertices one at a time,
+      // the best move first, and keep the best prefix of the moves.
+      // gain[v] is now the decrease of the cut when v changes side.
+      double cut = 0;
+      for (uint32_t v = 0; v < n; ++v)
+        {
+          gain[v] = 0;
+          const std::vector<std::pair<uint32_t, double> > &neighbors = graph.adjacency[vertices[v]];
+          for (std::size_t i = 0; i < neighbors.size (); ++i)
+            {
+              int32_t j = local[neighbors[i].first];
+              if (j < 0)
+                {
+                  continue;
+                }
+              if (side[j] != side[v])
+                {
+                  gain[v] += neighbors[i].second;
+                  cut += neighbors[i].second;
+                }
+              else
+                {
+                  gain[v] -= neighbors[i].second;
+                }
+            }
+        }
+      cut /= 2;
+
+      for (uint32_t pass = 0; pass < 16; ++pass)
+        {
+          // The unlocked vertices of each side, by decreasing gain
+          GainQueue unlocked[2];
+          for (uint32_t v = 0; v < n; ++v)
+            {
+              unlocked[side[v]].insert (std::make_pair (gain[v], v));
+            }
+          std::vector<bool> locked (n, false);
+          std::vector<uint32_t> moves;
+          double passCut = cut;
+          double passImbalance = std::abs (weight - target);
+          std::size_t bestMoves = 0;
+          for (uint32_t step = 0; step < n; ++step)
+            {
+              // The best move of each side is its first vertex which
+              // keeps the balance; the heavier vertices are skipped.
+              int32_t candidate = -1;
+              for (uint32_t from = 0; from < 2; ++from)
+                {
+                  for (GainQueue::const_iterator it = unlocked[from].begin (); it != unlocked[from].end (); ++it)
+                    {
+                      uint32_t v = it->second;
+                      double w = graph.vertexWeight[vertices[v]];
+                      double after = std::abs (weight + (side[v] ? -w : w) - target);
+                      if (after > tolerance && after >= std::abs (weight - target))
+                        {
+                          continue;
+                        }
+                      if (candidate < 0 || GainOrder () (*it, std::make_pair (gain[candidate], candidate)))
+                        {
+                          candidate = v;
+                        }
+                      break;
+                    }
+                }
+              if (candidate < 0)
+                {
+                  break;
+                }
+              uint32_t v = candidate;
+              unlocked[side[v]].erase (std::make_pair (gain[v], v));
+              locked[v] = true;
+              cut -= gain[v];
+              weight += side[v] ? -graph.vertexWeight[vertices[v]] : graph.vertexWeight[vertices[v]];
+              const std::vector<std::pair<uint32_t, double> > &neighbors = graph.adjacency[vertices[v]];
+              for (std::size_t i = 0; i < neighbors.size (); ++i)
+                {
+                  int32_t j = local[neighbors[i].first];
+                  if (j < 0)
+                    {
+                      continue;
+                    }
+                  if (!locked[j])
+                    {
+                      unlocked[side[j]].erase (std::make_pair (gain[j], j));
+                    }
+                  gain[j] += (side[j] == side[v] ? 2 : -2) * neighbors[i].second;
+                  if (!locked[j])
+                    {
+                      unlocked[side[j]].insert (std::make_pair (gain[j], j));
+                    }
+                }
+              gain[v] = -gain[v];
+              side[v] = !side[v];
+              moves.push_back (v);
+
+              double imbalance = std::abs (weight - target);
+              bool feasible = imbalance <= tolerance;
+              bool passFeasible = passImbalance <= tolerance;
+              if ((feasible && !passFeasible)
+                  || (feasible && cut < passCut - 1e-9)
+                  || (!passFeasible && imbalance < passImbalance))
+                {
+                  passCut = cut;
+                  passImbalance = imbalance;
+                  bestMoves = moves.size ();
+                }
+            }
+          // Undo the moves after the best prefix.
+          while (moves.size () > bestMoves)
+            {
+              uint32_t v = moves.back ();
+              moves.pop_back ();
+              cut -= gain[v];
+              weight += side[v] ? -graph.vertexWeight[vertices[v]] : graph.vertexWeight[vertices[v]];
+              const std::vector<std::pair<uint32_t, double> > &neighbors = graph.adjacency[vertices[v]];
+              for (std::size_t i = 0; i < neighbors.size (); ++i)
+                {
+                  int32_t j = local[neighbors[i].first];
+                  if (j >= 0)
+                    {
+                      gain[j] += (side[j] == side[v] ? 2 : -2) * neighbors[i].second;
+                    }
+                }
+              gain[v] = -gain[v];
+              side[v] = !side[v];
+            }
+          if (bestMoves == 0)
+            {
+              break;
+            }
+        }
+
+      double imbalance = std::abs (weight - target);
+      bool feasible = imbalance <= tolerance;
+      bool bestFeasible = bestImbalance <= tolerance;
+      NS_LOG_LOGIC ("Seed " << seeds[s] << ": cut " << cut << ", imbalance " << imbalance);
+      if (best.empty ()
+          || (feasible && !bestFeasible)
+          || (feasible == bestFeasible && cut < bestCut - 1e-9)
+          || (!feasible && !bestFeasible && imbalance < bestImbalance))
+        {
+          best = side;
+          bestCut = cut;
+          bestImbalance = imbalance;
+        }
+    }
+
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      local[vertices[i]] = -1;
+    }
+  return best;
+}
+
+void
+TopologyPartitionHelper::Install (NodeContainer nodes, uint32_t parts)
+{
+  NS_LOG_FUNCTION (this << parts);
+  std::vector<uint32_t> part = Partition (nodes, parts);
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      nodes.Get (i)->SetAttribute ("SystemId", UintegerValue (part[i]));
+    }
+
+#ifdef NS3_MPI
+  if (!MpiInterface::IsEnabled ())
+    {
+      return;
+    }
+  NS_ABORT_MSG_IF (parts != MpiInterface::GetSize (),
+                   "The nodes must be split in as many parts as there are MPI processes");
+  // As in PointToPointHelper::Install, a channel is remote as soon as
+  // one of its nodes belongs to another system.
+  uint32_t systemId = MpiInterface::GetSystemId ();
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      Ptr<Node> node = nodes.Get (i);
+      for (uint32_t j = 0; j < node->GetNDevices (); ++j)
+        {
+          Ptr<PointToPointNetDevice> device = DynamicCast<PointToPointNetDevice> (node->GetDevice (j));
+          if (device == 0)
+            {
+              continue;
+            }
+          Ptr<PointToPointChannel> channel = DynamicCast<PointToPointChannel> (device->GetChannel ());
+          if (channel == 0 || channel->GetNDevices () != 2
+              || DynamicCast<PointToPointRemoteChannel> (channel) != 0)
+            {
+              continue;
+            }
+          Ptr<PointToPointNetDevice> devA = DynamicCast<PointToPointNetDevice> (channel->GetDevice (0));
+          Ptr<PointToPointNetDevice> devB = DynamicCast<PointToPointNetDevice> (channel->GetDevice (1));
+          if (devA->GetNode ()->GetSystemId () == systemId
+              && devB->GetNode ()->GetSystemId () == systemId)
+            {
+              continue;
+            }
+          Ptr<PointToPointRemoteChannel> remote = CreateObject<PointToPointRemoteChannel> ();
+          TimeValue delay;
+          channel->GetAttribute ("Delay", delay);
+          remote->SetAttribute ("Delay", delay);
+          devA->Attach (remote);
+          devB->Attach (remote);
+          Ptr<PointToPointNetDevice> devices[2] = { devA, devB };
+          for (uint32_t k = 0; k < 2; ++k)
+            {
+              if (devices[k]->GetObject<MpiReceiver> () == 0)
+                {
+                  Ptr<MpiReceiver> receiver = CreateObject<MpiReceiver> ();
+                  receiver->SetReceiveCallback (MakeCallback (&PointToPointNetDevice::Receive, devices[k]));
+                  devices[k]->AggregateObject (receiver);
+                }
+            }
+        }
+    }
+#endif
+}
+
+} // namespace ns3
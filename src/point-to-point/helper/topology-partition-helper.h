@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TOPOLOGY_PARTITION_HELPER_H
+#define TOPOLOGY_PARTITION_HELPER_H
+
+#include <vector>
+
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+/**
+ * \brief Split a network of point-to-point links among the systems of a
+ * distributed simulation
+ *
+ * The nodes and the point-to-point channels linking them form a graph,
+ * which Partition() splits into balanced parts while minimizing the
+ * weight of the channels cut.  The weight of a node is its number of
+ * point-to-point devices, a proxy of the events it runs.  The weight of
+ * a channel grows with its data rate, since more packets then cross
+ * the cut, and with the inverse of its delay, since the lookahead of
+ * the simulation is the smallest delay of the channels cut.  The graph
+ * is split by recursive bisection, each bisection being grown from
+ * several seeds and refined with Fiduccia-Mattheyses passes, which keep
+ * the vertices sorted by gain so that a pass takes O(E log V) time.  The
+ * result only depends on the topology, so that every process of a
+ * distributed simulation computes the same partition.
+ *
+ * Install() assigns the partitions as the SystemId of the nodes and,
+ * when MPI is enabled, replaces the channels linking a node of another
+ * system with PointToPointRemoteChannel objects, so that a topology
+ * built for a sequential simulation can be run as is on several
+ * processes:
+ *
+ * \code
+ *   MpiInterface::Enable (&argc, &argv);
+ *   GlobalValue::Bind ("SimulatorImplementationType",
+ *                      StringValue ("ns3::DistributedSimulatorImpl"));
+ *   // ... create the nodes and the point-to-point links ...
+ *   TopologyPartitionHelper partitioner;
+ *   partitioner.Install (NodeContainer::GetGlobal (), MpiInterface::GetSize ());
+ *   Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+ *   // ... install applications on the nodes for which IsLocal() holds ...
+ * \endcode
+ *
+ * Install() must be called after the links are created, and before
+ * the routing tables are computed and the applications installed.
+ */
+class TopologyPartitionHelper
+{
+public:
+  TopologyPartitionHelper ();
+
+  /**
+   * \param imbalance The tolerated excess of the weight of a part over
+   * its share of the total weight, 0.05 for 5%.
+   */
+  void SetImbalance (double imbalance);
+
+  /**
+   * Compute a balanced partition of the nodes with a small cut.
+   *
+   * \param nodes The nodes to partition; the links to other nodes are
+   * ignored.
+   * \param parts The number of parts.
+   * \returns The part of each node, in the order of the container.
+   */
+  std::vector<uint32_t> Partition (NodeContainer nodes, uint32_t parts);
+
+  /**
+   * Partition the nodes, set their SystemId to their part and, when
+   * MPI is enabled, use remote channels for the links of the nodes of
+   * other systems.
+   *
+   * \param nodes The nodes to partition.
+   * \param parts The number of parts, i.e. of systems.
+   */
+  void Install (NodeContainer nodes, uint32_t parts);
+
+  /**
+   * \returns The number of channels cut by the last partition.
+   */
+  uint32_t GetCutSize (void) const;
+  /**
+   * \returns The smallest delay of the channels cut by the last
+   * partition, or zero if no channel is cut.
+   */
+  Time GetLookahead (void) const;
+
+  /**
+   * \param node A node.
+   * \returns true if the node runs on this system, i.e. if the
+   * applications of this node should be installed.
+   */
+  static bool IsLocal (Ptr<Node> node);
+
+private:
+  /** A graph of nodes linked by weighted channels. */
+  struct Graph
+  {
+    std::vector<double> vertexWeight;                          //!< Weight of each vertex
+    std::vector<std::vector<std::pair<uint32_t, double> > > adjacency; //!< Neighbor and edge weight
+  };
+
+  /**
+   * Split the vertices recursively into parts.
+   * \param graph The graph.
+   * \param vertices The vertices to split.
+   * \param firstPart The part of the first half.
+   * \param parts The number of parts.
+   * \param part The part of each vertex, to fill.
+   */
+  void Split (const Graph &graph, const std::vector<uint32_t> &vertices,
+              uint32_t firstPart, uint32_t parts, std::vector<uint32_t> &part) const;
+  /**
+   * Split the vertices in two.
+   * \param graph The graph.
+   * \param vertices The vertices to split.
+   * \param fraction The share of the weight of the first side.
+   * \returns For each vertex, true if it belongs to the first side.
+   */
+  std::vector<bool> Bisect (const Graph &graph, const std::vector<uint32_t> &vertices,
+                            double fraction) const;
+
+  double m_imbalance;   //!< Tolerated imbalance
+  uint32_t m_cutSize;   //!< Channels cut by the last partition
+  Time m_lookahead;     //!< Smallest delay of the channels cut
+};
+
+} // namespace ns3
+
+#endif /* TOPOLOGY_PARTITION_HELPER_H */
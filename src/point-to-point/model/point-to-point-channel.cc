@@ -23,6 +23,8 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 
+#include <vector>
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PointToPointChannel");
@@ -57,7 +59,8 @@ PointToPointChannel::PointToPointChannel()
   :
     Channel (),
     m_delay (Seconds (0.)),
-    m_nDevices (0)
+    m_nDevices (0),
+    m_crossPartition (false)
 {
   NS_LOG_FUNCTION_NOARGS ();
 }
@@ -97,6 +100,21 @@ PointToPointChannel::TransmitStart (
 
   uint32_t wire = src == m_link[0].m_src ? 0 : 1;
 
+  if (m_crossPartition)
+    {
+      // The receiving device runs in another thread: hand it over a
+      // packet rebuilt from a serialized copy, so that the two threads
+      // share no reference-counted buffer or tag, and refer to the
+      // device without touching its reference count.
+      std::vector<uint8_t> buffer (p->GetSerializedSize ());
+      p->Serialize (&buffer[0], buffer.size ());
+      Ptr<Packet> copy = Create<Packet> (&buffer[0], buffer.size (), true);
+      Simulator::ScheduleWithContext (m_link[wire].m_dstContext,
+                                      txTime + m_delay, &PointToPointNetDevice::Receive,
+                                      PeekPointer (m_link[wire].m_dst), copy);
+      return true;
+    }
+
   Simulator::ScheduleWithContext (m_link[wire].m_dst->GetNode ()->GetId (),
                                   txTime + m_delay, &PointToPointNetDevice::Receive,
                                   m_link[wire].m_dst, p->Copy ());
@@ -106,6 +124,69 @@ PointToPointChannel::TransmitStart (
   return true;
 }
 
+bool
+PointToPointChannel::TransmitTrain (
+  const std::vector<Ptr<Packet> > &train,
+  Ptr<PointToPointNetDevice> src,
+  const std::vector<Time> &txStart,
+  const std::vector<Time> &txTime)
+{
+  NS_LOG_FUNCTION (this << train.size () << src);
+  NS_ASSERT (!train.empty () && train.size () == txStart.size () && train.size () == txTime.size ());
+
+  NS_ASSERT (m_link[0].m_state != INITIALIZING);
+  NS_ASSERT (m_link[1].m_state != INITIALIZING);
+
+  uint32_t wire = src == m_link[0].m_src ? 0 : 1;
+  Time rxTime = txStart.back () + txTime.back () + m_delay;
+
+  std::vector<Ptr<Packet> > copies;
+  copies.reserve (train.size ());
+  if (m_crossPartition)
+    {
+      // As in TransmitStart, copies sharing nothing with the sender
+      std::vector<uint8_t> buffer;
+      for (std::size_t i = 0; i < train.size (); ++i)
+        {
+          buffer.resize (train[i]->GetSerializedSize ());
+          train[i]->Serialize (&buffer[0], buffer.size ());
+          copies.push_back (Create<Packet> (&buffer[0], buffer.size (), true));
+        }
+      Simulator::ScheduleWithContext (m_link[wire].m_dstContext,
+                                      rxTime, &PointToPointNetDevice::ReceiveTrain,
+                                      PeekPointer (m_link[wire].m_dst), copies);
+      return true;
+    }
+
+  for (std::size_t i = 0; i < train.size (); ++i)
+    {
+      copies.push_back (train[i]->Copy ());
+    }
+  Simulator::ScheduleWithContext (m_link[wire].m_dst->GetNode ()->GetId (),
+                                  rxTime, &PointToPointNetDevice::ReceiveTrain,
+                                  m_link[wire].m_dst, copies);
+
+  // The animation sees the exact times of each packet
+  for (std::size_t i = 0; i < train.size (); ++i)
+    {
+      m_txrxPointToPoint (train[i], src, m_link[wire].m_dst, txTime[i],
+                          txStart[i] + txTime[i] + m_delay);
+    }
+  return true;
+}
+
+void
+PointToPointChannel::SetCrossPartition (bool crossPartition)
+{
+  NS_LOG_FUNCTION (this << crossPartition);
+  NS_ASSERT_MSG (m_nDevices == N_DEVICES, "Both devices must be attached");
+  m_crossPartition = crossPartition;
+  for (uint32_t i = 0; i < N_DEVICES; ++i)
+    {
+      m_link[i].m_dstContext = m_link[i].m_dst->GetNode ()->GetId ();
+    }
+}
+
 std::size_t
 PointToPointChannel::GetNDevices (void) const
 {
@@ -20,6 +20,7 @@
 #define POINT_TO_POINT_CHANNEL_H
 
 #include <list>
+#include <vector>
 #include "ns3/channel.h"
 #include "ns3/ptr.h"
 #include "ns3/nstime.h"
@@ -80,6 +81,22 @@ public:
    */
   virtual bool TransmitStart (Ptr<const Packet> p, Ptr<PointToPointNetDevice> src, Time txTime);
 
+  /**
+   * \brief Transmit a train of packets serialized back to back over this
+   * channel
+   *
+   * The destination device receives the whole train in a single event,
+   * when the last bit of its last packet has arrived.
+   *
+   * \param train Packets to transmit, in order
+   * \param src Source PointToPointNetDevice
+   * \param txStart Time from now at which each packet starts being transmitted
+   * \param txTime Transmit time of each packet
+   * \returns true if successful (currently always true)
+   */
+  virtual bool TransmitTrain (const std::vector<Ptr<Packet> > &train, Ptr<PointToPointNetDevice> src,
+                              const std::vector<Time> &txStart, const std::vector<Time> &txTime);
+
   /**
    * \brief Get number of devices on this channel
    * \returns number of devices on this channel
@@ -100,6 +117,20 @@ public:
    */
   virtual Ptr<NetDevice> GetDevice (std::size_t i) const;
 
+  /**
+   * \brief Set whether the two devices run in different partitions of a
+   * multithreaded simulation
+   *
+   * The packets crossing the channel are then handed over to the
+   * receiving partition as copies which share no buffer nor tag with
+   * the transmitted packets, and the TxRxPointToPoint trace source is
+   * not fired.  Both devices must be attached.
+   *
+   * \see MultithreadedSimulatorHelper
+   * \param crossPartition true if the devices run in different partitions
+   */
+  void SetCrossPartition (bool crossPartition);
+
 protected:
   /**
    * \brief Get the delay associated with this channel
@@ -151,6 +182,7 @@ private:
 
   Time          m_delay;    //!< Propagation delay
   std::size_t        m_nDevices; //!< Devices of this channel
+  bool          m_crossPartition; //!< Do the devices run in different partitions
 
   /**
    * The trace source for the packet transmission animation events that the 
@@ -194,11 +226,12 @@ public:
     /** \brief Create the link, it will be in INITIALIZING state
      *
      */
-    Link() : m_state (INITIALIZING), m_src (0), m_dst (0) {}
+    Link() : m_state (INITIALIZING), m_src (0), m_dst (0), m_dstContext (0) {}
 
     WireState                  m_state; //!< State of the link
     Ptr<PointToPointNetDevice> m_src;   //!< First NetDevice
     Ptr<PointToPointNetDevice> m_dst;   //!< Second NetDevice
+    uint32_t                   m_dstContext; //!< Node id of m_dst, when crossing partitions
   };
 
   Link    m_link[N_DEVICES]; //!< Link model
@@ -67,6 +67,19 @@ PointToPointNetDevice::GetTypeId (void)
                    TimeValue (Seconds (0.0)),
                    MakeTimeAccessor (&PointToPointNetDevice::m_tInterframeGap),
                    MakeTimeChecker ())
+    .AddAttribute ("MaxTrainLength",
+                   "The highest number of queued packets serialized back to back "
+                   "in a single transmission event, 1 to transmit the packets one by one",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&PointToPointNetDevice::m_maxTrainLength),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("MaxTrainDuration",
+                   "The longest time from the start of a train to the end of its last "
+                   "packet, which bounds how early or late each packet of the train is "
+                   "dequeued, traced and received",
+                   TimeValue (MicroSeconds (10)),
+                   MakeTimeAccessor (&PointToPointNetDevice::m_maxTrainDuration),
+                   MakeTimeChecker ())
 
     //
     // Transmit queueing discipline for the device which includes its own set
@@ -177,7 +190,9 @@ PointToPointNetDevice::PointToPointNetDevice ()
     m_txMachineState (READY),
     m_channel (0),
     m_linkUp (false),
-    m_currentPkt (0)
+    m_currentPkt (0),
+    m_maxTrainLength (1),
+    m_maxTrainDuration (MicroSeconds (10))
 {
   NS_LOG_FUNCTION (this);
 }
@@ -214,6 +229,7 @@ PointToPointNetDevice::DoDispose ()
   m_channel = 0;
   m_receiveErrorModel = 0;
   m_currentPkt = 0;
+  m_currentTrain.clear ();
   m_queue = 0;
   NetDevice::DoDispose ();
 }
@@ -244,6 +260,10 @@ PointToPointNetDevice::TransmitStart (Ptr<Packet> p)
   // schedule an event that will be executed when the transmission is complete.
   //
   NS_ASSERT_MSG (m_txMachineState == READY, "Must be READY to transmit");
+  if (m_maxTrainLength > 1 && !m_queue->IsEmpty ())
+    {
+      return TransmitTrain (p);
+    }
   m_txMachineState = BUSY;
   m_currentPkt = p;
   m_phyTxBeginTrace (m_currentPkt);
@@ -262,6 +282,54 @@ PointToPointNetDevice::TransmitStart (Ptr<Packet> p)
   return result;
 }
 
+bool
+PointToPointNetDevice::TransmitTrain (Ptr<Packet> p)
+{
+  NS_LOG_FUNCTION (this << p);
+
+  m_txMachineState = BUSY;
+  std::vector<Time> txStart;
+  std::vector<Time> txTime;
+  Time next = Seconds (0);
+  while (true)
+    {
+      m_currentTrain.push_back (p);
+      m_phyTxBeginTrace (p);
+      txStart.push_back (next);
+      txTime.push_back (m_bps.CalculateBytesTxTime (p->GetSize ()));
+      next += txTime.back () + m_tInterframeGap;
+      if (m_currentTrain.size () == m_maxTrainLength)
+        {
+          break;
+        }
+      // A packet joins the train only if it ends within MaxTrainDuration,
+      // which bounds the timing error of every packet of the train
+      Ptr<const Packet> head = m_queue->Peek ();
+      if (head == 0
+          || next + m_bps.CalculateBytesTxTime (head->GetSize ()) > m_maxTrainDuration)
+        {
+          break;
+        }
+      p = m_queue->Dequeue ();
+      m_snifferTrace (p);
+      m_promiscSnifferTrace (p);
+    }
+
+  NS_LOG_LOGIC ("Schedule TransmitCompleteEvent of " << m_currentTrain.size ()
+                << " packets in " << next.As (Time::S));
+  Simulator::Schedule (next, &PointToPointNetDevice::TransmitComplete, this);
+
+  bool result = m_channel->TransmitTrain (m_currentTrain, this, txStart, txTime);
+  if (result == false)
+    {
+      for (std::size_t i = 0; i < m_currentTrain.size (); ++i)
+        {
+          m_phyTxDropTrace (m_currentTrain[i]);
+        }
+    }
+  return result;
+}
+
 void
 PointToPointNetDevice::TransmitComplete (void)
 {
@@ -276,10 +344,21 @@ PointToPointNetDevice::TransmitComplete (void)
   NS_ASSERT_MSG (m_txMachineState == BUSY, "Must be BUSY if transmitting");
   m_txMachineState = READY;
 
-  NS_ASSERT_MSG (m_currentPkt != 0, "PointToPointNetDevice::TransmitComplete(): m_currentPkt zero");
+  if (!m_currentTrain.empty ())
+    {
+      for (std::size_t i = 0; i < m_currentTrain.size (); ++i)
+        {
+          m_phyTxEndTrace (m_currentTrain[i]);
+        }
+      m_currentTrain.clear ();
+    }
+  else
+    {
+      NS_ASSERT_MSG (m_currentPkt != 0, "PointToPointNetDevice::TransmitComplete(): m_currentPkt zero");
 
-  m_phyTxEndTrace (m_currentPkt);
-  m_currentPkt = 0;
+      m_phyTxEndTrace (m_currentPkt);
+      m_currentPkt = 0;
+    }
 
   Ptr<Packet> p = m_queue->Dequeue ();
   if (p == 0)
@@ -378,6 +457,16 @@ PointToPointNetDevice::Receive (Ptr<Packet> packet)
     }
 }
 
+void
+PointToPointNetDevice::ReceiveTrain (const std::vector<Ptr<Packet> > &train)
+{
+  NS_LOG_FUNCTION (this << train.size ());
+  for (std::size_t i = 0; i < train.size (); ++i)
+    {
+      Receive (train[i]);
+    }
+}
+
 Ptr<Queue<Packet> >
 PointToPointNetDevice::GetQueue (void) const
 { 
@@ -20,6 +20,7 @@
 #define POINT_TO_POINT_NET_DEVICE_H
 
 #include <cstring>
+#include <vector>
 #include "ns3/address.h"
 #include "ns3/node.h"
 #include "ns3/net-device.h"
@@ -58,6 +59,17 @@ class ErrorModel;
  * Key parameters or objects that can be specified for this device 
  * include a queue, data rate, and interframe transmission gap (the 
  * propagation delay is set in the PointToPointChannel).
+ *
+ * With a MaxTrainLength greater than 1, the packets waiting in the queue
+ * when a transmission starts are serialized back to back as a train,
+ * which costs one transmission complete event and one receive event per
+ * train instead of per packet.  The packets leave the queue when the
+ * train starts, the PhyTxBegin and PhyTxEnd trace sources are fired for
+ * each packet at the start and at the end of the train, and the peer
+ * device receives the train when its last packet has arrived.  A train
+ * ends at most MaxTrainDuration after it starts, so each of these times
+ * is off by less than MaxTrainDuration.  The TxRxPointToPoint trace
+ * source of the channel keeps the exact times of each packet.
  */
 class PointToPointNetDevice : public NetDevice
 {
@@ -149,6 +161,17 @@ public:
    */
   void Receive (Ptr<Packet> p);
 
+  /**
+   * Receive a train of packets from a connected PointToPointChannel.
+   *
+   * The packets are received in order, as by Receive, when the last bit
+   * of the last packet of the train has arrived at the device.
+   *
+   * \see MaxTrainLength attribute
+   * \param train the received packets
+   */
+  void ReceiveTrain (const std::vector<Ptr<Packet> > &train);
+
   // The remaining methods are documented in ns3::NetDevice*
 
   virtual void SetIfIndex (const uint32_t index);
@@ -275,6 +298,21 @@ private:
    */
   void TransmitComplete (void);
 
+  /**
+   * Start Sending a Train of Packets Down the Wire.
+   *
+   * The packet and up to MaxTrainLength - 1 packets of the queue are
+   * serialized back to back, with the interframe gap between them, and
+   * handed over to the channel in a single call.  The packets of the
+   * queue join the train as long as they end within MaxTrainDuration.  A single event completes
+   * the transmission of the whole train.
+   *
+   * \see PointToPointChannel::TransmitTrain ()
+   * \param p the first packet of the train
+   * \returns true if success, false on failure
+   */
+  bool TransmitTrain (Ptr<Packet> p);
+
   /**
    * \brief Make the link up and running
    *
@@ -456,6 +494,19 @@ private:
   uint32_t m_mtu;
 
   Ptr<Packet> m_currentPkt; //!< Current packet processed
+  std::vector<Ptr<Packet> > m_currentTrain; //!< Current train of packets processed
+
+  /**
+   * The highest number of queued packets serialized as a train, 1 to
+   * transmit the packets one by one.
+   */
+  uint32_t m_maxTrainLength;
+
+  /**
+   * The longest time from the start of a train to the end of its last
+   * packet, which bounds the timing error of the packets of a train.
+   */
+  Time m_maxTrainDuration;
 
   /**
    * \brief PPP to Ethernet protocol number mapping
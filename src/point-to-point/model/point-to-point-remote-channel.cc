@@ -73,4 +73,26 @@ PointToPointRemoteChannel::TransmitStart (
   return true;
 }
 
+bool
+PointToPointRemoteChannel::TransmitTrain (
+  const std::vector<Ptr<Packet> > &train,
+  Ptr<PointToPointNetDevice> src,
+  const std::vector<Time> &txStart,
+  const std::vector<Time> &txTime)
+{
+  NS_LOG_FUNCTION (this << train.size () << src);
+
+  IsInitialized ();
+
+  uint32_t wire = src == GetSource (0) ? 0 : 1;
+  Ptr<PointToPointNetDevice> dst = GetDestination (wire);
+
+  for (std::size_t i = 0; i < train.size (); ++i)
+    {
+      Time rxTime = Simulator::Now () + txStart[i] + txTime[i] + GetDelay ();
+      MpiInterface::SendPacket (train[i]->Copy (), rxTime, dst->GetNode ()->GetId (), dst->GetIfIndex ());
+    }
+  return true;
+}
+
 } // namespace ns3
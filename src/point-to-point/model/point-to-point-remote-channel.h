@@ -68,6 +68,21 @@ public:
    */
   virtual bool TransmitStart (Ptr<const Packet> p, Ptr<PointToPointNetDevice> src,
                               Time txTime);
+
+  /**
+   * \brief Transmit a train of packets
+   *
+   * The packets are sent to the remote process one by one, each with its
+   * own receive time.
+   *
+   * \param train Packets to transmit, in order
+   * \param src Source PointToPointNetDevice
+   * \param txStart Time from now at which each packet starts being transmitted
+   * \param txTime Transmit time of each packet
+   * \returns true if successful (currently always true)
+   */
+  virtual bool TransmitTrain (const std::vector<Ptr<Packet> > &train, Ptr<PointToPointNetDevice> src,
+                              const std::vector<Time> &txStart, const std::vector<Time> &txTime);
 };
 
 } // namespace ns3
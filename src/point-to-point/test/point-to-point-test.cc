@@ -24,6 +24,11 @@
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/topology-partition-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 #include <string>
 
@@ -130,6 +135,323 @@ PointToPointTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \brief Test class for the trains of PointToPointNetDevice
+ *
+ * It sends a burst of packets with and without trains, and checks that
+ * the trains deliver the same packets in order with fewer events.
+ */
+class PointToPointTrainTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointTrainTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Send a burst of packets over a link
+   *
+   * \param maxTrainLength the MaxTrainLength of the sending device
+   * \param maxTrainDuration the MaxTrainDuration of the sending device
+   * \return the number of events executed
+   */
+  uint64_t SendBurst (uint32_t maxTrainLength, Time maxTrainDuration);
+  /**
+   * \brief Send the packets of the burst to the device specified
+   *
+   * \param device NetDevice to send to.
+   */
+  void SendPackets (Ptr<PointToPointNetDevice> device);
+  /**
+   * \brief Record a received packet
+   *
+   * \param dev The receiving device.
+   * \param pkt The received packet.
+   * \param mode The protocol mode used.
+   * \param sender The sender address.
+   *
+   * \return A boolean indicating packet handled properly.
+   */
+  bool RxPacket (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender);
+  /**
+   * \brief Record the times of a packet given to the animation
+   *
+   * \param pkt The packet.
+   * \param tx The transmitting device.
+   * \param rx The receiving device.
+   * \param duration The transmission time.
+   * \param lastBitTime The time until the last bit is received.
+   */
+  void TxRx (Ptr<const Packet> pkt, Ptr<NetDevice> tx, Ptr<NetDevice> rx, Time duration, Time lastBitTime);
+  /**
+   * \brief Count the packets transmitted
+   *
+   * \param pkt The packet.
+   */
+  void PhyTxEnd (Ptr<const Packet> pkt);
+
+  static const uint32_t BURST = 6;  //!< Packets of the burst
+  std::vector<uint8_t> m_received;  //!< First byte of each packet received
+  std::vector<Time> m_rxTimes;      //!< Receive time of each packet
+  std::vector<Time> m_lastBitTimes; //!< Last bit time of each packet given to the animation
+  uint32_t m_txEnd;                 //!< Packets transmitted
+};
+
+PointToPointTrainTest::PointToPointTrainTest ()
+  : TestCase ("PointToPoint trains"),
+    m_txEnd (0)
+{
+}
+
+void
+PointToPointTrainTest::SendPackets (Ptr<PointToPointNetDevice> device)
+{
+  // 123 bytes and the PPP header take 1 ms at 1 Mbps
+  for (uint8_t i = 0; i < BURST; ++i)
+    {
+      uint8_t buffer[123];
+      memset (buffer, i, sizeof (buffer));
+      device->Send (Create<Packet> (buffer, sizeof (buffer)), device->GetBroadcast (), 0x800);
+    }
+}
+
+bool
+PointToPointTrainTest::RxPacket (Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address &sender)
+{
+  uint8_t first;
+  pkt->CopyData (&first, 1);
+  m_received.push_back (first);
+  m_rxTimes.push_back (Simulator::Now ());
+  return true;
+}
+
+void
+PointToPointTrainTest::TxRx (Ptr<const Packet> pkt, Ptr<NetDevice> tx, Ptr<NetDevice> rx, Time duration, Time lastBitTime)
+{
+  m_lastBitTimes.push_back (Simulator::Now () + lastBitTime);
+}
+
+void
+PointToPointTrainTest::PhyTxEnd (Ptr<const Packet> pkt)
+{
+  m_txEnd++;
+}
+
+uint64_t
+PointToPointTrainTest::SendBurst (uint32_t maxTrainLength, Time maxTrainDuration)
+{
+  m_received.clear ();
+  m_rxTimes.clear ();
+  m_lastBitTimes.clear ();
+  m_txEnd = 0;
+
+  Ptr<Node> a = CreateObject<Node> ();
+  Ptr<Node> b = CreateObject<Node> ();
+  Ptr<PointToPointNetDevice> devA = CreateObjectWithAttributes<PointToPointNetDevice>
+      ("DataRate", StringValue ("1Mbps"), "MaxTrainLength", UintegerValue (maxTrainLength),
+      "MaxTrainDuration", TimeValue (maxTrainDuration));
+  Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice> ();
+  Ptr<PointToPointChannel> channel = CreateObjectWithAttributes<PointToPointChannel>
+      ("Delay", StringValue ("1ms"));
+
+  devA->Attach (channel);
+  devA->SetAddress (Mac48Address::Allocate ());
+  devA->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+  devB->Attach (channel);
+  devB->SetAddress (Mac48Address::Allocate ());
+  devB->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+  a->AddDevice (devA);
+  b->AddDevice (devB);
+
+  devB->SetReceiveCallback (MakeCallback (&PointToPointTrainTest::RxPacket, this));
+  devA->TraceConnectWithoutContext ("PhyTxEnd", MakeCallback (&PointToPointTrainTest::PhyTxEnd, this));
+  channel->TraceConnectWithoutContext ("TxRxPointToPoint", MakeCallback (&PointToPointTrainTest::TxRx, this));
+
+  Simulator::Schedule (Seconds (1.0), &PointToPointTrainTest::SendPackets, this, devA);
+  uint64_t events = Simulator::GetEventCount ();
+  Simulator::Run ();
+  events = Simulator::GetEventCount () - events;
+  Simulator::Destroy ();
+  return events;
+}
+
+void
+PointToPointTrainTest::DoRun (void)
+{
+  uint64_t events = SendBurst (1, MilliSeconds (10));
+  NS_TEST_ASSERT_MSG_EQ (m_received.size (), BURST, "Packets lost");
+  NS_TEST_EXPECT_MSG_EQ (m_rxTimes.back (), Seconds (1.007), "Wrong receive time");
+
+  // The first packet is sent alone, the four next ones as a train and the
+  // last one alone after the train.
+  uint64_t trainEvents = SendBurst (4, MilliSeconds (10));
+  NS_TEST_ASSERT_MSG_EQ (m_received.size (), BURST, "Packets lost in a train");
+  NS_TEST_EXPECT_MSG_EQ (m_txEnd, BURST, "PhyTxEnd should be fired for each packet");
+  for (uint8_t i = 0; i < BURST; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (static_cast<uint32_t> (m_received[i]), static_cast<uint32_t> (i), "Packets out of order");
+      NS_TEST_EXPECT_MSG_EQ (m_lastBitTimes[i], Seconds (1.002 + 0.001 * i), "Wrong last bit time of a packet");
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_rxTimes[0], Seconds (1.002), "Wrong receive time of the first packet");
+  NS_TEST_EXPECT_MSG_EQ (m_rxTimes[1], Seconds (1.006), "The train should be received with its last packet");
+  NS_TEST_EXPECT_MSG_EQ (m_rxTimes[4], Seconds (1.006), "The train should be received with its last packet");
+  NS_TEST_EXPECT_MSG_EQ (m_rxTimes[5], Seconds (1.007), "The train should not delay the next packet");
+  // A train of four packets saves two events per packet after the first
+  NS_TEST_EXPECT_MSG_EQ (events - trainEvents, 2 * 3, "Wrong number of events saved by the train");
+
+  // The trains end within 3 ms of their start: the four packets after the
+  // first one are split in a train of three and a train of two.
+  SendBurst (4, MilliSeconds (3));
+  NS_TEST_ASSERT_MSG_EQ (m_received.size (), BURST, "Packets lost in a short train");
+  NS_TEST_EXPECT_MSG_EQ (m_rxTimes[1], Seconds (1.005), "The train should be received with its last packet");
+  NS_TEST_EXPECT_MSG_EQ (m_rxTimes[3], Seconds (1.005), "The train should be received with its last packet");
+  NS_TEST_EXPECT_MSG_EQ (m_rxTimes[4], Seconds (1.007), "The second train should be received with its last packet");
+  for (uint8_t i = 0; i < BURST; ++i)
+    {
+      NS_TEST_EXPECT_MSG_LT (m_rxTimes[i] - m_lastBitTimes[i], MilliSeconds (3), "Receive time off by more than the train duration");
+    }
+}
+
+/**
+ * \brief Test class for TopologyPartitionHelper
+ *
+ * It partitions a small leaf-spine network, then two chains linked by
+ * slow channels, which should be cut rather than the fewer fast ones.
+ */
+class TopologyPartitionTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  TopologyPartitionTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Check the leaf-spine partitions
+   */
+  void CheckLeafSpine (void);
+  /**
+   * \brief Check the partition of the chains
+   */
+  void CheckChains (void);
+};
+
+TopologyPartitionTest::TopologyPartitionTest ()
+  : TestCase ("TopologyPartitionHelper")
+{
+}
+
+void
+TopologyPartitionTest::CheckLeafSpine (void)
+{
+  NodeContainer spines, leaves, servers;
+  spines.Create (2);
+  leaves.Create (4);
+  servers.Create (16);
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("10Gbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("10us"));
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      for (uint32_t j = 0; j < 4; ++j)
+        {
+          p2p.Install (leaves.Get (i), servers.Get (4 * i + j));
+        }
+      for (uint32_t j = 0; j < 2; ++j)
+        {
+          p2p.Install (leaves.Get (i), spines.Get (j));
+        }
+    }
+  NodeContainer nodes (spines, leaves, servers);
+
+  TopologyPartitionHelper partitioner;
+  partitioner.Install (nodes, 2);
+  NS_TEST_EXPECT_MSG_EQ (partitioner.GetCutSize (), 4, "Wrong cut");
+  NS_TEST_EXPECT_MSG_EQ (partitioner.GetLookahead (), MicroSeconds (10), "Wrong lookahead");
+  uint32_t size[2] = { 0, 0 };
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      uint32_t leaf = leaves.Get (i)->GetSystemId ();
+      NS_TEST_ASSERT_MSG_LT (leaf, 2, "Wrong system id");
+      size[leaf]++;
+      for (uint32_t j = 0; j < 4; ++j)
+        {
+          NS_TEST_EXPECT_MSG_EQ (servers.Get (4 * i + j)->GetSystemId (), leaf, "Server away from its leaf");
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (size[0], 2, "Unbalanced partition");
+
+  std::vector<uint32_t> parts = partitioner.Partition (nodes, 4);
+  std::vector<uint32_t> count (4, 0);
+  for (uint32_t i = 0; i < parts.size (); ++i)
+    {
+      NS_TEST_ASSERT_MSG_LT (parts[i], 4, "Wrong part");
+      count[parts[i]]++;
+    }
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      NS_TEST_EXPECT_MSG_GT (count[i], 0, "Empty part");
+    }
+  // Two leaves share a part with a spine, the two others cut both
+  // their spine channels.
+  NS_TEST_EXPECT_MSG_EQ (partitioner.GetCutSize (), 6, "Wrong cut");
+}
+
+void
+TopologyPartitionTest::CheckChains (void)
+{
+  NodeContainer a, b;
+  a.Create (4);
+  b.Create (4);
+  PointToPointHelper fast;
+  fast.SetDeviceAttribute ("DataRate", StringValue ("10Gbps"));
+  fast.SetChannelAttribute ("Delay", StringValue ("1us"));
+  PointToPointHelper slow;
+  slow.SetDeviceAttribute ("DataRate", StringValue ("10Gbps"));
+  slow.SetChannelAttribute ("Delay", StringValue ("100us"));
+  for (uint32_t i = 0; i < 3; ++i)
+    {
+      fast.Install (a.Get (i), a.Get (i + 1));
+      fast.Install (b.Get (i), b.Get (i + 1));
+      slow.Install (a.Get (i), b.Get (i));
+    }
+  NodeContainer nodes (a, b);
+
+  // Cutting the chains in their middle would cut two channels only,
+  // but limit the lookahead to 1us.
+  TopologyPartitionHelper partitioner;
+  std::vector<uint32_t> parts = partitioner.Partition (nodes, 2);
+  for (uint32_t i = 1; i < 4; ++i)
+    {
+      NS_TEST_EXPECT_MSG_EQ (parts[i], parts[0], "Chain a cut");
+      NS_TEST_EXPECT_MSG_EQ (parts[4 + i], parts[4], "Chain b cut");
+    }
+  NS_TEST_EXPECT_MSG_NE (parts[0], parts[4], "Chains together");
+  NS_TEST_EXPECT_MSG_EQ (partitioner.GetCutSize (), 3, "Wrong cut");
+  NS_TEST_EXPECT_MSG_EQ (partitioner.GetLookahead (), MicroSeconds (100), "Wrong lookahead");
+}
+
+void
+TopologyPartitionTest::DoRun (void)
+{
+  CheckLeafSpine ();
+  CheckChains ();
+  Simulator::Destroy ();
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -146,6 +468,8 @@ PointToPointTestSuite::PointToPointTestSuite ()
   : TestSuite ("devices-point-to-point", UNIT)
 {
   AddTestCase (new PointToPointTest, TestCase::QUICK);
+  AddTestCase (new PointToPointTrainTest, TestCase::QUICK);
+  AddTestCase (new TopologyPartitionTest, TestCase::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
@@ -24,6 +24,7 @@
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/uinteger.h"
 #include "ns3/pointer.h"
+#include "ns3/simulator.h"
 #include "ns3/traffic-control-layer.h"
 #include "traffic-control-helper.h"
 
@@ -275,6 +276,45 @@ TrafficControlHelper::Uninstall (Ptr<NetDevice> d)
     }
 }
 
+void
+TrafficControlHelper::InstallSharedBuffer (Ptr<Node> node, Ptr<SharedBufferManager> buffer)
+{
+  NS_LOG_FUNCTION (node << buffer);
+
+  Ptr<TrafficControlLayer> tc = node->GetObject<TrafficControlLayer> ();
+  NS_ASSERT (tc != 0);
+
+  for (uint32_t i = 0; i < node->GetNDevices (); i++)
+    {
+      Ptr<NetDevice> d = node->GetDevice (i);
+      Ptr<QueueDisc> qd = tc->GetRootQueueDiscOnDevice (d);
+      if (qd)
+        {
+          buffer->AddQueueDisc (qd, d->GetIfIndex ());
+        }
+    }
+  node->AggregateObject (buffer);
+}
+
+void
+TrafficControlHelper::InstallFluidLoad (Ptr<NetDevice> d, Ptr<FluidLoad> load)
+{
+  NS_LOG_FUNCTION (d << load);
+
+  Ptr<TrafficControlLayer> tc = d->GetNode ()->GetObject<TrafficControlLayer> ();
+  NS_ASSERT (tc != 0);
+  Ptr<QueueDisc> qd = tc->GetRootQueueDiscOnDevice (d);
+  NS_ABORT_MSG_IF (qd == 0, "No root queue disc on the device");
+
+  DataRateValue rate;
+  if (d->GetAttributeFailSafe ("DataRate", rate))
+    {
+      load->SetDataRate (rate.Get ());
+    }
+  qd->SetFluidLoad (load);
+  Simulator::ScheduleWithContext (d->GetNode ()->GetId (), Seconds (0), &FluidLoad::Start, load);
+}
+
 void
 TrafficControlHelper::Uninstall (NetDeviceContainer c)
 {
@@ -27,6 +27,8 @@
 #include "ns3/net-device-container.h"
 #include "ns3/queue-disc-container.h"
 #include "ns3/queue.h"
+#include "ns3/shared-buffer-manager.h"
+#include "ns3/fluid-load.h"
 
 namespace ns3 {
 
@@ -283,6 +285,28 @@ public:
    */
   void Uninstall (Ptr<NetDevice> d);
 
+  /**
+   * \param node the node
+   * \param buffer the shared buffer
+   *
+   * This method makes the root queue discs installed on the devices of the
+   * given node share the given buffer, each one as a queue of the port
+   * given by the index of its device, and aggregates the buffer to the
+   * node.  It must be called after the queue discs are installed.
+   */
+  static void InstallSharedBuffer (Ptr<Node> node, Ptr<SharedBufferManager> buffer);
+
+  /**
+   * \param d device
+   * \param load the fluid load
+   *
+   * This method makes the root queue disc installed on the given device
+   * hold the given fluid load, sets the capacity of the fluid to the
+   * DataRate of the device, if it has one, and starts the fluid at the
+   * current time.  It must be called after the queue disc is installed.
+   */
+  static void InstallFluidLoad (Ptr<NetDevice> d, Ptr<FluidLoad> load);
+
 private:
   /**
    * Actual implementation of the SetRootQueueDisc method.
@@ -0,0 +1,259 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+#include "fluid-load.h"
+#include "queue-disc.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FluidLoad");
+
+NS_OBJECT_ENSURE_REGISTERED (FluidLoad);
+
+TypeId
+FluidLoad::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FluidLoad")
+    .SetParent<Object> ()
+    .SetGroupName ("TrafficControl")
+    .AddAttribute ("DataRate",
+                   "The capacity of the link serving the fluid and the packets",
+                   DataRateValue (DataRate ("10Gbps")),
+                   MakeDataRateAccessor (&FluidLoad::SetDataRate,
+                                         &FluidLoad::GetDataRate),
+                   MakeDataRateChecker ())
+    .AddAttribute ("TimeStep",
+                   "The interval between the updates of the rate of the fluid",
+                   TimeValue (MicroSeconds (10)),
+                   MakeTimeAccessor (&FluidLoad::m_timeStep),
+                   MakeTimeChecker (NanoSeconds (1)))
+    .AddAttribute ("PacketSize",
+                   "The packet size of the backlog counted in packets",
+                   UintegerValue (1500),
+                   MakeUintegerAccessor (&FluidLoad::m_packetSize),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddTraceSource ("Backlog",
+                     "The fluid held in the queue, in bytes",
+                     MakeTraceSourceAccessor (&FluidLoad::m_backlog),
+                     "ns3::TracedValueCallback::Uint32")
+  ;
+  return tid;
+}
+
+FluidLoad::FluidLoad ()
+  : m_rate (0),
+    m_arrived (0),
+    m_removed (0),
+    m_debt (0),
+    m_stats (),
+    m_backlog (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+FluidLoad::~FluidLoad ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+FluidLoad::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  Simulator::Cancel (m_step);
+  m_queueDisc = 0;
+  m_ahead.clear ();
+  Object::DoDispose ();
+}
+
+void
+FluidLoad::SetQueueDisc (Ptr<QueueDisc> qd)
+{
+  NS_LOG_FUNCTION (this << qd);
+  m_queueDisc = qd;
+  m_lastUpdate = Simulator::Now ();
+}
+
+Ptr<QueueDisc>
+FluidLoad::GetQueueDisc (void) const
+{
+  return m_queueDisc;
+}
+
+DataRate
+FluidLoad::GetDataRate (void) const
+{
+  return m_dataRate;
+}
+
+void
+FluidLoad::SetDataRate (DataRate rate)
+{
+  NS_LOG_FUNCTION (this << rate);
+  Update ();
+  m_dataRate = rate;
+}
+
+Time
+FluidLoad::GetTimeStep (void) const
+{
+  return m_timeStep;
+}
+
+double
+FluidLoad::GetDroppedBytes (void) const
+{
+  return m_stats.nDroppedBytes;
+}
+
+FluidLoad::Stats
+FluidLoad::GetStats (void)
+{
+  Update ();
+  return m_stats;
+}
+
+void
+FluidLoad::Start (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (m_queueDisc, "The fluid load is not attached to a queue disc");
+  if (!m_step.IsRunning ())
+    {
+      m_lastUpdate = Simulator::Now ();
+      Step ();
+    }
+}
+
+void
+FluidLoad::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  Update ();
+  Simulator::Cancel (m_step);
+  m_rate = 0;
+}
+
+void
+FluidLoad::Step (void)
+{
+  NS_LOG_FUNCTION (this);
+  Update ();
+  m_rate = std::max (DoStep (), 0.0);
+  m_stats.nSteps++;
+  m_step = Simulator::Schedule (m_timeStep, &FluidLoad::Step, this);
+}
+
+void
+FluidLoad::Update (void)
+{
+  Time now = Simulator::Now ();
+  if (!m_queueDisc || now <= m_lastUpdate)
+    {
+      return;
+    }
+  double dt = (now - m_lastUpdate).GetSeconds ();
+  m_lastUpdate = now;
+
+  // The link transmits the packets sent to the device first, then the fluid
+  double capacity = m_dataRate.GetBitRate () / 8.0 * dt;
+  double paid = std::min (m_debt, capacity);
+  m_debt -= paid;
+  capacity -= paid;
+
+  double arrivals = m_rate * dt;
+  double served = std::min (m_arrived - m_removed + arrivals, capacity);
+  m_arrived += arrivals;
+  m_removed += served;
+  m_stats.nArrivedBytes += arrivals;
+  m_stats.nServedBytes += served;
+
+  // The fluid in excess of the buffer is dropped.  It is removed from the
+  // head rather than the tail of the fluid, which keeps the fluid ahead of
+  // the packets bounded by the backlog.
+  QueueSize max = m_queueDisc->GetMaxSize ();
+  double room = max.GetUnit () == QueueSizeUnit::BYTES
+    ? static_cast<double> (max.GetValue ()) - m_queueDisc->GetNBytes ()
+    : (static_cast<double> (max.GetValue ()) - m_queueDisc->GetNPackets ()) * m_packetSize;
+  double excess = m_arrived - m_removed - std::max (room, 0.0);
+  if (excess > 0)
+    {
+      m_removed += excess;
+      m_stats.nDroppedBytes += excess;
+    }
+
+  m_backlog = static_cast<uint32_t> (m_arrived - m_removed);
+  m_stats.maxBacklog = std::max (m_stats.maxBacklog, m_backlog.Get ());
+}
+
+uint32_t
+FluidLoad::GetBacklog (QueueSizeUnit unit)
+{
+  Update ();
+  return unit == QueueSizeUnit::BYTES ? m_backlog.Get () : m_backlog.Get () / m_packetSize;
+}
+
+void
+FluidLoad::PacketEnqueued (uint32_t bytes)
+{
+  NS_LOG_FUNCTION (this << bytes);
+  Update ();
+  m_ahead.push_back (m_arrived);
+}
+
+void
+FluidLoad::PacketDequeued (void)
+{
+  NS_LOG_FUNCTION (this);
+  // The packets enqueued before the fluid load was attached have no entry
+  if (!m_ahead.empty ())
+    {
+      m_ahead.pop_front ();
+    }
+}
+
+void
+FluidLoad::PacketTransmitted (uint32_t bytes)
+{
+  NS_LOG_FUNCTION (this << bytes);
+  Update ();
+  m_debt += bytes;
+}
+
+Time
+FluidLoad::GetReleaseDelay (void)
+{
+  if (m_ahead.empty ())
+    {
+      return Time (0);
+    }
+  Update ();
+  // Less than a byte left is rounding
+  double ahead = m_ahead.front () - m_removed;
+  if (ahead < 1)
+    {
+      return Time (0);
+    }
+  m_stats.nHolds++;
+  return Seconds ((ahead + m_debt) * 8 / m_dataRate.GetBitRate ());
+}
+
+} // namespace ns3
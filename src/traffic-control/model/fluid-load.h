@@ -0,0 +1,205 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef FLUID_LOAD_H
+#define FLUID_LOAD_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/data-rate.h"
+#include "ns3/queue-size.h"
+#include "ns3/traced-value.h"
+#include <deque>
+
+namespace ns3 {
+
+class QueueDisc;
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief The abstract base class of the background loads represented as
+ * a fluid in the queue of a queue disc
+ *
+ * The flows of a fluid load send no packets: their bytes arrive in the
+ * queue as a fluid, at a rate set by the subclass every TimeStep (see
+ * TcpFluidLoad for TCP flows), and are served by the link in FIFO order
+ * with the packets of the queue disc.  The fluid is held in the buffer of
+ * the queue disc, so that the packets see it:
+ *
+ * - the queue disc drops the packets which do not fit with the fluid in
+ *   its MaxSize, with the reason QueueDisc::FLUID_LOAD_DROP, and the fluid
+ *   in excess of the buffer is dropped;
+ * - the queue discs which mark or drop on their queue length, such as
+ *   RedQueueDisc and StepMarkingQueueDisc, count the fluid backlog in
+ *   their queue length, in packets of PacketSize bytes;
+ * - a packet is not dequeued before the fluid which arrived before it has
+ *   been served, hence its queueing delay.
+ *
+ * The link serves the fluid when it does not transmit packets.  The
+ * accounting is done upon the steps and the packet operations only, so
+ * that a fluid load costs one event per TimeStep whatever its rate, and
+ * one more event per packet which has to wait for the fluid ahead of it.
+ * The queue disc is assumed to serve its packets in FIFO order.
+ *
+ * A fluid load is attached to a root queue disc with a size limit, see
+ * QueueDisc::SetFluidLoad and TrafficControlHelper::InstallFluidLoad.
+ */
+class FluidLoad : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  FluidLoad ();
+  virtual ~FluidLoad ();
+
+  /// The statistics of the fluid
+  struct Stats
+  {
+    double nArrivedBytes;   //!< Bytes arrived in the queue
+    double nServedBytes;    //!< Bytes served by the link
+    double nDroppedBytes;   //!< Bytes dropped as the buffer was full
+    uint32_t maxBacklog;    //!< Highest backlog, in bytes
+    uint64_t nSteps;        //!< Steps done
+    uint32_t nHolds;        //!< Times a packet waited for the fluid ahead of it
+  };
+
+  /**
+   * \brief Set the queue disc holding the fluid
+   *
+   * This is done by QueueDisc::SetFluidLoad.
+   *
+   * \param qd the queue disc
+   */
+  void SetQueueDisc (Ptr<QueueDisc> qd);
+
+  /**
+   * \brief Start the steps of the fluid, from the current time
+   */
+  void Start (void);
+
+  /**
+   * \brief Stop the steps of the fluid, which then stops arriving
+   */
+  void Stop (void);
+
+  /**
+   * \param unit the unit of the backlog
+   * \return the fluid held in the queue, in bytes or in packets of
+   *         PacketSize bytes (rounded down)
+   */
+  uint32_t GetBacklog (QueueSizeUnit unit);
+
+  /**
+   * \brief Notify that a packet was enqueued behind the fluid
+   * \param bytes the size of the packet
+   */
+  void PacketEnqueued (uint32_t bytes);
+
+  /**
+   * \brief Notify that the packet at the head of the queue was dequeued
+   */
+  void PacketDequeued (void);
+
+  /**
+   * \brief Notify that a packet was sent to the device
+   * \param bytes the size of the packet
+   */
+  void PacketTransmitted (uint32_t bytes);
+
+  /**
+   * \return the time until the fluid ahead of the packet at the head of
+   *         the queue is served, zero if the packet can be dequeued now
+   */
+  Time GetReleaseDelay (void);
+
+  /**
+   * \return the capacity of the link
+   */
+  DataRate GetDataRate (void) const;
+
+  /**
+   * \param rate the capacity of the link
+   */
+  void SetDataRate (DataRate rate);
+
+  /**
+   * \return the statistics of the fluid
+   */
+  Stats GetStats (void);
+
+protected:
+  virtual void DoDispose (void);
+
+  /**
+   * \return the queue disc holding the fluid
+   */
+  Ptr<QueueDisc> GetQueueDisc (void) const;
+
+  /**
+   * \return the step of the fluid
+   */
+  Time GetTimeStep (void) const;
+
+  /**
+   * \return the fluid dropped since the start, in bytes
+   */
+  double GetDroppedBytes (void) const;
+
+private:
+  /**
+   * \brief Compute the rate of the fluid until the next step
+   *
+   * Called at each step, once the fluid is accounted up to now.
+   *
+   * \return the rate at which the fluid arrives, in bytes per second
+   */
+  virtual double DoStep (void) = 0;
+
+  /**
+   * \brief Account for the fluid arrived and served since the last update
+   */
+  void Update (void);
+
+  /**
+   * \brief Do a step of the fluid and schedule the next one
+   */
+  void Step (void);
+
+  Ptr<QueueDisc> m_queueDisc;   //!< The queue disc holding the fluid
+  DataRate m_dataRate;          //!< The capacity of the link
+  Time m_timeStep;              //!< The step of the fluid
+  uint32_t m_packetSize;        //!< The packet size of the backlog in packets
+  EventId m_step;               //!< The next step
+  Time m_lastUpdate;            //!< The time of the last update
+  double m_rate;                //!< The arrival rate, in bytes per second
+  double m_arrived;             //!< Cumulative fluid arrived, in bytes
+  double m_removed;             //!< Cumulative fluid served or dropped, in bytes
+  double m_debt;                //!< Bytes of the packets sent to the device not yet transmitted
+  std::deque<double> m_ahead;   //!< The fluid arrived before each packet of the queue
+  Stats m_stats;                //!< The statistics
+  TracedValue<uint32_t> m_backlog;  //!< The fluid held in the queue, in bytes
+};
+
+} // namespace ns3
+
+#endif /* FLUID_LOAD_H */
@@ -27,6 +27,8 @@
 #include "ns3/unused.h"
 #include "ns3/simulator.h"
 #include "queue-disc.h"
+#include "shared-buffer-manager.h"
+#include "fluid-load.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/queue.h"
 
@@ -325,6 +327,7 @@ QueueDisc::QueueDisc (QueueDiscSizePolicy policy)
      m_maxSize (QueueSize ("1p")),         // to avoid that setting the mode at construction time is ignored
      m_running (false),
      m_peeked (false),
+     m_sharedBufferQueue (0),
      m_sizePolicy (policy),
      m_prohibitChangeMode (false)
 {
@@ -389,6 +392,9 @@ QueueDisc::DoDispose (void)
   m_devQueueIface = 0;
   m_send = nullptr;
   m_requeued = 0;
+  m_sharedBuffer = 0;
+  Simulator::Cancel (m_fluidRelease);
+  m_fluidLoad = 0;
   m_internalQueueDbeFunctor = nullptr;
   m_internalQueueDadFunctor = nullptr;
   m_childQueueDiscDbeFunctor = nullptr;
@@ -563,6 +569,30 @@ QueueDisc::GetSendCallback (void) const
   return m_send;
 }
 
+void
+QueueDisc::SetSharedBuffer (Ptr<SharedBufferManager> buffer, uint32_t queue)
+{
+  NS_LOG_FUNCTION (this << buffer << queue);
+  m_sharedBuffer = buffer;
+  m_sharedBufferQueue = queue;
+}
+
+void
+QueueDisc::SetFluidLoad (Ptr<FluidLoad> load)
+{
+  NS_LOG_FUNCTION (this << load);
+  NS_ABORT_MSG_IF (m_sizePolicy == QueueDiscSizePolicy::NO_LIMITS,
+                   "A fluid load needs a queue disc with a size limit");
+  m_fluidLoad = load;
+  m_fluidLoad->SetQueueDisc (this);
+}
+
+Ptr<FluidLoad>
+QueueDisc::GetFluidLoad (void) const
+{
+  return m_fluidLoad;
+}
+
 void
 QueueDisc::SetQuota (const uint32_t quota)
 {
@@ -699,6 +729,15 @@ QueueDisc::PacketEnqueued (Ptr<const QueueDiscItem> item)
   m_stats.nTotalEnqueuedPackets++;
   m_stats.nTotalEnqueuedBytes += item->GetSize ();
 
+  if (m_sharedBuffer)
+    {
+      m_sharedBuffer->PacketEnqueued (m_sharedBufferQueue, item->GetSize ());
+    }
+  if (m_fluidLoad)
+    {
+      m_fluidLoad->PacketEnqueued (item->GetSize ());
+    }
+
   NS_LOG_LOGIC ("m_traceEnqueue (p)");
   m_traceEnqueue (item);
 }
@@ -718,6 +757,15 @@ QueueDisc::PacketDequeued (Ptr<const QueueDiscItem> item)
       m_stats.nTotalDequeuedPackets++;
       m_stats.nTotalDequeuedBytes += item->GetSize ();
 
+      if (m_sharedBuffer)
+        {
+          m_sharedBuffer->PacketDequeued (m_sharedBufferQueue, item->GetSize ());
+        }
+      if (m_fluidLoad)
+        {
+          m_fluidLoad->PacketDequeued ();
+        }
+
       m_sojourn (Simulator::Now () - item->GetTimeStamp ());
 
       NS_LOG_LOGIC ("m_traceDequeue (p)");
@@ -865,6 +913,26 @@ QueueDisc::Enqueue (Ptr<QueueDiscItem> item)
   m_stats.nTotalReceivedPackets++;
   m_stats.nTotalReceivedBytes += item->GetSize ();
 
+  if (m_sharedBuffer && !m_sharedBuffer->Admit (m_sharedBufferQueue, item->GetSize ()))
+    {
+      NS_LOG_LOGIC ("Not admitted by the shared buffer -- dropping pkt");
+      DropBeforeEnqueue (item, SHARED_BUFFER_DROP);
+      return false;
+    }
+
+  if (m_fluidLoad)
+    {
+      QueueSize max = GetMaxSize ();
+      bool bytes = max.GetUnit () == QueueSizeUnit::BYTES;
+      uint32_t occupancy = (bytes ? GetNBytes () : GetNPackets ()) + m_fluidLoad->GetBacklog (max.GetUnit ());
+      if (occupancy + (bytes ? item->GetSize () : 1) > max.GetValue ())
+        {
+          NS_LOG_LOGIC ("Overflow with the fluid load -- dropping pkt");
+          DropBeforeEnqueue (item, FLUID_LOAD_DROP);
+          return false;
+        }
+    }
+
   bool retval = DoEnqueue (item);
 
   if (retval)
@@ -1013,6 +1081,21 @@ QueueDisc::DequeuePacket ()
 
   Ptr<QueueDiscItem> item;
 
+  // The packet at the head waits for the fluid which arrived before it
+  if (m_fluidLoad && (!m_requeued || m_peeked))
+    {
+      Time delay = m_fluidLoad->GetReleaseDelay ();
+      if (!delay.IsZero ())
+        {
+          NS_LOG_LOGIC ("Waiting " << delay << " for the fluid ahead");
+          if (!m_fluidRelease.IsRunning ())
+            {
+              m_fluidRelease = Simulator::Schedule (delay, &QueueDisc::Run, this);
+            }
+          return item;
+        }
+    }
+
   // First check if there is a requeued packet
   if (m_requeued != 0)
     {
@@ -1091,6 +1174,10 @@ QueueDisc::Transmit (Ptr<QueueDiscItem> item)
       item->GetPacket ()->RemovePacketTag (priorityTag);
     }
   NS_ASSERT_MSG (m_send, "Send callback not set");
+  if (m_fluidLoad)
+    {
+      m_fluidLoad->PacketTransmitted (item->GetSize ());
+    }
   m_send (item);
 
   // the behavior here slightly diverges from Linux. In Linux, it is advised that
@@ -25,6 +25,7 @@
 #include "ns3/traced-callback.h"
 #include "ns3/queue-item.h"
 #include "ns3/queue-size.h"
+#include "ns3/event-id.h"
 #include <vector>
 #include <map>
 #include <functional>
@@ -36,6 +37,8 @@ namespace ns3 {
 class QueueDisc;
 template <typename Item> class Queue;
 class NetDeviceQueueInterface;
+class SharedBufferManager;
+class FluidLoad;
 
 /**
  * \ingroup traffic-control
@@ -372,6 +375,38 @@ public:
    */
   SendCallback GetSendCallback (void) const;
 
+  /**
+   * \brief Make this queue disc a queue of a shared buffer
+   *
+   * The packets are then only enqueued if the buffer admits them, and
+   * dropped otherwise with the SHARED_BUFFER_DROP reason.  This is done by
+   * SharedBufferManager::AddQueueDisc and should only be used for root
+   * queue discs, as the packets of the child queue discs are also counted
+   * by their parent.
+   *
+   * \param buffer the shared buffer
+   * \param queue the index of the queue of this queue disc in the buffer
+   */
+  void SetSharedBuffer (Ptr<SharedBufferManager> buffer, uint32_t queue);
+
+  /**
+   * \brief Hold the fluid of a background load in the queue of this queue disc
+   *
+   * The packets are then dropped with the FLUID_LOAD_DROP reason if they do
+   * not fit in MaxSize with the fluid, and are not dequeued before the fluid
+   * which arrived before them is served.  See FluidLoad, and
+   * TrafficControlHelper::InstallFluidLoad which also starts the fluid.  This
+   * should only be used for root queue discs with a size limit.
+   *
+   * \param load the fluid load
+   */
+  void SetFluidLoad (Ptr<FluidLoad> load);
+
+  /**
+   * \return the fluid load held by this queue disc, if any
+   */
+  Ptr<FluidLoad> GetFluidLoad (void) const;
+
   /**
    * \brief Set the maximum number of dequeue operations following a packet enqueue
    * \param quota the maximum number of dequeue operations following a packet enqueue.
@@ -515,6 +550,8 @@ public:
   // Reasons for dropping packets
   static constexpr const char* INTERNAL_QUEUE_DROP = "Dropped by internal queue";    //!< Packet dropped by an internal queue
   static constexpr const char* CHILD_QUEUE_DISC_DROP = "(Dropped by child queue disc) "; //!< Packet dropped by a child queue disc
+  static constexpr const char* SHARED_BUFFER_DROP = "Not admitted by the shared buffer"; //!< Packet dropped by the shared buffer
+  static constexpr const char* FLUID_LOAD_DROP = "Overflow with the fluid load"; //!< Packet dropped as the fluid fills the queue
   static constexpr const char* CHILD_QUEUE_DISC_MARK = "(Marked by child queue disc) "; //!< Packet marked by a child queue disc
 
 protected:
@@ -709,6 +746,10 @@ private:
   bool m_running;                   //!< The queue disc is performing multiple dequeue operations
   Ptr<QueueDiscItem> m_requeued;    //!< The last packet that failed to be transmitted
   bool m_peeked;                    //!< A packet was dequeued because Peek was called
+  Ptr<SharedBufferManager> m_sharedBuffer;  //!< The shared buffer holding the packets, if any
+  uint32_t m_sharedBufferQueue;     //!< The index of the queue in the shared buffer
+  Ptr<FluidLoad> m_fluidLoad;       //!< The fluid held in the queue, if any
+  EventId m_fluidRelease;           //!< Run once the fluid ahead of the head packet is served
   std::string m_childQueueDiscDropMsg;  //!< Reason why a packet was dropped by a child queue disc
   std::string m_childQueueDiscMarkMsg;  //!< Reason why a packet was marked by a child queue disc
   QueueDiscSizePolicy m_sizePolicy;     //!< The queue disc size policy
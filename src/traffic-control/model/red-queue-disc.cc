@@ -63,6 +63,7 @@
 #include "ns3/simulator.h"
 #include "ns3/abort.h"
 #include "red-queue-disc.h"
+#include "fluid-load.h"
 #include "ns3/drop-tail-queue.h"
 
 namespace ns3 {
@@ -342,6 +343,10 @@ RedQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item)
   NS_LOG_FUNCTION (this << item);
 
   uint32_t nQueued = GetInternalQueue (0)->GetCurrentSize ().GetValue ();
+  if (GetFluidLoad ())
+    {
+      nQueued += GetFluidLoad ()->GetBacklog (GetMaxSize ().GetUnit ());
+    }
 
   // simulate number of packets arrival during idle period
   uint32_t m = 0;
@@ -0,0 +1,239 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/abort.h"
+#include "ns3/trace-source-accessor.h"
+#include "shared-buffer-manager.h"
+#include "queue-disc.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SharedBufferManager");
+
+NS_OBJECT_ENSURE_REGISTERED (SharedBufferManager);
+
+TypeId SharedBufferManager::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::SharedBufferManager")
+    .SetParent<Object> ()
+    .SetGroupName ("TrafficControl")
+    .AddConstructor<SharedBufferManager> ()
+    .AddAttribute ("Size",
+                   "The size of the buffer, in packets or bytes",
+                   QueueSizeValue (QueueSize ("4MB")),
+                   MakeQueueSizeAccessor (&SharedBufferManager::SetSize,
+                                          &SharedBufferManager::GetSize),
+                   MakeQueueSizeChecker ())
+    .AddAttribute ("Alpha",
+                   "The alpha of the dynamic threshold of the queues added",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&SharedBufferManager::m_alpha),
+                   MakeDoubleChecker<double> (0.0))
+    .AddTraceSource ("Occupancy",
+                     "The packets or bytes held in the buffer",
+                     MakeTraceSourceAccessor (&SharedBufferManager::m_occupancy),
+                     "ns3::TracedValueCallback::Uint32")
+  ;
+  return tid;
+}
+
+SharedBufferManager::Stats::Stats ()
+  : occupancy (0),
+    maxOccupancy (0),
+    nAdmittedPackets (0),
+    nAdmittedBytes (0),
+    nDroppedPackets (0),
+    nDroppedBytes (0)
+{
+}
+
+SharedBufferManager::SharedBufferManager ()
+  : m_inBytes (false),
+    m_occupancy (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+SharedBufferManager::~SharedBufferManager ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint32_t
+SharedBufferManager::AddQueue (uint32_t port)
+{
+  NS_LOG_FUNCTION (this << port);
+
+  Queue q;
+  q.port = port;
+  q.alpha = m_alpha;
+  m_queues.push_back (q);
+  if (port >= m_ports.size ())
+    {
+      m_ports.resize (port + 1);
+    }
+  return m_queues.size () - 1;
+}
+
+uint32_t
+SharedBufferManager::AddQueueDisc (Ptr<QueueDisc> qd, uint32_t port)
+{
+  NS_LOG_FUNCTION (this << qd << port);
+
+  uint32_t queue = AddQueue (port);
+  qd->SetSharedBuffer (this, queue);
+  return queue;
+}
+
+void
+SharedBufferManager::SetAlpha (uint32_t queue, double alpha)
+{
+  NS_LOG_FUNCTION (this << queue << alpha);
+  NS_ASSERT (queue < m_queues.size ());
+  m_queues[queue].alpha = alpha;
+}
+
+double
+SharedBufferManager::GetAlpha (uint32_t queue) const
+{
+  NS_ASSERT (queue < m_queues.size ());
+  return m_queues[queue].alpha;
+}
+
+bool
+SharedBufferManager::Admit (uint32_t queue, uint32_t bytes)
+{
+  NS_LOG_FUNCTION (this << queue << bytes);
+
+  uint32_t amount = m_inBytes ? bytes : 1;
+  uint32_t free = m_size.GetValue () > m_stats.occupancy ? m_size.GetValue () - m_stats.occupancy : 0;
+
+  Queue &q = m_queues[queue];
+  if (amount <= free && q.stats.occupancy + amount <= q.alpha * free)
+    {
+      return true;
+    }
+
+  NS_LOG_LOGIC ("Queue " << queue << " holds " << q.stats.occupancy
+                << ", above its threshold " << q.alpha * free);
+  Stats *stats[] = {&q.stats, &m_ports[q.port], &m_stats};
+  for (Stats *s : stats)
+    {
+      s->nDroppedPackets++;
+      s->nDroppedBytes += bytes;
+    }
+  return false;
+}
+
+void
+SharedBufferManager::Add (Stats &stats, uint32_t amount, uint32_t bytes)
+{
+  stats.occupancy += amount;
+  if (stats.occupancy > stats.maxOccupancy)
+    {
+      stats.maxOccupancy = stats.occupancy;
+    }
+  stats.nAdmittedPackets++;
+  stats.nAdmittedBytes += bytes;
+}
+
+void
+SharedBufferManager::PacketEnqueued (uint32_t queue, uint32_t bytes)
+{
+  NS_LOG_FUNCTION (this << queue << bytes);
+
+  uint32_t amount = m_inBytes ? bytes : 1;
+  Queue &q = m_queues[queue];
+  Add (q.stats, amount, bytes);
+  Add (m_ports[q.port], amount, bytes);
+  Add (m_stats, amount, bytes);
+  m_occupancy = m_stats.occupancy;
+}
+
+void
+SharedBufferManager::PacketDequeued (uint32_t queue, uint32_t bytes)
+{
+  NS_LOG_FUNCTION (this << queue << bytes);
+
+  uint32_t amount = m_inBytes ? bytes : 1;
+  Queue &q = m_queues[queue];
+  NS_ASSERT (q.stats.occupancy >= amount);
+  q.stats.occupancy -= amount;
+  m_ports[q.port].occupancy -= amount;
+  m_stats.occupancy -= amount;
+  m_occupancy = m_stats.occupancy;
+}
+
+void
+SharedBufferManager::SetSize (QueueSize size)
+{
+  NS_LOG_FUNCTION (this << size);
+
+  NS_ABORT_MSG_IF (m_stats.occupancy > 0, "Cannot resize a buffer holding packets");
+  m_size = size;
+  m_inBytes = (size.GetUnit () == QueueSizeUnit::BYTES);
+}
+
+QueueSize
+SharedBufferManager::GetSize (void) const
+{
+  return m_size;
+}
+
+uint32_t
+SharedBufferManager::GetThreshold (uint32_t queue) const
+{
+  NS_ASSERT (queue < m_queues.size ());
+  uint32_t free = m_size.GetValue () > m_stats.occupancy ? m_size.GetValue () - m_stats.occupancy : 0;
+  return m_queues[queue].alpha * free;
+}
+
+uint32_t
+SharedBufferManager::GetNQueues (void) const
+{
+  return m_queues.size ();
+}
+
+uint32_t
+SharedBufferManager::GetNPorts (void) const
+{
+  return m_ports.size ();
+}
+
+const SharedBufferManager::Stats&
+SharedBufferManager::GetQueueStats (uint32_t queue) const
+{
+  NS_ASSERT (queue < m_queues.size ());
+  return m_queues[queue].stats;
+}
+
+const SharedBufferManager::Stats&
+SharedBufferManager::GetPortStats (uint32_t port) const
+{
+  NS_ASSERT (port < m_ports.size ());
+  return m_ports[port];
+}
+
+const SharedBufferManager::Stats&
+SharedBufferManager::GetStats (void) const
+{
+  return m_stats;
+}
+
+} // namespace ns3
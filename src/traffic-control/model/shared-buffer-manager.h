@@ -0,0 +1,205 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef SHARED_BUFFER_MANAGER_H
+#define SHARED_BUFFER_MANAGER_H
+
+#include "ns3/object.h"
+#include "ns3/queue-size.h"
+#include "ns3/traced-value.h"
+#include <vector>
+
+namespace ns3 {
+
+class QueueDisc;
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief The buffer shared by the queue discs of a switch, with dynamic
+ * threshold admission
+ *
+ * Switches such as the Broadcom Trident and Tomahawk ones hold the
+ * packets of all their ports in a single memory.  A queue may use the
+ * free memory as long as its length stays below the dynamic threshold
+ * (Choudhury and Hahne):
+ *
+ *   queue length + packet <= alpha * (buffer size - buffer occupancy)
+ *
+ * so that a congested port gets a large share of an idle switch but only
+ * a fraction of the memory left by the other ports.  With alpha = 1 and n
+ * congested queues, each queue gets 1 / (n + 1) of the buffer.
+ *
+ * The queue discs of the node consult the manager before enqueuing a
+ * packet, see QueueDisc::SetSharedBuffer and
+ * TrafficControlHelper::InstallSharedBuffer, and drop the packets it does
+ * not admit with the reason QueueDisc::SHARED_BUFFER_DROP.  Their own
+ * MaxSize still applies and should be at least the size of the buffer
+ * for the dynamic threshold to be the only limit.
+ *
+ * The size of the buffer is in packets or in bytes.  The admission check
+ * and the accounting are O(1).  The occupancy is counted for each queue,
+ * for each port (the devices of the node, several queues may share a
+ * port) and for the whole buffer.  Only the queue discs of a single node
+ * may share a buffer, as they are simulated by the same thread.
+ */
+class SharedBufferManager : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  SharedBufferManager ();
+  virtual ~SharedBufferManager ();
+
+  /**
+   * \brief The statistics of a queue, a port or the whole buffer
+   *
+   * The occupancies are in the unit of the buffer size.
+   */
+  struct Stats
+  {
+    uint32_t occupancy;         //!< Packets or bytes held
+    uint32_t maxOccupancy;      //!< Highest occupancy
+    uint32_t nAdmittedPackets;  //!< Packets admitted
+    uint64_t nAdmittedBytes;    //!< Bytes admitted
+    uint32_t nDroppedPackets;   //!< Packets refused
+    uint64_t nDroppedBytes;     //!< Bytes refused
+
+    /// Constructor
+    Stats ();
+  };
+
+  /**
+   * \brief Add a queue to the buffer
+   * \param port the port of the queue
+   * \returns the index of the queue
+   */
+  uint32_t AddQueue (uint32_t port);
+  /**
+   * \brief Make a queue disc use the buffer, as a new queue of a port
+   * \param qd the queue disc
+   * \param port the port of the queue disc
+   * \returns the index of the queue
+   */
+  uint32_t AddQueueDisc (Ptr<QueueDisc> qd, uint32_t port);
+
+  /**
+   * \brief Set the alpha of the dynamic threshold of a queue
+   *
+   * The queues get the value of the Alpha attribute when they are added.
+   *
+   * \param queue the index of the queue
+   * \param alpha the alpha
+   */
+  void SetAlpha (uint32_t queue, double alpha);
+  /**
+   * \param queue the index of the queue
+   * \returns the alpha of the dynamic threshold of the queue
+   */
+  double GetAlpha (uint32_t queue) const;
+
+  /**
+   * \brief Check that a packet fits in the buffer and below the dynamic
+   * threshold of its queue
+   *
+   * The packets refused are counted in the statistics.
+   *
+   * \param queue the index of the queue
+   * \param bytes the size of the packet
+   * \returns true if the packet may be enqueued
+   */
+  bool Admit (uint32_t queue, uint32_t bytes);
+  /**
+   * \brief Account for a packet enqueued
+   * \param queue the index of the queue
+   * \param bytes the size of the packet
+   */
+  void PacketEnqueued (uint32_t queue, uint32_t bytes);
+  /**
+   * \brief Account for a packet dequeued
+   * \param queue the index of the queue
+   * \param bytes the size of the packet
+   */
+  void PacketDequeued (uint32_t queue, uint32_t bytes);
+
+  /**
+   * \brief Set the size of the buffer
+   *
+   * Its unit selects the accounting in packets or in bytes.  The buffer
+   * must be empty.
+   *
+   * \param size the size of the buffer
+   */
+  void SetSize (QueueSize size);
+  /// \returns the size of the buffer
+  QueueSize GetSize (void) const;
+  /**
+   * \param queue the index of the queue
+   * \returns the dynamic threshold of the queue, in the unit of the buffer size
+   */
+  uint32_t GetThreshold (uint32_t queue) const;
+
+  /// \returns the number of queues
+  uint32_t GetNQueues (void) const;
+  /// \returns the number of ports, one more than the highest port
+  uint32_t GetNPorts (void) const;
+  /**
+   * \param queue the index of the queue
+   * \returns the statistics of the queue
+   */
+  const Stats& GetQueueStats (uint32_t queue) const;
+  /**
+   * \param port the port
+   * \returns the statistics of the queues of the port
+   */
+  const Stats& GetPortStats (uint32_t port) const;
+  /// \returns the statistics of the whole buffer
+  const Stats& GetStats (void) const;
+
+private:
+  /// A queue using the buffer
+  struct Queue
+  {
+    uint32_t port;              //!< Port of the queue
+    double alpha;               //!< Alpha of the dynamic threshold
+    Stats stats;                //!< Statistics of the queue
+  };
+
+  /**
+   * \brief Account for a packet admitted in a queue, a port or the buffer
+   * \param stats the statistics
+   * \param amount the packet, in the unit of the buffer size
+   * \param bytes the size of the packet
+   */
+  static void Add (Stats &stats, uint32_t amount, uint32_t bytes);
+
+  QueueSize m_size;                   //!< Size of the buffer
+  double m_alpha;                     //!< Alpha of the new queues
+  bool m_inBytes;                     //!< Is the size in bytes
+  std::vector<Queue> m_queues;        //!< Queues using the buffer
+  std::vector<Stats> m_ports;         //!< Statistics of the ports
+  Stats m_stats;                      //!< Statistics of the buffer
+  TracedValue<uint32_t> m_occupancy;  //!< Occupancy of the buffer
+};
+
+} // namespace ns3
+
+#endif /* SHARED_BUFFER_MANAGER_H */
@@ -0,0 +1,234 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/log.h"
+#include "ns3/boolean.h"
+#include "ns3/socket.h"
+#include "ns3/object-factory.h"
+#include "ns3/drop-tail-queue.h"
+#include "step-marking-queue-disc.h"
+#include "fluid-load.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("StepMarkingQueueDisc");
+
+NS_OBJECT_ENSURE_REGISTERED (StepMarkingQueueDisc);
+
+TypeId StepMarkingQueueDisc::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::StepMarkingQueueDisc")
+    .SetParent<QueueDisc> ()
+    .SetGroupName ("TrafficControl")
+    .AddConstructor<StepMarkingQueueDisc> ()
+    .AddAttribute ("MaxSize",
+                   "The max queue size",
+                   QueueSizeValue (QueueSize ("1000p")),
+                   MakeQueueSizeAccessor (&QueueDisc::SetMaxSize,
+                                          &QueueDisc::GetMaxSize),
+                   MakeQueueSizeChecker ())
+    .AddAttribute ("MarkingThreshold",
+                   "The queue length, in packets or bytes, from which the packets are marked",
+                   QueueSizeValue (QueueSize ("65p")),
+                   MakeQueueSizeAccessor (&StepMarkingQueueDisc::m_threshold),
+                   MakeQueueSizeChecker ())
+    .AddAttribute ("MarkOnDequeue",
+                   "True to mark the packets when they are dequeued instead of enqueued",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&StepMarkingQueueDisc::m_markOnDequeue),
+                   MakeBooleanChecker ())
+    .AddAttribute ("UseEcn",
+                   "True to mark the packets, false to drop them",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&StepMarkingQueueDisc::m_useEcn),
+                   MakeBooleanChecker ())
+  ;
+  return tid;
+}
+
+StepMarkingQueueDisc::StepMarkingQueueDisc ()
+  : QueueDisc (QueueDiscSizePolicy::SINGLE_INTERNAL_QUEUE),
+    m_inBytes (false),
+    m_byPriority (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+StepMarkingQueueDisc::~StepMarkingQueueDisc ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+StepMarkingQueueDisc::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_queue = 0;
+  QueueDisc::DoDispose ();
+}
+
+void
+StepMarkingQueueDisc::SetMarkingThreshold (uint8_t prio, QueueSize threshold)
+{
+  NS_LOG_FUNCTION (this << +prio << threshold);
+
+  NS_ASSERT_MSG (prio < 16, "Priority must be a value between 0 and 15");
+
+  m_prioThresholds[prio] = threshold;
+}
+
+QueueSize
+StepMarkingQueueDisc::GetMarkingThreshold (uint8_t prio) const
+{
+  NS_LOG_FUNCTION (this << +prio);
+
+  NS_ASSERT_MSG (prio < 16, "Priority must be a value between 0 and 15");
+
+  std::map<uint8_t, QueueSize>::const_iterator it = m_prioThresholds.find (prio);
+  if (it != m_prioThresholds.end ())
+    {
+      return it->second;
+    }
+  return m_threshold;
+}
+
+uint32_t
+StepMarkingQueueDisc::GetLength (void) const
+{
+  uint32_t length = m_inBytes ? m_queue->GetNBytes () : m_queue->GetNPackets ();
+  if (GetFluidLoad ())
+    {
+      length += GetFluidLoad ()->GetBacklog (m_inBytes ? QueueSizeUnit::BYTES : QueueSizeUnit::PACKETS);
+    }
+  return length;
+}
+
+uint32_t
+StepMarkingQueueDisc::GetThreshold (Ptr<const QueueDiscItem> item) const
+{
+  if (!m_byPriority)
+    {
+      return m_thresholds[0];
+    }
+  SocketPriorityTag priorityTag;
+  if (item->GetPacket ()->PeekPacketTag (priorityTag))
+    {
+      return m_thresholds[priorityTag.GetPriority () & 0x0f];
+    }
+  return m_thresholds[0];
+}
+
+bool
+StepMarkingQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item)
+{
+  NS_LOG_FUNCTION (this << item);
+
+  if (!m_markOnDequeue && GetLength () >= GetThreshold (item))
+    {
+      if (!m_useEcn || !Mark (item, THRESHOLD_EXCEEDED_MARK))
+        {
+          NS_LOG_LOGIC ("Above the threshold -- dropping pkt");
+          DropBeforeEnqueue (item, THRESHOLD_EXCEEDED_DROP);
+          return false;
+        }
+    }
+
+  // If Queue::Enqueue fails, QueueDisc::DropBeforeEnqueue is called by the
+  // internal queue because QueueDisc::AddInternalQueue sets the trace callback
+  return m_queue->Enqueue (item);
+}
+
+Ptr<QueueDiscItem>
+StepMarkingQueueDisc::DoDequeue (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<QueueDiscItem> item = m_queue->Dequeue ();
+  while (item != 0 && m_markOnDequeue && GetLength () >= GetThreshold (item))
+    {
+      if (m_useEcn && Mark (item, THRESHOLD_EXCEEDED_MARK))
+        {
+          break;
+        }
+      NS_LOG_LOGIC ("Above the threshold -- dropping pkt");
+      DropAfterDequeue (item, THRESHOLD_EXCEEDED_DROP);
+      item = m_queue->Dequeue ();
+    }
+
+  if (!item)
+    {
+      NS_LOG_LOGIC ("Queue empty");
+    }
+  return item;
+}
+
+bool
+StepMarkingQueueDisc::CheckConfig (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (GetNQueueDiscClasses () > 0)
+    {
+      NS_LOG_ERROR ("StepMarkingQueueDisc cannot have classes");
+      return false;
+    }
+
+  if (GetNPacketFilters () > 0)
+    {
+      NS_LOG_ERROR ("StepMarkingQueueDisc needs no packet filter");
+      return false;
+    }
+
+  if (GetNInternalQueues () == 0)
+    {
+      // add a DropTail queue
+      AddInternalQueue (CreateObjectWithAttributes<DropTailQueue<QueueDiscItem> >
+                          ("MaxSize", QueueSizeValue (GetMaxSize ())));
+    }
+
+  if (GetNInternalQueues () != 1)
+    {
+      NS_LOG_ERROR ("StepMarkingQueueDisc needs 1 internal queue");
+      return false;
+    }
+
+  for (std::map<uint8_t, QueueSize>::const_iterator it = m_prioThresholds.begin ();
+       it != m_prioThresholds.end (); ++it)
+    {
+      if (it->second.GetUnit () != m_threshold.GetUnit ())
+        {
+          NS_LOG_ERROR ("The marking thresholds must all be in packets or all in bytes");
+          return false;
+        }
+    }
+
+  return true;
+}
+
+void
+StepMarkingQueueDisc::InitializeParams (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_queue = GetInternalQueue (0);
+  m_inBytes = m_threshold.GetUnit () == QueueSizeUnit::BYTES;
+  m_byPriority = !m_prioThresholds.empty ();
+  for (uint8_t prio = 0; prio < 16; prio++)
+    {
+      m_thresholds[prio] = GetMarkingThreshold (prio).GetValue ();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef STEP_MARKING_QUEUE_DISC_H
+#define STEP_MARKING_QUEUE_DISC_H
+
+#include "ns3/queue-disc.h"
+#include <map>
+
+namespace ns3 {
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief A FIFO queue disc marking the packets when the instantaneous
+ * queue length reaches a threshold, as DCTCP switches do
+ *
+ * A packet is marked with ECN Congestion Experienced when the queue
+ * length, in packets or in bytes depending on the unit of the marking
+ * threshold K, is at least K.  The length is the backlog ahead of the
+ * packet when it is enqueued or, with the MarkOnDequeue attribute, the
+ * backlog left behind when it is dequeued.  The packets which cannot be
+ * marked, or all of them if UseEcn is false, are dropped instead.
+ *
+ * Marking on enqueue reproduces a RedQueueDisc configured with QW = 1,
+ * MinTh = MaxTh = K, Gentle = false and UseHardDrop = false, for any K of
+ * at least 2 (RED never marks a packet arriving to a queue holding a
+ * single packet).
+ *
+ * A different threshold can be given to each of the 16 priorities of the
+ * SocketPriorityTag, see SetMarkingThreshold.  The tag is only looked up
+ * when such a threshold was set.
+ */
+class StepMarkingQueueDisc : public QueueDisc
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief StepMarkingQueueDisc constructor
+   */
+  StepMarkingQueueDisc ();
+
+  virtual ~StepMarkingQueueDisc ();
+
+  /**
+   * \brief Set the marking threshold of the packets of a priority
+   *
+   * Must be called before the queue disc is initialized.  All the
+   * thresholds must have the unit of the MarkingThreshold attribute.
+   *
+   * \param prio the priority, between 0 and 15
+   * \param threshold the marking threshold
+   */
+  void SetMarkingThreshold (uint8_t prio, QueueSize threshold);
+  /**
+   * \param prio the priority, between 0 and 15
+   * \returns the marking threshold of the packets of this priority
+   */
+  QueueSize GetMarkingThreshold (uint8_t prio) const;
+
+  // Reasons for dropping packets
+  static constexpr const char* THRESHOLD_EXCEEDED_DROP = "Marking threshold exceeded";  //!< Packet that cannot be marked dropped above the threshold
+  // Reasons for marking packets
+  static constexpr const char* THRESHOLD_EXCEEDED_MARK = "Marking threshold exceeded";  //!< Packet marked above the threshold
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  virtual bool DoEnqueue (Ptr<QueueDiscItem> item);
+  virtual Ptr<QueueDiscItem> DoDequeue (void);
+  virtual bool CheckConfig (void);
+  virtual void InitializeParams (void);
+
+  /**
+   * \returns the length of the internal queue and of the fluid load, if
+   *          any, in the unit of the thresholds
+   */
+  uint32_t GetLength (void) const;
+  /**
+   * \param item the packet
+   * \returns the marking threshold of the packet, in the unit of the thresholds
+   */
+  uint32_t GetThreshold (Ptr<const QueueDiscItem> item) const;
+
+  QueueSize m_threshold;                         //!< Marking threshold of the priorities not set
+  std::map<uint8_t, QueueSize> m_prioThresholds; //!< Marking thresholds set by priority
+  bool m_markOnDequeue;                          //!< Mark when dequeuing instead of enqueuing
+  bool m_useEcn;                                 //!< Mark instead of dropping
+
+  // Set by InitializeParams
+  Ptr<InternalQueue> m_queue;                    //!< The internal queue
+  bool m_inBytes;                                //!< Are the thresholds in bytes
+  bool m_byPriority;                             //!< Does the threshold depend on the priority
+  uint32_t m_thresholds[16];                     //!< Marking threshold of each priority
+};
+
+} // namespace ns3
+
+#endif /* STEP_MARKING_QUEUE_DISC_H */
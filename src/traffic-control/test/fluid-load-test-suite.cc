@@ -0,0 +1,252 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/fluid-load.h"
+#include "ns3/fifo-queue-disc.h"
+#include "ns3/step-marking-queue-disc.h"
+#include "ns3/packet.h"
+#include "ns3/string.h"
+#include "ns3/simulator.h"
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Fluid Load Test Item
+ */
+class FluidLoadTestItem : public QueueDiscItem
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param p the packet
+   */
+  FluidLoadTestItem (Ptr<Packet> p);
+  virtual ~FluidLoadTestItem ();
+  virtual void AddHeader (void);
+  virtual bool Mark (void);
+
+private:
+  FluidLoadTestItem ();
+  /**
+   * \brief Copy constructor
+   * Disable default implementation to avoid misuse
+   */
+  FluidLoadTestItem (const FluidLoadTestItem &);
+  /**
+   * \brief Assignment operator
+   * \return this object
+   * Disable default implementation to avoid misuse
+   */
+  FluidLoadTestItem &operator = (const FluidLoadTestItem &);
+};
+
+FluidLoadTestItem::FluidLoadTestItem (Ptr<Packet> p)
+  : QueueDiscItem (p, Address (), 0)
+{
+}
+
+FluidLoadTestItem::~FluidLoadTestItem ()
+{
+}
+
+void
+FluidLoadTestItem::AddHeader (void)
+{
+}
+
+bool
+FluidLoadTestItem::Mark (void)
+{
+  return true;
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Fluid load of a constant rate
+ */
+class ConstantFluidLoad : public FluidLoad
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param rate the rate of the fluid, in bytes per second
+   */
+  ConstantFluidLoad (double rate);
+
+private:
+  virtual double DoStep (void);
+  double m_rate;  //!< The rate of the fluid, in bytes per second
+};
+
+ConstantFluidLoad::ConstantFluidLoad (double rate)
+  : m_rate (rate)
+{
+}
+
+double
+ConstantFluidLoad::DoStep (void)
+{
+  return m_rate;
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Fluid Load Test Case
+ */
+class FluidLoadTestCase : public TestCase
+{
+public:
+  FluidLoadTestCase ();
+private:
+  virtual void DoRun (void);
+  /**
+   * Enqueue a packet and run the queue disc
+   * \param qd the queue disc
+   * \param bytes the size of the packet
+   */
+  void Enqueue (Ptr<QueueDisc> qd, uint32_t bytes);
+  /**
+   * Record the transmission of a packet
+   * \param item the packet
+   */
+  void Sent (Ptr<QueueDiscItem> item);
+  /**
+   * Check the fluid backlog
+   * \param load the fluid load
+   * \param bytes the expected backlog
+   */
+  void CheckBacklog (Ptr<FluidLoad> load, uint32_t bytes);
+
+  std::vector<Time> m_sent;  //!< The transmission times of the packets
+};
+
+FluidLoadTestCase::FluidLoadTestCase ()
+  : TestCase ("Sanity check on the fluid held in a queue disc")
+{
+}
+
+void
+FluidLoadTestCase::Enqueue (Ptr<QueueDisc> qd, uint32_t bytes)
+{
+  qd->Enqueue (Create<FluidLoadTestItem> (Create<Packet> (bytes)));
+  qd->Run ();
+}
+
+void
+FluidLoadTestCase::Sent (Ptr<QueueDiscItem> item)
+{
+  m_sent.push_back (Simulator::Now ());
+}
+
+void
+FluidLoadTestCase::CheckBacklog (Ptr<FluidLoad> load, uint32_t bytes)
+{
+  NS_TEST_EXPECT_MSG_EQ_TOL (load->GetBacklog (QueueSizeUnit::BYTES), bytes, 1, "Wrong fluid backlog");
+}
+
+void
+FluidLoadTestCase::DoRun (void)
+{
+  // A fluid of twice the 8 Mbps capacity fills the queue at 1 MB/s
+  Ptr<QueueDisc> qd = CreateObjectWithAttributes<FifoQueueDisc> ("MaxSize", StringValue ("100000B"));
+  qd->Initialize ();
+  qd->SetSendCallback (MakeCallback (&FluidLoadTestCase::Sent, this));
+  Ptr<FluidLoad> load = CreateObject<ConstantFluidLoad> (2e6);
+  load->SetDataRate (DataRate ("8Mbps"));
+  load->SetAttribute ("TimeStep", StringValue ("1ms"));
+  qd->SetFluidLoad (load);
+  Simulator::Schedule (Seconds (0), &FluidLoad::Start, load);
+  Simulator::Schedule (MilliSeconds (10), &FluidLoadTestCase::CheckBacklog, this, load, 10000);
+  Simulator::Schedule (MilliSeconds (10), &FluidLoad::Stop, load);
+
+  // The packets wait for the 10 ms of fluid ahead of them
+  Simulator::Schedule (MilliSeconds (10), &FluidLoadTestCase::Enqueue, this, qd, 1000);
+  Simulator::Schedule (MilliSeconds (10), &FluidLoadTestCase::Enqueue, this, qd, 1000);
+  Simulator::Schedule (MilliSeconds (15), &FluidLoadTestCase::CheckBacklog, this, load, 5000);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_sent.size (), 2, "Both packets should have been sent");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[0], MilliSeconds (20), "The first packet should wait for the fluid ahead");
+  NS_TEST_EXPECT_MSG_EQ (m_sent[1], MilliSeconds (20), "The second packet should follow the first one");
+  FluidLoad::Stats stats = load->GetStats ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (stats.nArrivedBytes, 20000, 1, "Wrong fluid arrived");
+  NS_TEST_EXPECT_MSG_EQ_TOL (stats.nServedBytes, 20000, 1, "The fluid should have been served");
+  NS_TEST_EXPECT_MSG_EQ_TOL (stats.maxBacklog, 10000, 1, "Wrong peak backlog");
+  NS_TEST_EXPECT_MSG_EQ (stats.nSteps, 10, "Wrong number of steps");
+  NS_TEST_EXPECT_MSG_EQ (qd->GetNPackets (), 0, "The queue disc should be empty");
+
+  // The fluid is held in the buffer of the queue disc, the packets which
+  // do not fit are dropped, and the queue length of the marking counts it
+  qd->Dispose ();
+  m_sent.clear ();
+  qd = CreateObjectWithAttributes<StepMarkingQueueDisc> ("MaxSize", StringValue ("10p"),
+                                                         "MarkingThreshold", StringValue ("5p"));
+  qd->Initialize ();
+  qd->SetSendCallback (MakeCallback (&FluidLoadTestCase::Sent, this));
+  load = CreateObject<ConstantFluidLoad> (2e6);
+  load->SetDataRate (DataRate ("8Mbps"));
+  load->SetAttribute ("TimeStep", StringValue ("1ms"));
+  qd->SetFluidLoad (load);
+  Simulator::Schedule (Seconds (0), &FluidLoad::Start, load);
+  // 6 packets of fluid after 9 ms
+  Simulator::Schedule (MilliSeconds (9), &FluidLoadTestCase::Enqueue, this, qd, 1500);
+  // The buffer is full of fluid after 18 ms
+  Simulator::Schedule (MilliSeconds (20), &FluidLoadTestCase::Enqueue, this, qd, 1500);
+  Simulator::Stop (MilliSeconds (30));
+  Simulator::Run ();
+
+  stats = load->GetStats ();
+  NS_TEST_EXPECT_MSG_EQ_TOL (stats.maxBacklog, 15000, 1, "The fluid should fill the buffer");
+  NS_TEST_EXPECT_MSG_GT (stats.nDroppedBytes, 0, "The fluid in excess of the buffer should be dropped");
+  QueueDisc::Stats qdStats = qd->GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (qdStats.GetNMarkedPackets (StepMarkingQueueDisc::THRESHOLD_EXCEEDED_MARK), 1,
+                         "The packet behind the fluid should be marked");
+  NS_TEST_EXPECT_MSG_EQ (qdStats.GetNDroppedPackets (QueueDisc::FLUID_LOAD_DROP), 1,
+                         "The packet should not fit with the fluid");
+  NS_TEST_EXPECT_MSG_EQ (m_sent.size (), 1, "The packet should have been sent");
+  NS_TEST_EXPECT_MSG_GT (stats.nHolds, 0, "The packet should have waited for the fluid");
+
+  qd->Dispose ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Fluid Load Test Suite
+ */
+static class FluidLoadTestSuite : public TestSuite
+{
+public:
+  FluidLoadTestSuite ()
+    : TestSuite ("fluid-load", UNIT)
+  {
+    AddTestCase (new FluidLoadTestCase (), TestCase::QUICK);
+  }
+} g_fluidLoadTestSuite; ///< the test suite
@@ -0,0 +1,268 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/shared-buffer-manager.h"
+#include "ns3/fifo-queue-disc.h"
+#include "ns3/packet.h"
+#include "ns3/double.h"
+#include "ns3/string.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Shared Buffer Test Item
+ */
+class SharedBufferTestItem : public QueueDiscItem
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param p the packet
+   */
+  SharedBufferTestItem (Ptr<Packet> p);
+  virtual ~SharedBufferTestItem ();
+  virtual void AddHeader (void);
+  virtual bool Mark (void);
+
+private:
+  SharedBufferTestItem ();
+  /**
+   * \brief Copy constructor
+   * Disable default implementation to avoid misuse
+   */
+  SharedBufferTestItem (const SharedBufferTestItem &);
+  /**
+   * \brief Assignment operator
+   * \return this object
+   * Disable default implementation to avoid misuse
+   */
+  SharedBufferTestItem &operator = (const SharedBufferTestItem &);
+};
+
+SharedBufferTestItem::SharedBufferTestItem (Ptr<Packet> p)
+  : QueueDiscItem (p, Address (), 0)
+{
+}
+
+SharedBufferTestItem::~SharedBufferTestItem ()
+{
+}
+
+void
+SharedBufferTestItem::AddHeader (void)
+{
+}
+
+bool
+SharedBufferTestItem::Mark (void)
+{
+  return false;
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Shared Buffer Dynamic Threshold Test Case
+ */
+class SharedBufferThresholdTestCase : public TestCase
+{
+public:
+  SharedBufferThresholdTestCase ();
+private:
+  virtual void DoRun (void);
+  /**
+   * Fill a queue until the buffer refuses a packet
+   * \param buffer the shared buffer
+   * \param queue the index of the queue
+   * \param bytes the size of the packets
+   * \returns the number of packets admitted
+   */
+  uint32_t Fill (Ptr<SharedBufferManager> buffer, uint32_t queue, uint32_t bytes);
+};
+
+SharedBufferThresholdTestCase::SharedBufferThresholdTestCase ()
+  : TestCase ("Sanity check on the dynamic threshold admission")
+{
+}
+
+uint32_t
+SharedBufferThresholdTestCase::Fill (Ptr<SharedBufferManager> buffer, uint32_t queue, uint32_t bytes)
+{
+  uint32_t n = 0;
+  while (buffer->Admit (queue, bytes))
+    {
+      buffer->PacketEnqueued (queue, bytes);
+      n++;
+    }
+  return n;
+}
+
+void
+SharedBufferThresholdTestCase::DoRun (void)
+{
+  // A queue alone gets alpha / (1 + alpha) of the buffer
+  Ptr<SharedBufferManager> buffer = CreateObjectWithAttributes<SharedBufferManager>
+      ("Size", StringValue ("300p"), "Alpha", DoubleValue (1));
+  uint32_t q0 = buffer->AddQueue (0);
+  uint32_t q1 = buffer->AddQueue (0);
+  uint32_t q2 = buffer->AddQueue (2);
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetNQueues (), 3, "There should be 3 queues");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetNPorts (), 3, "There should be 3 ports");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetThreshold (q0), 300, "The threshold of an empty buffer is its size");
+
+  NS_TEST_EXPECT_MSG_EQ (Fill (buffer, q0, 1000), 150, "A queue alone should get half of the buffer");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetThreshold (q1), 150, "The threshold should be the free buffer");
+
+  // Then a second queue gets half of the remaining buffer
+  NS_TEST_EXPECT_MSG_EQ (Fill (buffer, q2, 1000), 75, "The second queue should get a quarter of the buffer");
+
+  // The occupancies are counted for each queue, port and the whole buffer
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetQueueStats (q0).occupancy, 150, "Wrong occupancy of queue 0");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetQueueStats (q1).occupancy, 0, "Wrong occupancy of queue 1");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetQueueStats (q2).occupancy, 75, "Wrong occupancy of queue 2");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetPortStats (0).occupancy, 150, "Wrong occupancy of port 0");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetPortStats (1).occupancy, 0, "Wrong occupancy of port 1");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetPortStats (2).occupancy, 75, "Wrong occupancy of port 2");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetStats ().occupancy, 225, "Wrong occupancy of the buffer");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetStats ().nDroppedPackets, 2, "Two packets should have been refused");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetStats ().nDroppedBytes, 2000, "Two packets should have been refused");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetPortStats (2).nAdmittedBytes, 75000, "Wrong bytes admitted on port 2");
+
+  // Draining queue 0 makes room for queue 2
+  for (uint32_t i = 0; i < 150; i++)
+    {
+      buffer->PacketDequeued (q0, 1000);
+    }
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetStats ().occupancy, 75, "Wrong occupancy of the buffer");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetStats ().maxOccupancy, 225, "Wrong peak occupancy of the buffer");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetQueueStats (q0).maxOccupancy, 150, "Wrong peak occupancy of queue 0");
+  NS_TEST_EXPECT_MSG_EQ (Fill (buffer, q2, 1000), 75, "Queue 2 should get half of the buffer");
+
+  // A higher alpha gets a larger share, in bytes as in packets
+  buffer = CreateObjectWithAttributes<SharedBufferManager>
+      ("Size", StringValue ("30000B"), "Alpha", DoubleValue (2));
+  q0 = buffer->AddQueue (0);
+  q1 = buffer->AddQueue (1);
+  buffer->SetAlpha (q1, 0.5);
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetAlpha (q0), 2, "The alpha should be the default one");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetAlpha (q1), 0.5, "The alpha should have been set");
+  NS_TEST_EXPECT_MSG_EQ (Fill (buffer, q0, 100), 200, "The queue should get two thirds of the buffer");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetStats ().occupancy, 20000, "The occupancy should be in bytes");
+  NS_TEST_EXPECT_MSG_EQ (Fill (buffer, q1, 100), 33, "The queue should get a third of the remaining buffer");
+  NS_TEST_EXPECT_MSG_EQ (buffer->Admit (q0, 100), false, "The buffer should be above the threshold of queue 0");
+
+  // A packet never exceeds the buffer, whatever the alpha
+  buffer = CreateObjectWithAttributes<SharedBufferManager>
+      ("Size", StringValue ("10p"), "Alpha", DoubleValue (1000));
+  q0 = buffer->AddQueue (0);
+  NS_TEST_EXPECT_MSG_EQ (Fill (buffer, q0, 100), 10, "The queue should fill the buffer");
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Shared Buffer Queue Disc Test Case
+ */
+class SharedBufferQueueDiscTestCase : public TestCase
+{
+public:
+  SharedBufferQueueDiscTestCase ();
+private:
+  virtual void DoRun (void);
+};
+
+SharedBufferQueueDiscTestCase::SharedBufferQueueDiscTestCase ()
+  : TestCase ("Queue discs sharing a buffer")
+{
+}
+
+void
+SharedBufferQueueDiscTestCase::DoRun (void)
+{
+  Ptr<SharedBufferManager> buffer = CreateObjectWithAttributes<SharedBufferManager>
+      ("Size", StringValue ("10p"));
+  Ptr<QueueDisc> qd[2];
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      qd[i] = CreateObjectWithAttributes<FifoQueueDisc> ("MaxSize", StringValue ("100p"));
+      qd[i]->Initialize ();
+      NS_TEST_EXPECT_MSG_EQ (buffer->AddQueueDisc (qd[i], i), i, "Wrong index of the queue");
+    }
+
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      qd[0]->Enqueue (Create<SharedBufferTestItem> (Create<Packet> (1000)));
+    }
+  NS_TEST_EXPECT_MSG_EQ (qd[0]->GetNPackets (), 5, "The queue disc should hold half of the buffer");
+  NS_TEST_EXPECT_MSG_EQ (qd[0]->GetStats ().GetNDroppedPackets (QueueDisc::SHARED_BUFFER_DROP), 5,
+                         "The other packets should have been dropped by the shared buffer");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetStats ().nDroppedPackets, 5, "The buffer should count the drops");
+
+  // A peeked packet is still in the buffer until it is dequeued
+  qd[0]->Peek ();
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetStats ().occupancy, 5, "A peeked packet should remain in the buffer");
+  qd[0]->Dequeue ();
+  qd[0]->Dequeue ();
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetPortStats (0).occupancy, 3, "The dequeued packets should leave the buffer");
+
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      qd[1]->Enqueue (Create<SharedBufferTestItem> (Create<Packet> (1000)));
+    }
+  NS_TEST_EXPECT_MSG_EQ (qd[1]->GetNPackets (), 4, "The queue disc should get the rest of the buffer");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetStats ().occupancy, 7, "Wrong occupancy of the buffer");
+
+  while (qd[0]->Dequeue ())
+    {
+    }
+  while (qd[1]->Dequeue ())
+    {
+    }
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetStats ().occupancy, 0, "The buffer should be empty");
+  NS_TEST_EXPECT_MSG_EQ (buffer->GetStats ().nAdmittedPackets, 9, "Wrong number of packets admitted");
+
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      qd[i]->Dispose ();
+    }
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Shared Buffer Manager Test Suite
+ */
+static class SharedBufferManagerTestSuite : public TestSuite
+{
+public:
+  SharedBufferManagerTestSuite ()
+    : TestSuite ("shared-buffer-manager", UNIT)
+  {
+    AddTestCase (new SharedBufferThresholdTestCase (), TestCase::QUICK);
+    AddTestCase (new SharedBufferQueueDiscTestCase (), TestCase::QUICK);
+  }
+} g_sharedBufferManagerTestSuite; ///< the test suite
@@ -0,0 +1,386 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/step-marking-queue-disc.h"
+#include "ns3/red-queue-disc.h"
+#include "ns3/packet.h"
+#include "ns3/socket.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Step Marking Queue Disc Test Item
+ */
+class StepMarkingQueueDiscTestItem : public QueueDiscItem
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param p packet
+   * \param ecnCapable ECN capable flag
+   */
+  StepMarkingQueueDiscTestItem (Ptr<Packet> p, bool ecnCapable);
+  virtual ~StepMarkingQueueDiscTestItem ();
+  virtual void AddHeader (void);
+  virtual bool Mark (void);
+  /// \returns true if the item was marked
+  bool IsMarked (void) const;
+
+private:
+  StepMarkingQueueDiscTestItem ();
+  /**
+   * \brief Copy constructor
+   * Disable default implementation to avoid misuse
+   */
+  StepMarkingQueueDiscTestItem (const StepMarkingQueueDiscTestItem &);
+  /**
+   * \brief Assignment operator
+   * \return this object
+   * Disable default implementation to avoid misuse
+   */
+  StepMarkingQueueDiscTestItem &operator = (const StepMarkingQueueDiscTestItem &);
+  bool m_ecnCapablePacket; ///< ECN capable packet?
+  bool m_marked;           ///< Was the packet marked?
+};
+
+StepMarkingQueueDiscTestItem::StepMarkingQueueDiscTestItem (Ptr<Packet> p, bool ecnCapable)
+  : QueueDiscItem (p, Address (), 0),
+    m_ecnCapablePacket (ecnCapable),
+    m_marked (false)
+{
+}
+
+StepMarkingQueueDiscTestItem::~StepMarkingQueueDiscTestItem ()
+{
+}
+
+void
+StepMarkingQueueDiscTestItem::AddHeader (void)
+{
+}
+
+bool
+StepMarkingQueueDiscTestItem::Mark (void)
+{
+  if (m_ecnCapablePacket)
+    {
+      m_marked = true;
+      return true;
+    }
+  return false;
+}
+
+bool
+StepMarkingQueueDiscTestItem::IsMarked (void) const
+{
+  return m_marked;
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Step Marking Queue Disc Test Case: marking and dropping at the
+ * threshold, on enqueue and on dequeue, with global and per-priority
+ * thresholds
+ */
+class StepMarkingQueueDiscTestCase : public TestCase
+{
+public:
+  StepMarkingQueueDiscTestCase ();
+  virtual void DoRun (void);
+private:
+  /**
+   * Enqueue a packet
+   * \param queue the queue disc
+   * \param size the size of the packet
+   * \param ecnCapable ECN capable flag
+   * \param prio the priority of the packet, none if negative
+   * \returns the item
+   */
+  Ptr<StepMarkingQueueDiscTestItem> Enqueue (Ptr<StepMarkingQueueDisc> queue, uint32_t size,
+                                             bool ecnCapable, int prio = -1);
+  /**
+   * Run the test with the thresholds in a unit
+   * \param unit the unit
+   */
+  void RunTest (QueueSizeUnit unit);
+};
+
+StepMarkingQueueDiscTestCase::StepMarkingQueueDiscTestCase ()
+  : TestCase ("Sanity check on the step marking queue disc implementation")
+{
+}
+
+Ptr<StepMarkingQueueDiscTestItem>
+StepMarkingQueueDiscTestCase::Enqueue (Ptr<StepMarkingQueueDisc> queue, uint32_t size,
+                                       bool ecnCapable, int prio)
+{
+  Ptr<Packet> p = Create<Packet> (size);
+  if (prio >= 0)
+    {
+      SocketPriorityTag priorityTag;
+      priorityTag.SetPriority (prio);
+      p->AddPacketTag (priorityTag);
+    }
+  Ptr<StepMarkingQueueDiscTestItem> item = Create<StepMarkingQueueDiscTestItem> (p, ecnCapable);
+  queue->Enqueue (item);
+  return item;
+}
+
+void
+StepMarkingQueueDiscTestCase::RunTest (QueueSizeUnit unit)
+{
+  // 1 for packets; pktSize for bytes
+  uint32_t pktSize = 500;
+  uint32_t modeSize = (unit == QueueSizeUnit::BYTES) ? pktSize : 1;
+  Ptr<StepMarkingQueueDiscTestItem> item[6];
+
+  // Marking on enqueue: the packets finding 3 packets ahead are marked
+  Ptr<StepMarkingQueueDisc> queue = CreateObjectWithAttributes<StepMarkingQueueDisc>
+      ("MaxSize", QueueSizeValue (QueueSize (unit, 5 * modeSize)),
+       "MarkingThreshold", QueueSizeValue (QueueSize (unit, 3 * modeSize)));
+  queue->Initialize ();
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      item[i] = Enqueue (queue, pktSize, true);
+    }
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (item[i]->IsMarked (), (i >= 3), "Wrong marking of packet " << i);
+    }
+  QueueDisc::Stats st = queue->GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (st.GetNMarkedPackets (StepMarkingQueueDisc::THRESHOLD_EXCEEDED_MARK), 2,
+                         "There should be two marked packets");
+  // The queue is full: the packet is marked, then dropped
+  item[5] = Enqueue (queue, pktSize, true);
+  st = queue->GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (st.GetNDroppedPackets (QueueDisc::INTERNAL_QUEUE_DROP), 1,
+                         "There should be one dropped packet");
+  // The packets which cannot be marked are dropped
+  queue->Dequeue ();
+  queue->Dequeue ();
+  Enqueue (queue, pktSize, false);
+  st = queue->GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (st.GetNDroppedPackets (StepMarkingQueueDisc::THRESHOLD_EXCEEDED_DROP), 1,
+                         "The packet not ECN capable should be dropped");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetCurrentSize ().GetValue (), 3 * modeSize, "There should be three packets in there");
+
+  // Without ECN, all the packets above the threshold are dropped
+  queue = CreateObjectWithAttributes<StepMarkingQueueDisc>
+      ("MaxSize", QueueSizeValue (QueueSize (unit, 5 * modeSize)),
+       "MarkingThreshold", QueueSizeValue (QueueSize (unit, 3 * modeSize)),
+       "UseEcn", BooleanValue (false));
+  queue->Initialize ();
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      Enqueue (queue, pktSize, true);
+    }
+  st = queue->GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (st.GetNDroppedPackets (StepMarkingQueueDisc::THRESHOLD_EXCEEDED_DROP), 2,
+                         "There should be two dropped packets");
+  NS_TEST_EXPECT_MSG_EQ (st.nTotalMarkedPackets, 0, "There should be no marked packet");
+
+  // Marking on dequeue: the packets leaving 3 packets behind are marked
+  queue = CreateObjectWithAttributes<StepMarkingQueueDisc>
+      ("MaxSize", QueueSizeValue (QueueSize (unit, 5 * modeSize)),
+       "MarkingThreshold", QueueSizeValue (QueueSize (unit, 3 * modeSize)),
+       "MarkOnDequeue", BooleanValue (true));
+  queue->Initialize ();
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      item[i] = Enqueue (queue, pktSize, true);
+      NS_TEST_EXPECT_MSG_EQ (item[i]->IsMarked (), false, "No packet should be marked on enqueue");
+    }
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      Ptr<QueueDiscItem> dequeued = queue->Dequeue ();
+      NS_TEST_EXPECT_MSG_EQ (dequeued, item[i], "Wrong packet dequeued");
+      NS_TEST_EXPECT_MSG_EQ (item[i]->IsMarked (), (i < 2), "Wrong marking of packet " << i);
+    }
+  // The packets which cannot be marked are dropped and the next one is dequeued
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      item[i] = Enqueue (queue, pktSize, i > 0);
+    }
+  NS_TEST_EXPECT_MSG_EQ (queue->Dequeue (), item[1], "The first packet should be dropped");
+  st = queue->GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (st.GetNDroppedPackets (StepMarkingQueueDisc::THRESHOLD_EXCEEDED_DROP), 1,
+                         "There should be one dropped packet");
+
+  // A threshold per priority: the packets of priority 1 are marked from
+  // 1 packet ahead, the other ones from 3 packets ahead
+  queue = CreateObjectWithAttributes<StepMarkingQueueDisc>
+      ("MaxSize", QueueSizeValue (QueueSize (unit, 10 * modeSize)),
+       "MarkingThreshold", QueueSizeValue (QueueSize (unit, 3 * modeSize)));
+  queue->SetMarkingThreshold (1, QueueSize (unit, modeSize));
+  NS_TEST_EXPECT_MSG_EQ (queue->GetMarkingThreshold (0), QueueSize (unit, 3 * modeSize), "Wrong threshold");
+  NS_TEST_EXPECT_MSG_EQ (queue->GetMarkingThreshold (1), QueueSize (unit, modeSize), "Wrong threshold");
+  queue->Initialize ();
+  item[0] = Enqueue (queue, pktSize, true, 1);
+  item[1] = Enqueue (queue, pktSize, true, 1);
+  item[2] = Enqueue (queue, pktSize, true);
+  item[3] = Enqueue (queue, pktSize, true, 2);
+  item[4] = Enqueue (queue, pktSize, true, 2);
+  item[5] = Enqueue (queue, pktSize, true, 17);
+  NS_TEST_EXPECT_MSG_EQ (item[0]->IsMarked (), false, "The first packet should not be marked");
+  NS_TEST_EXPECT_MSG_EQ (item[1]->IsMarked (), true, "The second packet should be marked");
+  NS_TEST_EXPECT_MSG_EQ (item[2]->IsMarked (), false, "A packet without priority should use the threshold of priority 0");
+  NS_TEST_EXPECT_MSG_EQ (item[3]->IsMarked (), true, "The fourth packet should be marked");
+  NS_TEST_EXPECT_MSG_EQ (item[4]->IsMarked (), true, "The fifth packet should be marked");
+  NS_TEST_EXPECT_MSG_EQ (item[5]->IsMarked (), true, "Priority 17 should use the threshold of priority 1");
+}
+
+void
+StepMarkingQueueDiscTestCase::DoRun (void)
+{
+  RunTest (QueueSizeUnit::PACKETS);
+  RunTest (QueueSizeUnit::BYTES);
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Step Marking Queue Disc Test Case: the packets marked and dropped
+ * are the ones a RedQueueDisc configured as a step marks and drops, with
+ * the parameters of the dstcp examples but without the Gentle mode
+ */
+class StepMarkingQueueDiscRedTestCase : public TestCase
+{
+public:
+  StepMarkingQueueDiscRedTestCase ();
+  virtual void DoRun (void);
+private:
+  /**
+   * Enqueue and dequeue random packets in both queue discs and compare them
+   * \param unit the unit of the queue size and of the threshold
+   * \param ecn whether the queue discs mark the packets
+   */
+  void RunTest (QueueSizeUnit unit, bool ecn);
+};
+
+StepMarkingQueueDiscRedTestCase::StepMarkingQueueDiscRedTestCase ()
+  : TestCase ("Check that the step marking queue disc marks as RED with QW = 1, MinTh = MaxTh and no Gentle mode")
+{
+}
+
+void
+StepMarkingQueueDiscRedTestCase::RunTest (QueueSizeUnit unit, bool ecn)
+{
+  uint32_t modeSize = (unit == QueueSizeUnit::BYTES) ? 1500 : 1;
+  double k = 65 * modeSize;
+  QueueSize maxSize (unit, 600 * modeSize);
+
+  Ptr<RedQueueDisc> red = CreateObjectWithAttributes<RedQueueDisc>
+      ("UseEcn", BooleanValue (ecn),
+       "Gentle", BooleanValue (false),
+       "UseHardDrop", BooleanValue (false),
+       "MeanPktSize", UintegerValue (1500),
+       "MaxSize", QueueSizeValue (maxSize),
+       "QW", DoubleValue (1),
+       "LinkBandwidth", StringValue ("10Gbps"),
+       "LinkDelay", StringValue ("10us"),
+       "MinTh", DoubleValue (k),
+       "MaxTh", DoubleValue (k));
+  Ptr<StepMarkingQueueDisc> step = CreateObjectWithAttributes<StepMarkingQueueDisc>
+      ("UseEcn", BooleanValue (ecn),
+       "MaxSize", QueueSizeValue (maxSize),
+       "MarkingThreshold", QueueSizeValue (QueueSize (unit, k)));
+  red->Initialize ();
+  step->Initialize ();
+
+  // Bursts of arrivals drive the queue across the threshold and to the
+  // limit, then it drains
+  Ptr<UniformRandomVariable> rv = CreateObject<UniformRandomVariable> ();
+  rv->SetStream (1);
+  uint32_t arrivalPercent = 50;
+  for (uint32_t i = 0; i < 20000; i++)
+    {
+      if (i % 1000 == 0)
+        {
+          arrivalPercent = rv->GetInteger (30, 70);
+        }
+      if (rv->GetInteger (0, 99) < arrivalPercent)
+        {
+          Ptr<Packet> p = Create<Packet> (rv->GetInteger (64, 1500));
+          bool ecnCapable = rv->GetInteger (0, 9) != 0;
+          Ptr<StepMarkingQueueDiscTestItem> redItem = Create<StepMarkingQueueDiscTestItem> (p, ecnCapable);
+          Ptr<StepMarkingQueueDiscTestItem> stepItem = Create<StepMarkingQueueDiscTestItem> (p, ecnCapable);
+          bool redEnqueued = red->Enqueue (redItem);
+          bool stepEnqueued = step->Enqueue (stepItem);
+          NS_TEST_ASSERT_MSG_EQ (stepEnqueued, redEnqueued, "Packet " << i << " enqueued differently");
+          NS_TEST_ASSERT_MSG_EQ (stepItem->IsMarked (), redItem->IsMarked (), "Packet " << i << " marked differently");
+        }
+      else
+        {
+          Ptr<QueueDiscItem> redItem = red->Dequeue ();
+          Ptr<QueueDiscItem> stepItem = step->Dequeue ();
+          NS_TEST_ASSERT_MSG_EQ ((stepItem == 0), (redItem == 0), "Dequeue " << i << " differs");
+          if (stepItem != 0)
+            {
+              NS_TEST_ASSERT_MSG_EQ (stepItem->GetPacket (), redItem->GetPacket (), "Dequeue " << i << " differs");
+            }
+        }
+      NS_TEST_ASSERT_MSG_EQ (step->GetCurrentSize (), red->GetCurrentSize (), "Queue length " << i << " differs");
+    }
+
+  QueueDisc::Stats redStats = red->GetStats ();
+  QueueDisc::Stats stepStats = step->GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (stepStats.nTotalMarkedPackets, redStats.nTotalMarkedPackets, "Different number of marks");
+  NS_TEST_EXPECT_MSG_EQ (stepStats.nTotalDroppedPackets, redStats.nTotalDroppedPackets, "Different number of drops");
+  NS_TEST_EXPECT_MSG_GT (redStats.nTotalDroppedPackets + redStats.nTotalMarkedPackets, 0, "The threshold was never reached");
+}
+
+void
+StepMarkingQueueDiscRedTestCase::DoRun (void)
+{
+  RunTest (QueueSizeUnit::PACKETS, true);
+  RunTest (QueueSizeUnit::PACKETS, false);
+  RunTest (QueueSizeUnit::BYTES, true);
+  RunTest (QueueSizeUnit::BYTES, false);
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Step Marking Queue Disc Test Suite
+ */
+static class StepMarkingQueueDiscTestSuite : public TestSuite
+{
+public:
+  StepMarkingQueueDiscTestSuite ()
+    : TestSuite ("step-marking-queue-disc", UNIT)
+  {
+    AddTestCase (new StepMarkingQueueDiscTestCase (), TestCase::QUICK);
+    AddTestCase (new StepMarkingQueueDiscRedTestCase (), TestCase::QUICK);
+  }
+} g_stepMarkingQueueDiscTestSuite; ///< the test suite
@@ -0,0 +1,425 @@
+set terminal postscript eps color enh "Times-BoldItalic"
+set output "80211n-mimo-throughput.eps"
+set xlabel "Distance (Meters)"
+set ylabel "Throughput (Mbit/s)"
+set xrange [0:100]
+set yrange [0:600]
+set ytics 0,50,600
+set style line 1 dashtype 1 linewidth 5
+set style line 2 dashtype 1 linewidth 5
+set style line 3 dashtype 1 linewidth 5
+set style line 4 dashtype 1 linewidth 5
+set style line 5 dashtype 1 linewidth 5
+set style line 6 dashtype 1 linewidth 5
+set style line 7 dashtype 1 linewidth 5
+set style line 8 dashtype 1 linewidth 5
+set style line 9 dashtype 2 linewidth 5
+set style line 10 dashtype 2 linewidth 5
+set style line 11 dashtype 2 linewidth 5
+set style line 12 dashtype 2 linewidth 5
+set style line 13 dashtype 2 linewidth 5
+set style line 14 dashtype 2 linewidth 5
+set style line 15 dashtype 2 linewidth 5
+set style line 16 dashtype 2 linewidth 5
+set style line 17 dashtype 3 linewidth 5
+set style line 18 dashtype 3 linewidth 5
+set style line 19 dashtype 3 linewidth 5
+set style line 20 dashtype 3 linewidth 5
+set style line 21 dashtype 3 linewidth 5
+set style line 22 dashtype 3 linewidth 5
+set style line 23 dashtype 3 linewidth 5
+set style line 24 dashtype 3 linewidth 5
+set style line 25 dashtype 4 linewidth 5
+set style line 26 dashtype 4 linewidth 5
+set style line 27 dashtype 4 linewidth 5
+set style line 28 dashtype 4 linewidth 5
+set style line 29 dashtype 4 linewidth 5
+set style line 30 dashtype 4 linewidth 5
+set style line 31 dashtype 4 linewidth 5
+set style line 32 dashtype 4 linewidth 5
+set style increment user
+plot "-"  title "HtMcs0" with lines, "-"  title "HtMcs1" with lines, "-"  title "HtMcs2" with lines, "-"  title "HtMcs3" with lines, "-"  title "HtMcs4" with lines, "-"  title "HtMcs5" with lines, "-"  title "HtMcs6" with lines, "-"  title "HtMcs7" with lines, "-"  title "HtMcs8" with lines, "-"  title "HtMcs9" with lines, "-"  title "HtMcs10" with lines, "-"  title "HtMcs11" with lines, "-"  title "HtMcs12" with lines, "-"  title "HtMcs13" with lines, "-"  title "HtMcs14" with lines, "-"  title "HtMcs15" with lines, "-"  title "HtMcs16" with lines, "-"  title "HtMcs17" with lines, "-"  title "HtMcs18" with lines, "-"  title "HtMcs19" with lines, "-"  title "HtMcs20" with lines, "-"  title "HtMcs21" with lines, "-"  title "HtMcs22" with lines, "-"  title "HtMcs23" with lines, "-"  title "HtMcs24" with lines, "-"  title "HtMcs25" with lines, "-"  title "HtMcs26" with lines, "-"  title "HtMcs27" with lines, "-"  title "HtMcs28" with lines, "-"  title "HtMcs29" with lines, "-"  title "HtMcs30" with lines, "-"  title "HtMcs31" with lines
+0 5.18144
+10 5.2992
+20 5.53472
+30 5.41696
+40 5.65248
+50 5.65248
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 11.1872
+10 10.8339
+20 11.4227
+30 11.1872
+40 11.305
+50 10.7162
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 17.4285
+10 16.0154
+20 16.6042
+30 16.9574
+40 16.0154
+50 16.3686
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 23.4342
+10 23.3165
+20 23.081
+30 21.9034
+40 22.3744
+50 23.552
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 33.6794
+10 34.7392
+20 32.9728
+30 33.7971
+40 33.2083
+50 22.7277
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 43.9245
+10 44.7488
+20 43.9245
+30 42.8646
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 52.1677
+10 52.6387
+20 52.0499
+30 47.6928
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 54.5229
+10 58.5267
+20 58.9978
+30 28.3802
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 11.4227
+10 10.5984
+20 11.0694
+30 11.4227
+40 11.4227
+50 10.7162
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 22.6099
+10 22.8454
+20 23.081
+30 22.6099
+40 21.9034
+50 21.6678
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 33.2083
+10 33.9149
+20 32.855
+30 32.855
+40 33.4438
+50 32.855
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 46.7507
+10 45.3376
+20 47.3395
+30 44.16
+40 46.7507
+50 45.2198
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 69.4784
+10 65.7101
+20 65.9456
+30 70.0672
+40 65.9456
+50 53.6986
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 91.3818
+10 92.5594
+20 92.4416
+30 92.5594
+40 7.6544
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 102.569
+10 103.393
+20 98.3296
+30 100.92
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 105.984
+10 106.102
+20 109.635
+30 80.4301
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 17.4285
+10 16.0154
+20 16.2509
+30 16.0154
+40 16.4864
+50 16.0154
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 32.384
+10 33.4438
+20 32.1485
+30 34.9747
+40 32.0307
+50 32.855
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 49.3414
+10 50.2835
+20 48.2816
+30 52.2854
+40 51.6966
+50 49.9302
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 67.0054
+10 65.7101
+20 69.2429
+30 65.1213
+40 66.5344
+50 70.0672
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 104.453
+10 104.571
+20 104.335
+30 105.395
+40 101.038
+50 85.7293
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 125.65
+10 128.594
+20 129.772
+30 137.426
+40 33.2083
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 152.97
+10 145.316
+20 153.324
+30 144.492
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 158.387
+10 162.156
+20 169.103
+30 141.901
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 21.5501
+10 23.1987
+20 22.9632
+30 21.3146
+40 23.1987
+50 22.7277
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 46.9862
+10 43.8067
+20 46.3974
+30 46.8685
+40 44.3955
+50 43.2179
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 68.5363
+10 66.4166
+20 67.8298
+30 65.7101
+40 65.5923
+50 69.9494
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 87.3779
+10 87.0246
+20 89.2621
+30 91.9706
+40 90.0864
+50 86.5536
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 132.951
+10 134.246
+20 131.773
+30 137.19
+40 125.768
+50 116.818
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 177.347
+10 178.406
+20 177.464
+30 166.395
+40 33.6794
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 199.603
+10 198.897
+20 195.128
+30 190.182
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 202.783
+10 211.261
+20 219.858
+30 160.978
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "idle-parf-0.eps"
+set title "Percentage time AP0 in Idle state vs time"
+set xlabel "Time (seconds)"
+set ylabel "Percent"
+plot "-"  title "Idle Time" with lines
+0 0
+1 90.8072
+2 44.0235
+3 36.2117
+4 35.5835
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "idle-parf-1.eps"
+set title "Percentage time AP1 in Idle state vs time"
+set xlabel "Time (seconds)"
+set ylabel "Percent"
+plot "-"  title "Idle Time" with lines
+0 0
+1 89.8477
+2 45.2862
+3 35.609
+4 35.6085
+e
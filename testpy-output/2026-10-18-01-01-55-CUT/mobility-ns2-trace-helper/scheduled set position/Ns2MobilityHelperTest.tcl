@@ -0,0 +1,3 @@
+$ns_ at 1.0 "$node_(0) set X_ 10"
+$ns_ at 1.0 "$node_(0) set Z_ 10"
+$ns_ at 1.0 "$node_(0) set Y_ 10"
\ No newline at end of file
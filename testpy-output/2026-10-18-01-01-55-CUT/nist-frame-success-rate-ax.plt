@@ -0,0 +1,5432 @@
+set terminal postscript eps color enh "Times-BoldItalic"
+set output "nist-frame-success-rate-ax.eps"
+set xlabel "SNR(dB)"
+set ylabel "Frame Success Rate"
+set xrange [-5:55]
+set yrange [0:1]
+set style line 1 linewidth 5
+set style line 2 linewidth 5
+set style line 3 linewidth 5
+set style line 4 linewidth 5
+set style line 5 linewidth 5
+set style line 6 linewidth 5
+set style line 7 linewidth 5
+set style line 8 linewidth 5
+set style line 9 linewidth 5
+set style line 10 linewidth 5
+set style line 11 linewidth 5
+set style line 12 linewidth 5
+set style increment user
+plot "-"  title "HeMcs0" with lines, "-"  title "HeMcs1" with lines, "-"  title "HeMcs2" with lines, "-"  title "HeMcs3" with lines, "-"  title "HeMcs4" with lines, "-"  title "HeMcs5" with lines, "-"  title "HeMcs6" with lines, "-"  title "HeMcs7" with lines, "-"  title "HeMcs8" with lines, "-"  title "HeMcs9" with lines, "-"  title "HeMcs10" with lines, "-"  title "HeMcs11" with lines
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 4.94066e-324
+1.6 9.61591e-218
+1.7 4.92396e-147
+1.8 9.51686e-100
+1.9 5.24018e-68
+2 1.25142e-46
+2.1 3.51077e-32
+2.2 2.21997e-22
+2.3 1.05324e-15
+2.4 3.89941e-11
+2.5 5.40229e-08
+2.6 8.01783e-06
+2.7 0.000258711
+2.8 0.00292712
+2.9 0.0160603
+3 0.0533043
+3.1 0.124538
+3.2 0.2274
+3.3 0.348939
+3.4 0.473371
+3.5 0.58832
+3.6 0.686929
+3.7 0.767094
+3.8 0.829748
+3.9 0.877305
+4 0.912613
+4.1 0.938383
+4.2 0.956937
+4.3 0.970146
+4.4 0.979459
+4.5 0.98597
+4.6 0.990486
+4.7 0.993595
+4.8 0.995719
+4.9 0.997159
+5 0.998129
+5.1 0.998778
+5.2 0.999208
+5.3 0.999491
+5.4 0.999675
+5.5 0.999795
+5.6 0.999871
+5.7 0.99992
+5.8 0.999951
+5.9 0.99997
+6 0.999982
+6.1 0.999989
+6.2 0.999994
+6.3 0.999996
+6.4 0.999998
+6.5 0.999999
+6.6 0.999999
+6.7 1
+6.8 1
+6.9 1
+7 1
+7.1 1
+7.2 1
+7.3 1
+7.4 1
+7.5 1
+7.6 1
+7.7 1
+7.8 1
+7.9 1
+8 1
+8.1 1
+8.2 1
+8.3 1
+8.4 1
+8.5 1
+8.6 1
+8.7 1
+8.8 1
+8.9 1
+9 1
+9.1 1
+9.2 1
+9.3 1
+9.4 1
+9.5 1
+9.6 1
+9.7 1
+9.8 1
+9.9 1
+10 1
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 8.64586e-227
+4.7 4.53221e-153
+4.8 8.59502e-104
+4.9 1.00042e-70
+5 1.83246e-48
+5.1 2.01154e-33
+5.2 3.17901e-23
+5.3 2.79482e-16
+5.4 1.5697e-11
+5.5 2.8851e-08
+5.6 5.19148e-06
+5.7 0.000191133
+5.8 0.00236814
+5.9 0.0138368
+6 0.0479809
+6.1 0.115593
+6.2 0.215671
+6.3 0.336032
+6.4 0.460826
+6.5 0.577163
+6.6 0.67762
+6.7 0.759679
+6.8 0.824039
+6.9 0.873021
+7 0.90946
+7.1 0.936098
+7.2 0.955301
+7.3 0.968986
+7.4 0.978645
+7.5 0.985403
+7.6 0.990094
+7.7 0.993326
+7.8 0.995536
+7.9 0.997036
+8 0.998047
+8.1 0.998723
+8.2 0.999171
+8.3 0.999467
+8.4 0.99966
+8.5 0.999785
+8.6 0.999865
+8.7 0.999916
+8.8 0.999948
+8.9 0.999969
+9 0.999981
+9.1 0.999989
+9.2 0.999993
+9.3 0.999996
+9.4 0.999998
+9.5 0.999999
+9.6 0.999999
+9.7 1
+9.8 1
+9.9 1
+10 1
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 1.06865e-244
+7.5 1.85226e-165
+7.6 2.18024e-112
+7.7 1.03905e-76
+7.8 1.20179e-52
+7.9 2.29993e-36
+8 2.61509e-25
+8.1 9.01075e-18
+8.2 1.30841e-12
+8.3 4.67705e-09
+8.4 1.34687e-06
+8.5 6.94148e-05
+8.6 0.00109762
+8.7 0.00767403
+8.8 0.0304277
+8.9 0.0811373
+9 0.163643
+9.1 0.270824
+9.2 0.38932
+9.3 0.505981
+9.4 0.611611
+9.5 0.701608
+9.6 0.774942
+9.7 0.832758
+9.8 0.877227
+9.9 0.910787
+10 0.935742
+10.1 0.954079
+10.2 0.96742
+10.3 0.977042
+10.4 0.98393
+10.5 0.988824
+10.6 0.992279
+10.7 0.994702
+10.8 0.996389
+10.9 0.997556
+11 0.998358
+11.1 0.998905
+11.2 0.999275
+11.3 0.999524
+11.4 0.99969
+11.5 0.9998
+11.6 0.999872
+11.7 0.999919
+11.8 0.999949
+11.9 0.999968
+12 0.99998
+12.1 0.999988
+12.2 0.999993
+12.3 0.999996
+12.4 0.999997
+12.5 0.999998
+12.6 0.999999
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 5.40018e-260
+10.9 9.57202e-185
+11 1.2572e-131
+11.1 4.85284e-94
+11.2 2.1514e-67
+11.3 1.80544e-48
+11.4 5.25097e-35
+11.5 2.08276e-25
+11.6 1.50455e-18
+11.7 1.23453e-13
+11.8 4.19461e-10
+11.9 1.47313e-07
+12 1.0219e-05
+12.1 0.000221627
+12.2 0.0020826
+12.3 0.0106989
+12.4 0.0354814
+12.5 0.0855821
+12.6 0.163603
+12.7 0.263765
+12.8 0.375205
+12.9 0.486695
+13 0.589744
+13.1 0.679512
+13.2 0.754296
+13.3 0.81452
+13.4 0.861774
+13.5 0.898105
+13.6 0.925592
+13.7 0.946117
+13.8 0.961278
+13.9 0.972371
+14 0.980421
+14.1 0.986218
+14.2 0.990362
+14.3 0.993305
+14.4 0.99538
+14.5 0.996834
+14.6 0.997845
+14.7 0.998544
+14.8 0.999023
+14.9 0.99935
+15 0.999571
+15.1 0.999719
+15.2 0.999817
+15.3 0.999882
+15.4 0.999925
+15.5 0.999952
+15.6 0.99997
+15.7 0.999981
+15.8 0.999989
+15.9 0.999993
+16 0.999996
+16.1 0.999997
+16.2 0.999999
+16.3 0.999999
+16.4 0.999999
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 3.47328e-321
+14 1.46286e-223
+14.1 3.91583e-156
+14.2 2.10004e-109
+14.3 6.14811e-77
+14.4 2.48227e-54
+14.5 1.47832e-38
+14.6 1.60193e-27
+14.7 8.8227e-20
+14.8 2.47572e-14
+14.9 1.7475e-10
+15 9.3874e-08
+15.1 8.27614e-06
+15.2 0.000204335
+15.3 0.00205051
+15.4 0.0108517
+15.5 0.0363625
+15.6 0.087762
+15.7 0.167157
+15.8 0.268143
+15.9 0.379558
+16 0.490279
+16.1 0.592145
+16.2 0.680655
+16.3 0.754342
+16.4 0.813744
+16.5 0.860467
+16.6 0.896524
+16.7 0.923933
+16.8 0.944517
+16.9 0.959818
+17 0.971094
+17.1 0.97934
+17.2 0.985326
+17.3 0.989643
+17.4 0.992737
+17.5 0.994939
+17.6 0.996496
+17.7 0.997591
+17.8 0.998355
+17.9 0.998885
+18 0.99925
+18.1 0.999499
+18.2 0.999668
+18.3 0.999782
+18.4 0.999858
+18.5 0.999908
+18.6 0.999941
+18.7 0.999963
+18.8 0.999976
+18.9 0.999985
+19 0.999991
+19.1 0.999994
+19.2 0.999997
+19.3 0.999998
+19.4 0.999999
+19.5 0.999999
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0
+14.7 0
+14.8 0
+14.9 0
+15 0
+15.1 0
+15.2 0
+15.3 0
+15.4 0
+15.5 0
+15.6 0
+15.7 0
+15.8 0
+15.9 0
+16 0
+16.1 0
+16.2 0
+16.3 0
+16.4 0
+16.5 0
+16.6 0
+16.7 0
+16.8 0
+16.9 0
+17 0
+17.1 0
+17.2 0
+17.3 0
+17.4 0
+17.5 0
+17.6 0
+17.7 0
+17.8 0
+17.9 0
+18 0
+18.1 0
+18.2 0
+18.3 0
+18.4 2.34498e-319
+18.5 3.88939e-240
+18.6 1.8269e-180
+18.7 1.61314e-135
+18.8 1.09385e-101
+18.9 2.99346e-76
+19 3.76828e-57
+19.1 7.87841e-43
+19.2 4.13918e-32
+19.3 4.2727e-24
+19.4 4.10182e-18
+19.5 1.18366e-13
+19.6 2.4839e-10
+19.7 7.36217e-08
+19.8 5.07021e-06
+19.9 0.000117751
+20 0.001218
+20.1 0.00690513
+20.2 0.0250396
+20.3 0.0651503
+20.4 0.132474
+20.5 0.224295
+20.6 0.331472
+20.7 0.442796
+20.8 0.548754
+20.9 0.643206
+21 0.723357
+21.1 0.788889
+21.2 0.840976
+21.3 0.88149
+21.4 0.912476
+21.5 0.93586
+21.6 0.953318
+21.7 0.966236
+21.8 0.975721
+21.9 0.982639
+22 0.987653
+22.1 0.991266
+22.2 0.993855
+22.3 0.9957
+22.4 0.997007
+22.5 0.997929
+22.6 0.998575
+22.7 0.999025
+22.8 0.999337
+22.9 0.999552
+23 0.999699
+23.1 0.9998
+23.2 0.999867
+23.3 0.999913
+23.4 0.999943
+23.5 0.999963
+23.6 0.999976
+23.7 0.999985
+23.8 0.99999
+23.9 0.999994
+24 0.999996
+24.1 0.999998
+24.2 0.999999
+24.3 0.999999
+24.4 0.999999
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0
+14.7 0
+14.8 0
+14.9 0
+15 0
+15.1 0
+15.2 0
+15.3 0
+15.4 0
+15.5 0
+15.6 0
+15.7 0
+15.8 0
+15.9 0
+16 0
+16.1 0
+16.2 0
+16.3 0
+16.4 0
+16.5 0
+16.6 0
+16.7 0
+16.8 0
+16.9 0
+17 0
+17.1 0
+17.2 0
+17.3 0
+17.4 0
+17.5 0
+17.6 0
+17.7 0
+17.8 0
+17.9 0
+18 0
+18.1 0
+18.2 0
+18.3 0
+18.4 0
+18.5 0
+18.6 0
+18.7 0
+18.8 0
+18.9 0
+19 0
+19.1 0
+19.2 0
+19.3 0
+19.4 0
+19.5 0
+19.6 0
+19.7 0
+19.8 2.46821e-256
+19.9 8.76972e-184
+20 4.49049e-132
+20.1 3.79187e-95
+20.2 9.72902e-69
+20.3 7.96532e-50
+20.4 2.92253e-36
+20.5 1.62536e-26
+20.6 1.68489e-19
+20.7 1.94755e-14
+20.8 8.9854e-11
+20.9 4.10819e-08
+21 3.56118e-06
+21.1 9.30229e-05
+21.2 0.00101992
+21.3 0.00595228
+21.4 0.0219326
+21.5 0.0577105
+21.6 0.118544
+21.7 0.202817
+21.8 0.30302
+21.9 0.409309
+22 0.512806
+22.1 0.607295
+22.2 0.689453
+22.3 0.758284
+22.4 0.814323
+22.5 0.858944
+22.6 0.893857
+22.7 0.920791
+22.8 0.94133
+22.9 0.956841
+23 0.968456
+23.1 0.977089
+23.2 0.98346
+23.3 0.988131
+23.4 0.991535
+23.5 0.994
+23.6 0.995774
+23.7 0.997042
+23.8 0.997944
+23.9 0.99858
+24 0.999026
+24.1 0.999337
+24.2 0.999552
+24.3 0.9997
+24.4 0.9998
+24.5 0.999868
+24.6 0.999914
+24.7 0.999944
+24.8 0.999964
+24.9 0.999977
+25 0.999986
+25.1 0.999991
+25.2 0.999994
+25.3 0.999997
+25.4 0.999998
+25.5 0.999999
+25.6 0.999999
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0
+14.7 0
+14.8 0
+14.9 0
+15 0
+15.1 0
+15.2 0
+15.3 0
+15.4 0
+15.5 0
+15.6 0
+15.7 0
+15.8 0
+15.9 0
+16 0
+16.1 0
+16.2 0
+16.3 0
+16.4 0
+16.5 0
+16.6 0
+16.7 0
+16.8 0
+16.9 0
+17 0
+17.1 0
+17.2 0
+17.3 0
+17.4 0
+17.5 0
+17.6 0
+17.7 0
+17.8 0
+17.9 0
+18 0
+18.1 0
+18.2 0
+18.3 0
+18.4 0
+18.5 0
+18.6 0
+18.7 0
+18.8 0
+18.9 0
+19 0
+19.1 0
+19.2 0
+19.3 0
+19.4 0
+19.5 0
+19.6 0
+19.7 0
+19.8 0
+19.9 0
+20 0
+20.1 0
+20.2 0
+20.3 0
+20.4 0
+20.5 0
+20.6 0
+20.7 0
+20.8 0
+20.9 0
+21 0
+21.1 6.4136e-256
+21.2 5.2334e-173
+21.3 8.83081e-118
+21.4 8.79868e-81
+21.5 7.31915e-56
+21.6 5.53219e-39
+21.7 1.75554e-27
+21.8 1.36429e-19
+21.9 3.8762e-14
+22 2.44282e-10
+22.1 1.1414e-07
+22.2 8.89916e-06
+22.3 0.000200322
+22.4 0.00189023
+22.5 0.00965263
+22.6 0.031824
+22.7 0.0766025
+22.8 0.146783
+22.9 0.23808
+23 0.34159
+23.1 0.447558
+23.2 0.548077
+23.3 0.638109
+23.4 0.715313
+23.5 0.779345
+23.6 0.831098
+23.7 0.872086
+23.8 0.904024
+23.9 0.928583
+24 0.94726
+24.1 0.961327
+24.2 0.971834
+24.3 0.979621
+24.4 0.985351
+24.5 0.989539
+24.6 0.992579
+24.7 0.99477
+24.8 0.99634
+24.9 0.997456
+25 0.998245
+25.1 0.998798
+25.2 0.999183
+25.3 0.999449
+25.4 0.999631
+25.5 0.999756
+25.6 0.999839
+25.7 0.999895
+25.8 0.999932
+25.9 0.999957
+26 0.999973
+26.1 0.999983
+26.2 0.999989
+26.3 0.999993
+26.4 0.999996
+26.5 0.999998
+26.6 0.999999
+26.7 0.999999
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0
+14.7 0
+14.8 0
+14.9 0
+15 0
+15.1 0
+15.2 0
+15.3 0
+15.4 0
+15.5 0
+15.6 0
+15.7 0
+15.8 0
+15.9 0
+16 0
+16.1 0
+16.2 0
+16.3 0
+16.4 0
+16.5 0
+16.6 0
+16.7 0
+16.8 0
+16.9 0
+17 0
+17.1 0
+17.2 0
+17.3 0
+17.4 0
+17.5 0
+17.6 0
+17.7 0
+17.8 0
+17.9 0
+18 0
+18.1 0
+18.2 0
+18.3 0
+18.4 0
+18.5 0
+18.6 0
+18.7 0
+18.8 0
+18.9 0
+19 0
+19.1 0
+19.2 0
+19.3 0
+19.4 0
+19.5 0
+19.6 0
+19.7 0
+19.8 0
+19.9 0
+20 0
+20.1 0
+20.2 0
+20.3 0
+20.4 0
+20.5 0
+20.6 0
+20.7 0
+20.8 0
+20.9 0
+21 0
+21.1 0
+21.2 0
+21.3 0
+21.4 0
+21.5 0
+21.6 0
+21.7 0
+21.8 0
+21.9 0
+22 0
+22.1 0
+22.2 0
+22.3 0
+22.4 0
+22.5 0
+22.6 0
+22.7 0
+22.8 0
+22.9 0
+23 0
+23.1 0
+23.2 0
+23.3 0
+23.4 0
+23.5 0
+23.6 0
+23.7 0
+23.8 0
+23.9 0
+24 0
+24.1 0
+24.2 0
+24.3 0
+24.4 0
+24.5 0
+24.6 0
+24.7 0
+24.8 0
+24.9 0
+25 0
+25.1 0
+25.2 0
+25.3 0
+25.4 0
+25.5 5.66691e-257
+25.6 1.11771e-188
+25.7 9.3459e-139
+25.8 3.23956e-102
+25.9 1.90387e-75
+26 8.05152e-56
+26.1 2.02742e-41
+26.2 7.6643e-31
+26.3 4.60703e-23
+26.4 2.47317e-17
+26.5 4.18617e-13
+26.6 5.61612e-10
+26.7 1.17112e-07
+26.8 6.20917e-06
+26.9 0.00011995
+27 0.00109867
+27.1 0.00578719
+27.2 0.0202015
+27.3 0.0518761
+27.4 0.105857
+27.5 0.181747
+27.6 0.27396
+27.7 0.374258
+27.8 0.474524
+27.9 0.568503
+28 0.652334
+28.1 0.72431
+28.2 0.784297
+28.3 0.833138
+28.4 0.872173
+28.5 0.902907
+28.6 0.92681
+28.7 0.94521
+28.8 0.959248
+28.9 0.969875
+29 0.977864
+29.1 0.983829
+29.2 0.988256
+29.3 0.991521
+29.4 0.993914
+29.5 0.995659
+29.6 0.996923
+29.7 0.997832
+29.8 0.998483
+29.9 0.998946
+30 0.999272
+30.1 0.999501
+30.2 0.999661
+30.3 0.999771
+30.4 0.999847
+30.5 0.999898
+30.6 0.999933
+30.7 0.999956
+30.8 0.999972
+30.9 0.999982
+31 0.999988
+31.1 0.999993
+31.2 0.999995
+31.3 0.999997
+31.4 0.999998
+31.5 0.999999
+31.6 0.999999
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0
+14.7 0
+14.8 0
+14.9 0
+15 0
+15.1 0
+15.2 0
+15.3 0
+15.4 0
+15.5 0
+15.6 0
+15.7 0
+15.8 0
+15.9 0
+16 0
+16.1 0
+16.2 0
+16.3 0
+16.4 0
+16.5 0
+16.6 0
+16.7 0
+16.8 0
+16.9 0
+17 0
+17.1 0
+17.2 0
+17.3 0
+17.4 0
+17.5 0
+17.6 0
+17.7 0
+17.8 0
+17.9 0
+18 0
+18.1 0
+18.2 0
+18.3 0
+18.4 0
+18.5 0
+18.6 0
+18.7 0
+18.8 0
+18.9 0
+19 0
+19.1 0
+19.2 0
+19.3 0
+19.4 0
+19.5 0
+19.6 0
+19.7 0
+19.8 0
+19.9 0
+20 0
+20.1 0
+20.2 0
+20.3 0
+20.4 0
+20.5 0
+20.6 0
+20.7 0
+20.8 0
+20.9 0
+21 0
+21.1 0
+21.2 0
+21.3 0
+21.4 0
+21.5 0
+21.6 0
+21.7 0
+21.8 0
+21.9 0
+22 0
+22.1 0
+22.2 0
+22.3 0
+22.4 0
+22.5 0
+22.6 0
+22.7 0
+22.8 0
+22.9 0
+23 0
+23.1 0
+23.2 0
+23.3 0
+23.4 0
+23.5 0
+23.6 0
+23.7 0
+23.8 0
+23.9 0
+24 0
+24.1 0
+24.2 0
+24.3 0
+24.4 0
+24.5 0
+24.6 0
+24.7 0
+24.8 0
+24.9 0
+25 0
+25.1 0
+25.2 0
+25.3 0
+25.4 0
+25.5 0
+25.6 0
+25.7 0
+25.8 0
+25.9 0
+26 0
+26.1 0
+26.2 0
+26.3 0
+26.4 0
+26.5 0
+26.6 0
+26.7 0
+26.8 0
+26.9 1.00008e-246
+27 1.42827e-170
+27.1 1.28722e-118
+27.2 5.26125e-83
+27.3 1.72919e-58
+27.4 1.5615e-41
+27.5 9.52162e-30
+27.6 1.64354e-21
+27.7 1.02007e-15
+27.8 1.28851e-11
+27.9 1.08379e-08
+28 1.36884e-06
+28.1 4.54546e-05
+28.2 0.000584798
+28.3 0.0038184
+28.4 0.0152891
+28.5 0.0429084
+28.6 0.0928251
+28.7 0.165728
+28.8 0.256563
+28.9 0.357036
+29 0.458638
+29.1 0.55463
+29.2 0.640739
+29.3 0.71496
+29.4 0.776984
+29.5 0.827573
+29.6 0.868044
+29.7 0.89992
+29.8 0.924705
+29.9 0.943769
+30 0.958296
+30.1 0.969274
+30.2 0.977507
+30.3 0.983638
+30.4 0.988174
+30.5 0.991506
+30.6 0.993939
+30.7 0.995704
+30.8 0.996975
+30.9 0.997885
+31 0.998532
+31.1 0.998988
+31.2 0.999308
+31.3 0.99953
+31.4 0.999684
+31.5 0.999789
+31.6 0.99986
+31.7 0.999908
+31.8 0.99994
+31.9 0.999961
+32 0.999975
+32.1 0.999984
+32.2 0.99999
+32.3 0.999994
+32.4 0.999996
+32.5 0.999998
+32.6 0.999999
+32.7 0.999999
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0
+14.7 0
+14.8 0
+14.9 0
+15 0
+15.1 0
+15.2 0
+15.3 0
+15.4 0
+15.5 0
+15.6 0
+15.7 0
+15.8 0
+15.9 0
+16 0
+16.1 0
+16.2 0
+16.3 0
+16.4 0
+16.5 0
+16.6 0
+16.7 0
+16.8 0
+16.9 0
+17 0
+17.1 0
+17.2 0
+17.3 0
+17.4 0
+17.5 0
+17.6 0
+17.7 0
+17.8 0
+17.9 0
+18 0
+18.1 0
+18.2 0
+18.3 0
+18.4 0
+18.5 0
+18.6 0
+18.7 0
+18.8 0
+18.9 0
+19 0
+19.1 0
+19.2 0
+19.3 0
+19.4 0
+19.5 0
+19.6 0
+19.7 0
+19.8 0
+19.9 0
+20 0
+20.1 0
+20.2 0
+20.3 0
+20.4 0
+20.5 0
+20.6 0
+20.7 0
+20.8 0
+20.9 0
+21 0
+21.1 0
+21.2 0
+21.3 0
+21.4 0
+21.5 0
+21.6 0
+21.7 0
+21.8 0
+21.9 0
+22 0
+22.1 0
+22.2 0
+22.3 0
+22.4 0
+22.5 0
+22.6 0
+22.7 0
+22.8 0
+22.9 0
+23 0
+23.1 0
+23.2 0
+23.3 0
+23.4 0
+23.5 0
+23.6 0
+23.7 0
+23.8 0
+23.9 0
+24 0
+24.1 0
+24.2 0
+24.3 0
+24.4 0
+24.5 0
+24.6 0
+24.7 0
+24.8 0
+24.9 0
+25 0
+25.1 0
+25.2 0
+25.3 0
+25.4 0
+25.5 0
+25.6 0
+25.7 0
+25.8 0
+25.9 0
+26 0
+26.1 0
+26.2 0
+26.3 0
+26.4 0
+26.5 0
+26.6 0
+26.7 0
+26.8 0
+26.9 0
+27 0
+27.1 0
+27.2 0
+27.3 0
+27.4 0
+27.5 0
+27.6 0
+27.7 0
+27.8 0
+27.9 0
+28 0
+28.1 0
+28.2 0
+28.3 0
+28.4 0
+28.5 0
+28.6 0
+28.7 0
+28.8 0
+28.9 0
+29 0
+29.1 0
+29.2 0
+29.3 0
+29.4 0
+29.5 0
+29.6 0
+29.7 0
+29.8 0
+29.9 0
+30 0
+30.1 0
+30.2 0
+30.3 0
+30.4 0
+30.5 0
+30.6 0
+30.7 0
+30.8 0
+30.9 0
+31 0
+31.1 0
+31.2 1.02938e-246
+31.3 6.007e-185
+31.4 8.62952e-139
+31.5 2.85013e-104
+31.6 1.91069e-78
+31.7 4.07499e-59
+31.8 1.20604e-44
+31.9 8.33692e-34
+32 1.11201e-25
+32.1 1.3878e-19
+32.2 5.27225e-15
+32.3 1.47122e-11
+32.4 5.81902e-09
+32.5 5.32676e-07
+32.6 1.62687e-05
+32.7 0.000217782
+32.8 0.00156658
+32.9 0.0070516
+33 0.0222611
+33.1 0.0536892
+33.2 0.1055
+33.3 0.177308
+33.4 0.264394
+33.5 0.359692
+33.6 0.456013
+33.7 0.547558
+33.8 0.630497
+33.9 0.702878
+34 0.764208
+34.1 0.814975
+34.2 0.856217
+34.3 0.889213
+34.4 0.915284
+34.5 0.935666
+34.6 0.951457
+34.7 0.963593
+34.8 0.972855
+34.9 0.979876
+35 0.985165
+35.1 0.989126
+35.2 0.992075
+35.3 0.994258
+35.4 0.995864
+35.5 0.997039
+35.6 0.997893
+35.7 0.998511
+35.8 0.998954
+35.9 0.999271
+36 0.999495
+36.1 0.999653
+36.2 0.999763
+36.3 0.999839
+36.4 0.999892
+36.5 0.999928
+36.6 0.999952
+36.7 0.999969
+36.8 0.99998
+36.9 0.999987
+37 0.999992
+37.1 0.999995
+37.2 0.999997
+37.3 0.999998
+37.4 0.999999
+37.5 0.999999
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0
+14.7 0
+14.8 0
+14.9 0
+15 0
+15.1 0
+15.2 0
+15.3 0
+15.4 0
+15.5 0
+15.6 0
+15.7 0
+15.8 0
+15.9 0
+16 0
+16.1 0
+16.2 0
+16.3 0
+16.4 0
+16.5 0
+16.6 0
+16.7 0
+16.8 0
+16.9 0
+17 0
+17.1 0
+17.2 0
+17.3 0
+17.4 0
+17.5 0
+17.6 0
+17.7 0
+17.8 0
+17.9 0
+18 0
+18.1 0
+18.2 0
+18.3 0
+18.4 0
+18.5 0
+18.6 0
+18.7 0
+18.8 0
+18.9 0
+19 0
+19.1 0
+19.2 0
+19.3 0
+19.4 0
+19.5 0
+19.6 0
+19.7 0
+19.8 0
+19.9 0
+20 0
+20.1 0
+20.2 0
+20.3 0
+20.4 0
+20.5 0
+20.6 0
+20.7 0
+20.8 0
+20.9 0
+21 0
+21.1 0
+21.2 0
+21.3 0
+21.4 0
+21.5 0
+21.6 0
+21.7 0
+21.8 0
+21.9 0
+22 0
+22.1 0
+22.2 0
+22.3 0
+22.4 0
+22.5 0
+22.6 0
+22.7 0
+22.8 0
+22.9 0
+23 0
+23.1 0
+23.2 0
+23.3 0
+23.4 0
+23.5 0
+23.6 0
+23.7 0
+23.8 0
+23.9 0
+24 0
+24.1 0
+24.2 0
+24.3 0
+24.4 0
+24.5 0
+24.6 0
+24.7 0
+24.8 0
+24.9 0
+25 0
+25.1 0
+25.2 0
+25.3 0
+25.4 0
+25.5 0
+25.6 0
+25.7 0
+25.8 0
+25.9 0
+26 0
+26.1 0
+26.2 0
+26.3 0
+26.4 0
+26.5 0
+26.6 0
+26.7 0
+26.8 0
+26.9 0
+27 0
+27.1 0
+27.2 0
+27.3 0
+27.4 0
+27.5 0
+27.6 0
+27.7 0
+27.8 0
+27.9 0
+28 0
+28.1 0
+28.2 0
+28.3 0
+28.4 0
+28.5 0
+28.6 0
+28.7 0
+28.8 0
+28.9 0
+29 0
+29.1 0
+29.2 0
+29.3 0
+29.4 0
+29.5 0
+29.6 0
+29.7 0
+29.8 0
+29.9 0
+30 0
+30.1 0
+30.2 0
+30.3 0
+30.4 0
+30.5 0
+30.6 0
+30.7 0
+30.8 0
+30.9 0
+31 0
+31.1 0
+31.2 0
+31.3 0
+31.4 0
+31.5 0
+31.6 0
+31.7 0
+31.8 0
+31.9 0
+32 0
+32.1 0
+32.2 0
+32.3 0
+32.4 0
+32.5 0
+32.6 2.92981e-321
+32.7 1.64195e-225
+32.8 4.47419e-159
+32.9 8.96764e-113
+33 2.21202e-80
+33.1 1.22427e-57
+33.2 1.30918e-41
+33.3 2.89551e-30
+33.4 3.38055e-22
+33.5 1.97663e-16
+33.6 2.76929e-12
+33.7 2.76848e-09
+33.8 4.23399e-07
+33.9 1.69084e-05
+34 0.00025689
+34.1 0.00193767
+34.2 0.0087682
+34.3 0.0272569
+34.4 0.0641767
+34.5 0.122853
+34.6 0.201374
+34.7 0.29364
+34.8 0.391856
+34.9 0.488803
+35 0.579104
+35.1 0.659524
+35.2 0.72868
+35.3 0.786538
+35.4 0.833894
+35.5 0.871977
+35.6 0.902164
+35.7 0.925806
+35.8 0.944133
+35.9 0.958213
+36 0.968945
+36.1 0.977064
+36.2 0.983165
+36.3 0.987719
+36.4 0.991097
+36.5 0.993586
+36.6 0.995409
+36.7 0.996736
+36.8 0.997694
+36.9 0.998383
+37 0.998874
+37.1 0.999221
+37.2 0.999466
+37.3 0.999636
+37.4 0.999754
+37.5 0.999835
+37.6 0.999891
+37.7 0.999928
+37.8 0.999953
+37.9 0.99997
+38 0.999981
+38.1 0.999988
+38.2 0.999992
+38.3 0.999995
+38.4 0.999997
+38.5 0.999998
+38.6 0.999999
+38.7 0.999999
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
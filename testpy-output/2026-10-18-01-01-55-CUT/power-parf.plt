@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "power-parf.eps"
+set title "Average transmit power (AP to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Power (mW)"
+plot "-"  title "Average Transmit Power" with lines
+5 1.09837
+15 3.22634
+25 15.0863
+35 31.1246
+45 36.7994
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "power-rrpaa.eps"
+set title "Average transmit power (AP to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Power (mW)"
+plot "-"  title "Average Transmit Power" with lines
+5 7.27999
+15 3.53612
+25 17.5082
+35 30.8419
+45 33.2627
+e
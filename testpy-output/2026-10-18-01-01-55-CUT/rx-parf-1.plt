@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "rx-parf-1.eps"
+set title "Percentage time AP1 in RX state vs time"
+set xlabel "Time (seconds)"
+set ylabel "Percent"
+plot "-"  title "RX Time" with lines
+0 0
+1 0.0092
+2 1.6444
+3 1.6232
+4 1.6064
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "throughput-parf-1.eps"
+set title "Throughput (AP1 to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Throughput (Mb/s)"
+plot "-"  title "Throughput Mbits/s" with lines
+0 0
+1 0
+2 23.2312
+3 23.0381
+4 22.8109
+e
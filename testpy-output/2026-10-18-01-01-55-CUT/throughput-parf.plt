@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "throughput-parf.eps"
+set title "Throughput (AP to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Throughput (Mb/s)"
+plot "-"  title "Throughput Mbits/s" with lines
+5 29.0362
+15 22.6859
+25 22.7882
+35 20.2094
+45 15.7109
+e
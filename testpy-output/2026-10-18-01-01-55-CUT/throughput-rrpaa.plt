@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "throughput-rrpaa.eps"
+set title "Throughput (AP to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Throughput (Mb/s)"
+plot "-"  title "Throughput Mbits/s" with lines
+5 27.5934
+15 25.8213
+25 26.3779
+35 20.1526
+45 14.5749
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "tx-parf-0.eps"
+set title "Percentage time AP0 in TX state vs time"
+set xlabel "Time (seconds)"
+set ylabel "Percent"
+plot "-"  title "TX Time" with lines
+0 0
+1 0.114
+2 60.0908
+3 58.9772
+4 59.5384
+e
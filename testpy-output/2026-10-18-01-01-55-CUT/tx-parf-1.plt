@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "tx-parf-1.eps"
+set title "Percentage time AP1 in TX state vs time"
+set xlabel "Time (seconds)"
+set ylabel "Percent"
+plot "-"  title "TX Time" with lines
+0 0
+1 0.114
+2 59.8224
+3 59.5384
+4 59.5772
+e
@@ -0,0 +1,2824 @@
+set terminal postscript eps color enh "Times-BoldItalic"
+set output "yans-frame-success-rate-ofdm.eps"
+set xlabel "SNR(dB)"
+set ylabel "Frame Success Rate"
+set xrange [-5:30]
+set yrange [0:1.2]
+set style line 1 linewidth 5
+set style line 2 linewidth 5
+set style line 3 linewidth 5
+set style line 4 linewidth 5
+set style line 5 linewidth 5
+set style line 6 linewidth 5
+set style line 7 linewidth 5
+set style line 8 linewidth 5
+set style increment user
+plot "-"  title "OfdmRate6Mbps" with lines, "-"  title "OfdmRate9Mbps" with lines, "-"  title "OfdmRate12Mbps" with lines, "-"  title "OfdmRate18Mbps" with lines, "-"  title "OfdmRate24Mbps" with lines, "-"  title "OfdmRate36Mbps" with lines, "-"  title "OfdmRate48Mbps" with lines, "-"  title "OfdmRate54Mbps" with lines
+-5 0
+-4.9 0
+-4.8 9.82651e-302
+-4.7 1.68286e-276
+-4.6 5.57761e-253
+-4.5 4.35089e-231
+-4.4 9.6585e-211
+-4.3 7.33629e-192
+-4.2 2.27995e-174
+-4.1 3.44787e-158
+-4 3.00144e-143
+-3.9 1.76983e-129
+-3.8 8.27431e-117
+-3.7 3.57126e-105
+-3.6 1.64815e-94
+-3.5 9.37056e-85
+-3.4 7.52201e-76
+-3.3 9.71866e-68
+-3.2 2.2918e-60
+-3.1 1.11257e-53
+-3 1.24747e-47
+-2.9 3.60527e-42
+-2.8 2.98132e-37
+-2.7 7.78939e-33
+-2.6 7.06337e-29
+-2.5 2.42925e-25
+-2.4 3.44507e-22
+-2.3 2.17933e-19
+-2.2 6.61962e-17
+-2.1 1.03424e-14
+-2 8.862e-13
+-1.9 4.42018e-11
+-1.8 1.35612e-09
+-1.7 2.69283e-08
+-1.6 3.62673e-07
+-1.5 3.45827e-06
+-1.4 2.42813e-05
+-1.3 0.000130095
+-1.2 0.0005494
+-1.1 0.00188306
+-1 0.00537807
+-0.9 0.0131049
+-0.8 0.0278257
+-0.7 0.0524583
+-0.6 0.0892805
+-0.5 0.1392
+-0.4 0.201398
+-0.3 0.27346
+-0.2 0.351894
+-0.1 0.432808
+-1.02696e-15 0.512538
+0.1 0.588076
+0.2 0.657279
+0.3 0.71888
+0.4 0.772376
+0.5 0.817856
+0.6 0.855816
+0.7 0.886994
+0.8 0.912244
+0.9 0.932438
+1 0.948409
+1.1 0.96091
+1.2 0.970605
+1.3 0.978057
+1.4 0.983737
+1.5 0.988033
+1.6 0.991256
+1.7 0.993657
+1.8 0.995431
+1.9 0.996733
+2 0.997681
+2.1 0.998366
+2.2 0.998857
+2.3 0.999207
+2.4 0.999454
+2.5 0.999627
+2.6 0.999747
+2.7 0.99983
+2.8 0.999887
+2.9 0.999925
+3 0.999951
+3.1 0.999968
+3.2 0.99998
+3.3 0.999987
+3.4 0.999992
+3.5 0.999995
+3.6 0.999997
+3.7 0.999998
+3.8 0.999999
+3.9 0.999999
+4 1
+4.1 1
+4.2 1
+4.3 1
+4.4 1
+4.5 1
+4.6 1
+4.7 1
+4.8 1
+4.9 1
+5 1
+5.1 1
+5.2 1
+5.3 1
+5.4 1
+5.5 1
+5.6 1
+5.7 1
+5.8 1
+5.9 1
+6 1
+6.1 1
+6.2 1
+6.3 1
+6.4 1
+6.5 1
+6.6 1
+6.7 1
+6.8 1
+6.9 1
+7 1
+7.1 1
+7.2 1
+7.3 1
+7.4 1
+7.5 1
+7.6 1
+7.7 1
+7.8 1
+7.9 1
+8 1
+8.1 1
+8.2 1
+8.3 1
+8.4 1
+8.5 1
+8.6 1
+8.7 1
+8.8 1
+8.9 1
+9 1
+9.1 1
+9.2 1
+9.3 1
+9.4 1
+9.5 1
+9.6 1
+9.7 1
+9.8 1
+9.9 1
+10 1
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 1.4822e-323
+-2.8 6.23464e-299
+-2.7 7.69596e-276
+-2.6 3.64567e-254
+-2.5 7.60508e-234
+-2.4 7.99598e-215
+-2.3 4.83716e-197
+-2.2 1.91713e-180
+-2.1 5.65349e-165
+-2 1.40509e-150
+-1.9 3.32479e-137
+-1.8 8.43845e-125
+-1.7 2.58076e-113
+-1.6 1.06541e-102
+-1.5 6.63108e-93
+-1.4 6.92878e-84
+-1.3 1.34922e-75
+-1.2 5.41796e-68
+-1.1 4.94842e-61
+-1 1.13001e-54
+-0.9 7.06821e-49
+-0.8 1.32216e-43
+-0.7 8.04653e-39
+-0.6 1.72724e-34
+-0.5 1.41264e-30
+-0.4 4.73802e-27
+-0.3 6.98935e-24
+-0.2 4.84594e-21
+-0.1 1.68148e-18
+-1.02696e-15 3.09823e-16
+0.1 3.20517e-14
+0.2 1.96163e-12
+0.3 7.45859e-11
+0.4 1.8441e-09
+0.5 3.09325e-08
+0.6 3.66115e-07
+0.7 3.17073e-06
+0.8 2.07755e-05
+0.9 0.000106196
+1 0.00043552
+1.1 0.00147007
+1.2 0.00417988
+1.3 0.0102233
+1.4 0.0219191
+1.5 0.0419004
+1.6 0.0725031
+1.7 0.115106
+1.8 0.169681
+1.9 0.234721
+2 0.307527
+2.1 0.384731
+2.2 0.46286
+2.3 0.538801
+2.4 0.610094
+2.5 0.675048
+2.6 0.732715
+2.7 0.78278
+2.8 0.825408
+2.9 0.861092
+3 0.890521
+3.1 0.914473
+3.2 0.933737
+3.3 0.949066
+3.4 0.961145
+3.5 0.970576
+3.6 0.977878
+3.7 0.983485
+3.8 0.987757
+3.9 0.990987
+4 0.993412
+4.1 0.995218
+4.2 0.996554
+4.3 0.997535
+4.4 0.998249
+4.5 0.998766
+4.6 0.999137
+4.7 0.999401
+4.8 0.999587
+4.9 0.999718
+5 0.999809
+5.1 0.999872
+5.2 0.999915
+5.3 0.999944
+5.4 0.999963
+5.5 0.999976
+5.6 0.999985
+5.7 0.99999
+5.8 0.999994
+5.9 0.999996
+6 0.999998
+6.1 0.999999
+6.2 0.999999
+6.3 0.999999
+6.4 1
+6.5 1
+6.6 1
+6.7 1
+6.8 1
+6.9 1
+7 1
+7.1 1
+7.2 1
+7.3 1
+7.4 1
+7.5 1
+7.6 1
+7.7 1
+7.8 1
+7.9 1
+8 1
+8.1 1
+8.2 1
+8.3 1
+8.4 1
+8.5 1
+8.6 1
+8.7 1
+8.8 1
+8.9 1
+9 1
+9.1 1
+9.2 1
+9.3 1
+9.4 1
+9.5 1
+9.6 1
+9.7 1
+9.8 1
+9.9 1
+10 1
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 9.81382e-314
+-2.2 1.11638e-291
+-2.1 8.67527e-271
+-2 4.99808e-251
+-1.9 2.31779e-232
+-1.8 9.39556e-215
+-1.7 3.6164e-198
+-1.6 1.43592e-182
+-1.5 6.3901e-168
+-1.4 3.46275e-154
+-1.3 2.48212e-141
+-1.2 2.55598e-129
+-1.1 4.10488e-118
+-1 1.11562e-107
+-0.9 5.56387e-98
+-0.8 5.51727e-89
+-0.7 1.17758e-80
+-0.6 5.84972e-73
+-0.5 7.30451e-66
+-0.4 2.4728e-59
+-0.3 2.44401e-53
+-0.2 7.58193e-48
+-0.1 7.92302e-43
+-1.02696e-15 2.98721e-38
+0.1 4.34356e-34
+0.2 2.59796e-30
+0.3 6.80211e-27
+0.4 8.27696e-24
+0.5 4.95736e-21
+0.6 1.54394e-18
+0.7 2.63482e-16
+0.8 2.58955e-14
+0.9 1.53647e-12
+1 5.75428e-11
+1.1 1.41847e-09
+1.2 2.39373e-08
+1.3 2.86885e-07
+1.4 2.5268e-06
+1.5 1.68828e-05
+1.6 8.81181e-05
+1.7 0.000369114
+1.8 0.00127201
+1.9 0.00368873
+2 0.00918896
+2.1 0.0200336
+2.2 0.0388745
+2.3 0.0681635
+2.4 0.10947
+2.5 0.162977
+2.6 0.227343
+2.7 0.299953
+2.8 0.377429
+2.9 0.456215
+3 0.533073
+3.1 0.60541
+3.2 0.671421
+3.3 0.730072
+3.4 0.780992
+3.5 0.824323
+3.6 0.860554
+3.7 0.890385
+3.8 0.914614
+3.9 0.934055
+4 0.949482
+4.1 0.961601
+4.2 0.971032
+4.3 0.978307
+4.4 0.983873
+4.5 0.988097
+4.6 0.991277
+4.7 0.993654
+4.8 0.995416
+4.9 0.996713
+5 0.997661
+5.1 0.998347
+5.2 0.998841
+5.3 0.999194
+5.4 0.999444
+5.5 0.999619
+5.6 0.999741
+5.7 0.999826
+5.8 0.999884
+5.9 0.999923
+6 0.99995
+6.1 0.999967
+6.2 0.999979
+6.3 0.999987
+6.4 0.999991
+6.5 0.999995
+6.6 0.999997
+6.7 0.999998
+6.8 0.999999
+6.9 0.999999
+7 1
+7.1 1
+7.2 1
+7.3 1
+7.4 1
+7.5 1
+7.6 1
+7.7 1
+7.8 1
+7.9 1
+8 1
+8.1 1
+8.2 1
+8.3 1
+8.4 1
+8.5 1
+8.6 1
+8.7 1
+8.8 1
+8.9 1
+9 1
+9.1 1
+9.2 1
+9.3 1
+9.4 1
+9.5 1
+9.6 1
+9.7 1
+9.8 1
+9.9 1
+10 1
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 3.25376e-313
+1.9 4.19549e-281
+2 8.78088e-252
+2.1 4.66443e-225
+2.2 9.60179e-201
+2.3 1.1434e-178
+2.4 1.15092e-158
+2.5 1.40198e-140
+2.6 2.90172e-124
+2.7 1.40605e-109
+2.8 2.15847e-96
+2.9 1.39595e-84
+3 4.97307e-74
+3.1 1.25537e-64
+3.2 2.84315e-56
+3.3 7.20372e-49
+3.4 2.50879e-42
+3.5 1.45458e-36
+3.6 1.67729e-31
+3.7 4.53476e-27
+3.8 3.34605e-23
+3.9 7.74838e-20
+4 6.40054e-17
+4.1 2.12022e-14
+4.2 3.13323e-12
+4.3 2.27535e-10
+4.4 8.86161e-09
+4.5 2.00251e-07
+4.6 2.81774e-06
+4.7 2.62958e-05
+4.8 0.000172148
+4.9 0.000830886
+5 0.00308923
+5.1 0.00919506
+5.2 0.0226608
+5.3 0.0476139
+5.4 0.0874885
+5.5 0.143688
+5.6 0.214928
+5.7 0.297517
+5.8 0.386351
+5.9 0.476086
+6 0.562094
+6.1 0.640989
+6.2 0.710748
+6.3 0.77056
+6.4 0.820531
+6.5 0.861374
+6.6 0.894136
+6.7 0.919996
+6.8 0.940122
+6.9 0.95559
+7 0.967347
+7.1 0.97619
+7.2 0.982778
+7.3 0.987643
+7.4 0.991203
+7.5 0.993787
+7.6 0.995647
+7.7 0.996974
+7.8 0.997914
+7.9 0.998573
+8 0.999032
+8.1 0.999349
+8.2 0.999566
+8.3 0.999714
+8.4 0.999812
+8.5 0.999878
+8.6 0.999922
+8.7 0.99995
+8.8 0.999969
+8.9 0.99998
+9 0.999988
+9.1 0.999993
+9.2 0.999996
+9.3 0.999997
+9.4 0.999998
+9.5 0.999999
+9.6 0.999999
+9.7 1
+9.8 1
+9.9 1
+10 1
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 4.56796e-316
+1.8 2.05881e-304
+1.9 5.73858e-293
+2 9.79665e-282
+2.1 1.01486e-270
+2.2 6.32336e-260
+2.3 2.34999e-249
+2.4 5.16812e-239
+2.5 6.67647e-229
+2.6 5.03202e-219
+2.7 2.19885e-209
+2.8 5.53916e-200
+2.9 8.00362e-191
+3 6.60391e-182
+3.1 3.09991e-173
+3.2 8.25252e-165
+3.3 1.243e-156
+3.4 1.05746e-148
+3.5 5.0763e-141
+3.6 1.37475e-133
+3.7 2.10144e-126
+3.8 1.81545e-119
+3.9 8.88203e-113
+4 2.46786e-106
+4.1 3.90811e-100
+4.2 3.54271e-94
+4.3 1.84777e-88
+4.4 5.57767e-83
+4.5 9.80888e-78
+4.6 1.01237e-72
+4.7 6.18171e-68
+4.8 2.25285e-63
+4.9 4.94656e-59
+5 6.60993e-55
+5.1 5.4332e-51
+5.2 2.77828e-47
+5.3 8.94326e-44
+5.4 1.83473e-40
+5.5 2.4298e-37
+5.6 2.10493e-34
+5.7 1.2092e-31
+5.8 4.67097e-29
+5.9 1.23073e-26
+6 2.24415e-24
+6.1 2.8738e-22
+6.2 2.62305e-20
+6.3 1.73212e-18
+6.4 8.39949e-17
+6.5 3.03606e-15
+6.6 8.3023e-14
+6.7 1.74305e-12
+6.8 2.85079e-11
+6.9 3.68463e-10
+7 3.81689e-09
+7.1 3.21289e-08
+7.2 2.22734e-07
+7.3 1.28841e-06
+7.4 6.29779e-06
+7.5 2.63326e-05
+7.6 9.52945e-05
+7.7 0.000301855
+7.8 0.000845964
+7.9 0.0021192
+8 0.00479147
+8.1 0.00986782
+8.2 0.0186713
+8.3 0.0327219
+8.4 0.0535173
+8.5 0.0822605
+8.6 0.119607
+8.7 0.165502
+8.8 0.219144
+8.9 0.27908
+9 0.343405
+9.1 0.409996
+9.2 0.476752
+9.3 0.541778
+9.4 0.603522
+9.5 0.660826
+9.6 0.712939
+9.7 0.759479
+9.8 0.80037
+9.9 0.835778
+10 0.866036
+10.1 0.891585
+10.2 0.912925
+10.3 0.930572
+10.4 0.94503
+10.5 0.956772
+10.6 0.966232
+10.7 0.973794
+10.8 0.979793
+10.9 0.984519
+11 0.988216
+11.1 0.991088
+11.2 0.993303
+11.3 0.995
+11.4 0.996292
+11.5 0.997268
+11.6 0.998001
+11.7 0.998548
+11.8 0.998952
+11.9 0.999249
+12 0.999466
+12.1 0.999623
+12.2 0.999736
+12.3 0.999816
+12.4 0.999873
+12.5 0.999913
+12.6 0.999941
+12.7 0.99996
+12.8 0.999974
+12.9 0.999983
+13 0.999989
+13.1 0.999993
+13.2 0.999995
+13.3 0.999997
+13.4 0.999998
+13.5 0.999999
+13.6 0.999999
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 4.5594e-298
+8 6.85948e-273
+8.1 2.07261e-249
+8.2 1.5089e-227
+8.3 3.16382e-207
+8.4 2.27548e-188
+8.5 6.66086e-171
+8.6 9.38033e-155
+8.7 7.4832e-140
+8.8 3.96598e-126
+8.9 1.63092e-113
+9 6.05223e-102
+9.1 2.34677e-91
+9.2 1.09601e-81
+9.3 7.07348e-73
+9.4 7.20353e-65
+9.5 1.31533e-57
+9.6 4.86871e-51
+9.7 4.10934e-45
+9.8 8.85016e-40
+9.9 5.41399e-35
+10 1.04169e-30
+10.1 6.9436e-27
+10.2 1.75679e-23
+10.3 1.83873e-20
+10.4 8.6315e-18
+10.5 1.96016e-15
+10.6 2.311e-13
+10.7 1.51053e-11
+10.8 5.81712e-10
+10.9 1.39615e-08
+11 2.19913e-07
+11.1 2.3836e-06
+11.2 1.85635e-05
+11.3 0.000108047
+11.4 0.000487034
+11.5 0.00175572
+11.6 0.00521001
+11.7 0.0130594
+11.8 0.0282944
+11.9 0.0540786
+12 0.0928369
+12.1 0.145431
+12.2 0.210789
+12.3 0.286106
+12.4 0.367476
+12.5 0.450672
+12.6 0.531837
+12.7 0.607917
+12.8 0.676843
+12.9 0.737501
+13 0.789574
+13.1 0.833334
+13.2 0.869437
+13.3 0.898748
+13.4 0.922214
+13.5 0.940766
+13.6 0.955269
+13.7 0.966491
+13.8 0.975092
+13.9 0.981625
+14 0.986546
+14.1 0.990222
+14.2 0.992946
+14.3 0.994949
+14.4 0.996411
+14.5 0.997469
+14.6 0.998229
+14.7 0.99877
+14.8 0.999153
+14.9 0.999421
+15 0.999608
+15.1 0.999737
+15.2 0.999825
+15.3 0.999884
+15.4 0.999924
+15.5 0.999951
+15.6 0.999969
+15.7 0.99998
+15.8 0.999987
+15.9 0.999992
+16 0.999995
+16.1 0.999997
+16.2 0.999998
+16.3 0.999999
+16.4 0.999999
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 5.06411e-315
+8.9 2.08723e-304
+9 6.11752e-294
+9.1 1.26001e-283
+9.2 1.80278e-273
+9.3 1.77173e-263
+9.4 1.18303e-253
+9.5 5.31073e-244
+9.6 1.58658e-234
+9.7 3.12388e-225
+9.8 4.01621e-216
+9.9 3.34202e-207
+10 1.78513e-198
+10.1 6.07334e-190
+10.2 1.30665e-181
+10.3 1.76601e-173
+10.4 1.49047e-165
+10.5 7.81309e-158
+10.6 2.53188e-150
+10.7 5.05164e-143
+10.8 6.18501e-136
+10.9 4.63473e-129
+11 2.12157e-122
+11.1 5.92554e-116
+11.2 1.00938e-109
+11.3 1.04901e-103
+11.4 6.65846e-98
+11.5 2.58607e-92
+11.6 6.16182e-87
+11.7 9.03732e-82
+11.8 8.19248e-77
+11.9 4.61255e-72
+12 1.62194e-67
+12.1 3.58443e-63
+12.2 5.01332e-59
+12.3 4.4716e-55
+12.4 2.56464e-51
+12.5 9.54269e-48
+12.6 2.32545e-44
+12.7 3.74872e-41
+12.8 4.03984e-38
+12.9 2.94253e-35
+13 1.46525e-32
+13.1 5.04729e-30
+13.2 1.2174e-27
+13.3 2.08178e-25
+13.4 2.55602e-23
+13.5 2.28252e-21
+13.6 1.50188e-19
+13.7 7.37773e-18
+13.8 2.74154e-16
+13.9 7.80851e-15
+14 1.72719e-13
+14.1 3.00582e-12
+14.2 4.16904e-11
+14.3 4.6674e-10
+14.4 4.27073e-09
+14.5 3.23315e-08
+14.6 2.0494e-07
+14.7 1.10038e-06
+14.8 5.06121e-06
+14.9 2.01596e-05
+15 7.02694e-05
+15.1 0.000216503
+15.2 0.000595302
+15.3 0.0014742
+15.4 0.0033166
+15.5 0.00683454
+15.6 0.0130008
+15.7 0.0229949
+15.8 0.0380763
+15.9 0.0594019
+16 0.0878279
+16.1 0.123745
+16.2 0.166988
+16.3 0.216828
+16.4 0.272063
+16.5 0.331159
+16.6 0.392417
+16.7 0.454147
+16.8 0.514798
+16.9 0.573055
+17 0.627893
+17.1 0.678591
+17.2 0.724709
+17.3 0.766061
+17.4 0.802661
+17.5 0.834681
+17.6 0.862402
+17.7 0.886174
+17.8 0.906383
+17.9 0.923429
+18 0.937702
+18.1 0.949572
+18.2 0.959383
+18.3 0.967442
+18.4 0.974026
+18.5 0.979376
+18.6 0.9837
+18.7 0.987177
+18.8 0.989959
+18.9 0.992174
+19 0.99393
+19.1 0.995314
+19.2 0.9964
+19.3 0.997248
+19.4 0.997907
+19.5 0.998416
+19.6 0.998808
+19.7 0.999107
+19.8 0.999335
+19.9 0.999508
+20 0.999638
+20.1 0.999735
+20.2 0.999807
+20.3 0.999861
+20.4 0.9999
+20.5 0.999929
+20.6 0.999949
+20.7 0.999964
+20.8 0.999975
+20.9 0.999983
+21 0.999988
+21.1 0.999992
+21.2 0.999995
+21.3 0.999996
+21.4 0.999998
+21.5 0.999998
+21.6 0.999999
+21.7 0.999999
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 2.49785e-303
+13.2 7.68851e-283
+13.3 2.31282e-263
+13.4 7.19542e-245
+13.5 2.45385e-227
+13.6 9.73684e-211
+13.7 4.77812e-195
+13.8 3.08603e-180
+13.9 2.79497e-166
+14 3.78573e-153
+14.1 8.18575e-141
+14.2 3.01826e-129
+14.3 2.02835e-118
+14.4 2.65638e-108
+14.5 7.25075e-99
+14.6 4.41194e-90
+14.7 6.40031e-82
+14.8 2.36672e-74
+14.9 2.38407e-67
+15 6.9872e-61
+15.1 6.35827e-55
+15.2 1.91535e-49
+15.3 2.03404e-44
+15.4 8.09939e-40
+15.5 1.28433e-35
+15.6 8.60017e-32
+15.7 2.57438e-28
+15.8 3.64012e-25
+15.9 2.56412e-22
+16 9.47043e-20
+16.1 1.92628e-17
+16.2 2.26132e-15
+16.3 1.60214e-13
+16.4 7.14765e-12
+16.5 2.09018e-10
+16.6 4.16105e-09
+16.7 5.84344e-08
+16.8 5.98471e-07
+16.9 4.61125e-06
+17 2.75128e-05
+17.1 0.000130558
+17.2 0.000505048
+17.3 0.00162916
+17.4 0.00447408
+17.5 0.01066
+17.6 0.0224173
+17.7 0.0422585
+17.8 0.0724132
+17.9 0.114217
+18 0.167688
+18.1 0.231446
+18.2 0.302959
+18.3 0.379022
+18.4 0.456283
+18.5 0.531693
+18.6 0.6028
+18.7 0.667877
+18.8 0.725913
+18.9 0.776521
+19 0.819796
+19.1 0.856173
+19.2 0.886293
+19.3 0.910901
+19.4 0.930765
+19.5 0.946627
+19.6 0.959169
+19.7 0.968993
+19.8 0.976624
+19.9 0.982501
+20 0.986993
+20.1 0.990399
+20.2 0.992963
+20.3 0.994879
+20.4 0.9963
+20.5 0.997346
+20.6 0.99811
+20.7 0.998664
+20.8 0.999063
+20.9 0.999348
+21 0.99955
+21.1 0.999692
+21.2 0.99979
+21.3 0.999859
+21.4 0.999906
+21.5 0.999938
+21.6 0.999959
+21.7 0.999973
+21.8 0.999983
+21.9 0.999989
+22 0.999993
+22.1 0.999996
+22.2 0.999997
+22.3 0.999998
+22.4 0.999999
+22.5 0.999999
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+e
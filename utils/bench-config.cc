@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+// This program benchmarks the resolution of Config paths through the
+// NodeList of a large topology: the drop trace of the queue of every
+// device is connected with a wildcard path, and then node by node, as
+// the examples tracing each node separately do.
+// Sample usage:  ./waf --run 'bench-config --nodes=10000'
+
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/node-container.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/packet.h"
+#include <iostream>
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * Sink of the drop traces.
+ *
+ * \param context the Config path of the queue
+ * \param p the packet
+ */
+static void
+Drop (std::string context, Ptr<const Packet> p)
+{
+}
+
+/**
+ * Print the rate of a phase
+ *
+ * \param name the phase
+ * \param paths the paths resolved
+ * \param ms the elapsed time
+ */
+static void
+PrintRate (char const *name, uint64_t paths, uint64_t ms)
+{
+  double ps = paths;
+  ps *= 1000;
+  ps /= std::max<uint64_t> (ms, 1);
+  std::cout << ps << " paths/s"
+            << " (" << ms << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nodes = 10000;
+  uint32_t devices = 2;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("nodes", "number of nodes", nodes);
+  cmd.AddValue ("devices", "number of devices of each node", devices);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Running bench-config with nodes=" << nodes
+            << ", devices=" << devices << std::endl;
+
+  NodeContainer c;
+  c.Create (nodes);
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); i++)
+    {
+      for (uint32_t j = 0; j < devices; j++)
+        {
+          Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+          device->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+          (*i)->AddDevice (device);
+        }
+    }
+
+  SystemWallClockMs time;
+  time.Start ();
+  Config::Connect ("/NodeList/*/DeviceList/*/$ns3::SimpleNetDevice/TxQueue/Drop",
+                   MakeCallback (&Drop));
+  PrintRate ("wildcard", 1, time.End ());
+
+  time.Start ();
+  for (uint32_t i = 0; i < nodes; i++)
+    {
+      std::ostringstream oss;
+      oss << "/NodeList/" << i << "/DeviceList/0/$ns3::SimpleNetDevice/TxQueue/Drop";
+      Config::Connect (oss.str (), MakeCallback (&Drop));
+    }
+  PrintRate ("node by node", nodes, time.End ());
+
+  return 0;
+}
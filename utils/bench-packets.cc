@@ -328,6 +328,43 @@ benchByteTags (uint32_t n)
     }
 }
 
+static void
+benchHops (uint32_t n)
+{
+  BenchHeader<20> tcp;
+  BenchHeader<20> ipv4;
+  BenchHeader<2> ppp;
+  BenchTag<1> tos;
+  BenchTag<1> priority;
+  BenchTag<16> flow;
+
+  for (uint32_t i = 0; i < n; i++)
+    {
+      // Sent by a host as a TCP socket and a flow probe do
+      Ptr<Packet> p = Create<Packet> (1448);
+      p->AddHeader (tcp);
+      p->AddPacketTag (tos);
+      p->AddPacketTag (priority);
+      p->AddByteTag (flow);
+      p->AddHeader (ipv4);
+      // Forwarded by four switches: each one gets a copy from the
+      // channel, looks for the tags and forwards it
+      for (uint32_t hop = 0; hop < 4; hop++)
+        {
+          Ptr<Packet> q = p->Copy ();
+          q->AddHeader (ppp);
+          q->RemoveHeader (ppp);
+          q->RemoveHeader (ipv4);
+          q->FindFirstMatchingByteTag (flow);
+          q->PeekPacketTag (priority);
+          q->RemovePacketTag (tos);
+          q->AddPacketTag (tos);
+          q->AddHeader (ipv4);
+          p = q;
+        }
+    }
+}
+
 static uint64_t
 runBenchOneIteration (void (*bench) (uint32_t), uint32_t n)
 {
@@ -376,6 +413,10 @@ int main (int argc, char *argv[])
         "by command-line argument --n=(number of packets)" << std::endl;
       exit (1);
     }
+  if (enablePrinting)
+    {
+      Packet::EnablePrinting ();
+    }
   std::cout << "Running bench-packets with n=" << n << std::endl;
   std::cout << "All tests begin by adding UDP and IPv4 headers." << std::endl;
 
@@ -385,6 +426,7 @@ int main (int argc, char *argv[])
   runBench (&benchD, n, minIterations, "Intermixed add/remove headers and tags");
   runBench (&benchFragment, n, minIterations, "Fragmentation and concatenation");
   runBench (&benchByteTags, n, minIterations, "Benchmark byte tags");
+  runBench (&benchHops, n, minIterations, "Forward over four hops with packet and byte tags");
 
   return 0;
 }
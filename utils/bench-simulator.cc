@@ -205,6 +205,7 @@ int main (int argc, char *argv[])
 
   bool schedCal           = false;
   bool schedHeap          = false;
+  bool schedLadder        = false;
   bool schedList          = false;
   bool schedMap           = true;
   bool schedPriorityQueue = false;
@@ -214,6 +215,7 @@ int main (int argc, char *argv[])
   uint32_t runs  =       1;
   std::string filename = "";
   bool calRev = false;
+  bool noPool = false;
 
   CommandLine cmd (__FILE__);
   cmd.Usage ("Benchmark the simulator scheduler.\n"
@@ -227,9 +229,11 @@ int main (int argc, char *argv[])
   cmd.AddValue ("cal",   "use CalendarSheduler",          schedCal);
   cmd.AddValue ("calrev", "reverse ordering in the CalendarScheduler", calRev);
   cmd.AddValue ("heap",  "use HeapScheduler",             schedHeap);
+  cmd.AddValue ("ladder", "use LadderScheduler",          schedLadder);
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
   cmd.AddValue ("pri",   "use PriorityQueue",             schedPriorityQueue);
+  cmd.AddValue ("nopool", "disable the event free lists", noPool);
   cmd.AddValue ("debug", "enable debugging output",       g_debug);
   cmd.AddValue ("pop",   "event population size (default 1E5)",         pop);
   cmd.AddValue ("total", "total number of events to run (default 1E6)", total);
@@ -250,6 +254,10 @@ int main (int argc, char *argv[])
     {
       factory.SetTypeId ("ns3::HeapScheduler");
     }
+  if (schedLadder)
+    {
+      factory.SetTypeId ("ns3::LadderScheduler");
+    }
   if (schedList)
     {
       factory.SetTypeId ("ns3::ListScheduler");
@@ -260,6 +268,7 @@ int main (int argc, char *argv[])
     }
       
   Simulator::SetScheduler (factory);
+  EventImpl::SetPoolEnabled (!noPool);
 
   LOGME (std::setprecision (g_fwidth - 6));
   DEB ("debugging is ON");
@@ -273,6 +282,7 @@ int main (int argc, char *argv[])
   LOGME ("population: " << pop);
   LOGME ("total events: " << total);
   LOGME ("runs: " << runs);
+  LOGME ("event pool: " << (noPool ? "disabled" : "enabled"));
 
   Bench *bench = new Bench (pop, total);
   bench->SetRandomStream (GetRandomStream (filename));
@@ -315,6 +325,11 @@ int main (int argc, char *argv[])
     }
 
   LOG ("");
+  EventImpl::PoolStats stats = EventImpl::GetPoolStats ();
+  LOGME ("event allocations: " << stats.allocations);
+  LOGME ("heap allocations: " << stats.heapAllocations <<
+         ", heap frees: " << stats.heapFrees);
+
   Simulator::Destroy ();
   delete bench;
   return 0;
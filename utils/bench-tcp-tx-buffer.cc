@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+// This program benchmarks the TcpTxBuffer scoreboard of a flow with a
+// large congestion window: a window of 'cwnd' segments is sent, one
+// segment out of 'lossEvery' is lost, the other ones are SACKed one ACK at
+// a time, the losses are retransmitted and the window is acknowledged.
+// Sample usage:  ./waf --run 'bench-tcp-tx-buffer --cwnd=10000 --rounds=5'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/packet.h"
+#include "ns3/tcp-tx-buffer.h"
+#include <iostream>
+#include <limits>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/// \returns an unlimited receiver window
+static uint32_t
+GetRWnd (void)
+{
+  return std::numeric_limits<uint32_t>::max ();
+}
+
+/// Elapsed time of each phase of the rounds
+struct BenchTimes
+{
+  uint64_t send {0};       //!< Sending the window
+  uint64_t sack {0};       //!< Processing the ACKs carrying SACK blocks
+  uint64_t retransmit {0}; //!< Retransmitting the losses
+  uint64_t ack {0};        //!< Acknowledging the window
+};
+
+/**
+ * Send, SACK, retransmit and acknowledge one window
+ *
+ * \param txBuf the buffer
+ * \param cwnd the window, in segments
+ * \param segmentSize the segment size
+ * \param lossEvery one segment out of this many is lost
+ * \param times the elapsed times, updated
+ */
+static void
+RunRound (Ptr<TcpTxBuffer> txBuf, uint32_t cwnd, uint32_t segmentSize,
+          uint32_t lossEvery, BenchTimes &times)
+{
+  SequenceNumber32 head = txBuf->HeadSequence ();
+  SystemWallClockMs time;
+
+  time.Start ();
+  for (uint32_t i = 0; i < cwnd; i++)
+    {
+      txBuf->Add (Create<Packet> (segmentSize));
+      txBuf->CopyFromSequence (segmentSize, head + i * segmentSize);
+    }
+  times.send += time.End ();
+
+  // The receiver reports the block holding the last segment first, then
+  // the two blocks received before (RFC 2018).
+  time.Start ();
+  TcpOptionSack::SackList previous;
+  uint32_t blockStart = 0;
+  for (uint32_t i = 0; i < cwnd; i++)
+    {
+      if (i % lossEvery == lossEvery - 1)
+        {
+          if (i > blockStart)
+            {
+              previous.push_front (TcpOptionSack::SackBlock (head + blockStart * segmentSize,
+                                                             head + i * segmentSize));
+              if (previous.size () > 2)
+                {
+                  previous.pop_back ();
+                }
+            }
+          blockStart = i + 1;
+          continue;
+        }
+      if (i < lossEvery - 1)
+        {
+          txBuf->DiscardUpTo (head + (i + 1) * segmentSize);
+          blockStart = i + 1;
+          continue;
+        }
+      TcpOptionSack::SackList sack = previous;
+      sack.push_front (TcpOptionSack::SackBlock (head + blockStart * segmentSize,
+                                                 head + (i + 1) * segmentSize));
+      txBuf->Update (sack);
+      txBuf->IsLost (txBuf->HeadSequence ());
+    }
+  times.sack += time.End ();
+
+  time.Start ();
+  for (uint32_t i = lossEvery - 1; i < cwnd; i += lossEvery)
+    {
+      txBuf->CopyFromSequence (segmentSize, head + i * segmentSize);
+    }
+  times.retransmit += time.End ();
+
+  time.Start ();
+  for (uint32_t i = lossEvery - 1; i < cwnd; i += lossEvery)
+    {
+      txBuf->DiscardUpTo (head + std::min (i + lossEvery, cwnd) * segmentSize);
+    }
+  times.ack += time.End ();
+}
+
+/**
+ * Print the rate of a phase
+ *
+ * \param name the phase
+ * \param segments the segments processed
+ * \param ms the elapsed time
+ */
+static void
+PrintRate (char const *name, uint64_t segments, uint64_t ms)
+{
+  double ps = segments;
+  ps *= 1000;
+  ps /= std::max<uint64_t> (ms, 1);
+  std::cout << ps << " segments/s"
+            << " (" << ms << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t cwnd = 10000;
+  uint32_t segmentSize = 1448;
+  uint32_t lossEvery = 100;
+  uint32_t rounds = 5;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the TcpTxBuffer scoreboard with a large window");
+  cmd.AddValue ("cwnd", "congestion window, in segments", cwnd);
+  cmd.AddValue ("segmentSize", "segment size, in bytes", segmentSize);
+  cmd.AddValue ("lossEvery", "one segment out of this many is lost", lossEvery);
+  cmd.AddValue ("rounds", "number of windows sent", rounds);
+  cmd.Parse (argc, argv);
+
+  if (cwnd == 0 || lossEvery < 2)
+    {
+      std::cerr << "Error-- the window must not be empty and "
+                << "at least one segment out of two must be received" << std::endl;
+      exit (1);
+    }
+  std::cout << "Running bench-tcp-tx-buffer with cwnd=" << cwnd
+            << " lossEvery=" << lossEvery << " rounds=" << rounds << std::endl;
+
+  Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer> ();
+  txBuf->SetRWndCallback (MakeCallback (&GetRWnd));
+  txBuf->SetHeadSequence (SequenceNumber32 (1));
+  txBuf->SetMaxBufferSize (cwnd * segmentSize);
+  txBuf->SetSegmentSize (segmentSize);
+  txBuf->SetDupAckThresh (3);
+
+  BenchTimes times;
+  for (uint32_t r = 0; r < rounds; r++)
+    {
+      RunRound (txBuf, cwnd, segmentSize, lossEvery, times);
+    }
+
+  uint64_t segments = static_cast<uint64_t> (cwnd) * rounds;
+  uint64_t losses = static_cast<uint64_t> (cwnd / lossEvery) * rounds;
+  PrintRate ("Send new data", segments, times.send);
+  PrintRate ("Process SACK blocks", segments - losses, times.sack);
+  PrintRate ("Retransmit losses", losses, times.retransmit);
+  PrintRate ("Acknowledge retransmissions", losses, times.ack);
+  return 0;
+}